@@ -0,0 +1,510 @@
+// vim:foldmethod=marker
+// Loader benchmarks for vkDuck. Writes synthetic models to a temporary
+// directory and times the loader on them.
+//
+//   vkDuckBench [suite...]
+//
+// Without arguments every suite runs. Numbers are the best of a few runs.
+#include <vkDuck/model_loader.h>
+#include <vkDuck/simd_kernels.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Heap tracking {{{
+// Every allocation carries its size in a header, so the suites can report
+// the peak heap use of a load. Mapped files are not counted.
+namespace {
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+std::atomic<size_t> gHeapBytes{0};
+std::atomic<size_t> gHeapPeak{0};
+
+void* trackedAlloc(size_t size) {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + kHeaderSize));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    std::memcpy(block, &size, sizeof(size));
+    const size_t now = gHeapBytes.fetch_add(size) + size;
+    size_t peak = gHeapPeak.load();
+    while (now > peak && !gHeapPeak.compare_exchange_weak(peak, now)) {
+    }
+    return block + kHeaderSize;
+}
+
+void trackedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(pointer) - kHeaderSize;
+    size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    gHeapBytes.fetch_sub(size);
+    std::free(block);
+}
+
+/// Reset the peak to the current heap use; returns that baseline
+size_t resetHeapPeak() {
+    const size_t now = gHeapBytes.load();
+    gHeapPeak.store(now);
+    return now;
+}
+} // namespace
+
+void* operator new(size_t size) { return trackedAlloc(size); }
+void* operator new[](size_t size) { return trackedAlloc(size); }
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { trackedFree(pointer); }
+// }}}
+
+// Helpers {{{
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kMB = 1024.0 * 1024.0;
+
+/// Best wall time of `runs` calls, in milliseconds
+double bestOf(int runs, const std::function<void()>& fn) {
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = Clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void append(std::vector<unsigned char>& bytes, const T& value) {
+    const auto* begin = reinterpret_cast<const unsigned char*>(&value);
+    bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+std::string base64Encode(const std::vector<unsigned char>& bytes) {
+    static constexpr char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        const size_t n = std::min<size_t>(3, bytes.size() - i);
+        uint32_t group = uint32_t(bytes[i]) << 16;
+        if (n > 1) group |= uint32_t(bytes[i + 1]) << 8;
+        if (n > 2) group |= bytes[i + 2];
+        out += kAlphabet[(group >> 18) & 63];
+        out += kAlphabet[(group >> 12) & 63];
+        out += n > 1 ? kAlphabet[(group >> 6) & 63] : '=';
+        out += n > 2 ? kAlphabet[group & 63] : '=';
+    }
+    return out;
+}
+
+/// A grid model with `meshCount` meshes of gridSize x gridSize vertices
+/// (positions, normals, texture coordinates, 32-bit indices), one node per
+/// mesh, in a .gltf with one buffer per mesh: an external .bin, or a base64
+/// data URI with `dataUri`
+struct GridModel {
+    fs::path path;
+    size_t vertexCount{0};
+    size_t indexCount{0};
+};
+
+GridModel writeGridModel(const fs::path& directory, const std::string& name,
+                         uint32_t meshCount, uint32_t gridSize, bool dataUri = false) {
+    GridModel model;
+    model.path = directory / (name + ".gltf");
+
+    const uint32_t vertices = gridSize * gridSize;
+    const uint32_t indices = (gridSize - 1) * (gridSize - 1) * 6;
+    std::string buffers, views, accessors, meshes, nodes, sceneNodes;
+    for (uint32_t m = 0; m < meshCount; ++m) {
+        std::vector<unsigned char> bytes;
+        for (uint32_t y = 0; y < gridSize; ++y) {
+            for (uint32_t x = 0; x < gridSize; ++x) {
+                append(bytes, float(x) / gridSize);
+                append(bytes, 0.01f * float((x * 7 + y * 13) % 17));
+                append(bytes, float(y) / gridSize);
+            }
+        }
+        for (uint32_t v = 0; v < vertices; ++v) {
+            append(bytes, 0.0f);
+            append(bytes, 1.0f);
+            append(bytes, 0.0f);
+        }
+        for (uint32_t y = 0; y < gridSize; ++y) {
+            for (uint32_t x = 0; x < gridSize; ++x) {
+                append(bytes, float(x) / gridSize);
+                append(bytes, float(y) / gridSize);
+            }
+        }
+        for (uint32_t y = 0; y + 1 < gridSize; ++y) {
+            for (uint32_t x = 0; x + 1 < gridSize; ++x) {
+                const uint32_t i = y * gridSize + x;
+                for (uint32_t index : {i, i + gridSize, i + 1, i + 1, i + gridSize, i + gridSize + 1}) {
+                    append(bytes, index);
+                }
+            }
+        }
+        std::string uri;
+        if (dataUri) {
+            uri = "data:application/octet-stream;base64," + base64Encode(bytes);
+        } else {
+            uri = name + "_" + std::to_string(m) + ".bin";
+            std::ofstream(directory / uri, std::ios::binary)
+                .write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+        }
+
+        const char* sep = m ? "," : "";
+        const uint32_t view = m * 4;
+        buffers += std::string(sep) + "{\"uri\":\"" + uri + "\",\"byteLength\":" +
+            std::to_string(bytes.size()) + "}";
+        const size_t sizes[4] = {vertices * 12u, vertices * 12u, vertices * 8u, indices * 4u};
+        size_t offset = 0;
+        for (int v = 0; v < 4; ++v) {
+            views += std::string(m || v ? "," : "") + "{\"buffer\":" + std::to_string(m) +
+                ",\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" +
+                std::to_string(sizes[v]) + "}";
+            offset += sizes[v];
+        }
+        const std::string count = std::to_string(vertices);
+        accessors += std::string(sep) +
+            "{\"bufferView\":" + std::to_string(view) + ",\"componentType\":5126,\"count\":" + count +
+            ",\"type\":\"VEC3\",\"min\":[0,0,0],\"max\":[1,1,1]}," +
+            "{\"bufferView\":" + std::to_string(view + 1) + ",\"componentType\":5126,\"count\":" + count +
+            ",\"type\":\"VEC3\"}," +
+            "{\"bufferView\":" + std::to_string(view + 2) + ",\"componentType\":5126,\"count\":" + count +
+            ",\"type\":\"VEC2\"}," +
+            "{\"bufferView\":" + std::to_string(view + 3) + ",\"componentType\":5125,\"count\":" +
+            std::to_string(indices) + ",\"type\":\"SCALAR\"}";
+        meshes += std::string(sep) + "{\"primitives\":[{\"attributes\":{\"POSITION\":" +
+            std::to_string(view) + ",\"NORMAL\":" + std::to_string(view + 1) +
+            ",\"TEXCOORD_0\":" + std::to_string(view + 2) + "},\"indices\":" +
+            std::to_string(view + 3) + "}]}";
+        nodes += std::string(sep) + "{\"mesh\":" + std::to_string(m) + ",\"translation\":[" +
+            std::to_string(m) + ",0,0]}";
+        sceneNodes += std::string(sep) + std::to_string(m);
+
+        model.vertexCount += vertices;
+        model.indexCount += indices;
+    }
+
+    std::ofstream(model.path)
+        << "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[" << sceneNodes
+        << "]}],\"nodes\":[" << nodes << "],\"meshes\":[" << meshes << "],\"accessors\":["
+        << accessors << "],\"bufferViews\":[" << views << "],\"buffers\":[" << buffers << "]}";
+    return model;
+}
+
+} // namespace
+// }}}
+
+// Model loading and mesh cache {{{
+namespace {
+
+void benchModelLoad(const fs::path& directory) {
+    const GridModel grid = writeGridModel(directory, "grid", 16, 512);
+    std::printf("model load: %zu vertices, %zu indices in 16 meshes\n",
+        grid.vertexCount, grid.indexCount);
+
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    ModelData data;
+    size_t peak = 0;
+    const double coldMs = bestOf(3, [&] {
+        data = {};
+        const size_t baseline = resetHeapPeak();
+        data = loadModel(grid.path, directory, options);
+        peak = gHeapPeak.load() - baseline;
+    });
+    const double geometry = data.timings.geometryBytes / kMB;
+    std::printf("  cold load     %8.1f ms  %7.1f MB geometry  %7.0f MB/s  peak heap %.1f MB (%.2fx geometry)\n",
+        coldMs, geometry, geometry / (coldMs / 1000.0), peak / kMB, peak / kMB / geometry);
+}
+
+void benchMeshCache(const fs::path& directory) {
+    const GridModel grid = writeGridModel(directory, "cached", 16, 512);
+    std::vector<fs::path> sources{grid.path};
+    for (uint32_t m = 0; m < 16; ++m) {
+        sources.push_back(directory / ("cached_" + std::to_string(m) + ".bin"));
+    }
+    std::printf("mesh cache: %zu vertices, %zu indices in 16 meshes\n",
+        grid.vertexCount, grid.indexCount);
+
+    ModelLoadOptions options;
+    ModelData data = loadModel(grid.path, directory, options);
+    std::printf("  cold + write  %8.1f ms\n", data.timings.totalMs);
+
+    const double warmMs = bestOf(5, [&] {
+        data = {};
+        data = loadModel(grid.path, directory, options);
+    });
+    std::printf("  warm hit      %8.2f ms  (sources stat'ed)\n", warmMs);
+
+    // Same size, new mtime: the content hash decides
+    const double hashedMs = bestOf(5, [&] {
+        data = {};
+        for (const fs::path& source : sources) {
+            fs::last_write_time(source, fs::last_write_time(source) + std::chrono::seconds(1));
+        }
+        data = loadModel(grid.path, directory, options);
+    });
+    std::printf("  warm hit      %8.2f ms  (sources touched, hashed)  cacheHit=%d\n",
+        hashedMs, int(data.timings.cacheHit));
+
+    // One of 16 meshes: the cache must not cost more than the load
+    ModelLoadOptions selective;
+    selective.nodeSelection = {3};
+    data = {};
+    data = loadModel(grid.path, directory, selective);
+    std::printf("  selective cold + write %8.1f ms  (read %.1f of %.1f MB of buffers)\n",
+        data.timings.totalMs, data.timings.bufferBytesRead / kMB, data.timings.bufferBytes / kMB);
+    const double selectiveWarmMs = bestOf(5, [&] {
+        data = {};
+        data = loadModel(grid.path, directory, selective);
+    });
+    std::printf("  selective warm hit     %8.2f ms\n", selectiveWarmMs);
+}
+
+void benchDataUris(const fs::path& directory) {
+    const GridModel grid = writeGridModel(directory, "inline", 4, 512, true);
+    std::printf("data URIs: %zu vertices, %zu indices in 4 inline buffers\n",
+        grid.vertexCount, grid.indexCount);
+
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    ModelData data;
+    double bestMBps = 0.0;
+    const double loadMs = bestOf(3, [&] {
+        data = {};
+        data = loadModel(grid.path, directory, options);
+        bestMBps = std::max(bestMBps,
+            data.timings.dataUriBytes / kMB / std::max(data.timings.dataUriMs / 1000.0, 1e-9));
+    });
+    std::printf("  cold load     %8.1f ms  %7.1f MB decoded from base64 at %.0f MB/s\n",
+        loadMs, data.timings.dataUriBytes / kMB, bestMBps);
+
+    // The kernel alone, per instruction set, over the same amount of base64
+    const size_t quads = data.timings.dataUriBytes / 3;
+    std::string encoded(quads * 4, 'A');
+    for (size_t i = 0; i < encoded.size(); ++i) {
+        encoded[i] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(i * 37 + i / 5) % 64];
+    }
+    std::vector<uint8_t> decoded(quads * 3);
+    for (simd::Isa isa : {simd::Isa::Scalar, simd::Isa::SSE41, simd::Isa::AVX2, simd::Isa::NEON}) {
+        const simd::KernelTable* k = simd::kernelsFor(isa);
+        if (!k) {
+            continue;
+        }
+        const double ms = bestOf(3, [&] { k->decodeBase64(encoded.data(), quads, decoded.data()); });
+        std::printf("  kernel %-7s %7.1f ms  %7.0f MB/s on one thread\n",
+            simd::isaName(isa), ms, decoded.size() / kMB / (ms / 1000.0));
+    }
+}
+
+} // namespace
+// }}}
+
+// SIMD kernels {{{
+namespace {
+
+using simd::Isa;
+using simd::KernelTable;
+
+/// Throughput of one kernel on one instruction set
+struct KernelBenchmark {
+    std::string kernel;
+    Isa isa;
+    double nsPerElement;
+    double gbPerSecond;     // Bytes read + written
+};
+
+/// Time every kernel on every supported instruction set over `elementCount`
+/// synthetic elements
+std::vector<KernelBenchmark> benchmarkKernels(size_t elementCount) {
+    using Clock = std::chrono::steady_clock;
+    elementCount = std::max<size_t>(elementCount, 1);
+
+    std::vector<uint16_t> indices16(elementCount);
+    std::vector<uint8_t> indices8(elementCount);
+    std::vector<uint32_t> indices32(elementCount);
+    std::vector<float> positions(elementCount * 3);
+    std::vector<float> output(elementCount * 3);
+    for (size_t i = 0; i < elementCount; ++i) {
+        indices16[i] = static_cast<uint16_t>(i * 7);
+        indices8[i] = static_cast<uint8_t>(i * 13);
+        positions[i * 3 + 0] = static_cast<float>(i % 1021) * 0.25f;
+        positions[i * 3 + 1] = static_cast<float>(i % 509) * -0.5f + 1.0f;
+        positions[i * 3 + 2] = static_cast<float>(i % 257) * 0.125f + 0.5f;
+    }
+
+    const float matrix4x4[16] = {
+        0.8f, 0.1f, 0.0f, 0.0f,
+        -0.1f, 0.9f, 0.2f, 0.0f,
+        0.0f, -0.2f, 1.1f, 0.0f,
+        3.0f, -2.0f, 1.0f, 1.0f,
+    };
+    const float matrix3x3[9] = {
+        0.8f, 0.1f, 0.0f,
+        -0.1f, 0.9f, 0.2f,
+        0.0f, -0.2f, 1.1f,
+    };
+    const size_t stride = 3 * sizeof(float);
+
+    // One base64 quad (4 characters -> 3 bytes) per element
+    std::string base64(elementCount * 4, 'A');
+    std::vector<uint8_t> decoded(elementCount * 3);
+
+    // One destination pixel (a 2x2 block of two 8-byte rows) per element
+    std::vector<uint8_t> pixelRows(elementCount * 16);
+    for (size_t i = 0; i < pixelRows.size(); ++i) {
+        pixelRows[i] = static_cast<uint8_t>(i * 29 + i / 7);
+    }
+    std::vector<uint8_t> downsampled(elementCount * 4);
+    std::vector<int32_t> projected(elementCount);
+    const int16_t axis[4] = {77, 150, 29, -64};
+    const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (size_t i = 0; i < base64.size(); ++i) {
+        base64[i] = alphabet[(i * 37 + i / 5) % 64];
+    }
+
+    // Best of a few runs to filter out warm-up and scheduling noise
+    auto time = [&](auto&& fn) {
+        double best = 0.0;
+        for (int run = 0; run < 5; ++run) {
+            auto start = Clock::now();
+            fn();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            best = (run == 0) ? ns : std::min(best, ns);
+        }
+        return best;
+    };
+
+    std::vector<KernelBenchmark> results;
+    auto record = [&](const char* kernel, Isa isa, double ns, size_t bytesPerElement) {
+        double bytes = static_cast<double>(bytesPerElement * elementCount);
+        results.push_back({
+            kernel, isa,
+            ns / static_cast<double>(elementCount),
+            ns > 0.0 ? bytes / ns : 0.0,
+        });
+    };
+
+    for (Isa isa : {Isa::Scalar, Isa::SSE41, Isa::AVX2, Isa::NEON}) {
+        const KernelTable* k = simd::kernelsFor(isa);
+        if (!k) {
+            continue;
+        }
+
+        record("widenIndices16", isa, time([&] {
+            k->widenIndices16(indices16.data(), indices32.data(), elementCount);
+        }), sizeof(uint16_t) + sizeof(uint32_t));
+
+        record("widenIndices8", isa, time([&] {
+            k->widenIndices8(indices8.data(), indices32.data(), elementCount);
+        }), sizeof(uint8_t) + sizeof(uint32_t));
+
+        record("narrowIndices32", isa, time([&] {
+            k->narrowIndices32(indices32.data(), indices16.data(), elementCount);
+        }), sizeof(uint32_t) + sizeof(uint16_t));
+
+        record("widenIndices8To16", isa, time([&] {
+            k->widenIndices8To16(indices8.data(), indices16.data(), elementCount);
+        }), sizeof(uint8_t) + sizeof(uint16_t));
+
+        record("transformPositions", isa, time([&] {
+            k->transformPositions(positions.data(), stride, matrix4x4,
+                output.data(), stride, elementCount);
+        }), 2 * stride);
+
+        record("transformDirections", isa, time([&] {
+            k->transformDirections(positions.data(), stride, matrix3x3,
+                output.data(), stride, elementCount);
+        }), 2 * stride);
+
+        float mn[3], mx[3];
+        record("computeBounds", isa, time([&] {
+            k->computeBounds(positions.data(), stride, elementCount, mn, mx);
+        }), stride);
+
+        record("decodeBase64", isa, time([&] {
+            k->decodeBase64(base64.data(), elementCount, decoded.data());
+        }), 4 + 3);
+
+        record("downsample2x2", isa, time([&] {
+            k->downsample2x2(pixelRows.data(), pixelRows.data() + elementCount * 8,
+                downsampled.data(), elementCount);
+        }), 16 + 4);
+
+        record("projectPixels", isa, time([&] {
+            k->projectPixels(pixelRows.data(), axis, projected.data(), elementCount);
+        }), 4 + sizeof(int32_t));
+    }
+
+    return results;
+}
+
+void benchSimdKernels(const fs::path&) {
+    constexpr size_t kElements = 1 << 20;
+    std::printf("simd kernels: %zu elements, best of 5\n", kElements);
+    for (const KernelBenchmark& result : benchmarkKernels(kElements)) {
+        std::printf("  %-20s %-7s %7.3f ns/element  %6.2f GB/s\n", result.kernel.c_str(),
+            simd::isaName(result.isa), result.nsPerElement, result.gbPerSecond);
+    }
+}
+
+} // namespace
+// }}}
+
+int main(int argc, char** argv) {
+    struct Suite {
+        const char* name;
+        void (*run)(const fs::path&);
+    };
+    const Suite suites[] = {
+        {"load", benchModelLoad},
+        {"cache", benchMeshCache},
+        {"datauri", benchDataUris},
+        {"kernels", benchSimdKernels},
+    };
+
+    const fs::path directory = fs::temp_directory_path() / "vkduck_bench";
+    fs::create_directories(directory);
+
+    int ran = 0;
+    for (const Suite& suite : suites) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            selected |= std::string_view(argv[i]) == suite.name;
+        }
+        if (selected) {
+            suite.run(directory);
+            ++ran;
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    if (ran == 0) {
+        std::fprintf(stderr, "unknown suite; available:");
+        for (const Suite& suite : suites) {
+            std::fprintf(stderr, " %s", suite.name);
+        }
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// vim:foldmethod=marker
+#pragma once
+#include <vkDuck/vulkan_base.h>
+#include <cstdint>
+#include <span>
+
+// BCn block compression {{{
+// CPU encoder for the block-compressed formats textures are cooked to:
+//
+//   BC1  RGB, 4 bits/texel. Opaque colour (4-colour mode only)
+//   BC4  R, 4 bits/texel. Single-channel data
+//   BC5  RG, 8 bits/texel. Two BC4 blocks: tangent-space normal XY
+//   BC7  RGBA, 8 bits/texel. Mode 6 only (one subset, 7777.1 endpoints,
+//        4-bit indices): colour with alpha and packed material data
+//
+// Endpoints come from the principal axis of each 4x4 block; texels are
+// projected onto it with the SIMD projectPixels kernel, and the endpoints
+// are refined once by least squares. Sources are BGRA8 images (as decoded
+// by imageLoad()); BC4/BC5 read the R and G channels. Blocks past the
+// image edge repeat the last row/column. Only the UNORM/SRGB variants are
+// encoded.
+
+/// True if encodeBlocks() can produce `format`
+bool isBlockEncodable(VkFormat format);
+
+/// Encode one BGRA8 level of `width` x `height` texels into
+/// textureLevelSize(format, width, height) bytes at `dst`. Rows of 4x4
+/// blocks are spread over the job system.
+/// Throws std::runtime_error for formats isBlockEncodable() rejects.
+void encodeBlocks(
+    const uint8_t* bgra,
+    uint32_t width,
+    uint32_t height,
+    VkFormat format,
+    uint8_t* dst
+);
+
+/// Encode a full mip chain (mipChainSize() layout, level 0 first) into
+/// `dst`, tightly packed in the same order. Blocks of all levels share one
+/// parallel pass, so small levels do not serialize behind large ones.
+void encodeBlockMipChain(
+    const uint8_t* bgraLevels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levels,
+    VkFormat format,
+    uint8_t* dst
+);
+
+/// Decode one level produced by encodeBlocks() back to BGRA8 (channels a
+/// format does not store read as 0, alpha as 255). BC7 blocks must use
+/// mode 6, as the encoder writes them.
+void decodeBlocks(
+    const uint8_t* blocks,
+    uint32_t width,
+    uint32_t height,
+    VkFormat format,
+    uint8_t* bgra
+);
+
+/// Peak signal-to-noise ratio in dB between two BGRA8 images over the
+/// channels `format` stores; infinity when they are identical there
+double blockPsnr(
+    std::span<const uint8_t> reference,
+    std::span<const uint8_t> decoded,
+    VkFormat format
+);
+// }}}
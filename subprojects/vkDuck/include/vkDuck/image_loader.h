@@ -1,17 +1,28 @@
 // vim:foldmethod=marker
 #pragma once
+#include <vkDuck/vulkan_base.h>
+#include <vkDuck/mapped_file.h>
 #include <cstdint>
 #include <filesystem>
+#include <span>
 #include <vector>
 #include <string>
 #include <unordered_map>
 
+struct ModelData;
+
 // Loaded image data
 struct LoadedImage {
     void* pixels = nullptr;
     uint32_t width = 0;
     uint32_t height = 0;
     bool valid = false;
+    // Decoded PNG/JPEG images are BGRA8 with one level. KTX2/DDS textures
+    // keep their own format and all stored levels, tightly packed level 0
+    // first (see texture_container.h).
+    VkFormat format = VK_FORMAT_B8G8R8A8_UNORM;
+    uint32_t mipLevels = 1;
+    size_t size = 0;                // Bytes at pixels, all levels
 };
 
 // Load an image file (PNG, etc.) using wuffs
@@ -23,9 +34,213 @@ void* imageLoad(
     uint32_t& height
 );
 
-// Load multiple images in parallel
+// Decode an encoded image (PNG, JPEG) held in memory, without copying it
+// Returns pixel data in BGRA format, or nullptr on failure
+// Caller must call imageFree() on the returned pointer
+void* imageLoadFromMemory(
+    std::span<const uint8_t> bytes,
+    uint32_t& width,
+    uint32_t& height
+);
+
+// Load a texture file: KTX2/DDS containers are passed through unchanged,
+// anything else is decoded to BGRA8 like imageLoad()
+// Free the pixels with imageFree(); valid is false on failure
+LoadedImage textureLoad(const std::filesystem::path& path);
+
+// textureLoad() for a file held in memory
+LoadedImage textureLoadFromMemory(std::span<const uint8_t> bytes);
+
+// Load multiple images in parallel, through the decoded texture cache when
+// it is configured (see texture_cache.h)
 // Returns a map of path -> LoadedImage
 std::unordered_map<std::string, LoadedImage> loadImagesAsync(const std::vector<std::string>& paths);
 
+// Decode all images embedded in a model (GLB bufferViews, data URIs) in
+// parallel, straight from the model's mapped memory
+// Returns a map of virtual texture path (see embeddedImagePath()) -> LoadedImage
+std::unordered_map<std::string, LoadedImage> loadEmbeddedImagesAsync(const ModelData& model);
+
 // Free image data returned by imageLoad
 void imageFree(void* pixels);
+
+// Channel packing {{{
+// Normal and metallic-roughness maps do not need four channels: they are
+// uploaded as R8G8 or R8 with a view swizzle that puts the kept channels
+// back where shaders sample them (see textureChannelLayout() in
+// texture_cook.h). Channel names are those of the BGRA8 texel.
+
+enum class TextureChannels : uint8_t {
+    Bgra,   // All four, B8G8R8A8 (nothing dropped)
+    Rg,     // R8G8 <- R, G (tangent-space normals)
+    Gb,     // R8G8 <- G, B (roughness, metallic)
+    G,      // R8 <- G
+    B       // R8 <- B
+};
+
+// Format a texture packed to `channels` is uploaded with
+VkFormat textureChannelsFormat(TextureChannels channels);
+
+// Bytes per texel of `channels`: 4, 2 or 1
+uint32_t textureChannelsTexelSize(TextureChannels channels);
+
+// Keep `channels` of `texels` BGRA8 texels, written tightly packed to `dst`
+// (which may alias `bgra`, as packing only shrinks)
+void packTextureChannels(const uint8_t* bgra, size_t texels, TextureChannels channels, uint8_t* dst);
+// }}}
+
+// Deferred decoding into staging memory {{{
+// A TextureSource maps a texture file (or views/copies encoded bytes) and
+// reads only its header, so the upload size is known before any pixel
+// exists. decodeInto() then writes the GPU-ready data straight into caller
+// memory, typically a persistently mapped staging buffer: the only copies
+// of a texture in flight are the file mapping and the staging memory,
+// instead of a file buffer, a decoded pixel buffer and the staging memory.
+
+class TextureSource {
+public:
+    TextureSource() = default;
+
+    /// Map `path` and read its header. Throws std::runtime_error if the file
+    /// cannot be read or is not a PNG, JPEG, KTX2 or DDS texture.
+    explicit TextureSource(const std::filesystem::path& path);
+
+    /// Read the header of a texture held in memory. With `copyBytes` false
+    /// the bytes are viewed in place and must outlive the source; otherwise
+    /// the encoded bytes (a fraction of the decoded size) are copied.
+    /// Throws like the path constructor.
+    explicit TextureSource(std::span<const uint8_t> bytes, bool copyBytes = true);
+
+    /// Take ownership of an encoded texture. Throws like the path constructor.
+    explicit TextureSource(std::vector<uint8_t>&& bytes);
+
+    TextureSource(TextureSource&&) noexcept = default;
+    TextureSource& operator=(TextureSource&&) noexcept = default;
+
+    bool valid() const { return size_ != 0; }
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    /// B8G8R8A8_UNORM for PNG/JPEG, the stored format for KTX2/DDS
+    VkFormat format() const { return format_; }
+    /// Levels decodeInto() writes: 1 for PNG/JPEG, all stored levels otherwise
+    uint32_t mipLevels() const { return mipLevels_; }
+    /// Bytes decodeInto() writes, all levels tightly packed level 0 first
+    size_t size() const { return size_; }
+    /// The encoded file
+    std::span<const uint8_t> bytes() const { return bytes_; }
+
+    /// Decode (PNG/JPEG) or copy (KTX2/DDS) into `dst`, which must hold
+    /// size() bytes. `dst` is only written, so write-combined memory is fine.
+    /// Returns false on a decoding error. Safe to call from several threads.
+    bool decodeInto(void* dst) const;
+
+    /// Bytes decodeInto(dst, channels) writes. Channels are only dropped
+    /// from B8G8R8A8 sources; other formats are written unchanged.
+    size_t size(TextureChannels channels) const;
+
+    /// decodeInto() keeping only `channels` of each texel, all levels
+    bool decodeInto(void* dst, TextureChannels channels) const;
+
+    /// Halvings setDownscale() can apply: the stored levels after the first
+    /// for KTX2/DDS with mips, down to 1x1 for PNG/JPEG and single-level
+    /// 4-byte containers, 0 for single-level block-compressed textures
+    uint32_t maxDownscale() const;
+
+    /// Decode `halvings` times smaller in each dimension, for previews.
+    /// KTX2/DDS with mips skip their first levels; PNG/JPEG are decoded
+    /// into scratch memory and box-filtered like generateMipChain() (in
+    /// linear space if `srgb`). width(), height(), mipLevels() and size()
+    /// then describe the reduced texture. Clamped to maxDownscale();
+    /// returns the halvings applied.
+    uint32_t setDownscale(uint32_t halvings, bool srgb);
+    /// Halvings applied by setDownscale(), 0 for full resolution
+    uint32_t downscale() const { return downscale_; }
+    /// Level 0 size as stored, before setDownscale()
+    uint32_t fullWidth() const { return fullWidth_; }
+    uint32_t fullHeight() const { return fullHeight_; }
+
+    /// decodeInto() a new buffer, for callers that keep the pixels; free it
+    /// with imageFree()
+    LoadedImage load() const;
+
+private:
+    void readHeader();
+    bool decodeImage(uint8_t* dst, size_t size) const;
+
+    MappedFile file_;
+    std::vector<uint8_t> ownedBytes_;
+    std::span<const uint8_t> bytes_;
+    uint32_t width_{0};
+    uint32_t height_{0};
+    VkFormat format_{VK_FORMAT_B8G8R8A8_UNORM};
+    uint32_t mipLevels_{1};
+    size_t size_{0};
+    uint32_t fullWidth_{0};
+    uint32_t fullHeight_{0};
+    uint32_t fullMipLevels_{1};
+    uint32_t downscale_{0};
+    bool srgbDownscale_{false};
+};
+
+// Open texture files in parallel (header only). Files that cannot be
+// opened map to an invalid source. With the decoded texture cache
+// configured (see texture_cache.h), sources come from the cache instead,
+// decoding misses into it; `linearPaths` are filtered as linear data when
+// the cache stores mips.
+std::unordered_map<std::string, TextureSource> openTexturesAsync(
+    const std::vector<std::string>& paths,
+    const std::vector<std::string>& linearPaths = {}
+);
+
+// Open all images embedded in a model (see loadEmbeddedImagesAsync()). The
+// sources view the model's memory, so `model` must outlive them; cached
+// sources map the cache instead.
+std::unordered_map<std::string, TextureSource> openEmbeddedTexturesAsync(
+    const ModelData& model,
+    const std::vector<std::string>& linearPaths = {}
+);
+// }}}
+
+// Mip chains {{{
+// Textures are uploaded with a full mip chain. The levels are either blitted
+// on the GPU after level 0 is copied (see recordMipBlits() in library.h) or
+// filtered here on the CPU while staging, which keeps the transfer queue free
+// of blits and also works for formats that cannot be blitted.
+
+enum class MipGeneration : uint8_t {
+    None,   // Level 0 only
+    Gpu,    // vkCmdBlitImage from each level to the next
+    Cpu     // 2x2 box filter while staging
+};
+
+// Number of levels down to 1x1: floor(log2(max(width, height))) + 1
+uint32_t mipLevelCount(uint32_t width, uint32_t height);
+
+// Bytes of `levels` tightly packed 4-byte-per-pixel levels, level 0 first
+size_t mipChainSize(uint32_t width, uint32_t height, uint32_t levels);
+
+// Filter levels 1..levels-1 of a BGRA/RGBA image into `dst`, tightly packed
+// in order (dst points just past level 0). Each level is the 2x2 box average
+// of the previous one; sRGB images are averaged in linear space. `dst` is
+// only written, so it can be mapped staging memory.
+void generateMipChain(
+    const uint8_t* level0,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levels,
+    bool srgb,
+    uint8_t* dst
+);
+
+// Box-filter a BGRA/RGBA image `halvings` times like generateMipChain(),
+// writing only the last level, max(1, width >> halvings) x
+// max(1, height >> halvings) pixels, to `dst` (preview resolution)
+void downscaleImage(
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t halvings,
+    bool srgb,
+    uint8_t* dst
+);
+// }}}
@@ -0,0 +1,179 @@
+// vim:foldmethod=marker
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+// Shared job system {{{
+// A fixed set of worker threads shared by every loader in vkDuck, so that
+// loading many models or images never starts more threads than the machine
+// has cores. Jobs run in one of two lanes:
+//
+//   Cpu  decoding and processing; one worker per hardware thread
+//   Io   blocking filesystem calls (existence checks, reads); a few workers
+//        that mostly wait, kept apart so they never hold up CPU work
+//
+// Each worker owns a queue. Jobs submitted from a worker go to its own queue
+// and run newest first; idle workers steal the oldest jobs of the others.
+// Jobs in the Io lane must not wait on other jobs.
+
+enum class JobLane {
+    Cpu,
+    Io
+};
+
+/// Counters of one lane since the pool was created or resetStats()
+struct JobLaneStats {
+    uint32_t threads{0};
+    uint64_t jobsCompleted{0};
+    uint64_t jobsStolen{0};      // Taken from another worker's queue
+    size_t queuedJobs{0};        // Waiting at the time of the call
+    double busyMs{0.0};          // Time spent running jobs, summed over workers
+    double wallMs{0.0};
+
+    /// Fraction of the lane's worker time spent running jobs
+    float utilization() const {
+        return threads > 0 && wallMs > 0.0
+            ? static_cast<float>(busyMs / (wallMs * threads)) : 0.0f;
+    }
+};
+
+struct JobSystemStats {
+    JobLaneStats cpu;
+    JobLaneStats io;
+};
+
+class JobSystem {
+public:
+    /// 0 picks the default: hardware_concurrency CPU workers, 4 I/O workers
+    explicit JobSystem(uint32_t cpuThreads = 0, uint32_t ioThreads = 0);
+
+    /// Runs every queued job, then joins the workers
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Queue `job`. Exceptions escaping it are swallowed; use async() to
+    /// observe them.
+    void submit(std::function<void()> job, JobLane lane = JobLane::Cpu);
+
+    /// Queue `fn` and return a future for its result (the std::async
+    /// replacement for the loaders)
+    template <typename Fn>
+    auto async(Fn&& fn, JobLane lane = JobLane::Cpu)
+        -> std::future<std::invoke_result_t<std::decay_t<Fn>>>;
+
+    /// Run `fn(i)` for i in [0, count) on the lane's workers and the calling
+    /// thread, which takes part until every index is claimed. Safe to call
+    /// from inside a job. The first exception thrown by any call is rethrown
+    /// here. Returns the number of threads that ran at least one index.
+    template <typename Fn>
+    uint32_t parallelFor(size_t count, Fn&& fn, JobLane lane = JobLane::Cpu);
+
+    uint32_t threadCount(JobLane lane = JobLane::Cpu) const;
+
+    JobSystemStats stats() const;
+    void resetStats();
+
+private:
+    struct Lane;
+    Lane& lane(JobLane lane) const;
+
+    std::unique_ptr<Lane> cpu_;
+    std::unique_ptr<Lane> io_;
+};
+
+/// The process-wide pool used by the vkDuck loaders, created on first use
+JobSystem& jobSystem();
+
+/// Recreate the shared pool with the given thread counts (0 = default).
+/// Call while no loader is running; queued jobs finish on the old pool.
+void configureJobSystem(uint32_t cpuThreads, uint32_t ioThreads = 0);
+// }}}
+
+// Template implementation {{{
+template <typename Fn>
+auto JobSystem::async(Fn&& fn, JobLane lane)
+    -> std::future<std::invoke_result_t<std::decay_t<Fn>>> {
+    using Result = std::invoke_result_t<std::decay_t<Fn>>;
+    // std::function needs a copyable target, so the task is shared
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+    std::future<Result> future = task->get_future();
+    submit([task]() { (*task)(); }, lane);
+    return future;
+}
+
+template <typename Fn>
+uint32_t JobSystem::parallelFor(size_t count, Fn&& fn, JobLane lane) {
+    const size_t threads = std::min<size_t>(threadCount(lane), count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return 1;
+    }
+
+    // Helpers that start after the last index was claimed return without
+    // touching `fn`, so the state they share outlives this call
+    struct State {
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> completed{0};
+        std::atomic<uint32_t> participants{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr firstError;
+        std::mutex errorMutex;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+
+    auto run = [](State& s, auto& body) {
+        bool participated = false;
+        for (size_t i = s.next.fetch_add(1, std::memory_order_relaxed); i < s.count;
+             i = s.next.fetch_add(1, std::memory_order_relaxed)) {
+            if (!participated) {
+                participated = true;
+                s.participants.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!s.failed.load(std::memory_order_relaxed)) {
+                try {
+                    body(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(s.errorMutex);
+                    if (!s.firstError) {
+                        s.firstError = std::current_exception();
+                    }
+                    s.failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            if (s.completed.fetch_add(1, std::memory_order_acq_rel) + 1 == s.count) {
+                s.completed.notify_all();
+            }
+        }
+    };
+
+    auto* body = &fn;
+    for (size_t t = 1; t < threads; ++t) {
+        submit([state, body, run]() { run(*state, *body); }, lane);
+    }
+    run(*state, fn);
+
+    for (size_t done = state->completed.load(std::memory_order_acquire); done < count;
+         done = state->completed.load(std::memory_order_acquire)) {
+        state->completed.wait(done, std::memory_order_acquire);
+    }
+
+    if (state->firstError) {
+        std::rethrow_exception(state->firstError);
+    }
+    return state->participants.load(std::memory_order_relaxed);
+}
+// }}}
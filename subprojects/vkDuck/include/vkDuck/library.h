@@ -83,9 +83,13 @@ void transitionImageLayout(
     VkImage image,
     VkFormat format,
     VkImageLayout oldLayout,
-    VkImageLayout newLayout
+    VkImageLayout newLayout,
+    uint32_t mipLevels = 1
 );
 
+// Copy `mipLevels` levels of `format` tightly packed in `buffer`, level 0
+// first (see textureLevelSize() in texture_container.h) into an image in
+// TRANSFER_DST layout
 void copyBufferToImage(
     VkDevice device,
     VkQueue graphicsQueue,
@@ -93,7 +97,32 @@ void copyBufferToImage(
     VkBuffer buffer,
     VkImage image,
     uint32_t width,
-    uint32_t height
+    uint32_t height,
+    uint32_t mipLevels = 1,
+    VkFormat format = VK_FORMAT_B8G8R8A8_UNORM
+);
+
+// Record blits filling levels 1..mipLevels-1 from level 0. Every level must
+// be in TRANSFER_DST layout with level 0 written; all of them end up in
+// SHADER_READ_ONLY. The image needs TRANSFER_SRC usage and a format that
+// supports linear blit filtering.
+void recordMipBlits(
+    VkCommandBuffer commandBuffer,
+    VkImage image,
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevels
+);
+
+// recordMipBlits() in a single-time command buffer
+void generateMipmaps(
+    VkDevice device,
+    VkQueue graphicsQueue,
+    VkCommandPool commandPool,
+    VkImage image,
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevels
 );
 // }}}
 
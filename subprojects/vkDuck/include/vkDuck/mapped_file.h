@@ -0,0 +1,53 @@
+// vim:foldmethod=marker
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// Read-only memory-mapped file {{{
+/// Maps a whole file read-only for the lifetime of the object.
+/// Move-only; the mapping is released in the destructor.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /// Map `path` read-only. Throws std::runtime_error if the file cannot be
+    /// opened or mapped. Empty files are valid and yield an empty span.
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::span<const uint8_t> bytes() const { return {data_, size_}; }
+
+    /// Drop the mapped pages from the process's resident set once they have
+    /// been consumed. They stay in the OS file cache and fault back in on
+    /// the next access, so the mapping remains fully usable.
+    void evict() const;
+
+private:
+    void release();
+
+    const uint8_t* data_{nullptr};
+    size_t size_{0};
+#ifdef _WIN32
+    void* fileHandle_{nullptr};
+    void* mappingHandle_{nullptr};
+#endif
+};
+// }}}
+
+// Content hashing {{{
+/// 64-bit non-cryptographic content hash (XXH64), used as cache keys
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+/// Hash the full contents of a file through a read-only mapping.
+/// Throws std::runtime_error if the file cannot be read.
+uint64_t hashFile(const std::filesystem::path& path, uint64_t seed = 0);
+// }}}
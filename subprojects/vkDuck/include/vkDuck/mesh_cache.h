@@ -0,0 +1,58 @@
+// vim:foldmethod=marker
+#pragma once
+
+#include <vkDuck/model_loader.h>
+#include <filesystem>
+#include <vector>
+
+// Preprocessed binary mesh cache (.vkdmesh) {{{
+// A .vkdmesh file sits next to its source model and stores the decoded
+// output of loadModel(): vertex and 16/32-bit index arrays, geometry ranges,
+// LOD chains, meshlets, instances, materials, scene nodes, cameras, lights,
+// resolved texture paths and the location of embedded images. Warm loads map
+// the file and serve vertices, indices and meshlets as spans without touching
+// the glTF; images in a GLB's BIN chunk are viewed in the mapped model file.
+//
+// A cache is only used when its key matches: format version, loader version
+// (kModelLoaderVersion), a hash of the load options and project root, and the
+// source file and every external buffer it references. Sources are checked
+// by size and modification time first, so a warm hit only stats them; their
+// content hash is read only when the size matches but the mtime does not
+// (e.g. after a checkout that rewrote an identical file). Caches of selective
+// loads (ModelLoadOptions::nodeSelection) store no content hashes, so neither
+// writing nor validating them reads the buffers of unselected meshes.
+
+/// Bump when the on-disk layout of .vkdmesh files changes
+constexpr uint32_t kMeshCacheFormatVersion = 8;
+
+/// Cache file path for a model. The name carries the option/project-root key,
+/// so loads with different options (e.g. editor and generated app) keep
+/// separate caches: "models/ship.glb" -> "models/ship.glb.3f2a9c1e.vkdmesh"
+std::filesystem::path meshCachePath(
+    const std::filesystem::path& modelPath,
+    const std::filesystem::path& projectRoot,
+    const ModelLoadOptions& options
+);
+
+/// Map the cache of `modelPath` into `out` if it exists and its key matches.
+/// Returns false on a miss or a stale/corrupt cache; never throws.
+bool readMeshCache(
+    const std::filesystem::path& modelPath,
+    const std::filesystem::path& projectRoot,
+    const ModelLoadOptions& options,
+    ModelData& out
+);
+
+/// Write the cache for `modelPath`. `dependencies` are external files the
+/// decoded data depends on (e.g. .bin buffers), relative to the model's
+/// directory. The file is written to a temporary name and renamed, so
+/// concurrent readers never see a partial cache.
+/// Returns false if the cache could not be written; never throws.
+bool writeMeshCache(
+    const std::filesystem::path& modelPath,
+    const std::filesystem::path& projectRoot,
+    const ModelLoadOptions& options,
+    const ModelData& data,
+    const std::vector<std::filesystem::path>& dependencies
+);
+// }}}
@@ -0,0 +1,147 @@
+// vim:foldmethod=marker
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Index/vertex buffer optimization {{{
+// Reorders triangle lists for the GPU's post-transform vertex cache and for
+// early-z friendly draw order, then reorders vertices for linear fetch.
+// All functions operate on a single triangle list whose indices are relative
+// to its own vertex array (one GeometryRange).
+
+/// FIFO size assumed by the cache simulation and optimizer
+constexpr uint32_t kVertexCacheSize = 16;
+
+/// Result of simulating a FIFO post-transform vertex cache
+struct VertexCacheStats {
+    size_t misses{0};         // Vertices transformed
+    size_t triangles{0};
+    size_t vertices{0};       // Distinct vertices referenced
+    float acmr{0.0f};         // Average cache miss ratio: misses per triangle (0.5 - 3.0)
+    float atvr{0.0f};         // Average transformed vertex ratio: misses per vertex (1.0 is optimal)
+};
+
+/// Simulate a `cacheSize`-entry FIFO cache over `indices`
+VertexCacheStats analyzeVertexCache(
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount,
+    uint32_t cacheSize = kVertexCacheSize
+);
+
+/// Reorder triangles for vertex cache locality (Tipsify, Sander et al. 2007).
+/// `destination` must not alias `indices`.
+void optimizeVertexCache(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount,
+    uint32_t cacheSize = kVertexCacheSize
+);
+
+/// Reorder clusters of a cache-optimized triangle list so that outward
+/// facing clusters are drawn first, reducing overdraw. Clusters are only
+/// split where the cache miss ratio stays within `threshold` of the input
+/// (1.05 = at most 5% worse). `positions` are strided float3.
+/// `destination` must not alias `indices`.
+void optimizeOverdraw(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    float threshold = 1.05f,
+    uint32_t cacheSize = kVertexCacheSize
+);
+
+/// Build a vertex remap table in first-use order: remap[old] = new.
+/// Unreferenced vertices keep their relative order after all referenced ones,
+/// so the vertex count is unchanged. Returns the number of referenced vertices.
+size_t generateVertexFetchRemap(
+    uint32_t* remap,
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount
+);
+// }}}
+
+// Simplification {{{
+/// Reduce a triangle list towards `targetIndexCount` indices with quadric
+/// error metric half-edge collapses (Garland and Heckbert 1997). Vertices only
+/// move onto existing vertices, so the result indexes the same vertex array
+/// and can be stored as an extra index range over it (a LOD level).
+/// Vertices on open borders and attribute seams (several vertices sharing one
+/// position) are kept in place so UVs and silhouettes don't tear.
+/// Collapses stop once their error would exceed `targetError`, relative to the
+/// mesh extent (0.01 = 1% of the largest bounding box side). `resultError`
+/// receives the largest error reached, in the same unit.
+/// `destination` may alias `indices`. Returns the number of indices written.
+size_t simplifyMesh(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    size_t targetIndexCount,
+    float targetError,
+    float* resultError = nullptr
+);
+// }}}
+
+// Meshlets {{{
+// Splits a triangle list into small clusters for cluster-level culling (task/
+// mesh shaders or compute culling before an indirect draw). A meshlet lists
+// up to kMeshletMaxVertices vertices of the range and stores its triangles as
+// byte triplets into that list, the layout VK_EXT_mesh_shader consumes.
+
+constexpr uint32_t kMeshletMaxVertices = 64;
+constexpr uint32_t kMeshletMaxTriangles = 124;
+
+/// One cluster, laid out for std430 storage buffers.
+/// A meshlet is invisible from a camera at `eye` if its sphere is outside the
+/// frustum, or if all of its triangles face away:
+///   dot(center - eye, coneAxis) >= coneCutoff * length(center - eye) + radius
+/// coneCutoff is 1 when the normals spread too far for the cone test.
+/// Bounds are in the space of the vertices, so `eye` has to be as well.
+struct Meshlet {
+    uint32_t vertexOffset;      // First entry in the meshlet vertex list
+    uint32_t triangleOffset;    // First byte in the meshlet triangle list
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+    float center[3];            // Bounding sphere
+    float radius;
+    float coneAxis[3];          // Average facing direction
+    float coneCutoff;           // sin of the cone's half angle
+};
+static_assert(sizeof(Meshlet) == 48);
+
+/// Upper bound of the meshlets buildMeshlets() emits for `indexCount` indices
+size_t meshletBound(
+    size_t indexCount,
+    size_t maxVertices = kMeshletMaxVertices,
+    size_t maxTriangles = kMeshletMaxTriangles
+);
+
+/// Grow meshlets greedily across shared vertices, preferring triangles that
+/// add the fewest new vertices; disconnected pieces continue with the nearest
+/// of the next triangles in input order, so cache-optimized input gives
+/// tighter meshlets. With bound = meshletBound(indexCount, ...), `meshlets`
+/// must hold bound entries, `meshletVertices` bound * maxVertices and
+/// `meshletTriangles` bound * maxTriangles * 3. Offsets start at 0 and the
+/// lists are packed, so the last meshlet marks their used length.
+/// `maxVertices` must not exceed 256. Returns the number of meshlets.
+size_t buildMeshlets(
+    Meshlet* meshlets,
+    uint32_t* meshletVertices,
+    uint8_t* meshletTriangles,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    size_t maxVertices = kMeshletMaxVertices,
+    size_t maxTriangles = kMeshletMaxTriangles
+);
+// }}}
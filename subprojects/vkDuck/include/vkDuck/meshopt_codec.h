@@ -0,0 +1,48 @@
+// vim:foldmethod=marker
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// EXT_meshopt_compression decoding {{{
+// Decoder for buffer views compressed with the meshoptimizer codecs (as
+// written by gltfpack -c). Each compressed view is one stream of `count`
+// elements of `stride` bytes, decoded in one of three modes and optionally
+// post-processed by a filter:
+//
+//   ATTRIBUTES  vertex codec: per-byte deltas against the previous vertex,
+//               packed in groups of 16 with 0/2/4/8 bits per delta
+//   TRIANGLES   index codec: edge/vertex FIFOs over a triangle list
+//   INDICES     index sequence: zigzag varint deltas against two baselines
+//
+//   OCTAHEDRAL  snorm8/16 octahedral unit vectors -> snorm xyz (w kept)
+//   QUATERNION  snorm16 three-component quaternions -> snorm16 xyzw
+//   EXPONENTIAL 24-bit mantissa + 8-bit exponent -> float32
+//
+// See the extension specification for the exact bitstream layout.
+
+enum class MeshoptMode {
+    Attributes,
+    Triangles,
+    Indices
+};
+
+enum class MeshoptFilter {
+    None,
+    Octahedral,
+    Quaternion,
+    Exponential
+};
+
+/// Decode one compressed stream into `destination` (count * stride bytes)
+/// and apply `filter` in place. Throws std::runtime_error if the stream is
+/// malformed or the mode/filter does not support `stride`.
+void decodeMeshoptStream(
+    void* destination,
+    size_t count,
+    size_t stride,
+    std::span<const uint8_t> source,
+    MeshoptMode mode,
+    MeshoptFilter filter
+);
+// }}}
@@ -2,13 +2,22 @@
 #pragma once
 
 #include <vkDuck/vulkan_base.h>
+#include <vkDuck/mesh_optimizer.h>
 #include <glm/glm.hpp>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <future>
 #include <unordered_map>
 
+class MappedFile;
+
+/// Bump when the decoded output of loadModel() changes, so that stale
+/// .vkdmesh caches are rebuilt
+constexpr uint32_t kModelLoaderVersion = 7;
+
 // Vertex structure for loaded models {{{
 struct Vertex {
     glm::vec3 pos;
@@ -64,6 +73,38 @@ struct Vertex {
 };
 // }}}
 
+// Per-instance data for instanced geometry {{{
+/// Bound as a second vertex stream (binding 1, per-instance rate).
+/// The transform occupies locations 5-8, one vec4 column per location.
+/// Vertices of instanced ranges are in mesh space: a vertex shader that
+/// does not read these locations draws every instance at the mesh origin.
+struct InstanceData {
+    glm::mat4 transform{1.0f};
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 1;
+        bindingDescription.stride = sizeof(InstanceData);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        return bindingDescription;
+    }
+
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+        for (uint32_t column = 0; column < 4; ++column) {
+            attributeDescriptions[column].binding = 1;
+            attributeDescriptions[column].location = 5 + column;
+            attributeDescriptions[column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attributeDescriptions[column].offset =
+                offsetof(InstanceData, transform) + column * sizeof(glm::vec4);
+        }
+
+        return attributeDescriptions;
+    }
+};
+// }}}
+
 // GLTFCamera structure for embedded cameras in GLTF files {{{
 struct GLTFCamera {
     std::string name;
@@ -100,6 +141,72 @@ struct GLTFLight {
 };
 // }}}
 
+// Scene hierarchy {{{
+/// A node of the default scene. ModelData::nodes is stored depth-first, so
+/// every parent precedes its children.
+struct SceneNode {
+    std::string name;
+    int32_t parent{-1};              // Into ModelData::nodes, -1 for scene roots
+    glm::mat4 localTransform{1.0f};  // Relative to the parent
+    glm::mat4 worldTransform{1.0f};  // Parent's worldTransform * localTransform
+};
+// }}}
+
+// Embedded images {{{
+/// An image stored inside the model file instead of next to it: a GLB
+/// bufferView or a data URI. Its ModelData::allTexturePaths entry is a
+/// virtual path (see embeddedImagePath()) that only names it.
+struct EmbeddedImage {
+    std::string mimeType;
+    /// Encoded PNG/JPEG bytes, viewed in place in the mapped GLB, the mesh
+    /// cache mapping or ModelData::embeddedImageData. Empty for images on disk.
+    std::span<const uint8_t> bytes;
+};
+
+/// Virtual texture path of image `imageIndex` embedded in `modelPath`:
+/// "models/ship.glb" -> "models/ship.glb#3"
+std::filesystem::path embeddedImagePath(
+    const std::filesystem::path& modelPath,
+    size_t imageIndex
+);
+
+/// True for paths made by embeddedImagePath()
+bool isEmbeddedImagePath(const std::filesystem::path& path);
+// }}}
+
+// Scene outline {{{
+/// A glTF node as listed by inspectModel()
+struct ModelOutlineNode {
+    std::string name;
+    int32_t parent{-1};              // Into ModelOutline::nodes, -1 for roots
+    std::vector<int32_t> children;   // Into ModelOutline::nodes
+    int32_t mesh{-1};                // Into ModelOutline::meshes, -1 without a mesh
+};
+
+/// A glTF mesh with the sizes its accessors declare
+struct ModelOutlineMesh {
+    std::string name;
+    uint32_t primitiveCount{0};
+    uint64_t vertexCount{0};
+    uint64_t indexCount{0};
+};
+
+/// Nodes and meshes of a glTF/GLB file, read from its JSON alone. Node
+/// indices match the file, so they can be passed to
+/// ModelLoadOptions::nodeSelection as they are.
+struct ModelOutline {
+    std::vector<ModelOutlineNode> nodes;
+    std::vector<int32_t> roots;      // Root nodes of the default scene
+    std::vector<ModelOutlineMesh> meshes;
+    uint64_t bufferBytes{0};         // Declared size of all buffers (none are read)
+    double parseMs{0.0};
+};
+
+/// List the nodes and meshes of a model without reading any buffer or image.
+/// Throws std::runtime_error if the file cannot be mapped or its JSON parsed.
+ModelOutline inspectModel(const std::filesystem::path& path);
+// }}}
+
 // Model data structures {{{
 struct GeometryRange {
     uint32_t firstVertex;
@@ -107,6 +214,53 @@ struct GeometryRange {
     uint32_t firstIndex;
     uint32_t indexCount;
     int materialIndex;
+    uint32_t firstInstance{0};   // Into ModelData::instances (instanced models only)
+    uint32_t instanceCount{0};   // 0 = not instanced
+    glm::vec3 boundsMin{0.0f};   // AABB of the range's vertices, in the space they are stored in
+    glm::vec3 boundsMax{0.0f};
+    uint32_t firstLod{0};        // Into ModelData::lods
+    uint32_t lodCount{0};        // 0 = no LOD chain; otherwise level 0 is the range itself
+    // UINT16 when every vertex of the range is addressable with 16 bits.
+    // Selects the array firstIndex points into: ModelData::indices16 or indices.
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32};
+    uint32_t firstMeshlet{0};         // Into ModelData::meshlets
+    uint32_t meshletCount{0};         // 0 = no meshlets built
+    uint32_t firstMeshletVertex{0};   // Into ModelData::meshletVertices
+    uint32_t firstMeshletTriangle{0}; // Into ModelData::meshletTriangles (bytes)
+    int32_t node{-1};            // Owning SceneNode (-1 when instanced)
+};
+
+/// Largest range (in vertices) whose indices are stored as uint16_t
+constexpr uint32_t kMaxUint16IndexedVertices = 65536;
+
+/// Bytes per index of `type` (VK_INDEX_TYPE_UINT16 or VK_INDEX_TYPE_UINT32)
+constexpr size_t indexTypeSize(VkIndexType type) {
+    return type == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+/// Indices of one geometry in their stored width
+struct IndexView {
+    const void* data{nullptr};
+    size_t count{0};
+    VkIndexType type{VK_INDEX_TYPE_UINT32};
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t size_bytes() const { return count * indexTypeSize(type); }
+
+    uint32_t operator[](size_t i) const {
+        return type == VK_INDEX_TYPE_UINT16 ? static_cast<const uint16_t*>(data)[i]
+                                            : static_cast<const uint32_t*>(data)[i];
+    }
+};
+
+/// One level of detail of a geometry range: an index list over the range's
+/// vertices. A range's LOD indices directly follow its own indices, so
+/// `firstIndex` is relative to GeometryRange::firstIndex.
+struct GeometryLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;                 // Simplification error in model units (0 for level 0)
 };
 
 struct MaterialData {
@@ -123,15 +277,181 @@ struct MaterialData {
     float roughnessFactor{1.0f};
 };
 
+/// Options that change the shape of the loaded data
+struct ModelLoadOptions {
+    /// Keep each mesh primitive once in mesh space and emit one InstanceData
+    /// per node that references it, instead of baking node transforms into
+    /// duplicated vertices. Shaders must apply the instance transform (vertex
+    /// input locations 5-8, see InstanceData).
+    bool preserveInstancing{false};
+
+    /// Keep each range's vertices in the space of its owning node instead of
+    /// baking the node's world transform into them. Draw with
+    /// geometryTransform() as the model matrix; moving a node then only
+    /// changes that matrix. Has no effect together with preserveInstancing.
+    bool preserveHierarchy{false};
+
+    /// Read/write the preprocessed .vkdmesh cache next to the model.
+    /// Not part of the cache key.
+    bool useMeshCache{true};
+
+    /// Load the model's textures through the cooked texture cache (see
+    /// texture_cook.h): block-compressed with full mip chains, by material
+    /// slot. Read by texture loaders such as the editor's; loadModel() does
+    /// not decode images. Not part of the mesh cache key.
+    bool cookTextures{false};
+
+    /// Upload normal maps as R8G8 and metallic-roughness maps as R8G8 or R8
+    /// instead of BGRA8 (see textureChannelLayout() in texture_cook.h).
+    /// Uncooked BGRA8 textures only. Not part of the mesh cache key.
+    bool packTextureChannels{true};
+
+    /// Reorder each geometry range for the post-transform vertex cache,
+    /// overdraw and vertex fetch locality (see mesh_optimizer.h)
+    bool optimizeMeshes{false};
+
+    /// Simplified levels generated per geometry range (0 = no LODs).
+    /// Level n aims for lodTriangleRatio^n of the full triangle count and may
+    /// deviate from the surface by lodTargetError * 2^(n-1), relative to the
+    /// range's extent.
+    uint32_t lodLevels{0};
+    float lodTriangleRatio{0.5f};
+    float lodTargetError{0.01f};
+
+    /// Split each geometry range into meshlets of at most 64 vertices and
+    /// 124 triangles for cluster culling (see mesh_optimizer.h).
+    /// Experimental: the editor uploads them but no pipeline consumes them yet.
+    bool buildMeshlets{false};
+
+    /// glTF node indices (see inspectModel()) to load, each with its whole
+    /// subtree, instead of the default scene; order and duplicates don't
+    /// matter. Selected nodes keep the transforms of their ancestors. Buffers
+    /// are then mapped rather than read, so only the bytes of the selected
+    /// meshes and their textures are touched.
+    std::vector<int32_t> nodeSelection;
+
+    bool operator==(const ModelLoadOptions&) const = default;
+};
+
+/// Wall-clock breakdown of a loadModel() call
+struct ModelLoadTimings {
+    double parseMs{0.0};       // glTF/GLB parsing (tinygltf)
+    double decodeMs{0.0};      // Sizing pre-pass + primitive decode/transform (parallel)
+    double assembleMs{0.0};    // Cameras, lights and materials
+    double totalMs{0.0};
+    uint32_t primitiveCount{0};
+    uint32_t decodeThreads{1};
+    // Bytes of consolidated vertex, index and meshlet data. Primitives decode
+    // in place, so this is also the loader's peak geometry allocation.
+    size_t geometryBytes{0};
+    double optimizeMs{0.0};    // Vertex cache/overdraw/fetch optimization
+    bool cacheHit{false};      // Served from a mapped .vkdmesh cache
+    double cacheMs{0.0};       // Cache validation + mapping (hit) or write (miss)
+    double lodMs{0.0};         // LOD chain simplification
+    double meshletMs{0.0};     // Meshlet building
+    double meshoptMs{0.0};     // EXT_meshopt_compression buffer view decoding (parallel)
+    size_t meshoptBytes{0};    // Bytes produced by the meshopt decoder
+    size_t bufferBytes{0};     // Declared size of all buffers of the file
+    size_t bufferBytesRead{0}; // Bytes of the buffer views the decoded accessors read
+    double dataUriMs{0.0};     // Base64 data URI buffer decoding (vectorized, parallel)
+    size_t dataUriBytes{0};    // Bytes decoded from data URIs
+};
+
+/// Effect of ModelLoadOptions::optimizeMeshes over all ranges of a model,
+/// simulated with a 16-entry FIFO cache
+struct MeshOptimizationStats {
+    bool applied{false};
+    float acmrBefore{0.0f};    // Average cache miss ratio (misses per triangle)
+    float acmrAfter{0.0f};
+    float atvrBefore{0.0f};    // Average transformed vertex ratio (1.0 is optimal)
+    float atvrAfter{0.0f};
+};
+
+/// Meshlet occupancy over all ranges of a model
+struct MeshletStats {
+    size_t meshletCount{0};
+    float averageVertices{0.0f};
+    float averageTriangles{0.0f};
+    float vertexFill{0.0f};      // averageVertices / kMeshletMaxVertices
+    float triangleFill{0.0f};    // averageTriangles / kMeshletMaxTriangles
+};
+
+/// Meshlets of one geometry with their vertex and triangle lists. Meshlet
+/// offsets are relative to `vertices` and `triangles`, so all three spans can
+/// be uploaded as they are.
+struct MeshletView {
+    std::span<const Meshlet> meshlets;
+    std::span<const uint32_t> vertices;   // Relative to the geometry's first vertex
+    std::span<const uint8_t> triangles;   // 3 per triangle, into the meshlet's vertices
+};
+
 struct ModelData {
     std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<uint32_t> indices;          // Ranges with VK_INDEX_TYPE_UINT32
+    std::vector<uint16_t> indices16;        // Ranges with VK_INDEX_TYPE_UINT16
     std::vector<GeometryRange> ranges;
     std::vector<GLTFCamera> cameras;        // Embedded cameras from GLTF
     std::vector<GLTFLight> lights;          // Embedded lights from GLTF (KHR_lights_punctual)
     std::vector<MaterialData> materials;    // PBR material data per material
     std::vector<std::filesystem::path> allTexturePaths;  // All unique texture paths (indexed by MaterialData)
     std::vector<std::filesystem::path> texturePaths;  // DEPRECATED: Legacy single texture path per material
+    std::vector<EmbeddedImage> embeddedImages;  // Parallel to allTexturePaths, empty bytes for files on disk
+    std::vector<InstanceData> instances;    // Per-instance transforms, indexed by GeometryRange
+    std::vector<GeometryLod> lods;          // LOD chains, indexed by GeometryRange
+    std::vector<SceneNode> nodes;           // Scene hierarchy, indexed by GeometryRange::node
+    std::vector<Meshlet> meshlets;          // Indexed by GeometryRange
+    std::vector<uint32_t> meshletVertices;  // Indexed by GeometryRange and Meshlet
+    std::vector<uint8_t> meshletTriangles;  // Indexed by GeometryRange and Meshlet
+    bool instanced{false};                  // Loaded with ModelLoadOptions::preserveInstancing
+    bool hierarchical{false};               // Vertices are in node space (ModelLoadOptions::preserveHierarchy)
+    ModelLoadTimings timings;
+    MeshOptimizationStats optimization;
+
+    // Backing storage of embeddedImages: the mapped GLB for images in its BIN
+    // chunk, owned copies for data URIs and other buffers
+    std::shared_ptr<const MappedFile> sourceMapping;
+    std::shared_ptr<const std::vector<uint8_t>> embeddedImageData;
+
+    // Set when served from a .vkdmesh cache: the vertex, index and meshlet
+    // arrays stay empty and the spans below point into the mapping, which is
+    // kept alive here
+    std::shared_ptr<const MappedFile> cacheMapping;
+    std::span<const Vertex> mappedVertices;
+    std::span<const uint32_t> mappedIndices;
+    std::span<const uint16_t> mappedIndices16;
+    std::span<const Meshlet> mappedMeshlets;
+    std::span<const uint32_t> mappedMeshletVertices;
+    std::span<const uint8_t> mappedMeshletTriangles;
+
+    /// All vertices, whether owned or mapped from the cache
+    std::span<const Vertex> vertexSpan() const {
+        return cacheMapping ? mappedVertices : std::span<const Vertex>(vertices);
+    }
+
+    /// All 32-bit indices, whether owned or mapped from the cache
+    std::span<const uint32_t> indexSpan() const {
+        return cacheMapping ? mappedIndices : std::span<const uint32_t>(indices);
+    }
+
+    /// All 16-bit indices, whether owned or mapped from the cache
+    std::span<const uint16_t> index16Span() const {
+        return cacheMapping ? mappedIndices16 : std::span<const uint16_t>(indices16);
+    }
+
+    /// All meshlets, whether owned or mapped from the cache
+    std::span<const Meshlet> meshletSpan() const {
+        return cacheMapping ? mappedMeshlets : std::span<const Meshlet>(meshlets);
+    }
+
+    /// All meshlet vertex lists, whether owned or mapped from the cache
+    std::span<const uint32_t> meshletVertexSpan() const {
+        return cacheMapping ? mappedMeshletVertices : std::span<const uint32_t>(meshletVertices);
+    }
+
+    /// All meshlet triangle lists, whether owned or mapped from the cache
+    std::span<const uint8_t> meshletTriangleSpan() const {
+        return cacheMapping ? mappedMeshletTriangles : std::span<const uint8_t>(meshletTriangles);
+    }
 };
 // }}}
 
@@ -139,23 +459,129 @@ struct ModelData {
 /// Load a GLTF/GLB model and return all geometry data
 /// @param path Path to the model file (.gltf or .glb)
 /// @param projectRoot Optional project root for texture path resolution
+/// @param options Load options (instancing, ...)
 /// @return ModelData containing all vertices, indices, geometry ranges, cameras, and texture paths
-ModelData loadModel(const std::filesystem::path& path, const std::filesystem::path& projectRoot = "");
+ModelData loadModel(
+    const std::filesystem::path& path,
+    const std::filesystem::path& projectRoot = "",
+    const ModelLoadOptions& options = {}
+);
 
 /// Load multiple models asynchronously in parallel
-/// @param paths Vector of paths to model files
+/// @param paths Vector of paths to model files; repeated paths load once
+/// @param options Load options applied to every model
+/// @return Map of path to ModelData for each loaded model
+std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(
+    const std::vector<std::filesystem::path>& paths,
+    const ModelLoadOptions& options = {}
+);
+
+/// Load multiple models asynchronously in parallel, each with its own options
+/// @param requests Pairs of model path and load options. Throws
+///        std::runtime_error if a path appears more than once, since the
+///        results hold one ModelData per path.
 /// @return Map of path to ModelData for each loaded model
-std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(const std::vector<std::filesystem::path>& paths);
+std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(
+    const std::vector<std::pair<std::filesystem::path, ModelLoadOptions>>& requests
+);
 
 /// Load a specific geometry from pre-loaded model data
 /// @param data The pre-loaded model data
 /// @param geometryIndex Index of the geometry to load
 /// @param outVertices Output vector for vertices
-/// @param outIndices Output vector for indices
+/// @param outIndices Output vector for indices (widened to 32 bits)
 void loadModelGeometry(
     const ModelData& data,
     uint32_t geometryIndex,
     std::vector<Vertex>& outVertices,
     std::vector<uint32_t>& outIndices
 );
+
+/// View the vertices of a specific geometry without copying
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+std::span<const Vertex> geometryVertices(const ModelData& data, uint32_t geometryIndex);
+
+/// View the indices of a specific geometry without copying
+/// (relative to the geometry's first vertex, 16 or 32 bits wide)
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+IndexView geometryIndices(const ModelData& data, uint32_t geometryIndex);
+
+/// View the indices of a specific geometry followed by those of its LODs,
+/// as one contiguous block (equal to geometryIndices() without LODs)
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+IndexView geometryLodIndices(const ModelData& data, uint32_t geometryIndex);
+
+/// View the LOD chain of a specific geometry, finest first (empty without LODs).
+/// Offsets are relative to geometryLodIndices().
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+std::span<const GeometryLod> geometryLods(const ModelData& data, uint32_t geometryIndex);
+
+/// View the meshlets of a specific geometry (empty unless loaded with
+/// ModelLoadOptions::buildMeshlets)
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+MeshletView geometryMeshlets(const ModelData& data, uint32_t geometryIndex);
+
+/// Meshlet count and average fill over all geometries of a model
+/// @param data The pre-loaded model data
+MeshletStats meshletStats(const ModelData& data);
+
+/// Model matrix to draw a specific geometry with: the world transform of its
+/// node for hierarchical models, identity when the node transform is baked
+/// into the vertices or the geometry is instanced
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+glm::mat4 geometryTransform(const ModelData& data, uint32_t geometryIndex);
+
+/// Recompute every node's worldTransform from the localTransforms, e.g. after
+/// moving a node
+/// @param data The model data whose nodes changed
+void updateWorldTransforms(ModelData& data);
+
+/// World-space bounds of a specific geometry, covering all of its instances
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+/// @param outMin Output minimum corner
+/// @param outMax Output maximum corner
+void geometryBounds(
+    const ModelData& data,
+    uint32_t geometryIndex,
+    glm::vec3& outMin,
+    glm::vec3& outMax
+);
+
+/// Pick the coarsest LOD whose error, projected to the screen, stays below
+/// `maxPixelError` pixels. The nearest point of the bounds' bounding sphere
+/// is used, so the choice is conservative.
+/// @param lods LOD chain, finest first
+/// @param boundsMin World-space bounds minimum
+/// @param boundsMax World-space bounds maximum
+/// @param view Camera view matrix
+/// @param proj Camera projection matrix
+/// @param viewportHeight Viewport height in pixels
+/// @param maxPixelError Allowed screen-space error in pixels
+/// @return Index into `lods` (0 when `lods` is empty)
+uint32_t selectLod(
+    std::span<const GeometryLod> lods,
+    const glm::vec3& boundsMin,
+    const glm::vec3& boundsMax,
+    const glm::mat4& view,
+    const glm::mat4& proj,
+    float viewportHeight,
+    float maxPixelError = 1.0f
+);
+
+/// Load the instance transforms of a specific geometry
+/// @param data The pre-loaded model data
+/// @param geometryIndex Index of the geometry
+/// @param outInstances Output vector for instances (empty if the model is not instanced)
+void loadModelInstances(
+    const ModelData& data,
+    uint32_t geometryIndex,
+    std::vector<InstanceData>& outInstances
+);
 // }}}
@@ -0,0 +1,84 @@
+// vim:foldmethod=marker
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Runtime-dispatched SIMD kernels for loader hot loops {{{
+// The best instruction set is picked once at runtime from CPU features, so
+// default builds (no -msse4.1/-mavx2) still get vector code on x86-64.
+// On AArch64 NEON is architecturally guaranteed and selected at build time.
+//
+// Vector data is addressed as strided float3 so kernels can read glTF
+// accessors and write into interleaved Vertex arrays directly. Matrices are
+// column-major, matching glm.
+namespace simd {
+
+enum class Isa {
+    Scalar,
+    SSE41,
+    AVX2,   // AVX2 + FMA
+    NEON
+};
+
+const char* isaName(Isa isa);
+
+struct KernelTable {
+    Isa isa;
+
+    /// dst[i] = src[i] for 16-bit indices
+    void (*widenIndices16)(const uint16_t* src, uint32_t* dst, size_t count);
+
+    /// dst[i] = src[i] for 8-bit indices
+    void (*widenIndices8)(const uint8_t* src, uint32_t* dst, size_t count);
+
+    /// dst[i] = src[i] for 32-bit indices that all fit in 16 bits
+    void (*narrowIndices32)(const uint32_t* src, uint16_t* dst, size_t count);
+
+    /// dst[i] = src[i] for 8-bit indices stored as 16-bit
+    void (*widenIndices8To16)(const uint8_t* src, uint16_t* dst, size_t count);
+
+    /// dst = (matrix * vec4(src, 1)).xyz for `count` strided float3
+    void (*transformPositions)(
+        const void* src, size_t srcStride,
+        const float* matrix4x4,
+        void* dst, size_t dstStride,
+        size_t count
+    );
+
+    /// dst = normalize(matrix * src) for `count` strided float3 (normals, tangents)
+    void (*transformDirections)(
+        const void* src, size_t srcStride,
+        const float* matrix3x3,
+        void* dst, size_t dstStride,
+        size_t count
+    );
+
+    /// Component-wise min/max over `count` strided float3 (count > 0)
+    void (*computeBounds)(
+        const void* src, size_t stride, size_t count,
+        float outMin[3], float outMax[3]
+    );
+
+    /// Decode `quadCount` groups of 4 base64 characters (standard alphabet,
+    /// no padding) into 3 bytes each. False if any character is outside the
+    /// alphabet; `dst` is then partially written.
+    bool (*decodeBase64)(const char* src, size_t quadCount, uint8_t* dst);
+
+    /// dst[x] = rounded average of the 2x2 block at column 2x of two source
+    /// rows, per byte, for `dstWidth` 4-byte pixels (mip downsampling)
+    void (*downsample2x2)(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth);
+
+    /// dst[i] = dot(pixel i, axis) for `count` 4-byte pixels (texture block
+    /// encoding: ordering texels along an endpoint axis)
+    void (*projectPixels)(const uint8_t* pixels, const int16_t axis[4], int32_t* dst, size_t count);
+};
+
+/// Kernels for the best instruction set supported by this CPU
+const KernelTable& kernels();
+
+/// Kernels for a specific instruction set, or nullptr if this CPU/build
+/// cannot run it
+const KernelTable* kernelsFor(Isa isa);
+
+} // namespace simd
+// }}}
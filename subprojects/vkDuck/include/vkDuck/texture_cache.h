@@ -0,0 +1,62 @@
+// vim:foldmethod=marker
+#pragma once
+#include <vkDuck/image_loader.h>
+#include <cstdint>
+#include <filesystem>
+
+// Decoded texture cache {{{
+// Decoding PNG/JPEG is most of the time spent loading textures. The decoded
+// texture cache keeps what wuffs produced as uncompressed BGRA8 DDS files,
+// optionally with a full mip chain, in one directory. Each file is named
+// after a hash of the encoded texture and the decode options:
+//
+//   ".texture_cache/3f2a9c1e5b7d0a44.dds"
+//
+// A hit maps the file, so TextureSource::decodeInto() becomes a copy from
+// the page cache. The directory is kept under a size limit by deleting the
+// least recently used files. A hit refreshes the file's modification time,
+// which is how the order survives between runs. KTX2/DDS sources are never
+// cached.
+//
+// The cache is process-wide. It is off until configureTextureCache() gives
+// it a directory.
+
+/// Bump when the cached layout or the decode/mip filtering changes
+constexpr uint32_t kTextureCacheVersion = 1;
+
+struct TextureCacheConfig {
+    std::filesystem::path directory{};  // Empty disables the cache
+    uint64_t maxBytes{2ull << 30};      // Evicts down to this after each write
+    bool mips{false};                   // Store full mip chains (2x2 box filter)
+
+    bool operator==(const TextureCacheConfig&) const = default;
+};
+
+/// Counters since the process started (hits and misses) and the state of
+/// the directory as last seen (entries and bytes)
+struct TextureCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};         // Decoded, then written unless writing failed
+    uint64_t evictions{0};
+    uint64_t writeFailures{0};
+    size_t entries{0};
+    uint64_t bytes{0};
+};
+
+/// Replace the cache configuration. The directory is created and scanned
+/// on first use; counters are kept.
+void configureTextureCache(const TextureCacheConfig& config);
+
+TextureCacheConfig textureCacheConfig();
+TextureCacheStats textureCacheStats();
+
+/// Delete every cached file in the configured directory
+void clearTextureCache();
+
+/// The cached version of `source`, decoding it into the cache on a miss.
+/// With mips, `linear` data is filtered as such; other textures are
+/// filtered as sRGB colour (linear is part of the key). Returns `source`
+/// itself when the cache is off or the source is a KTX2/DDS texture.
+/// Throws std::runtime_error if `source` cannot be decoded.
+TextureSource openCachedTexture(TextureSource source, bool linear = false);
+// }}}
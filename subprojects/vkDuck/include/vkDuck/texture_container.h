@@ -0,0 +1,61 @@
+// vim:foldmethod=marker
+#pragma once
+#include <vkDuck/vulkan_base.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+// Precompressed texture containers {{{
+// KTX2 and DDS files hold GPU-ready data: block-compressed (BC1-BC7) or
+// plain 8-bit texels, with all of their mip levels. They are uploaded as
+// they are instead of being decoded to BGRA8, so a BC1 texture takes an
+// eighth of the memory. Supported:
+//
+//   KTX2  2D, one layer and face, no supercompression (Basis Universal and
+//         zstd payloads are rejected), any format listed below
+//   DDS   2D, one surface, legacy FourCC (DXT1, DXT3, DXT5, ATI1/BC4U,
+//         ATI2/BC5U), 32-bit RGBA/BGRA, or a DX10 header with a DXGI format
+//         listed below
+//
+// Formats: BC1-BC5 and BC7 (UNORM/SRGB/SNORM as the format defines them),
+// R8G8B8A8 and B8G8R8A8 (UNORM/SRGB).
+
+/// A parsed container. `levels` views the caller's bytes, level 0 first.
+struct ContainerTexture {
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    uint32_t width{0};
+    uint32_t height{0};
+    std::vector<std::span<const uint8_t>> levels;
+};
+
+/// True if `bytes` start with a KTX2 or DDS signature
+bool isTextureContainer(std::span<const uint8_t> bytes);
+
+/// Parse a KTX2 or DDS file held in memory
+/// Throws std::runtime_error for malformed or unsupported files
+ContainerTexture parseTextureContainer(std::span<const uint8_t> bytes);
+
+/// Write `texture` as a DDS file with a DX10 header (the layout
+/// parseTextureContainer() reads back). BC1 is stored as its RGBA DXGI
+/// format, which decodes identically for 4-colour blocks.
+/// Throws std::runtime_error for unsupported formats or write errors.
+void writeDds(const std::filesystem::path& path, const ContainerTexture& texture);
+
+/// The bytes writeDds() would write, in memory. Throws like writeDds().
+std::vector<uint8_t> encodeDds(const ContainerTexture& texture);
+
+/// True for the BCn formats accepted above
+bool isBlockCompressed(VkFormat format);
+
+/// Bytes of one tightly packed `width` x `height` level of `format`
+/// (4x4 blocks for compressed formats, 1 or 2 bytes per texel for R8 and
+/// R8G8, 4 otherwise). Throws std::runtime_error if it does not fit in size_t.
+size_t textureLevelSize(VkFormat format, uint32_t width, uint32_t height);
+
+/// The SRGB (`srgb` true) or UNORM variant of `format`. Containers often
+/// do not record how a texture is sampled; glTF does, by material slot.
+/// Formats without both variants (BC4, BC5) are returned unchanged.
+VkFormat textureFormatForColorSpace(VkFormat format, bool srgb);
+// }}}
@@ -0,0 +1,112 @@
+// vim:foldmethod=marker
+#pragma once
+#include <vkDuck/image_loader.h>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// Cooked texture cache (.dds) {{{
+// Cooking turns a PNG/JPEG texture into a block-compressed DDS with a full
+// mip chain (see bc_encoder.h), so loads skip image decoding and textures
+// take 4-8x less memory. The cooked file sits next to its source and is
+// named after it, the texture role and a key:
+//
+//   "textures/wood.png" -> "textures/wood.png.color.5e1f03aa.dds"
+//   "models/ship.glb#3" -> "models/ship.glb.image3.normal.0c7d21f4.dds"
+//
+// The key hashes the source bytes, the role and kTextureCookVersion, so an
+// edited source cooks again and older cooks of it are removed. KTX2/DDS
+// sources are already GPU-ready and are never cooked.
+
+/// Bump when the encoder output or the role -> format mapping changes
+constexpr uint32_t kTextureCookVersion = 1;
+
+/// How a material samples a texture, which decides its cooked format
+enum class TextureRole : uint8_t {
+    Color,      // Base colour, emissive: sRGB
+    Normal,     // Tangent-space normal map: XY only
+    Data        // Metallic-roughness, occlusion: linear
+};
+
+const char* textureRoleName(TextureRole role);
+
+/// Cooked format for a texture of `role`:
+///   Color   BC1 SRGB when fully opaque, otherwise BC7 SRGB
+///   Normal  BC5 (shaders rebuild Z from XY)
+///   Data    BC7 UNORM (keeps occlusion in R next to roughness and metallic)
+VkFormat cookedTextureFormat(TextureRole role, bool hasAlpha);
+
+/// Cache file for a source texture and role with content hash `sourceHash`
+std::filesystem::path cookedTexturePath(
+    const std::filesystem::path& sourcePath,
+    TextureRole role,
+    uint64_t sourceHash
+);
+
+struct TextureCookStats {
+    bool cooked{false};             // False for KTX2/DDS sources and failures
+    bool cacheHit{false};
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    double encodeMs{0.0};           // Mip filtering and block encoding, 0 on a hit
+    double megapixelsPerSecond{0.0};// Encoded texels over all levels / encodeMs
+    double psnr{0.0};               // Level 0 in dB over stored channels, 0 on a hit
+    size_t uncompressedBytes{0};    // BGRA8 size of the same mip chain
+    size_t cookedBytes{0};
+    std::filesystem::path cookedPath;   // The .dds loaded or written, if cooked
+};
+
+/// Load the cooked version of a texture, cooking it and writing the cache
+/// on a miss. `encoded` holds the source file's bytes, or is empty to read
+/// `sourcePath` (embedded images pass their bytes with a virtual path).
+/// KTX2/DDS sources load as they are. Returns an invalid image if the
+/// source cannot be decoded; a cache that cannot be written only costs
+/// the cache. Never throws.
+LoadedImage loadCookedTexture(
+    const std::filesystem::path& sourcePath,
+    std::span<const uint8_t> encoded,
+    TextureRole role,
+    TextureCookStats* stats = nullptr
+);
+
+/// Make sure the cooked file of a texture exists, cooking it on a miss
+/// like loadCookedTexture(), and return its path without loading it (open
+/// it with a TextureSource to decode straight into staging memory).
+/// Returns an empty path for KTX2/DDS sources, which are used as they are,
+/// and when the source cannot be decoded or the cook cannot be written.
+/// Never throws.
+std::filesystem::path cookTexture(
+    const std::filesystem::path& sourcePath,
+    std::span<const uint8_t> encoded,
+    TextureRole role,
+    TextureCookStats* stats = nullptr
+);
+// }}}
+
+// Reduced channels {{{
+// Uncooked textures are uploaded with only the channels their role reads
+// (see TextureChannels in image_loader.h). The view swizzle maps them back,
+// so shaders sample the same components as from the BGRA8 texture:
+//
+//   Normal  R8G8 <- R, G; view (R, G, 1, 1), Z is rebuilt as for BC5
+//   Data    R8G8 <- G, B (roughness, metallic); view (1, G, B, 1)
+//           R8 when B or G is constant 0 or 255, or when G == B everywhere
+//
+// R of metallic-roughness maps (occlusion in ORM maps) is read as 1, or 0
+// if it is 0 everywhere; materials take occlusion from its own texture.
+
+struct TextureChannelLayout {
+    TextureChannels channels{TextureChannels::Bgra};
+    VkComponentMapping swizzle{};   // Identity for Bgra
+};
+
+/// Channels to upload a BGRA8 texture of `role` with. `bgra` holds
+/// `texels` texels of level 0 and is only read for Data textures (it may be
+/// null otherwise). Color textures keep all four channels.
+TextureChannelLayout textureChannelLayout(TextureRole role, const uint8_t* bgra, size_t texels);
+
+/// View swizzle for a texture of `role` uploaded as stored in `format`
+/// (cooked, or a container's own format). Two-channel normal maps (BC5,
+/// R8G8, R16G16) read (R, G, 1, 1) like the packed R8G8 upload above, so B
+/// does not sample as 0; everything else is identity.
+VkComponentMapping textureFormatSwizzle(TextureRole role, VkFormat format);
+// }}}
@@ -0,0 +1,96 @@
+// vim:foldmethod=marker
+#pragma once
+
+#include <vkDuck/model_loader.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Compact vertex layouts {{{
+// Alternatives to the 60-byte Vertex for bandwidth-bound GPUs. Attribute
+// locations match Vertex (0 pos, 1 normal, 2 uv, 3 color, 4 tangent) but the
+// shader has to decode them:
+//
+//   vec3 octDecode(vec2 e) {
+//       vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+//       float t = max(-n.z, 0.0);
+//       n.x += n.x >= 0.0 ? -t : t;
+//       n.y += n.y >= 0.0 ? -t : t;
+//       return normalize(n);
+//   }
+//   normal  = octDecode(inNormal);                  // R16G16_SNORM
+//   tangent = vec4(octDecode(inTangent), inColor.a * 2.0 - 1.0);
+//   color   = inColor.rgb;                          // R8G8B8A8_UNORM
+//   uv      = inTexCoord;                           // R16G16_SFLOAT
+//
+// PackedQuantized additionally stores positions as unorm16 within the
+// geometry's bounds; the vertex shader restores them from a push constant:
+//
+//   layout(push_constant) uniform PositionDequantization {
+//       vec4 offset;
+//       vec4 scale;
+//   } dequant;
+//   vec3 pos = dequant.offset.xyz + inPosition.xyz * dequant.scale.xyz;
+
+enum class VertexFormat : uint32_t {
+    Full,              // Vertex, 60 bytes
+    Packed,            // PackedVertex, 28 bytes
+    PackedQuantized    // QuantizedVertex, 24 bytes
+};
+
+const char* vertexFormatName(VertexFormat format);
+
+/// Float position with octahedral normal/tangent, half UVs and unorm8 color.
+/// color[3] holds the tangent handedness (0 = -1, 255 = +1).
+struct PackedVertex {
+    glm::vec3 pos;
+    int16_t normal[2];
+    uint16_t texCoord[2];
+    uint8_t color[4];
+    int16_t tangent[2];
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+};
+
+/// PackedVertex with unorm16 positions relative to the geometry's bounds
+/// (pos[3] is padding)
+struct QuantizedVertex {
+    uint16_t pos[4];
+    int16_t normal[2];
+    uint16_t texCoord[2];
+    uint8_t color[4];
+    int16_t tangent[2];
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+};
+
+static_assert(sizeof(PackedVertex) == 28);
+static_assert(sizeof(QuantizedVertex) == 24);
+
+/// Push constant block that restores QuantizedVertex positions:
+/// pos = offset + unorm * scale
+struct PositionDequantization {
+    glm::vec4 offset{0.0f};
+    glm::vec4 scale{1.0f};
+};
+
+/// Bytes per vertex in `format`
+uint32_t vertexStride(VertexFormat format);
+
+/// Binding 0 description for `format`
+VkVertexInputBindingDescription vertexBindingDescription(VertexFormat format);
+
+/// Attribute descriptions (locations 0-4) for `format`
+std::vector<VkVertexInputAttributeDescription> vertexAttributeDescriptions(VertexFormat format);
+
+/// Convert `vertices` to `format`. `destination` must hold
+/// vertices.size() * vertexStride(format) bytes. Returns the dequantization
+/// for PackedQuantized (computed from the vertices' bounds), identity otherwise.
+PositionDequantization packVertices(
+    std::span<const Vertex> vertices,
+    VertexFormat format,
+    void* destination
+);
+// }}}
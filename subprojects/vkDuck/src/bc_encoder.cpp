@@ -0,0 +1,722 @@
+// vim:foldmethod=marker
+#include <vkDuck/bc_encoder.h>
+#include <vkDuck/job_system.h>
+#include <vkDuck/simd_kernels.h>
+#include <vkDuck/texture_container.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Block layout {{{
+constexpr uint32_t kBlockRowsPerJob = 8;
+
+enum class BlockKind { BC1, BC4, BC5, BC7 };
+
+BlockKind blockKind(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            return BlockKind::BC1;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            return BlockKind::BC4;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            return BlockKind::BC5;
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return BlockKind::BC7;
+        default:
+            throw std::runtime_error("Block encoder: unsupported format " + std::to_string(format));
+    }
+}
+
+size_t blockBytes(BlockKind kind) {
+    return (kind == BlockKind::BC1 || kind == BlockKind::BC4) ? 8 : 16;
+}
+
+/// Gather the 4x4 block at block coordinates (bx, by) as RGBA, repeating
+/// the last row/column past the image edge
+void loadBlock(
+    const uint8_t* bgra, uint32_t width, uint32_t height,
+    uint32_t bx, uint32_t by, uint8_t rgba[64]
+) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t sy = std::min(by * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t sx = std::min(bx * 4 + x, width - 1);
+            const uint8_t* p = bgra + (static_cast<size_t>(sy) * width + sx) * 4;
+            uint8_t* q = rgba + (y * 4 + x) * 4;
+            q[0] = p[2];
+            q[1] = p[1];
+            q[2] = p[0];
+            q[3] = p[3];
+        }
+    }
+}
+
+/// Squared error of a decoded RGBA block against the source over `channels`
+uint32_t blockError(const uint8_t a[64], const uint8_t b[64], int channels) {
+    uint32_t error = 0;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            const int d = a[i * 4 + c] - b[i * 4 + c];
+            error += static_cast<uint32_t>(d * d);
+        }
+    }
+    return error;
+}
+
+struct BitWriter {
+    uint8_t* bytes;
+    uint32_t position{0};
+
+    void put(uint32_t value, uint32_t bits) {
+        for (uint32_t i = 0; i < bits; ++i, ++position) {
+            if (value & (1u << i)) {
+                bytes[position >> 3] |= static_cast<uint8_t>(1u << (position & 7));
+            }
+        }
+    }
+};
+
+struct BitReader {
+    const uint8_t* bytes;
+    uint32_t position{0};
+
+    uint32_t get(uint32_t bits) {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bits; ++i, ++position) {
+            value |= ((bytes[position >> 3] >> (position & 7)) & 1u) << i;
+        }
+        return value;
+    }
+};
+// }}}
+
+// Endpoint fitting {{{
+/// Endpoints of a block along the principal axis of its texels over the
+/// first `channels` channels: the two texels with the smallest and largest
+/// projection onto the axis
+void fitEndpoints(
+    const uint8_t rgba[64], int channels, const simd::KernelTable& k,
+    float lo[4], float hi[4]
+) {
+    float mean[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < channels; ++c) {
+            mean[c] += rgba[i * 4 + c];
+        }
+    }
+    for (int c = 0; c < channels; ++c) {
+        mean[c] /= 16.0f;
+    }
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i) {
+        float d[4] = {};
+        for (int c = 0; c < channels; ++c) {
+            d[c] = rgba[i * 4 + c] - mean[c];
+        }
+        for (int r = 0; r < channels; ++r) {
+            for (int c = r; c < channels; ++c) {
+                cov[r][c] += d[r] * d[c];
+            }
+        }
+    }
+    for (int r = 0; r < channels; ++r) {
+        for (int c = 0; c < r; ++c) {
+            cov[r][c] = cov[c][r];
+        }
+    }
+
+    // Power iteration from the covariance row with the largest variance
+    int start = 0;
+    for (int c = 1; c < channels; ++c) {
+        if (cov[c][c] > cov[start][start]) {
+            start = c;
+        }
+    }
+    float axis[4] = {};
+    for (int c = 0; c < channels; ++c) {
+        axis[c] = cov[start][c];
+    }
+    for (int iteration = 0; iteration < 6; ++iteration) {
+        float next[4] = {};
+        float scale = 0.0f;
+        for (int r = 0; r < channels; ++r) {
+            for (int c = 0; c < channels; ++c) {
+                next[r] += cov[r][c] * axis[c];
+            }
+            scale = std::max(scale, std::abs(next[r]));
+        }
+        if (scale == 0.0f) {
+            break;
+        }
+        for (int c = 0; c < channels; ++c) {
+            axis[c] = next[c] / scale;
+        }
+    }
+
+    float largest = 0.0f;
+    for (int c = 0; c < channels; ++c) {
+        largest = std::max(largest, std::abs(axis[c]));
+    }
+    if (largest == 0.0f) {
+        // Flat block: both endpoints are the (only) colour
+        for (int c = 0; c < 4; ++c) {
+            lo[c] = hi[c] = rgba[c];
+        }
+        return;
+    }
+
+    int16_t axis16[4] = {};
+    for (int c = 0; c < channels; ++c) {
+        axis16[c] = static_cast<int16_t>(std::lround(axis[c] / largest * 256.0f));
+    }
+    int32_t projected[16];
+    k.projectPixels(rgba, axis16, projected, 16);
+    int minIndex = 0;
+    int maxIndex = 0;
+    for (int i = 1; i < 16; ++i) {
+        if (projected[i] < projected[minIndex]) {
+            minIndex = i;
+        }
+        if (projected[i] > projected[maxIndex]) {
+            maxIndex = i;
+        }
+    }
+    for (int c = 0; c < 4; ++c) {
+        lo[c] = rgba[minIndex * 4 + c];
+        hi[c] = rgba[maxIndex * 4 + c];
+    }
+}
+
+/// Position of each texel between endpoints `a` and `b` (0..1), via the
+/// SIMD projection onto b - a
+void projectBetween(
+    const uint8_t rgba[64], const int a[4], const int b[4], int channels,
+    const simd::KernelTable& k, float t[16]
+) {
+    int16_t axis[4] = {};
+    int32_t start = 0;
+    int32_t length = 0;
+    for (int c = 0; c < channels; ++c) {
+        axis[c] = static_cast<int16_t>(b[c] - a[c]);
+        start += a[c] * axis[c];
+        length += axis[c] * axis[c];
+    }
+    if (length == 0) {
+        std::fill(t, t + 16, 0.0f);
+        return;
+    }
+    int32_t projected[16];
+    k.projectPixels(rgba, axis, projected, 16);
+    for (int i = 0; i < 16; ++i) {
+        t[i] = std::clamp(static_cast<float>(projected[i] - start) / static_cast<float>(length), 0.0f, 1.0f);
+    }
+}
+
+/// Least-squares endpoints for texels with fixed interpolation weights
+/// (0 = lo, 1 = hi). False if the weights do not determine both endpoints.
+bool refineEndpoints(
+    const uint8_t rgba[64], const float weights[16], int channels,
+    float lo[4], float hi[4]
+) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ra[4] = {}, rb[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float w = weights[i];
+        const float v = 1.0f - w;
+        aa += v * v;
+        ab += v * w;
+        bb += w * w;
+        for (int c = 0; c < channels; ++c) {
+            ra[c] += v * rgba[i * 4 + c];
+            rb[c] += w * rgba[i * 4 + c];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < channels; ++c) {
+        lo[c] = std::clamp((bb * ra[c] - ab * rb[c]) / det, 0.0f, 255.0f);
+        hi[c] = std::clamp((aa * rb[c] - ab * ra[c]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+// }}}
+
+// BC1 {{{
+uint16_t packRgb565(const float rgb[3]) {
+    const uint32_t r = static_cast<uint32_t>(std::lround(rgb[0] * 31.0f / 255.0f));
+    const uint32_t g = static_cast<uint32_t>(std::lround(rgb[1] * 63.0f / 255.0f));
+    const uint32_t b = static_cast<uint32_t>(std::lround(rgb[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRgb565(uint16_t c, int rgb[3]) {
+    const int r = (c >> 11) & 31;
+    const int g = (c >> 5) & 63;
+    const int b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+void decodeBc1Block(const uint8_t* block, uint8_t rgba[64]) {
+    const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    int palette[4][4];
+    unpackRgb565(c0, palette[0]);
+    unpackRgb565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (c0 > c1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(indices >> (2 * i)) & 3];
+        rgba[i * 4 + 0] = static_cast<uint8_t>(color[0]);
+        rgba[i * 4 + 1] = static_cast<uint8_t>(color[1]);
+        rgba[i * 4 + 2] = static_cast<uint8_t>(color[2]);
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+/// Write a 4-colour block with endpoints `a` and `b` (in either order)
+void writeBc1Block(const uint8_t rgba[64], const float a[3], const float b[3], const simd::KernelTable& k, uint8_t* block) {
+    uint16_t c0 = packRgb565(a);
+    uint16_t c1 = packRgb565(b);
+    // 4-colour mode needs c0 > c1
+    if (c0 < c1) {
+        std::swap(c0, c1);
+    }
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int e0[4] = {};
+        int e1[4] = {};
+        unpackRgb565(c0, e0);
+        unpackRgb565(c1, e1);
+        float t[16];
+        projectBetween(rgba, e0, e1, 3, k, t);
+        // Palette order along the axis is c0, c2, c3, c1
+        constexpr uint32_t kIndexAtStep[4] = {0, 2, 3, 1};
+        for (int i = 0; i < 16; ++i) {
+            indices |= kIndexAtStep[std::lround(t[i] * 3.0f)] << (2 * i);
+        }
+    }
+    block[0] = static_cast<uint8_t>(c0);
+    block[1] = static_cast<uint8_t>(c0 >> 8);
+    block[2] = static_cast<uint8_t>(c1);
+    block[3] = static_cast<uint8_t>(c1 >> 8);
+    std::memcpy(block + 4, &indices, 4);
+}
+
+void encodeBc1Block(const uint8_t rgba[64], const simd::KernelTable& k, uint8_t* block) {
+    float lo[4], hi[4];
+    fitEndpoints(rgba, 3, k, lo, hi);
+    writeBc1Block(rgba, lo, hi, k, block);
+
+    // One least-squares pass over the chosen indices
+    uint8_t decoded[64];
+    decodeBc1Block(block, decoded);
+    const uint32_t error = blockError(rgba, decoded, 3);
+    if (error == 0) {
+        return;
+    }
+    const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+    constexpr float kWeightOfIndex[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    float weights[16];
+    for (int i = 0; i < 16; ++i) {
+        weights[i] = kWeightOfIndex[(indices >> (2 * i)) & 3];
+    }
+    if (!refineEndpoints(rgba, weights, 3, lo, hi)) {
+        return;
+    }
+    uint8_t refined[8];
+    writeBc1Block(rgba, lo, hi, k, refined);
+    decodeBc1Block(refined, decoded);
+    if (blockError(rgba, decoded, 3) < error) {
+        std::memcpy(block, refined, 8);
+    }
+}
+// }}}
+
+// BC4 / BC5 {{{
+void encodeBc4Block(const uint8_t rgba[64], int channel, uint8_t* block) {
+    int lo = 255;
+    int hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        lo = std::min<int>(lo, rgba[i * 4 + channel]);
+        hi = std::max<int>(hi, rgba[i * 4 + channel]);
+    }
+    // 8-value mode: r0 = hi > r1 = lo, indices 2-7 step from hi towards lo
+    block[0] = static_cast<uint8_t>(hi);
+    block[1] = static_cast<uint8_t>(lo);
+    uint64_t indices = 0;
+    if (hi > lo) {
+        const int range = hi - lo;
+        for (int i = 0; i < 16; ++i) {
+            const int step = ((rgba[i * 4 + channel] - lo) * 14 + range) / (2 * range);
+            const uint64_t index = step == 7 ? 0 : step == 0 ? 1 : static_cast<uint64_t>(8 - step);
+            indices |= index << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+
+void decodeBc4Block(const uint8_t* block, int channel, uint8_t rgba[64]) {
+    const int r0 = block[0];
+    const int r1 = block[1];
+    int palette[8] = {r0, r1};
+    if (r0 > r1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * r0 + (i - 1) * r1) / 7;
+        }
+    } else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * r0 + (i - 1) * r1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+    }
+}
+// }}}
+
+// BC7 mode 6 {{{
+constexpr int kBc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// Quantize an endpoint to 7 bits per channel plus a shared p-bit, picking
+/// the p-bit with the smaller error. Returns the expanded 8-bit endpoint.
+void quantizeBc7Endpoint(const float value[4], int q[4], int& p, int expanded[4]) {
+    float bestError = std::numeric_limits<float>::max();
+    for (int bit = 0; bit < 2; ++bit) {
+        int candidate[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            candidate[c] = std::clamp(static_cast<int>(std::lround((value[c] - bit) / 2.0f)), 0, 127);
+            const float d = static_cast<float>(candidate[c] * 2 + bit) - value[c];
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            p = bit;
+            std::copy(candidate, candidate + 4, q);
+        }
+    }
+    for (int c = 0; c < 4; ++c) {
+        expanded[c] = (q[c] << 1) | p;
+    }
+}
+
+void writeBc7Block(const uint8_t rgba[64], const float lo[4], const float hi[4], const simd::KernelTable& k, uint8_t* block) {
+    int q[2][4], p[2], e[2][4];
+    quantizeBc7Endpoint(lo, q[0], p[0], e[0]);
+    quantizeBc7Endpoint(hi, q[1], p[1], e[1]);
+
+    float t[16];
+    projectBetween(rgba, e[0], e[1], 4, k, t);
+    int indices[16];
+    for (int i = 0; i < 16; ++i) {
+        // Weights are nearly uniform; check the neighbours of the linear guess
+        const float target = t[i] * 64.0f;
+        int best = std::clamp(static_cast<int>(std::lround(t[i] * 15.0f)), 0, 15);
+        for (int candidate = std::max(0, best - 1); candidate <= std::min(15, best + 1); ++candidate) {
+            if (std::abs(kBc7Weights4[candidate] - target) < std::abs(kBc7Weights4[best] - target)) {
+                best = candidate;
+            }
+        }
+        indices[i] = best;
+    }
+
+    // The anchor (texel 0) index has an implicit high bit of 0
+    if (indices[0] >= 8) {
+        std::swap(q[0], q[1]);
+        std::swap(p[0], p[1]);
+        for (int& index : indices) {
+            index = 15 - index;
+        }
+    }
+
+    std::memset(block, 0, 16);
+    BitWriter bits{block};
+    bits.put(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        bits.put(static_cast<uint32_t>(q[0][c]), 7);
+        bits.put(static_cast<uint32_t>(q[1][c]), 7);
+    }
+    bits.put(static_cast<uint32_t>(p[0]), 1);
+    bits.put(static_cast<uint32_t>(p[1]), 1);
+    bits.put(static_cast<uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i) {
+        bits.put(static_cast<uint32_t>(indices[i]), 4);
+    }
+}
+
+void decodeBc7Block(const uint8_t* block, uint8_t rgba[64]) {
+    if ((block[0] & 0x7f) != 0x40) {
+        // Not mode 6: decoded as transparent black, like reserved modes
+        std::memset(rgba, 0, 64);
+        return;
+    }
+    BitReader bits{block};
+    bits.get(7);
+    int q[2][4];
+    for (int c = 0; c < 4; ++c) {
+        q[0][c] = static_cast<int>(bits.get(7));
+        q[1][c] = static_cast<int>(bits.get(7));
+    }
+    const int p0 = static_cast<int>(bits.get(1));
+    const int p1 = static_cast<int>(bits.get(1));
+    for (int i = 0; i < 16; ++i) {
+        const int w = kBc7Weights4[bits.get(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c) {
+            const int e0 = (q[0][c] << 1) | p0;
+            const int e1 = (q[1][c] << 1) | p1;
+            rgba[i * 4 + c] = static_cast<uint8_t>(((64 - w) * e0 + w * e1 + 32) >> 6);
+        }
+    }
+}
+
+void encodeBc7Block(const uint8_t rgba[64], const simd::KernelTable& k, uint8_t* block) {
+    float lo[4], hi[4];
+    fitEndpoints(rgba, 4, k, lo, hi);
+    writeBc7Block(rgba, lo, hi, k, block);
+
+    uint8_t decoded[64];
+    decodeBc7Block(block, decoded);
+    const uint32_t error = blockError(rgba, decoded, 4);
+    if (error == 0) {
+        return;
+    }
+    // Weights in the order the block stores its endpoints (they may have
+    // been swapped for the anchor bit)
+    BitReader bits{block};
+    bits.get(7 + 56 + 2);
+    float weights[16];
+    for (int i = 0; i < 16; ++i) {
+        weights[i] = kBc7Weights4[bits.get(i == 0 ? 3 : 4)] / 64.0f;
+    }
+    float first[4], second[4];
+    if (!refineEndpoints(rgba, weights, 4, first, second)) {
+        return;
+    }
+    uint8_t refined[16];
+    writeBc7Block(rgba, first, second, k, refined);
+    decodeBc7Block(refined, decoded);
+    if (blockError(rgba, decoded, 4) < error) {
+        std::memcpy(block, refined, 16);
+    }
+}
+// }}}
+
+void encodeBlock(BlockKind kind, const uint8_t rgba[64], const simd::KernelTable& k, uint8_t* block) {
+    switch (kind) {
+        case BlockKind::BC1:
+            encodeBc1Block(rgba, k, block);
+            break;
+        case BlockKind::BC4:
+            encodeBc4Block(rgba, 0, block);
+            break;
+        case BlockKind::BC5:
+            encodeBc4Block(rgba, 0, block);
+            encodeBc4Block(rgba, 1, block + 8);
+            break;
+        case BlockKind::BC7:
+            encodeBc7Block(rgba, k, block);
+            break;
+    }
+}
+
+void decodeBlock(BlockKind kind, const uint8_t* block, uint8_t rgba[64]) {
+    switch (kind) {
+        case BlockKind::BC1:
+            decodeBc1Block(block, rgba);
+            break;
+        case BlockKind::BC4:
+        case BlockKind::BC5:
+            for (int i = 0; i < 16; ++i) {
+                rgba[i * 4 + 1] = rgba[i * 4 + 2] = 0;
+                rgba[i * 4 + 3] = 255;
+            }
+            decodeBc4Block(block, 0, rgba);
+            if (kind == BlockKind::BC5) {
+                decodeBc4Block(block + 8, 1, rgba);
+            }
+            break;
+        case BlockKind::BC7:
+            decodeBc7Block(block, rgba);
+            break;
+    }
+}
+
+} // anonymous namespace
+
+// Public API {{{
+bool isBlockEncodable(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void encodeBlocks(
+    const uint8_t* bgra,
+    uint32_t width,
+    uint32_t height,
+    VkFormat format,
+    uint8_t* dst
+) {
+    encodeBlockMipChain(bgra, width, height, 1, format, dst);
+}
+
+void encodeBlockMipChain(
+    const uint8_t* bgraLevels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levels,
+    VkFormat format,
+    uint8_t* dst
+) {
+    const BlockKind kind = blockKind(format);
+    const size_t bytesPerBlock = blockBytes(kind);
+
+    struct Level {
+        const uint8_t* src;
+        uint8_t* dst;
+        uint32_t width;
+        uint32_t height;
+    };
+    struct Job {
+        uint32_t level;
+        uint32_t firstRow;
+        uint32_t lastRow;
+    };
+    std::vector<Level> chain;
+    std::vector<Job> jobs;
+    for (uint32_t level = 0; level < levels; ++level) {
+        const uint32_t w = std::max(1u, width >> level);
+        const uint32_t h = std::max(1u, height >> level);
+        chain.push_back({bgraLevels, dst, w, h});
+        bgraLevels += static_cast<size_t>(w) * h * 4;
+        dst += textureLevelSize(format, w, h);
+
+        const uint32_t blockRows = (h + 3) / 4;
+        for (uint32_t row = 0; row < blockRows; row += kBlockRowsPerJob) {
+            jobs.push_back({level, row, std::min(row + kBlockRowsPerJob, blockRows)});
+        }
+    }
+
+    auto encodeRows = [&](const Job& job) {
+        const simd::KernelTable& k = simd::kernels();
+        const Level& level = chain[job.level];
+        const uint32_t blocksX = (level.width + 3) / 4;
+        uint8_t rgba[64];
+        for (uint32_t by = job.firstRow; by < job.lastRow; ++by) {
+            uint8_t* out = level.dst + static_cast<size_t>(by) * blocksX * bytesPerBlock;
+            for (uint32_t bx = 0; bx < blocksX; ++bx, out += bytesPerBlock) {
+                loadBlock(level.src, level.width, level.height, bx, by, rgba);
+                encodeBlock(kind, rgba, k, out);
+            }
+        }
+    };
+    if (jobs.size() > 1) {
+        jobSystem().parallelFor(jobs.size(), [&](size_t i) { encodeRows(jobs[i]); });
+    } else if (!jobs.empty()) {
+        encodeRows(jobs[0]);
+    }
+}
+
+void decodeBlocks(
+    const uint8_t* blocks,
+    uint32_t width,
+    uint32_t height,
+    VkFormat format,
+    uint8_t* bgra
+) {
+    const BlockKind kind = blockKind(format);
+    const size_t bytesPerBlock = blockBytes(kind);
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    uint8_t rgba[64];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx, blocks += bytesPerBlock) {
+            decodeBlock(kind, blocks, rgba);
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    const uint8_t* p = rgba + (y * 4 + x) * 4;
+                    uint8_t* q = bgra + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4 + x) * 4;
+                    q[0] = p[2];
+                    q[1] = p[1];
+                    q[2] = p[0];
+                    q[3] = p[3];
+                }
+            }
+        }
+    }
+}
+
+double blockPsnr(
+    std::span<const uint8_t> reference,
+    std::span<const uint8_t> decoded,
+    VkFormat format
+) {
+    // Which BGRA bytes each format stores
+    bool stored[4] = {true, true, true, true};
+    switch (blockKind(format)) {
+        case BlockKind::BC1:
+            stored[3] = false;
+            break;
+        case BlockKind::BC4:
+            stored[0] = stored[1] = stored[3] = false;
+            break;
+        case BlockKind::BC5:
+            stored[0] = stored[3] = false;
+            break;
+        case BlockKind::BC7:
+            break;
+    }
+
+    const size_t count = std::min(reference.size(), decoded.size());
+    uint64_t squared = 0;
+    uint64_t samples = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (stored[i & 3]) {
+            const int d = reference[i] - decoded[i];
+            squared += static_cast<uint64_t>(d * d);
+            ++samples;
+        }
+    }
+    if (squared == 0 || samples == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const double mse = static_cast<double>(squared) / static_cast<double>(samples);
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+// }}}
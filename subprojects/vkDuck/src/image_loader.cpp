@@ -1,9 +1,20 @@
 // vim:foldmethod=marker
 #include <vkDuck/image_loader.h>
+#include <vkDuck/job_system.h>
+#include <vkDuck/model_loader.h>
+#include <vkDuck/mapped_file.h>
+#include <vkDuck/simd_kernels.h>
+#include <vkDuck/texture_cache.h>
+#include <vkDuck/texture_container.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
+#include <unordered_set>
 #include <vector>
-#include <future>
 #include <chrono>
 #include <iostream>
 
@@ -28,19 +39,25 @@ void* imageLoad(
     uint32_t& width,
     uint32_t& height
 ) {
-    // Read the entire file into memory
-    std::vector<char> data;
-    auto file_size = fs::file_size(path);
-    data.resize(file_size);
-    std::ifstream fin(path, std::ios::binary);
-    fin.read(data.data(), file_size);
-    if (!fin) {
+    // Decoded straight from a mapping of the file
+    try {
+        MappedFile file(path);
+        return imageLoadFromMemory(file.bytes(), width, height);
+    } catch (const std::exception&) {
         return nullptr;
     }
+}
 
-    // Decode using wuffs
+void* imageLoadFromMemory(
+    std::span<const uint8_t> bytes,
+    uint32_t& width,
+    uint32_t& height
+) {
+    // Decode using wuffs; MemoryInput reads the bytes in place
     wuffs_aux::DecodeImageCallbacks callbacks;
-    wuffs_aux::sync_io::MemoryInput input(data.data(), file_size);
+    wuffs_aux::sync_io::MemoryInput input(
+        reinterpret_cast<const char*>(bytes.data()), bytes.size()
+    );
 
     wuffs_aux::DecodeImageResult result =
         wuffs_aux::DecodeImage(callbacks, input);
@@ -57,34 +74,625 @@ void imageFree(void* pixels) {
     free(pixels);
 }
 
+LoadedImage textureLoadFromMemory(std::span<const uint8_t> bytes) {
+    LoadedImage result;
+    if (!isTextureContainer(bytes)) {
+        result.pixels = imageLoadFromMemory(bytes, result.width, result.height);
+        result.valid = (result.pixels != nullptr);
+        result.size = result.valid ? static_cast<size_t>(result.width) * result.height * 4 : 0;
+        return result;
+    }
+
+    ContainerTexture texture;
+    try {
+        texture = parseTextureContainer(bytes);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load texture: " << e.what() << std::endl;
+        return result;
+    }
+
+    // Packed into one malloc block so imageFree() releases both kinds
+    size_t size = 0;
+    for (const auto& level : texture.levels) {
+        size += level.size();
+    }
+    auto* pixels = static_cast<uint8_t*>(malloc(size));
+    if (!pixels) {
+        return result;
+    }
+    size_t offset = 0;
+    for (const auto& level : texture.levels) {
+        std::memcpy(pixels + offset, level.data(), level.size());
+        offset += level.size();
+    }
+
+    result.pixels = pixels;
+    result.width = texture.width;
+    result.height = texture.height;
+    result.valid = true;
+    result.format = texture.format;
+    result.mipLevels = static_cast<uint32_t>(texture.levels.size());
+    result.size = size;
+    return result;
+}
+
+LoadedImage textureLoad(const std::filesystem::path& path) {
+    try {
+        MappedFile file(path);
+        return textureLoadFromMemory(file.bytes());
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load texture " << path << ": " << e.what() << std::endl;
+        return {};
+    }
+}
+
 std::unordered_map<std::string, LoadedImage> loadImagesAsync(const std::vector<std::string>& paths) {
     auto totalStart = std::chrono::high_resolution_clock::now();
 
-    // Launch async tasks for each image
-    std::vector<std::future<std::pair<std::string, LoadedImage>>> futures;
-    futures.reserve(paths.size());
+    // Decoded on the shared pool rather than one thread per image, or
+    // copied out of the decoded texture cache when it is configured
+    std::vector<LoadedImage> decoded(paths.size());
+    jobSystem().parallelFor(paths.size(), [&](size_t i) {
+        try {
+            decoded[i] = openCachedTexture(TextureSource(fs::path(paths[i]))).load();
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load texture " << paths[i] << ": " << e.what() << std::endl;
+        }
+    });
+
+    std::unordered_map<std::string, LoadedImage> results;
+    results.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        results[paths[i]] = decoded[i];
+    }
+
+    auto totalEnd = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> totalMs = totalEnd - totalStart;
+    std::cout << "All images loaded in " << totalMs.count() << "ms (async, " << paths.size() << " images)" << std::endl;
+
+    return results;
+}
+
+std::unordered_map<std::string, LoadedImage> loadEmbeddedImagesAsync(const ModelData& model) {
+    auto totalStart = std::chrono::high_resolution_clock::now();
 
-    for (const auto& path : paths) {
-        futures.push_back(std::async(std::launch::async, [path]() {
-            LoadedImage result;
-            result.pixels = imageLoad(path, result.width, result.height);
-            result.valid = (result.pixels != nullptr);
-            return std::make_pair(path, result);
-        }));
+    std::vector<size_t> embedded;
+    size_t encodedBytes = 0;
+    for (size_t i = 0; i < model.embeddedImages.size() && i < model.allTexturePaths.size(); ++i) {
+        if (!model.embeddedImages[i].bytes.empty()) {
+            embedded.push_back(i);
+            encodedBytes += model.embeddedImages[i].bytes.size();
+        }
     }
 
-    // Collect results
+    // The model keeps the encoded bytes alive while the jobs run
+    std::vector<LoadedImage> decoded(embedded.size());
+    jobSystem().parallelFor(embedded.size(), [&](size_t j) {
+        decoded[j] = textureLoadFromMemory(model.embeddedImages[embedded[j]].bytes);
+    });
+
     std::unordered_map<std::string, LoadedImage> results;
-    results.reserve(paths.size());
+    results.reserve(embedded.size());
+    for (size_t j = 0; j < embedded.size(); ++j) {
+        results[model.allTexturePaths[embedded[j]].string()] = decoded[j];
+    }
+
+    if (!embedded.empty()) {
+        auto totalEnd = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> totalMs = totalEnd - totalStart;
+        std::cout << "Embedded images decoded in " << totalMs.count() << "ms (async, "
+            << embedded.size() << " images, " << encodedBytes / (1024.0 * 1024.0)
+            << " MB encoded)" << std::endl;
+    }
+    return results;
+}
+
+// Channel packing {{{
+VkFormat textureChannelsFormat(TextureChannels channels) {
+    switch (channels) {
+    case TextureChannels::Bgra:
+        return VK_FORMAT_B8G8R8A8_UNORM;
+    case TextureChannels::Rg:
+    case TextureChannels::Gb:
+        return VK_FORMAT_R8G8_UNORM;
+    case TextureChannels::G:
+    case TextureChannels::B:
+        return VK_FORMAT_R8_UNORM;
+    }
+    return VK_FORMAT_B8G8R8A8_UNORM;
+}
+
+uint32_t textureChannelsTexelSize(TextureChannels channels) {
+    switch (channels) {
+    case TextureChannels::Bgra:
+        return 4;
+    case TextureChannels::Rg:
+    case TextureChannels::Gb:
+        return 2;
+    case TextureChannels::G:
+    case TextureChannels::B:
+        return 1;
+    }
+    return 4;
+}
+
+void packTextureChannels(const uint8_t* bgra, size_t texels, TextureChannels channels, uint8_t* dst) {
+    // BGRA8 byte order: 0 = B, 1 = G, 2 = R, 3 = A
+    switch (channels) {
+    case TextureChannels::Bgra:
+        if (dst != bgra) {
+            std::memmove(dst, bgra, texels * 4);
+        }
+        break;
+    case TextureChannels::Rg:
+        for (size_t i = 0; i < texels; ++i) {
+            const uint8_t r = bgra[i * 4 + 2];
+            const uint8_t g = bgra[i * 4 + 1];
+            dst[i * 2] = r;
+            dst[i * 2 + 1] = g;
+        }
+        break;
+    case TextureChannels::Gb:
+        for (size_t i = 0; i < texels; ++i) {
+            const uint8_t g = bgra[i * 4 + 1];
+            const uint8_t b = bgra[i * 4];
+            dst[i * 2] = g;
+            dst[i * 2 + 1] = b;
+        }
+        break;
+    case TextureChannels::G:
+        for (size_t i = 0; i < texels; ++i) {
+            dst[i] = bgra[i * 4 + 1];
+        }
+        break;
+    case TextureChannels::B:
+        for (size_t i = 0; i < texels; ++i) {
+            dst[i] = bgra[i * 4];
+        }
+        break;
+    }
+}
+// }}}
+
+// Deferred decoding into staging memory {{{
+namespace {
+constexpr const char* kHeaderRead = "vkDuck: header read";
+
+/// Stops wuffs after the image header: AllocPixbuf is the first callback
+/// that knows the dimensions and runs before any pixel is decoded
+class HeaderCallbacks : public wuffs_aux::DecodeImageCallbacks {
+public:
+    uint32_t width{0};
+    uint32_t height{0};
+
+    AllocPixbufResult AllocPixbuf(const wuffs_base__image_config& config, bool) override {
+        width = config.pixcfg.width();
+        height = config.pixcfg.height();
+        return AllocPixbufResult(std::string(kHeaderRead));
+    }
+};
+
+/// Points the pixel buffer at caller memory instead of allocating one
+class DecodeIntoCallbacks : public wuffs_aux::DecodeImageCallbacks {
+public:
+    DecodeIntoCallbacks(uint8_t* dst, size_t size) : dst_(dst), size_(size) {}
+
+    AllocPixbufResult AllocPixbuf(const wuffs_base__image_config& config, bool) override {
+        // Not cleared: PNG and JPEG frames cover the whole image, and
+        // staging memory is best written exactly once
+        if (config.pixcfg.pixbuf_len() != size_) {
+            return AllocPixbufResult(std::string("vkDuck: destination size mismatch"));
+        }
+        wuffs_base__pixel_buffer pixbuf;
+        wuffs_base__status status = pixbuf.set_from_slice(
+            &config.pixcfg, wuffs_base__make_slice_u8(dst_, size_));
+        if (!status.is_ok()) {
+            return AllocPixbufResult(status.message());
+        }
+        return AllocPixbufResult(wuffs_aux::MemOwner(nullptr, &free), pixbuf);
+    }
+
+private:
+    uint8_t* dst_;
+    size_t size_;
+};
+}
+
+TextureSource::TextureSource(const std::filesystem::path& path) : file_(path) {
+    bytes_ = file_.bytes();
+    readHeader();
+}
+
+TextureSource::TextureSource(std::span<const uint8_t> bytes, bool copyBytes) {
+    if (copyBytes) {
+        ownedBytes_.assign(bytes.begin(), bytes.end());
+        bytes_ = ownedBytes_;
+    } else {
+        bytes_ = bytes;
+    }
+    readHeader();
+}
+
+TextureSource::TextureSource(std::vector<uint8_t>&& bytes) : ownedBytes_(std::move(bytes)) {
+    bytes_ = ownedBytes_;
+    readHeader();
+}
+
+void TextureSource::readHeader() {
+    if (isTextureContainer(bytes_)) {
+        const ContainerTexture texture = parseTextureContainer(bytes_);
+        width_ = texture.width;
+        height_ = texture.height;
+        format_ = texture.format;
+        mipLevels_ = static_cast<uint32_t>(texture.levels.size());
+        for (const auto& level : texture.levels) {
+            size_ += level.size();
+        }
+        fullWidth_ = width_;
+        fullHeight_ = height_;
+        fullMipLevels_ = mipLevels_;
+        return;
+    }
+
+    HeaderCallbacks callbacks;
+    wuffs_aux::sync_io::MemoryInput input(reinterpret_cast<const char*>(bytes_.data()), bytes_.size());
+    wuffs_aux::DecodeImageResult result = wuffs_aux::DecodeImage(callbacks, input);
+    if (result.error_message != kHeaderRead || callbacks.width == 0 || callbacks.height == 0) {
+        throw std::runtime_error("Unsupported or corrupt image" +
+            (result.error_message.empty() ? std::string() : ": " + result.error_message));
+    }
+    width_ = callbacks.width;
+    height_ = callbacks.height;
+    size_ = static_cast<size_t>(width_) * height_ * 4;
+    fullWidth_ = width_;
+    fullHeight_ = height_;
+}
+
+bool TextureSource::decodeImage(uint8_t* dst, size_t size) const {
+    DecodeIntoCallbacks callbacks(dst, size);
+    wuffs_aux::sync_io::MemoryInput input(reinterpret_cast<const char*>(bytes_.data()), bytes_.size());
+    return wuffs_aux::DecodeImage(callbacks, input).error_message.empty();
+}
+
+uint32_t TextureSource::maxDownscale() const {
+    if (!valid()) {
+        return 0;
+    }
+    if (fullMipLevels_ > 1) {
+        return fullMipLevels_ - 1;
+    }
+    if (isBlockCompressed(format_) || textureLevelSize(format_, 1, 1) != 4) {
+        return 0;
+    }
+    return mipLevelCount(fullWidth_, fullHeight_) - 1;
+}
+
+uint32_t TextureSource::setDownscale(uint32_t halvings, bool srgb) {
+    downscale_ = std::min(halvings, maxDownscale());
+    srgbDownscale_ = srgb;
+    width_ = std::max(1u, fullWidth_ >> downscale_);
+    height_ = std::max(1u, fullHeight_ >> downscale_);
+    if (fullMipLevels_ > 1) {
+        // Stored levels are skipped
+        mipLevels_ = fullMipLevels_ - downscale_;
+        size_ = 0;
+        const ContainerTexture texture = parseTextureContainer(bytes_);
+        for (size_t level = downscale_; level < texture.levels.size(); ++level) {
+            size_ += texture.levels[level].size();
+        }
+    } else {
+        size_ = textureLevelSize(format_, width_, height_);
+    }
+    return downscale_;
+}
+
+bool TextureSource::decodeInto(void* dst) const {
+    if (!valid()) {
+        return false;
+    }
+    auto* out = static_cast<uint8_t*>(dst);
+    if (isTextureContainer(bytes_)) {
+        const ContainerTexture texture = parseTextureContainer(bytes_);
+        if (downscale_ > 0 && texture.levels.size() == 1) {
+            downscaleImage(texture.levels[0].data(), fullWidth_, fullHeight_, downscale_,
+                srgbDownscale_, out);
+        } else {
+            for (size_t level = downscale_; level < texture.levels.size(); ++level) {
+                std::memcpy(out, texture.levels[level].data(), texture.levels[level].size());
+                out += texture.levels[level].size();
+            }
+        }
+        file_.evict();
+        return true;
+    }
+
+    bool decoded = false;
+    if (downscale_ > 0) {
+        // Full size in scratch memory, only the preview reaches `dst`
+        std::vector<uint8_t> full(static_cast<size_t>(fullWidth_) * fullHeight_ * 4);
+        decoded = decodeImage(full.data(), full.size());
+        if (decoded) {
+            downscaleImage(full.data(), fullWidth_, fullHeight_, downscale_, srgbDownscale_, out);
+        }
+    } else {
+        decoded = decodeImage(out, size_);
+    }
+    // The encoded file is not needed until the next upload
+    file_.evict();
+    return decoded;
+}
+
+size_t TextureSource::size(TextureChannels channels) const {
+    if (format_ != VK_FORMAT_B8G8R8A8_UNORM) {
+        return size_;
+    }
+    return size_ / 4 * textureChannelsTexelSize(channels);
+}
+
+bool TextureSource::decodeInto(void* dst, TextureChannels channels) const {
+    if (channels == TextureChannels::Bgra || format_ != VK_FORMAT_B8G8R8A8_UNORM) {
+        return decodeInto(dst);
+    }
+    // Staging memory may be write-combined: decode to a scratch buffer and
+    // only write the packed texels
+    std::vector<uint8_t> bgra(size_);
+    if (!decodeInto(bgra.data())) {
+        return false;
+    }
+    packTextureChannels(bgra.data(), size_ / 4, channels, static_cast<uint8_t*>(dst));
+    return true;
+}
+
+LoadedImage TextureSource::load() const {
+    LoadedImage result;
+    if (!valid()) {
+        return result;
+    }
+    result.pixels = malloc(size_);
+    if (!result.pixels) {
+        return result;
+    }
+    if (!decodeInto(result.pixels)) {
+        imageFree(result.pixels);
+        result.pixels = nullptr;
+        return result;
+    }
+    result.width = width_;
+    result.height = height_;
+    result.valid = true;
+    result.format = format_;
+    result.mipLevels = mipLevels_;
+    result.size = size_;
+    return result;
+}
+
+std::unordered_map<std::string, TextureSource> openTexturesAsync(
+    const std::vector<std::string>& paths,
+    const std::vector<std::string>& linearPaths
+) {
+    auto totalStart = std::chrono::high_resolution_clock::now();
 
-    for (auto& future : futures) {
-        auto [path, image] = future.get();
-        results[path] = image;
+    // Header reads are mostly page faults on the mapping: the I/O lane.
+    // Cache misses decode, which is CPU work.
+    const std::unordered_set<std::string> linear(linearPaths.begin(), linearPaths.end());
+    const bool cached = !textureCacheConfig().directory.empty();
+    std::vector<TextureSource> sources(paths.size());
+    jobSystem().parallelFor(paths.size(), [&](size_t i) {
+        try {
+            sources[i] = openCachedTexture(TextureSource(fs::path(paths[i])), linear.contains(paths[i]));
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to open texture " << paths[i] << ": " << e.what() << std::endl;
+        }
+    }, cached ? JobLane::Cpu : JobLane::Io);
+
+    std::unordered_map<std::string, TextureSource> results;
+    results.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        results[paths[i]] = std::move(sources[i]);
     }
 
     auto totalEnd = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> totalMs = totalEnd - totalStart;
-    std::cout << "All images loaded in " << totalMs.count() << "ms (async, " << paths.size() << " images)" << std::endl;
+    std::cout << "All textures opened in " << totalMs.count() << "ms (" << paths.size() << " textures)" << std::endl;
+    return results;
+}
+
+std::unordered_map<std::string, TextureSource> openEmbeddedTexturesAsync(
+    const ModelData& model,
+    const std::vector<std::string>& linearPaths
+) {
+    const std::unordered_set<std::string> linear(linearPaths.begin(), linearPaths.end());
+    std::vector<size_t> embedded;
+    for (size_t i = 0; i < model.embeddedImages.size() && i < model.allTexturePaths.size(); ++i) {
+        if (!model.embeddedImages[i].bytes.empty()) {
+            embedded.push_back(i);
+        }
+    }
+
+    std::vector<TextureSource> sources(embedded.size());
+    jobSystem().parallelFor(embedded.size(), [&](size_t j) {
+        try {
+            sources[j] = openCachedTexture(
+                TextureSource(model.embeddedImages[embedded[j]].bytes, false),
+                linear.contains(model.allTexturePaths[embedded[j]].string()));
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to open embedded texture "
+                << model.allTexturePaths[embedded[j]].string() << ": " << e.what() << std::endl;
+        }
+    });
 
+    std::unordered_map<std::string, TextureSource> results;
+    results.reserve(embedded.size());
+    for (size_t j = 0; j < embedded.size(); ++j) {
+        results[model.allTexturePaths[embedded[j]].string()] = std::move(sources[j]);
+    }
     return results;
 }
+// }}}
+
+// Mip chains {{{
+namespace {
+/// sRGB byte to linear [0, 1]
+const std::array<float, 256>& srgbToLinearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t{};
+        for (size_t i = 0; i < t.size(); ++i) {
+            const float c = static_cast<float>(i) / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+/// Linear value quantized to 12 bits back to an sRGB byte
+constexpr size_t kLinearSteps = 4096;
+const std::array<uint8_t, kLinearSteps>& linearToSrgbTable() {
+    static const std::array<uint8_t, kLinearSteps> table = [] {
+        std::array<uint8_t, kLinearSteps> t{};
+        for (size_t i = 0; i < t.size(); ++i) {
+            const float l = static_cast<float>(i) / (kLinearSteps - 1);
+            const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            t[i] = static_cast<uint8_t>(std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+        return t;
+    }();
+    return table;
+}
+
+void downsampleRowSrgb(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth) {
+    const auto& toLinear = srgbToLinearTable();
+    const auto& toSrgb = linearToSrgbTable();
+    for (size_t x = 0; x < dstWidth; ++x, row0 += 8, row1 += 8, dst += 4) {
+        for (int c = 0; c < 3; ++c) {
+            const float sum = toLinear[row0[c]] + toLinear[row0[c + 4]]
+                + toLinear[row1[c]] + toLinear[row1[c + 4]];
+            dst[c] = toSrgb[static_cast<size_t>(sum * ((kLinearSteps - 1) / 4.0f) + 0.5f)];
+        }
+        dst[3] = static_cast<uint8_t>((row0[3] + row0[7] + row1[3] + row1[7] + 2) >> 2);
+    }
+}
+
+/// One destination row from source rows `row0` and `row1`. A 1-pixel-wide
+/// source is widened so the kernels can always read pixel pairs.
+void downsampleRow(
+    const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth,
+    uint8_t* dst, uint32_t dstWidth, bool srgb
+) {
+    uint8_t widened[2][8];
+    if (srcWidth == 1) {
+        std::memcpy(widened[0], row0, 4);
+        std::memcpy(widened[0] + 4, row0, 4);
+        std::memcpy(widened[1], row1, 4);
+        std::memcpy(widened[1] + 4, row1, 4);
+        row0 = widened[0];
+        row1 = widened[1];
+    }
+    if (srgb) {
+        downsampleRowSrgb(row0, row1, dst, dstWidth);
+    } else {
+        simd::kernels().downsample2x2(row0, row1, dst, dstWidth);
+    }
+}
+
+/// Rows per job when a level is split across the pool
+constexpr uint32_t kMipRowsPerJob = 64;
+
+/// The 2x2 box average of a `srcWidth` x `srcHeight` level into `dst`,
+/// rows split across the pool for large levels
+void downsampleLevel(
+    const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, bool srgb,
+    std::vector<uint8_t>& dst
+) {
+    const uint32_t dstWidth = std::max(1u, srcWidth / 2);
+    const uint32_t dstHeight = std::max(1u, srcHeight / 2);
+    const size_t srcPitch = static_cast<size_t>(srcWidth) * 4;
+    const size_t dstPitch = static_cast<size_t>(dstWidth) * 4;
+    dst.resize(dstPitch * dstHeight);
+
+    auto filterRows = [&](uint32_t firstRow, uint32_t lastRow) {
+        for (uint32_t y = firstRow; y < lastRow; ++y) {
+            const uint8_t* row0 = src + srcPitch * std::min(2 * y, srcHeight - 1);
+            const uint8_t* row1 = src + srcPitch * std::min(2 * y + 1, srcHeight - 1);
+            downsampleRow(row0, row1, srcWidth, dst.data() + dstPitch * y, dstWidth, srgb);
+        }
+    };
+    const uint32_t jobs = (dstHeight + kMipRowsPerJob - 1) / kMipRowsPerJob;
+    if (jobs > 1) {
+        jobSystem().parallelFor(jobs, [&](size_t job) {
+            const uint32_t first = static_cast<uint32_t>(job) * kMipRowsPerJob;
+            filterRows(first, std::min(first + kMipRowsPerJob, dstHeight));
+        });
+    } else {
+        filterRows(0, dstHeight);
+    }
+}
+}
+
+uint32_t mipLevelCount(uint32_t width, uint32_t height) {
+    return static_cast<uint32_t>(std::bit_width(std::max({width, height, 1u})));
+}
+
+size_t mipChainSize(uint32_t width, uint32_t height, uint32_t levels) {
+    size_t bytes = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        bytes += static_cast<size_t>(width) * height * 4;
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    return bytes;
+}
+
+void generateMipChain(
+    const uint8_t* level0,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levels,
+    bool srgb,
+    uint8_t* dst
+) {
+    // Each level is built in scratch memory and then copied out, so `dst`
+    // (often write-combined) is never read back
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> current;
+    const uint8_t* src = level0;
+    uint32_t srcWidth = width;
+    uint32_t srcHeight = height;
+
+    for (uint32_t level = 1; level < levels; ++level) {
+        downsampleLevel(src, srcWidth, srcHeight, srgb, current);
+        std::memcpy(dst, current.data(), current.size());
+        dst += current.size();
+        std::swap(previous, current);
+        src = previous.data();
+        srcWidth = std::max(1u, srcWidth / 2);
+        srcHeight = std::max(1u, srcHeight / 2);
+    }
+}
+
+void downscaleImage(
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t halvings,
+    bool srgb,
+    uint8_t* dst
+) {
+    if (halvings == 0) {
+        std::memcpy(dst, pixels, static_cast<size_t>(width) * height * 4);
+        return;
+    }
+    // Intermediate levels stay in scratch memory; `dst` is only written
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> current;
+    const uint8_t* src = pixels;
+    for (uint32_t i = 0; i < halvings; ++i) {
+        downsampleLevel(src, width, height, srgb, current);
+        std::swap(previous, current);
+        src = previous.data();
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    std::memcpy(dst, previous.data(), previous.size());
+}
+// }}}
@@ -0,0 +1,229 @@
+// vim:foldmethod=marker
+#include <vkDuck/job_system.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Lane {{{
+/// Worker threads with one queue each. A job submitted from one of the
+/// lane's own workers goes to that worker's queue; other threads spread
+/// their jobs round-robin. Workers take their own newest job first and
+/// otherwise steal the oldest job of another worker.
+struct JobSystem::Lane {
+    using Clock = std::chrono::steady_clock;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+        std::thread thread;
+    };
+
+    explicit Lane(uint32_t threadCount) : workers(threadCount) {
+        for (auto& worker : workers) {
+            worker = std::make_unique<Worker>();
+        }
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i]->thread = std::thread([this, i]() { work(i); });
+        }
+    }
+
+    ~Lane() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    void submit(std::function<void()> job) {
+        size_t target = currentWorker();
+        if (target == kNotAWorker) {
+            target = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+        }
+        {
+            // Queued and counted under the sleep mutex, so a worker about to
+            // wait sees it, and one that takes the job early only uncounts
+            // it after it was counted
+            std::lock_guard<std::mutex> sleepLock(sleepMutex);
+            std::lock_guard<std::mutex> lock(workers[target]->mutex);
+            workers[target]->jobs.push_back(std::move(job));
+            ++pending;
+        }
+        wake.notify_one();
+    }
+
+    bool take(size_t self, std::function<void()>& job) {
+        {
+            Worker& own = *workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < workers.size(); ++offset) {
+            Worker& victim = *workers[(self + offset) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                jobsStolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t self) {
+        tlsLane = this;
+        tlsWorker = self;
+        std::function<void()> job;
+        while (true) {
+            if (!take(self, job)) {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait(lock, [this]() { return stopping || pending > 0; });
+                if (stopping && pending == 0) {
+                    return;
+                }
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                --pending;
+            }
+
+            const auto start = Clock::now();
+            try {
+                job();
+            } catch (...) {
+                // submit() jobs have nobody to report to; async() and
+                // parallelFor() catch their own exceptions
+            }
+            job = nullptr;
+            busyNs.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(),
+                std::memory_order_relaxed
+            );
+            jobsCompleted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Index of the calling thread among this lane's workers
+    size_t currentWorker() const {
+        return tlsLane == this ? tlsWorker : kNotAWorker;
+    }
+
+    JobLaneStats stats() const {
+        JobLaneStats result;
+        result.threads = static_cast<uint32_t>(workers.size());
+        result.jobsCompleted = jobsCompleted.load(std::memory_order_relaxed);
+        result.jobsStolen = jobsStolen.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            result.queuedJobs = pending;
+        }
+        result.busyMs = busyNs.load(std::memory_order_relaxed) / 1e6;
+        std::lock_guard<std::mutex> lock(statsMutex);
+        result.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - statsStart).count();
+        return result;
+    }
+
+    void resetStats() {
+        jobsCompleted.store(0, std::memory_order_relaxed);
+        jobsStolen.store(0, std::memory_order_relaxed);
+        busyNs.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(statsMutex);
+        statsStart = Clock::now();
+    }
+
+    static constexpr size_t kNotAWorker = ~size_t(0);
+    static thread_local const Lane* tlsLane;
+    static thread_local size_t tlsWorker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> nextWorker{0};
+
+    mutable std::mutex sleepMutex;
+    std::condition_variable wake;
+    size_t pending{0};          // Queued jobs over all workers
+    bool stopping{false};
+
+    std::atomic<uint64_t> jobsCompleted{0};
+    std::atomic<uint64_t> jobsStolen{0};
+    std::atomic<uint64_t> busyNs{0};
+    mutable std::mutex statsMutex;
+    Clock::time_point statsStart{Clock::now()};
+};
+
+thread_local const JobSystem::Lane* JobSystem::Lane::tlsLane = nullptr;
+thread_local size_t JobSystem::Lane::tlsWorker = JobSystem::Lane::kNotAWorker;
+// }}}
+
+// JobSystem {{{
+JobSystem::JobSystem(uint32_t cpuThreads, uint32_t ioThreads) {
+    if (cpuThreads == 0) {
+        cpuThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (ioThreads == 0) {
+        ioThreads = 4;
+    }
+    cpu_ = std::make_unique<Lane>(cpuThreads);
+    io_ = std::make_unique<Lane>(ioThreads);
+}
+
+JobSystem::~JobSystem() = default;
+
+JobSystem::Lane& JobSystem::lane(JobLane lane) const {
+    return lane == JobLane::Io ? *io_ : *cpu_;
+}
+
+void JobSystem::submit(std::function<void()> job, JobLane lane) {
+    this->lane(lane).submit(std::move(job));
+}
+
+uint32_t JobSystem::threadCount(JobLane lane) const {
+    return static_cast<uint32_t>(this->lane(lane).workers.size());
+}
+
+JobSystemStats JobSystem::stats() const {
+    return {cpu_->stats(), io_->stats()};
+}
+
+void JobSystem::resetStats() {
+    cpu_->resetStats();
+    io_->resetStats();
+}
+// }}}
+
+// Shared pool {{{
+namespace {
+std::mutex g_jobSystemMutex;
+std::unique_ptr<JobSystem> g_jobSystem;
+}
+
+JobSystem& jobSystem() {
+    std::lock_guard<std::mutex> lock(g_jobSystemMutex);
+    if (!g_jobSystem) {
+        g_jobSystem = std::make_unique<JobSystem>();
+    }
+    return *g_jobSystem;
+}
+
+void configureJobSystem(uint32_t cpuThreads, uint32_t ioThreads) {
+    std::unique_ptr<JobSystem> previous;
+    {
+        std::lock_guard<std::mutex> lock(g_jobSystemMutex);
+        previous = std::move(g_jobSystem);
+        g_jobSystem = std::make_unique<JobSystem>(cpuThreads, ioThreads);
+    }
+    // Drains and joins outside the lock
+    previous.reset();
+}
+// }}}
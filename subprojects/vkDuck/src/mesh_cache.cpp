@@ -0,0 +1,645 @@
+// vim:foldmethod=marker
+#include <vkDuck/mesh_cache.h>
+#include <vkDuck/mapped_file.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Internal helper functions {{{
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kMagic[8] = {'V', 'K', 'D', 'M', 'E', 'S', 'H', '\0'};
+constexpr size_t kSectionAlignment = 16;
+
+static_assert(std::is_trivially_copyable_v<Vertex>);
+static_assert(std::is_trivially_copyable_v<GeometryRange>);
+static_assert(std::is_trivially_copyable_v<InstanceData>);
+static_assert(std::is_trivially_copyable_v<MaterialData>);
+static_assert(std::is_trivially_copyable_v<MeshOptimizationStats>);
+static_assert(std::is_trivially_copyable_v<GeometryLod>);
+static_assert(std::is_trivially_copyable_v<Meshlet>);
+
+// File layout {{{
+enum class Section : uint32_t {
+    Dependencies,   // Model file and external files: size, mtime, content hash
+    Vertices,       // Vertex[]
+    Indices,        // uint32_t[], ranges with VK_INDEX_TYPE_UINT32
+    Ranges,         // GeometryRange[]
+    Instances,      // InstanceData[]
+    Materials,      // MaterialData[]
+    Scene,          // Cameras, lights, texture paths, flags, stats
+    Lods,           // GeometryLod[]
+    Indices16,      // uint16_t[], ranges with VK_INDEX_TYPE_UINT16
+    Meshlets,       // Meshlet[]
+    MeshletVertices,    // uint32_t[]
+    MeshletTriangles,   // uint8_t[]
+    EmbeddedImages,     // Encoded images not stored in the model file's BIN chunk
+    Count
+};
+
+struct SectionEntry {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t loaderVersion;
+    uint64_t keyHash;           // Load options + project root
+    uint32_t vertexSize;        // sizeof(Vertex), guards against layout drift
+    uint32_t sectionCount;
+    SectionEntry sections[static_cast<size_t>(Section::Count)];
+};
+// }}}
+
+// Serialization helpers {{{
+class ByteWriter {
+public:
+    template <typename T>
+    void pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        raw(&value, sizeof(T));
+    }
+
+    void string(const std::string& value) {
+        pod(static_cast<uint32_t>(value.size()));
+        raw(value.data(), value.size());
+    }
+
+    void raw(const void* data, size_t size) {
+        if (size == 0)
+            return;
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    std::vector<uint8_t> buffer;
+};
+
+/// Bounds-checked reader; any overrun marks the reader as failed
+class ByteReader {
+public:
+    explicit ByteReader(std::span<const uint8_t> bytes) : bytes_(bytes) {}
+
+    template <typename T>
+    T pod() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (take(sizeof(T))) {
+            std::memcpy(&value, bytes_.data() + pos_ - sizeof(T), sizeof(T));
+        }
+        return value;
+    }
+
+    std::string string() {
+        uint32_t size = pod<uint32_t>();
+        if (!take(size)) {
+            return {};
+        }
+        return std::string(reinterpret_cast<const char*>(bytes_.data() + pos_ - size), size);
+    }
+
+    bool ok() const { return ok_; }
+
+private:
+    bool take(size_t size) {
+        if (!ok_ || size > bytes_.size() - pos_) {
+            ok_ = false;
+            return false;
+        }
+        pos_ += size;
+        return true;
+    }
+
+    std::span<const uint8_t> bytes_;
+    size_t pos_{0};
+    bool ok_{true};
+};
+// }}}
+
+// Cache key {{{
+/// Hash everything besides the source files that changes loadModel() output.
+/// Add new ModelLoadOptions fields here (useMeshCache, cookTextures and
+/// packTextureChannels are deliberately excluded).
+uint64_t computeKeyHash(const ModelLoadOptions& options, const fs::path& projectRoot) {
+    ByteWriter key;
+    key.pod(static_cast<uint8_t>(options.preserveInstancing));
+    key.pod(static_cast<uint8_t>(options.optimizeMeshes));
+    key.pod(options.lodLevels);
+    key.pod(options.lodTriangleRatio);
+    key.pod(options.lodTargetError);
+    key.pod(static_cast<uint8_t>(options.buildMeshlets));
+    key.pod(static_cast<uint8_t>(options.preserveHierarchy));
+    key.string(projectRoot.generic_string());
+    // Appended only when set, so caches of whole-scene loads keep their key
+    if (!options.nodeSelection.empty()) {
+        std::vector<int32_t> selection = options.nodeSelection;
+        std::sort(selection.begin(), selection.end());
+        selection.erase(std::unique(selection.begin(), selection.end()), selection.end());
+        key.pod(static_cast<uint32_t>(selection.size()));
+        key.raw(selection.data(), selection.size() * sizeof(int32_t));
+    }
+    return hashBytes(key.buffer.data(), key.buffer.size());
+}
+
+/// Size and modification time of a source file, checked before its hash.
+/// Throws if the file cannot be stat'ed.
+struct SourceStamp {
+    uint64_t size;
+    int64_t mtime;      // file_time_type ticks
+};
+
+SourceStamp stampFile(const fs::path& path) {
+    return {fs::file_size(path), fs::last_write_time(path).time_since_epoch().count()};
+}
+
+/// Check one recorded source file. Unchanged size and mtime are trusted
+/// without reading the file; on an mtime mismatch the content hash decides,
+/// if one was recorded.
+bool sourceUnchanged(const fs::path& path, const SourceStamp& recorded, bool hashed, uint64_t hash) {
+    const SourceStamp current = stampFile(path);
+    if (current.size != recorded.size) {
+        return false;
+    }
+    if (current.mtime == recorded.mtime) {
+        return true;
+    }
+    return hashed && hashFile(path) == hash;
+}
+// }}}
+
+// Scene section {{{
+/// Where the bytes of an embedded image are stored
+enum class ImageStorage : uint8_t {
+    None,       // Image on disk
+    Source,     // Range of the model file (GLB BIN chunk)
+    Cache       // Range of the EmbeddedImages section
+};
+
+struct CachedImage {
+    ImageStorage storage{ImageStorage::None};
+    uint64_t offset{0};
+    uint64_t size{0};
+};
+
+/// Write the scene tables. Embedded images inside the mapped model file are
+/// stored as file ranges; all others are appended to `images`.
+void writeScene(ByteWriter& w, ByteWriter& images, const ModelData& data) {
+    w.pod(static_cast<uint8_t>(data.instanced));
+    w.pod(static_cast<uint8_t>(data.hierarchical));
+    w.pod(data.optimization);
+
+    w.pod(static_cast<uint32_t>(data.nodes.size()));
+    for (const auto& node : data.nodes) {
+        w.string(node.name);
+        w.pod(node.parent);
+        w.pod(node.localTransform);
+        w.pod(node.worldTransform);
+    }
+
+    w.pod(static_cast<uint32_t>(data.cameras.size()));
+    for (const auto& cam : data.cameras) {
+        w.string(cam.name);
+        w.pod(static_cast<uint8_t>(cam.isPerspective));
+        w.pod(cam.fov);
+        w.pod(cam.aspectRatio);
+        w.pod(cam.nearPlane);
+        w.pod(cam.farPlane);
+        w.pod(cam.xmag);
+        w.pod(cam.ymag);
+        w.pod(cam.position);
+        w.pod(cam.transform);
+    }
+
+    w.pod(static_cast<uint32_t>(data.lights.size()));
+    for (const auto& light : data.lights) {
+        w.string(light.name);
+        w.pod(static_cast<uint32_t>(light.type));
+        w.pod(light.color);
+        w.pod(light.intensity);
+        w.pod(light.range);
+        w.pod(light.innerConeAngle);
+        w.pod(light.outerConeAngle);
+        w.pod(light.position);
+        w.pod(light.direction);
+        w.pod(light.transform);
+    }
+
+    auto writePaths = [&](const std::vector<fs::path>& paths) {
+        w.pod(static_cast<uint32_t>(paths.size()));
+        for (const auto& path : paths) {
+            w.string(path.string());
+        }
+    };
+    writePaths(data.allTexturePaths);
+    writePaths(data.texturePaths);
+
+    const std::span<const uint8_t> source =
+        data.sourceMapping ? data.sourceMapping->bytes() : std::span<const uint8_t>();
+    w.pod(static_cast<uint32_t>(data.embeddedImages.size()));
+    for (const auto& image : data.embeddedImages) {
+        w.string(image.mimeType);
+        CachedImage cached;
+        if (!image.bytes.empty() && image.bytes.data() >= source.data() &&
+            image.bytes.data() + image.bytes.size() <= source.data() + source.size()) {
+            cached = {ImageStorage::Source,
+                static_cast<uint64_t>(image.bytes.data() - source.data()), image.bytes.size()};
+        } else if (!image.bytes.empty()) {
+            cached = {ImageStorage::Cache, images.buffer.size(), image.bytes.size()};
+            images.raw(image.bytes.data(), image.bytes.size());
+        }
+        w.pod(static_cast<uint8_t>(cached.storage));
+        w.pod(cached.offset);
+        w.pod(cached.size);
+    }
+}
+
+/// Read the scene tables. Embedded image bytes are resolved by the caller
+/// from `images`, which is parallel to data.embeddedImages.
+bool readScene(ByteReader& r, ModelData& data, std::vector<CachedImage>& images) {
+    data.instanced = r.pod<uint8_t>() != 0;
+    data.hierarchical = r.pod<uint8_t>() != 0;
+    data.optimization = r.pod<MeshOptimizationStats>();
+
+    uint32_t nodeCount = r.pod<uint32_t>();
+    for (uint32_t i = 0; i < nodeCount && r.ok(); ++i) {
+        SceneNode node;
+        node.name = r.string();
+        node.parent = r.pod<int32_t>();
+        node.localTransform = r.pod<glm::mat4>();
+        node.worldTransform = r.pod<glm::mat4>();
+        // Parents precede their children
+        if (node.parent >= static_cast<int32_t>(i)) {
+            return false;
+        }
+        data.nodes.push_back(std::move(node));
+    }
+
+    uint32_t cameraCount = r.pod<uint32_t>();
+    for (uint32_t i = 0; i < cameraCount && r.ok(); ++i) {
+        GLTFCamera cam;
+        cam.name = r.string();
+        cam.isPerspective = r.pod<uint8_t>() != 0;
+        cam.fov = r.pod<float>();
+        cam.aspectRatio = r.pod<float>();
+        cam.nearPlane = r.pod<float>();
+        cam.farPlane = r.pod<float>();
+        cam.xmag = r.pod<float>();
+        cam.ymag = r.pod<float>();
+        cam.position = r.pod<glm::vec3>();
+        cam.transform = r.pod<glm::mat4>();
+        data.cameras.push_back(std::move(cam));
+    }
+
+    uint32_t lightCount = r.pod<uint32_t>();
+    for (uint32_t i = 0; i < lightCount && r.ok(); ++i) {
+        GLTFLight light;
+        light.name = r.string();
+        light.type = static_cast<GLTFLightType>(r.pod<uint32_t>());
+        light.color = r.pod<glm::vec3>();
+        light.intensity = r.pod<float>();
+        light.range = r.pod<float>();
+        light.innerConeAngle = r.pod<float>();
+        light.outerConeAngle = r.pod<float>();
+        light.position = r.pod<glm::vec3>();
+        light.direction = r.pod<glm::vec3>();
+        light.transform = r.pod<glm::mat4>();
+        data.lights.push_back(std::move(light));
+    }
+
+    auto readPaths = [&](std::vector<fs::path>& paths) {
+        uint32_t count = r.pod<uint32_t>();
+        for (uint32_t i = 0; i < count && r.ok(); ++i) {
+            paths.emplace_back(r.string());
+        }
+    };
+    readPaths(data.allTexturePaths);
+    readPaths(data.texturePaths);
+
+    uint32_t imageCount = r.pod<uint32_t>();
+    if (imageCount != 0 && imageCount != data.allTexturePaths.size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < imageCount && r.ok(); ++i) {
+        EmbeddedImage image;
+        image.mimeType = r.string();
+        data.embeddedImages.push_back(std::move(image));
+        CachedImage& cached = images.emplace_back();
+        cached.storage = static_cast<ImageStorage>(r.pod<uint8_t>());
+        cached.offset = r.pod<uint64_t>();
+        cached.size = r.pod<uint64_t>();
+    }
+
+    return r.ok();
+}
+// }}}
+
+template <typename T>
+std::span<const uint8_t> asBytes(std::span<T> values) {
+    return {reinterpret_cast<const uint8_t*>(values.data()), values.size_bytes()};
+}
+
+template <typename T>
+bool sectionArray(
+    const MappedFile& file,
+    const SectionEntry& entry,
+    std::span<const T>& out
+) {
+    if (entry.size % sizeof(T) != 0 || entry.offset % alignof(T) != 0) {
+        return false;
+    }
+    out = std::span<const T>(
+        reinterpret_cast<const T*>(file.data() + entry.offset),
+        entry.size / sizeof(T)
+    );
+    return true;
+}
+
+} // anonymous namespace
+// }}}
+
+// Mesh cache implementation {{{
+
+fs::path meshCachePath(
+    const fs::path& modelPath,
+    const fs::path& projectRoot,
+    const ModelLoadOptions& options
+) {
+    char key[9];
+    std::snprintf(key, sizeof(key), "%08x",
+        static_cast<uint32_t>(computeKeyHash(options, projectRoot)));
+    fs::path cachePath = modelPath;
+    cachePath += std::string(".") + key + ".vkdmesh";
+    return cachePath;
+}
+
+bool readMeshCache(
+    const fs::path& modelPath,
+    const fs::path& projectRoot,
+    const ModelLoadOptions& options,
+    ModelData& out
+) {
+    try {
+        fs::path cachePath = meshCachePath(modelPath, projectRoot, options);
+        std::error_code ec;
+        if (!fs::exists(cachePath, ec)) {
+            return false;
+        }
+
+        auto file = std::make_shared<MappedFile>(cachePath);
+        if (file->size() < sizeof(Header)) {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, file->data(), sizeof(Header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.formatVersion != kMeshCacheFormatVersion ||
+            header.loaderVersion != kModelLoaderVersion ||
+            header.vertexSize != sizeof(Vertex) ||
+            header.sectionCount != static_cast<uint32_t>(Section::Count) ||
+            header.keyHash != computeKeyHash(options, projectRoot)) {
+            return false;
+        }
+
+        for (const auto& entry : header.sections) {
+            if (entry.offset > file->size() || entry.size > file->size() - entry.offset) {
+                return false;
+            }
+        }
+        auto section = [&](Section s) -> const SectionEntry& {
+            return header.sections[static_cast<size_t>(s)];
+        };
+        auto sectionBytes = [&](Section s) {
+            const SectionEntry& entry = section(s);
+            return std::span<const uint8_t>(file->data() + entry.offset, entry.size);
+        };
+
+        // Validate the sources before trusting any data. The first entry is
+        // the model file itself (empty path).
+        ByteReader deps(sectionBytes(Section::Dependencies));
+        uint32_t dependencyCount = deps.pod<uint32_t>();
+        if (dependencyCount == 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < dependencyCount; ++i) {
+            fs::path dependency = deps.string();
+            SourceStamp stamp;
+            stamp.size = deps.pod<uint64_t>();
+            stamp.mtime = deps.pod<int64_t>();
+            const bool hashed = deps.pod<uint8_t>() != 0;
+            const uint64_t hash = deps.pod<uint64_t>();
+            if (!deps.ok() || (i == 0) != dependency.empty()) {
+                return false;
+            }
+            const fs::path sourcePath = i == 0 ? modelPath : modelPath.parent_path() / dependency;
+            if (!sourceUnchanged(sourcePath, stamp, hashed, hash)) {
+                return false;
+            }
+        }
+
+        ModelData data;
+        std::span<const GeometryRange> ranges;
+        std::span<const InstanceData> instances;
+        std::span<const MaterialData> materials;
+        std::span<const GeometryLod> lods;
+        if (!sectionArray(*file, section(Section::Vertices), data.mappedVertices) ||
+            !sectionArray(*file, section(Section::Lods), lods) ||
+            !sectionArray(*file, section(Section::Indices), data.mappedIndices) ||
+            !sectionArray(*file, section(Section::Indices16), data.mappedIndices16) ||
+            !sectionArray(*file, section(Section::Meshlets), data.mappedMeshlets) ||
+            !sectionArray(*file, section(Section::MeshletVertices), data.mappedMeshletVertices) ||
+            !sectionArray(*file, section(Section::MeshletTriangles), data.mappedMeshletTriangles) ||
+            !sectionArray(*file, section(Section::Ranges), ranges) ||
+            !sectionArray(*file, section(Section::Instances), instances) ||
+            !sectionArray(*file, section(Section::Materials), materials)) {
+            return false;
+        }
+
+        // Small per-model tables are copied; bulk geometry stays mapped
+        data.ranges.assign(ranges.begin(), ranges.end());
+        data.instances.assign(instances.begin(), instances.end());
+        data.materials.assign(materials.begin(), materials.end());
+        data.lods.assign(lods.begin(), lods.end());
+
+        for (const auto& range : data.ranges) {
+            if (range.indexType != VK_INDEX_TYPE_UINT16 && range.indexType != VK_INDEX_TYPE_UINT32) {
+                return false;
+            }
+            const uint64_t indexCount = range.indexType == VK_INDEX_TYPE_UINT16
+                ? data.mappedIndices16.size() : data.mappedIndices.size();
+            if (static_cast<uint64_t>(range.firstVertex) + range.vertexCount > data.mappedVertices.size() ||
+                static_cast<uint64_t>(range.firstIndex) + range.indexCount > indexCount ||
+                static_cast<uint64_t>(range.firstLod) + range.lodCount > data.lods.size()) {
+                return false;
+            }
+            for (uint32_t l = 0; l < range.lodCount; ++l) {
+                const GeometryLod& lod = data.lods[range.firstLod + l];
+                if (static_cast<uint64_t>(range.firstIndex) + lod.firstIndex + lod.indexCount >
+                    indexCount) {
+                    return false;
+                }
+            }
+            if (static_cast<uint64_t>(range.firstMeshlet) + range.meshletCount >
+                data.mappedMeshlets.size()) {
+                return false;
+            }
+            for (uint32_t m = 0; m < range.meshletCount; ++m) {
+                const Meshlet& meshlet = data.mappedMeshlets[range.firstMeshlet + m];
+                if (meshlet.vertexCount > kMeshletMaxVertices ||
+                    meshlet.triangleCount > kMeshletMaxTriangles ||
+                    static_cast<uint64_t>(range.firstMeshletVertex) + meshlet.vertexOffset +
+                        meshlet.vertexCount > data.mappedMeshletVertices.size() ||
+                    static_cast<uint64_t>(range.firstMeshletTriangle) + meshlet.triangleOffset +
+                        meshlet.triangleCount * 3 > data.mappedMeshletTriangles.size()) {
+                    return false;
+                }
+            }
+        }
+
+        ByteReader scene(sectionBytes(Section::Scene));
+        std::vector<CachedImage> images;
+        if (!readScene(scene, data, images)) {
+            return false;
+        }
+        for (const auto& range : data.ranges) {
+            if (range.node >= static_cast<int32_t>(data.nodes.size())) {
+                return false;
+            }
+        }
+
+        // Embedded images view the model file (mapped on demand) or the cache
+        const std::span<const uint8_t> cachedImageBytes = sectionBytes(Section::EmbeddedImages);
+        for (size_t i = 0; i < images.size(); ++i) {
+            const CachedImage& image = images[i];
+            std::span<const uint8_t> bytes;
+            if (image.storage == ImageStorage::Source) {
+                if (!data.sourceMapping) {
+                    data.sourceMapping = std::make_shared<const MappedFile>(modelPath);
+                }
+                bytes = data.sourceMapping->bytes();
+            } else if (image.storage == ImageStorage::Cache) {
+                bytes = cachedImageBytes;
+            } else {
+                continue;
+            }
+            if (image.offset > bytes.size() || image.size > bytes.size() - image.offset) {
+                return false;
+            }
+            data.embeddedImages[i].bytes = bytes.subspan(image.offset, image.size);
+        }
+
+        data.cacheMapping = std::move(file);
+        out = std::move(data);
+        return true;
+    } catch (const std::exception&) {
+        // Unreadable cache or dependency: treat as a miss and rebuild
+        return false;
+    }
+}
+
+bool writeMeshCache(
+    const fs::path& modelPath,
+    const fs::path& projectRoot,
+    const ModelLoadOptions& options,
+    const ModelData& data,
+    const std::vector<fs::path>& dependencies
+) {
+    fs::path cachePath = meshCachePath(modelPath, projectRoot, options);
+    // Unique per writer thread, so concurrent loads of one model don't clash
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    try {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kMeshCacheFormatVersion;
+        header.loaderVersion = kModelLoaderVersion;
+        header.keyHash = computeKeyHash(options, projectRoot);
+        header.vertexSize = sizeof(Vertex);
+        header.sectionCount = static_cast<uint32_t>(Section::Count);
+
+        // Small sections are built in memory; bulk geometry is streamed
+        // straight from `data` so writing does not duplicate the model
+        // A selective load reads only the selected meshes' bytes, so hashing
+        // whole sources would cost more than the load; those caches are
+        // validated by size and mtime alone
+        const bool hashSources = options.nodeSelection.empty();
+        ByteWriter deps;
+        deps.pod(static_cast<uint32_t>(dependencies.size() + 1));
+        auto writeSource = [&](const fs::path& name, const fs::path& path) {
+            const SourceStamp stamp = stampFile(path);
+            deps.string(name.generic_string());
+            deps.pod(stamp.size);
+            deps.pod(stamp.mtime);
+            deps.pod(static_cast<uint8_t>(hashSources));
+            deps.pod(hashSources ? hashFile(path) : uint64_t{0});
+        };
+        writeSource({}, modelPath);
+        for (const auto& dependency : dependencies) {
+            writeSource(dependency, modelPath.parent_path() / dependency);
+        }
+
+        ByteWriter scene;
+        ByteWriter images;
+        writeScene(scene, images, data);
+
+        const std::pair<Section, std::span<const uint8_t>> payloads[] = {
+            {Section::Dependencies, deps.buffer},
+            {Section::Vertices, asBytes(data.vertexSpan())},
+            {Section::Indices, asBytes(data.indexSpan())},
+            {Section::Ranges, asBytes(std::span(data.ranges))},
+            {Section::Instances, asBytes(std::span(data.instances))},
+            {Section::Materials, asBytes(std::span(data.materials))},
+            {Section::Scene, scene.buffer},
+            {Section::Lods, asBytes(std::span(data.lods))},
+            {Section::Indices16, asBytes(data.index16Span())},
+            {Section::Meshlets, asBytes(data.meshletSpan())},
+            {Section::MeshletVertices, asBytes(data.meshletVertexSpan())},
+            {Section::MeshletTriangles, data.meshletTriangleSpan()},
+            {Section::EmbeddedImages, images.buffer},
+        };
+
+        // Lay out sections after the header, each 16-byte aligned
+        uint64_t offset = sizeof(Header);
+        for (const auto& [section, bytes] : payloads) {
+            offset = (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+            header.sections[static_cast<size_t>(section)] = {offset, bytes.size()};
+            offset += bytes.size();
+        }
+
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            uint64_t written = sizeof(Header);
+            const char padding[kSectionAlignment] = {};
+            for (const auto& [section, bytes] : payloads) {
+                uint64_t sectionOffset = header.sections[static_cast<size_t>(section)].offset;
+                file.write(padding, static_cast<std::streamsize>(sectionOffset - written));
+                file.write(reinterpret_cast<const char*>(bytes.data()),
+                    static_cast<std::streamsize>(bytes.size()));
+                written = sectionOffset + bytes.size();
+            }
+            if (!file) {
+                throw std::runtime_error("write failed");
+            }
+        }
+        fs::rename(tempPath, cachePath);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: could not write mesh cache " << cachePath.string()
+            << ": " << e.what() << std::endl;
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+}
+// }}}
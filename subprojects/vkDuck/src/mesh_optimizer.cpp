@@ -0,0 +1,944 @@
+// vim:foldmethod=marker
+#include <vkDuck/mesh_optimizer.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+// Internal helper functions {{{
+namespace {
+
+/// FIFO cache simulated with timestamps: a vertex is resident while fewer
+/// than `cacheSize` misses happened since it was last loaded
+struct FifoCache {
+    std::vector<uint32_t> timestamps;
+    uint32_t timestamp;
+    uint32_t cacheSize;
+
+    FifoCache(size_t vertexCount, uint32_t size)
+        : timestamps(vertexCount, 0), timestamp(size + 1), cacheSize(size) {}
+
+    /// Returns 1 on a miss
+    uint32_t touch(uint32_t v) {
+        if (timestamp - timestamps[v] > cacheSize) {
+            timestamps[v] = timestamp++;
+            return 1;
+        }
+        return 0;
+    }
+
+    uint32_t touchTriangle(const uint32_t* tri) {
+        return touch(tri[0]) + touch(tri[1]) + touch(tri[2]);
+    }
+
+    void flush() {
+        timestamp += cacheSize + 1;
+    }
+};
+
+bool indicesInRange(const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    return std::all_of(indices, indices + indexCount,
+        [&](uint32_t i) { return i < vertexCount; });
+}
+
+void loadPosition(const void* positions, size_t stride, uint32_t index, float out[3]) {
+    std::memcpy(out, static_cast<const uint8_t*>(positions) + index * stride, 3 * sizeof(float));
+}
+
+void cross(const float* p0, const float* p1, const float* p2, float out[3]) {
+    float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+/// Symmetric 4x4 plane quadric accumulated with area weights
+struct Quadric {
+    double a00{0.0}, a11{0.0}, a22{0.0}, a01{0.0}, a02{0.0}, a12{0.0};
+    double b0{0.0}, b1{0.0}, b2{0.0}, c{0.0};
+    double weight{0.0};
+
+    /// Plane n.p + d = 0 with unit normal n
+    static Quadric fromPlane(double nx, double ny, double nz, double d, double w) {
+        Quadric q;
+        q.a00 = w * nx * nx;
+        q.a11 = w * ny * ny;
+        q.a22 = w * nz * nz;
+        q.a01 = w * nx * ny;
+        q.a02 = w * nx * nz;
+        q.a12 = w * ny * nz;
+        q.b0 = w * nx * d;
+        q.b1 = w * ny * d;
+        q.b2 = w * nz * d;
+        q.c = w * d * d;
+        q.weight = w;
+        return q;
+    }
+
+    void add(const Quadric& o) {
+        a00 += o.a00; a11 += o.a11; a22 += o.a22;
+        a01 += o.a01; a02 += o.a02; a12 += o.a12;
+        b0 += o.b0; b1 += o.b1; b2 += o.b2;
+        c += o.c;
+        weight += o.weight;
+    }
+
+    /// Weighted mean squared distance of `p` to the accumulated planes
+    double error(const float* p) const {
+        const double x = p[0], y = p[1], z = p[2];
+        double r = a00 * x * x + a11 * y * y + a22 * z * z +
+            2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+            2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return weight > 0.0 ? std::abs(r) / weight : 0.0;
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const std::array<uint32_t, 3>& key) const {
+        return (key[0] * 73856093u) ^ (key[1] * 19349663u) ^ (key[2] * 83492791u);
+    }
+};
+
+struct CollapseCandidate {
+    uint32_t from;
+    uint32_t to;
+    double cost;
+};
+
+float length(const float* v) {
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+/// Fill the bounding sphere and normal cone of a finished meshlet
+void computeMeshletBounds(
+    Meshlet& meshlet,
+    const uint32_t* meshletVertices,
+    const uint8_t* meshletTriangles,
+    const void* positions,
+    size_t positionStride
+) {
+    const uint32_t* vertices = meshletVertices + meshlet.vertexOffset;
+    const uint8_t* triangles = meshletTriangles + meshlet.triangleOffset;
+
+    // Sphere around the AABB center
+    constexpr float big = std::numeric_limits<float>::max();
+    float lo[3] = {big, big, big};
+    float hi[3] = {-big, -big, -big};
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+        float p[3];
+        loadPosition(positions, positionStride, vertices[i], p);
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], p[c]);
+            hi[c] = std::max(hi[c], p[c]);
+        }
+    }
+    float radius = 0.0f;
+    for (int c = 0; c < 3; ++c) {
+        meshlet.center[c] = 0.5f * (lo[c] + hi[c]);
+    }
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+        float p[3];
+        loadPosition(positions, positionStride, vertices[i], p);
+        float d[3] = {p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2]};
+        radius = std::max(radius, length(d));
+    }
+    meshlet.radius = radius;
+
+    // Cone around the average unit normal; its half angle covers every
+    // non-degenerate triangle
+    auto triangleNormal = [&](uint32_t t, float n[3]) {
+        float p0[3], p1[3], p2[3];
+        loadPosition(positions, positionStride, vertices[triangles[t * 3 + 0]], p0);
+        loadPosition(positions, positionStride, vertices[triangles[t * 3 + 1]], p1);
+        loadPosition(positions, positionStride, vertices[triangles[t * 3 + 2]], p2);
+        cross(p0, p1, p2, n);
+        float len = length(n);
+        if (len <= 0.0f) {
+            return false;
+        }
+        n[0] /= len;
+        n[1] /= len;
+        n[2] /= len;
+        return true;
+    };
+
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        float n[3];
+        if (triangleNormal(t, n)) {
+            axis[0] += n[0];
+            axis[1] += n[1];
+            axis[2] += n[2];
+        }
+    }
+    float axisLength = length(axis);
+    meshlet.coneAxis[0] = meshlet.coneAxis[1] = meshlet.coneAxis[2] = 0.0f;
+    meshlet.coneCutoff = 1.0f;
+    if (axisLength <= 0.0f) {
+        return;
+    }
+    for (int c = 0; c < 3; ++c) {
+        meshlet.coneAxis[c] = axis[c] / axisLength;
+    }
+
+    float minDot = 1.0f;
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        float n[3];
+        if (triangleNormal(t, n)) {
+            minDot = std::min(minDot,
+                n[0] * meshlet.coneAxis[0] + n[1] * meshlet.coneAxis[1] + n[2] * meshlet.coneAxis[2]);
+        }
+    }
+    // Near-hemispherical cones would almost never cull; keep them disabled
+    // so float error can't cull a visible meshlet
+    if (minDot > 0.1f) {
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+} // anonymous namespace
+// }}}
+
+// Cache analysis {{{
+VertexCacheStats analyzeVertexCache(
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount,
+    uint32_t cacheSize
+) {
+    VertexCacheStats stats;
+    stats.triangles = indexCount / 3;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> seen(vertexCount, false);
+    for (size_t i = 0; i < stats.triangles * 3; ++i) {
+        uint32_t v = indices[i];
+        if (v >= vertexCount) {
+            continue;
+        }
+        stats.misses += cache.touch(v);
+        if (!seen[v]) {
+            seen[v] = true;
+            stats.vertices++;
+        }
+    }
+
+    if (stats.triangles > 0) {
+        stats.acmr = static_cast<float>(stats.misses) / static_cast<float>(stats.triangles);
+    }
+    if (stats.vertices > 0) {
+        stats.atvr = static_cast<float>(stats.misses) / static_cast<float>(stats.vertices);
+    }
+    return stats;
+}
+// }}}
+
+// Vertex cache optimization (Tipsify) {{{
+void optimizeVertexCache(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount,
+    uint32_t cacheSize
+) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || !indicesInRange(indices, indexCount, vertexCount)) {
+        std::copy(indices, indices + indexCount, destination);
+        return;
+    }
+
+    // Vertex -> triangle adjacency (CSR) and live triangle counts
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        liveCount[indices[i]]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    std::partial_sum(liveCount.begin(), liveCount.end(), offsets.begin() + 1);
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;
+    deadEnd.reserve(triangleCount * 3);
+    std::vector<uint32_t> candidates;
+
+    uint32_t timestamp = cacheSize + 1;
+    size_t scanCursor = 0;
+    size_t written = 0;
+    int64_t fanning = indices[0];
+
+    while (fanning >= 0) {
+        const uint32_t f = static_cast<uint32_t>(fanning);
+
+        // Emit every remaining triangle around the fanning vertex
+        candidates.clear();
+        for (uint32_t k = offsets[f]; k < offsets[f + 1]; ++k) {
+            uint32_t t = adjacency[k];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = true;
+            for (int c = 0; c < 3; ++c) {
+                uint32_t v = indices[t * 3 + c];
+                destination[written++] = v;
+                candidates.push_back(v);
+                deadEnd.push_back(v);
+                liveCount[v]--;
+                if (timestamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+        }
+
+        // Next fanning vertex: the one that stays in cache the longest
+        // after its remaining triangles are emitted
+        int64_t best = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveCount[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            int64_t age = static_cast<int64_t>(timestamp - cacheTime[v]);
+            if (age + 2 * static_cast<int64_t>(liveCount[v]) <= cacheSize) {
+                priority = age;
+            }
+            if (priority > bestPriority) {
+                best = v;
+                bestPriority = priority;
+            }
+        }
+
+        // Dead end: fall back to recently used vertices, then to a linear scan
+        while (best < 0 && !deadEnd.empty()) {
+            uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveCount[v] > 0) {
+                best = v;
+            }
+        }
+        while (best < 0 && scanCursor < vertexCount) {
+            if (liveCount[scanCursor] > 0) {
+                best = static_cast<int64_t>(scanCursor);
+            }
+            ++scanCursor;
+        }
+
+        fanning = best;
+    }
+
+    // Trailing indices that don't form a triangle are kept as-is
+    std::copy(indices + triangleCount * 3, indices + indexCount, destination + written);
+}
+// }}}
+
+// Overdraw optimization {{{
+void optimizeOverdraw(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    float threshold,
+    uint32_t cacheSize
+) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || !indicesInRange(indices, indexCount, vertexCount)) {
+        std::copy(indices, indices + indexCount, destination);
+        return;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+
+    // Hard boundaries: a triangle missing all three vertices usually starts
+    // a new patch that is disjoint from the previous one
+    std::vector<uint32_t> hardClusters;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (cache.touchTriangle(indices + t * 3) == 3 || t == 0) {
+            hardClusters.push_back(static_cast<uint32_t>(t));
+        }
+    }
+    hardClusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // Soft boundaries: split hard clusters wherever doing so keeps the
+    // local miss ratio within `threshold` of the cluster's own ratio
+    std::vector<uint32_t> clusters;
+    for (size_t h = 0; h + 1 < hardClusters.size(); ++h) {
+        const uint32_t start = hardClusters[h];
+        const uint32_t end = hardClusters[h + 1];
+
+        cache.flush();
+        uint32_t misses = 0;
+        for (uint32_t t = start; t < end; ++t) {
+            misses += cache.touchTriangle(indices + t * 3);
+        }
+        const float clusterThreshold =
+            threshold * static_cast<float>(misses) / static_cast<float>(end - start);
+
+        cache.flush();
+        clusters.push_back(start);
+        uint32_t softStart = start;
+        uint32_t softMisses = 0;
+        for (uint32_t t = start; t < end; ++t) {
+            softMisses += cache.touchTriangle(indices + t * 3);
+            if (t + 1 < end &&
+                static_cast<float>(softMisses) <= clusterThreshold * static_cast<float>(t + 1 - softStart)) {
+                clusters.push_back(t + 1);
+                softStart = t + 1;
+                softMisses = 0;
+                cache.flush();
+            }
+        }
+    }
+    clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // Area-weighted centroid and normal per cluster
+    const size_t clusterCount = clusters.size() - 1;
+    std::vector<float> centroids(clusterCount * 3, 0.0f);
+    std::vector<float> normals(clusterCount * 3, 0.0f);
+    std::vector<float> areas(clusterCount, 0.0f);
+    float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusterCount; ++c) {
+        for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            float p0[3], p1[3], p2[3];
+            loadPosition(positions, positionStride, indices[t * 3 + 0], p0);
+            loadPosition(positions, positionStride, indices[t * 3 + 1], p1);
+            loadPosition(positions, positionStride, indices[t * 3 + 2], p2);
+
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3] = {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0],
+            };
+            float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (int k = 0; k < 3; ++k) {
+                float center = (p0[k] + p1[k] + p2[k]) / 3.0f;
+                centroids[c * 3 + k] += center * area;
+                normals[c * 3 + k] += n[k];
+                meshCentroid[k] += center * area;
+            }
+            areas[c] += area;
+            meshArea += area;
+        }
+    }
+    if (meshArea > 0.0f) {
+        for (float& k : meshCentroid) {
+            k /= meshArea;
+        }
+    }
+
+    // Outward-facing clusters (far from the center along their normal) are
+    // the most likely to occlude others, so they are drawn first
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        const float* n = &normals[c * 3];
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (areas[c] <= 0.0f || length <= 0.0f) {
+            continue;
+        }
+        float key = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            float centroid = centroids[c * 3 + k] / areas[c];
+            key += (centroid - meshCentroid[k]) * (n[k] / length);
+        }
+        sortKeys[c] = key;
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    size_t written = 0;
+    for (uint32_t c : order) {
+        const size_t first = static_cast<size_t>(clusters[c]) * 3;
+        const size_t last = static_cast<size_t>(clusters[c + 1]) * 3;
+        std::copy(indices + first, indices + last, destination + written);
+        written += last - first;
+    }
+    std::copy(indices + triangleCount * 3, indices + indexCount, destination + written);
+}
+// }}}
+
+// Vertex fetch optimization {{{
+size_t generateVertexFetchRemap(
+    uint32_t* remap,
+    const uint32_t* indices,
+    size_t indexCount,
+    size_t vertexCount
+) {
+    constexpr uint32_t unused = ~0u;
+    std::fill(remap, remap + vertexCount, unused);
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t v = indices[i];
+        if (v < vertexCount && remap[v] == unused) {
+            remap[v] = next++;
+        }
+    }
+    const size_t referenced = next;
+
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] == unused) {
+            remap[v] = next++;
+        }
+    }
+    return referenced;
+}
+// }}}
+
+// Simplification {{{
+size_t simplifyMesh(
+    uint32_t* destination,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    size_t targetIndexCount,
+    float targetError,
+    float* resultError
+) {
+    if (resultError) {
+        *resultError = 0.0f;
+    }
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || !indicesInRange(indices, indexCount, vertexCount)) {
+        std::copy(indices, indices + indexCount, destination);
+        return indexCount;
+    }
+
+    std::vector<uint32_t> result(indices, indices + triangleCount * 3);
+
+    // Positions normalized to the unit cube, so errors are relative to extent
+    std::vector<float> pos(vertexCount * 3);
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float extent = 0.0f;
+    {
+        float boundsMax[3];
+        loadPosition(positions, positionStride, result[0], boundsMin);
+        loadPosition(positions, positionStride, result[0], boundsMax);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            loadPosition(positions, positionStride, static_cast<uint32_t>(v), &pos[v * 3]);
+        }
+        for (uint32_t v : result) {
+            for (int k = 0; k < 3; ++k) {
+                boundsMin[k] = std::min(boundsMin[k], pos[v * 3 + k]);
+                boundsMax[k] = std::max(boundsMax[k], pos[v * 3 + k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            extent = std::max(extent, boundsMax[k] - boundsMin[k]);
+        }
+        const float scale = extent > 0.0f ? 1.0f / extent : 0.0f;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            for (int k = 0; k < 3; ++k) {
+                pos[v * 3 + k] = (pos[v * 3 + k] - boundsMin[k]) * scale;
+            }
+        }
+    }
+
+    // Vertices sharing a position (UV/normal seams) are welded into one
+    // canonical vertex for topology and error tracking
+    std::vector<uint32_t> canonical(vertexCount);
+    std::vector<uint32_t> wedgeCount(vertexCount, 0);
+    {
+        std::vector<bool> referenced(vertexCount, false);
+        for (uint32_t v : result) {
+            referenced[v] = true;
+        }
+        std::unordered_map<std::array<uint32_t, 3>, uint32_t, PositionKeyHash> firstAtPosition;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            canonical[v] = static_cast<uint32_t>(v);
+            if (!referenced[v]) {
+                continue;
+            }
+            std::array<uint32_t, 3> key;
+            std::memcpy(key.data(), &pos[v * 3], sizeof(key));
+            canonical[v] = firstAtPosition.emplace(key, static_cast<uint32_t>(v)).first->second;
+            wedgeCount[canonical[v]]++;
+        }
+    }
+
+    // Lock seams, open borders and non-manifold edges (edges not shared by
+    // exactly two triangles)
+    std::vector<bool> locked(vertexCount, false);
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        edgeUse.reserve(result.size());
+        for (size_t t = 0; t < result.size() / 3; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                uint64_t a = canonical[result[t * 3 + k]];
+                uint64_t b = canonical[result[t * 3 + (k + 1) % 3]];
+                edgeUse[a < b ? (a << 32) | b : (b << 32) | a]++;
+            }
+        }
+        for (const auto& [edge, count] : edgeUse) {
+            if (count != 2) {
+                locked[static_cast<uint32_t>(edge >> 32)] = true;
+                locked[static_cast<uint32_t>(edge & 0xffffffffu)] = true;
+            }
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            if (wedgeCount[v] > 1) {
+                locked[v] = true;
+            }
+        }
+    }
+    auto collapsible = [&](uint32_t v) {
+        return !locked[canonical[v]];
+    };
+
+    // Per-vertex quadrics from the planes of adjacent triangles
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t < result.size() / 3; ++t) {
+        const uint32_t* tri = &result[t * 3];
+        float n[3];
+        cross(&pos[tri[0] * 3], &pos[tri[1] * 3], &pos[tri[2] * 3], n);
+        double length = std::sqrt(double(n[0]) * n[0] + double(n[1]) * n[1] + double(n[2]) * n[2]);
+        if (length <= 0.0) {
+            continue;
+        }
+        double nx = n[0] / length, ny = n[1] / length, nz = n[2] / length;
+        const float* p0 = &pos[tri[0] * 3];
+        double d = -(nx * p0[0] + ny * p0[1] + nz * p0[2]);
+        Quadric q = Quadric::fromPlane(nx, ny, nz, d, length * 0.5);
+        for (int k = 0; k < 3; ++k) {
+            quadrics[canonical[tri[k]]].add(q);
+        }
+    }
+
+    const double errorLimit = double(targetError) * double(targetError);
+    double maxError = 0.0;
+    targetIndexCount -= targetIndexCount % 3;
+
+    std::vector<uint32_t> offsets(vertexCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<uint32_t> collapseTo(vertexCount);
+    std::vector<bool> touched(vertexCount);
+    std::vector<CollapseCandidate> candidates;
+
+    // Each pass collapses the cheapest edges whose one-rings don't overlap,
+    // so every collapse is validated against up-to-date geometry
+    while (result.size() > targetIndexCount) {
+        const size_t currentTriangles = result.size() / 3;
+
+        // Vertex -> triangle adjacency (CSR)
+        std::fill(offsets.begin(), offsets.end(), 0u);
+        for (uint32_t v : result) {
+            offsets[v + 1]++;
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        adjacency.resize(result.size());
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < result.size(); ++i) {
+                adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        // Every directed triangle edge a->b is a candidate for moving a onto
+        // b; the opposite direction comes from the neighbouring triangle
+        candidates.clear();
+        for (size_t t = 0; t < currentTriangles; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t a = result[t * 3 + k];
+                uint32_t b = result[t * 3 + (k + 1) % 3];
+                if (!collapsible(a)) {
+                    continue;
+                }
+                Quadric q = quadrics[canonical[a]];
+                q.add(quadrics[canonical[b]]);
+                candidates.push_back({a, b, q.error(&pos[b * 3])});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+            [](const CollapseCandidate& x, const CollapseCandidate& y) { return x.cost < y.cost; });
+
+        std::iota(collapseTo.begin(), collapseTo.end(), 0u);
+        std::fill(touched.begin(), touched.end(), false);
+        const size_t removeBudget = (result.size() - targetIndexCount) / 3;
+        size_t removed = 0;
+        size_t collapses = 0;
+
+        for (const CollapseCandidate& candidate : candidates) {
+            if (removed >= removeBudget || candidate.cost > errorLimit) {
+                break;
+            }
+            const uint32_t from = candidate.from;
+            const uint32_t to = candidate.to;
+            const uint32_t toCanonical = canonical[to];
+            if (touched[canonical[from]] || touched[toCanonical]) {
+                continue;
+            }
+
+            // Reject collapses that flip or fold a surviving triangle
+            bool flips = false;
+            size_t collapsedTriangles = 0;
+            for (uint32_t k = offsets[from]; k < offsets[from + 1] && !flips; ++k) {
+                const uint32_t* tri = &result[adjacency[k] * 3];
+                if (canonical[tri[0]] == toCanonical || canonical[tri[1]] == toCanonical ||
+                    canonical[tri[2]] == toCanonical) {
+                    collapsedTriangles++;
+                    continue;
+                }
+                const float* before[3];
+                const float* after[3];
+                for (int c = 0; c < 3; ++c) {
+                    before[c] = &pos[tri[c] * 3];
+                    after[c] = tri[c] == from ? &pos[to * 3] : before[c];
+                }
+                float n0[3], n1[3];
+                cross(before[0], before[1], before[2], n0);
+                cross(after[0], after[1], after[2], n1);
+                float dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+                float lengths = std::sqrt(n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) *
+                    std::sqrt(n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]);
+                flips = dot <= 0.25f * lengths;
+            }
+            if (flips) {
+                continue;
+            }
+
+            // Freeze the one-ring for the rest of this pass
+            for (uint32_t k = offsets[from]; k < offsets[from + 1]; ++k) {
+                const uint32_t* tri = &result[adjacency[k] * 3];
+                for (int c = 0; c < 3; ++c) {
+                    touched[canonical[tri[c]]] = true;
+                }
+            }
+
+            collapseTo[from] = to;
+            quadrics[toCanonical].add(quadrics[canonical[from]]);
+            maxError = std::max(maxError, candidate.cost);
+            removed += collapsedTriangles;
+            collapses++;
+        }
+
+        if (collapses == 0) {
+            break;
+        }
+
+        // Apply collapses and drop triangles that became degenerate
+        size_t written = 0;
+        for (size_t t = 0; t < currentTriangles; ++t) {
+            uint32_t i0 = collapseTo[result[t * 3 + 0]];
+            uint32_t i1 = collapseTo[result[t * 3 + 1]];
+            uint32_t i2 = collapseTo[result[t * 3 + 2]];
+            if (canonical[i0] == canonical[i1] || canonical[i1] == canonical[i2] ||
+                canonical[i0] == canonical[i2]) {
+                continue;
+            }
+            result[written++] = i0;
+            result[written++] = i1;
+            result[written++] = i2;
+        }
+        result.resize(written);
+    }
+
+    if (resultError) {
+        *resultError = static_cast<float>(std::sqrt(maxError));
+    }
+    std::copy(result.begin(), result.end(), destination);
+    return result.size();
+}
+// }}}
+
+// Meshlets {{{
+size_t meshletBound(size_t indexCount, size_t maxVertices, size_t maxTriangles) {
+    if (maxVertices < 3 || maxTriangles == 0) {
+        return 0;
+    }
+    // A meshlet is only closed for vertices once it holds at least
+    // maxVertices - 2 of them, each of which took at least one index
+    const size_t byVertices = (indexCount + maxVertices - 3) / (maxVertices - 2);
+    const size_t byTriangles = (indexCount / 3 + maxTriangles - 1) / maxTriangles;
+    return std::max(byVertices, byTriangles);
+}
+
+size_t buildMeshlets(
+    Meshlet* meshlets,
+    uint32_t* meshletVertices,
+    uint8_t* meshletTriangles,
+    const uint32_t* indices,
+    size_t indexCount,
+    const void* positions,
+    size_t positionStride,
+    size_t vertexCount,
+    size_t maxVertices,
+    size_t maxTriangles
+) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || maxVertices < 3 || maxVertices > 256 || maxTriangles == 0 ||
+        !indicesInRange(indices, triangleCount * 3, vertexCount)) {
+        return 0;
+    }
+
+    // Vertex -> triangle adjacency (CSR) and live triangle counts
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        liveCount[indices[i]]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    std::partial_sum(liveCount.begin(), liveCount.end(), offsets.begin() + 1);
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<float> centroids(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        float p0[3], p1[3], p2[3];
+        loadPosition(positions, positionStride, indices[t * 3 + 0], p0);
+        loadPosition(positions, positionStride, indices[t * 3 + 1], p1);
+        loadPosition(positions, positionStride, indices[t * 3 + 2], p2);
+        for (int c = 0; c < 3; ++c) {
+            centroids[t * 3 + c] = (p0[c] + p1[c] + p2[c]) / 3.0f;
+        }
+    }
+
+    // Position of each vertex in the open meshlet, -1 if not part of it
+    std::vector<int16_t> localIndex(vertexCount, -1);
+    std::vector<bool> emitted(triangleCount, false);
+
+    size_t meshletCount = 0;
+    Meshlet current{};
+    float centroidSum[3] = {0.0f, 0.0f, 0.0f};
+
+    auto newVertices = [&](size_t t) {
+        uint32_t count = 0;
+        for (int c = 0; c < 3; ++c) {
+            count += localIndex[indices[t * 3 + c]] < 0;
+        }
+        return count;
+    };
+
+    auto finish = [&]() {
+        if (current.triangleCount == 0) {
+            return;
+        }
+        computeMeshletBounds(current, meshletVertices, meshletTriangles, positions, positionStride);
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            localIndex[meshletVertices[current.vertexOffset + i]] = -1;
+        }
+        meshlets[meshletCount++] = current;
+
+        Meshlet next{};
+        next.vertexOffset = current.vertexOffset + current.vertexCount;
+        next.triangleOffset = current.triangleOffset + current.triangleCount * 3;
+        current = next;
+        centroidSum[0] = centroidSum[1] = centroidSum[2] = 0.0f;
+    };
+
+    auto append = [&](size_t t) {
+        emitted[t] = true;
+        uint8_t* triangle = meshletTriangles + current.triangleOffset + current.triangleCount * 3;
+        for (int c = 0; c < 3; ++c) {
+            uint32_t v = indices[t * 3 + c];
+            if (localIndex[v] < 0) {
+                localIndex[v] = static_cast<int16_t>(current.vertexCount);
+                meshletVertices[current.vertexOffset + current.vertexCount++] = v;
+            }
+            triangle[c] = static_cast<uint8_t>(localIndex[v]);
+            liveCount[v]--;
+        }
+        for (int c = 0; c < 3; ++c) {
+            centroidSum[c] += centroids[t * 3 + c];
+        }
+        current.triangleCount++;
+    };
+
+    // Candidates examined when the open meshlet has no adjacent triangles left
+    constexpr size_t searchWindow = 32;
+    size_t scanCursor = 0;
+
+    for (size_t remaining = triangleCount; remaining > 0; --remaining) {
+        // Adjacent triangle adding the fewest vertices; ties go to the one
+        // whose vertices have the fewest triangles left, finishing them off
+        int64_t best = -1;
+        uint32_t bestExtra = 4;
+        uint32_t bestLive = UINT32_MAX;
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            const uint32_t v = meshletVertices[current.vertexOffset + i];
+            if (liveCount[v] == 0) {
+                continue;
+            }
+            for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+                const uint32_t t = adjacency[k];
+                if (emitted[t]) {
+                    continue;
+                }
+                const uint32_t extra = newVertices(t);
+                const uint32_t live = liveCount[indices[t * 3 + 0]] +
+                    liveCount[indices[t * 3 + 1]] + liveCount[indices[t * 3 + 2]];
+                if (extra < bestExtra || (extra == bestExtra && live < bestLive)) {
+                    best = t;
+                    bestExtra = extra;
+                    bestLive = live;
+                }
+            }
+        }
+
+        if (best < 0) {
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            best = static_cast<int64_t>(scanCursor);
+            if (current.triangleCount > 0) {
+                float mean[3];
+                for (int c = 0; c < 3; ++c) {
+                    mean[c] = centroidSum[c] / static_cast<float>(current.triangleCount);
+                }
+                float bestDistance = std::numeric_limits<float>::max();
+                size_t checked = 0;
+                for (size_t t = scanCursor; t < triangleCount && checked < searchWindow; ++t) {
+                    if (emitted[t]) {
+                        continue;
+                    }
+                    ++checked;
+                    float d[3] = {
+                        centroids[t * 3 + 0] - mean[0],
+                        centroids[t * 3 + 1] - mean[1],
+                        centroids[t * 3 + 2] - mean[2],
+                    };
+                    float distance = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+                    if (distance < bestDistance) {
+                        best = static_cast<int64_t>(t);
+                        bestDistance = distance;
+                    }
+                }
+            }
+            bestExtra = newVertices(static_cast<size_t>(best));
+        }
+
+        if (current.vertexCount + bestExtra > maxVertices || current.triangleCount >= maxTriangles) {
+            finish();
+        }
+        append(static_cast<size_t>(best));
+    }
+    finish();
+
+    return meshletCount;
+}
+// }}}
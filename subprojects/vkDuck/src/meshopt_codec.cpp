@@ -0,0 +1,456 @@
+// vim:foldmethod=marker
+#include <vkDuck/meshopt_codec.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Internal helper functions {{{
+namespace {
+
+constexpr uint8_t kVertexHeader = 0xa0;
+constexpr uint8_t kIndexHeader = 0xe0;
+constexpr uint8_t kSequenceHeader = 0xd0;
+
+constexpr size_t kVertexBlockSizeBytes = 8192;
+constexpr size_t kVertexBlockMaxSize = 256;
+constexpr size_t kByteGroupSize = 16;
+constexpr size_t kByteGroupDecodeLimit = 24;  // Largest group: 8 packed bytes + 16 escapes
+constexpr size_t kTailMinSize = 32;
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("Malformed meshopt stream: ") + what);
+}
+
+// Vertex codec {{{
+/// Vertices per block: the block's bytes fit in 8 KB, rounded down to whole
+/// byte groups
+size_t vertexBlockSize(size_t stride) {
+    size_t result = (kVertexBlockSizeBytes / stride) & ~(kByteGroupSize - 1);
+    return result < kVertexBlockMaxSize ? result : kVertexBlockMaxSize;
+}
+
+uint8_t unzigzag8(uint8_t v) {
+    return static_cast<uint8_t>(-(v & 1) ^ (v >> 1));
+}
+
+/// Unpack 16 values of 0, 2, 4 or 8 bits. Packed values are stored
+/// most-significant first; the all-ones value escapes to a full byte that
+/// follows the packed bytes.
+const uint8_t* decodeBytesGroup(const uint8_t* data, uint8_t* out, int bitsLog2) {
+    switch (bitsLog2) {
+    case 0:
+        std::memset(out, 0, kByteGroupSize);
+        return data;
+    case 1:
+    case 2: {
+        const int bits = 1 << bitsLog2;
+        const uint8_t escape = static_cast<uint8_t>((1 << bits) - 1);
+        const size_t packedBytes = kByteGroupSize * bits / 8;
+        const uint8_t* escapes = data + packedBytes;
+        for (size_t i = 0; i < kByteGroupSize; ++i) {
+            const size_t bit = i * bits;
+            uint8_t value = static_cast<uint8_t>(
+                (data[bit / 8] >> (8 - bits - bit % 8)) & escape
+            );
+            if (value == escape) {
+                value = *escapes++;
+            }
+            out[i] = value;
+        }
+        return escapes;
+    }
+    default:
+        std::memcpy(out, data, kByteGroupSize);
+        return data + kByteGroupSize;
+    }
+}
+
+/// Decode `size` bytes (a multiple of 16): 2-bit group modes, four per
+/// header byte, followed by the groups
+const uint8_t* decodeBytes(const uint8_t* data, const uint8_t* end, uint8_t* out, size_t size) {
+    const size_t headerSize = (size / kByteGroupSize + 3) / 4;
+    if (static_cast<size_t>(end - data) < headerSize) {
+        malformed("truncated byte group header");
+    }
+    const uint8_t* header = data;
+    data += headerSize;
+
+    for (size_t i = 0; i < size; i += kByteGroupSize) {
+        // The stream tail guarantees this much slack for valid data
+        if (static_cast<size_t>(end - data) < kByteGroupDecodeLimit) {
+            malformed("truncated byte group");
+        }
+        const size_t group = i / kByteGroupSize;
+        const int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+        data = decodeBytesGroup(data, out + i, bitsLog2);
+    }
+    return data;
+}
+
+void decodeVertexBuffer(uint8_t* out, size_t count, size_t stride, std::span<const uint8_t> source) {
+    if (stride == 0 || stride > 256 || stride % 4 != 0) {
+        malformed("vertex stride must be a multiple of 4 up to 256");
+    }
+    const uint8_t* data = source.data();
+    const uint8_t* end = data + source.size();
+    if (source.size() < 1 + stride) {
+        malformed("truncated vertex stream");
+    }
+    if ((*data & 0xf0) != kVertexHeader || (*data & 0x0f) != 0) {
+        malformed("unsupported vertex codec version");
+    }
+    ++data;
+
+    // The stream ends with the first vertex, the baseline for the deltas
+    uint8_t lastVertex[256];
+    std::memcpy(lastVertex, end - stride, stride);
+
+    const size_t blockSize = vertexBlockSize(stride);
+    uint8_t deltas[kVertexBlockMaxSize];
+    for (size_t first = 0; first < count; first += blockSize) {
+        const size_t blockCount = std::min(blockSize, count - first);
+        const size_t alignedCount = (blockCount + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+        uint8_t* block = out + first * stride;
+
+        // Byte k of every vertex in the block is one delta channel
+        for (size_t k = 0; k < stride; ++k) {
+            data = decodeBytes(data, end, deltas, alignedCount);
+            uint8_t previous = lastVertex[k];
+            for (size_t i = 0; i < blockCount; ++i) {
+                previous = static_cast<uint8_t>(previous + unzigzag8(deltas[i]));
+                block[i * stride + k] = previous;
+            }
+        }
+        std::memcpy(lastVertex, block + (blockCount - 1) * stride, stride);
+    }
+
+    const size_t tailSize = stride < kTailMinSize ? kTailMinSize : stride;
+    if (static_cast<size_t>(end - data) != tailSize) {
+        malformed("unexpected vertex stream size");
+    }
+}
+// }}}
+
+// Index codecs {{{
+uint32_t decodeVByte(const uint8_t*& data) {
+    uint8_t lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+
+    // At most 4 more groups, so malformed data cannot run on
+    uint32_t result = lead & 127;
+    uint32_t shift = 7;
+    for (int i = 0; i < 4; ++i) {
+        uint8_t group = *data++;
+        result |= static_cast<uint32_t>(group & 127) << shift;
+        shift += 7;
+        if (group < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+uint32_t decodeIndex(const uint8_t*& data, uint32_t last) {
+    uint32_t v = decodeVByte(data);
+    uint32_t delta = (v >> 1) ^ (0u - (v & 1));
+    return last + delta;
+}
+
+void writeIndex(void* out, size_t i, size_t stride, uint32_t index) {
+    if (stride == 2) {
+        static_cast<uint16_t*>(out)[i] = static_cast<uint16_t>(index);
+    } else {
+        static_cast<uint32_t*>(out)[i] = index;
+    }
+}
+
+/// Triangle list codec. Each triangle is one code byte: either an edge from
+/// a 16-entry edge FIFO plus a third vertex (new, from a 16-entry vertex FIFO
+/// or a free delta-coded index), or three vertices coded through a 16-byte
+/// lookup table stored at the end of the stream. Every FIFO push mirrors the
+/// encoder exactly.
+void decodeIndexBuffer(void* out, size_t count, size_t stride, std::span<const uint8_t> source) {
+    if (count % 3 != 0) {
+        malformed("triangle index count is not a multiple of 3");
+    }
+    if (source.size() < 1 + count / 3 + 16) {
+        malformed("truncated triangle stream");
+    }
+    const uint8_t* buffer = source.data();
+    const int version = buffer[0] & 0x0f;
+    if ((buffer[0] & 0xf0) != kIndexHeader || version > 1) {
+        malformed("unsupported index codec version");
+    }
+
+    uint32_t edgeFifo[16][2];
+    uint32_t vertexFifo[16];
+    std::memset(edgeFifo, -1, sizeof(edgeFifo));
+    std::memset(vertexFifo, -1, sizeof(vertexFifo));
+    size_t edgeOffset = 0;
+    size_t vertexOffset = 0;
+
+    auto pushEdge = [&](uint32_t a, uint32_t b) {
+        edgeFifo[edgeOffset][0] = a;
+        edgeFifo[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    };
+    auto pushVertex = [&](uint32_t v, bool condition = true) {
+        vertexFifo[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (condition ? 1 : 0)) & 15;
+    };
+    auto writeTriangle = [&](size_t i, uint32_t a, uint32_t b, uint32_t c) {
+        writeIndex(out, i + 0, stride, a);
+        writeIndex(out, i + 1, stride, b);
+        writeIndex(out, i + 2, stride, c);
+    };
+
+    uint32_t next = 0;
+    uint32_t last = 0;
+    // Version 1 codes last-1 and last+1 free indices as 13 and 14
+    const int fecMax = version >= 1 ? 13 : 15;
+
+    const uint8_t* code = buffer + 1;
+    const uint8_t* data = code + count / 3;
+    const uint8_t* dataSafeEnd = buffer + source.size() - 16;
+    const uint8_t* codeAuxTable = dataSafeEnd;
+
+    for (size_t i = 0; i < count; i += 3) {
+        // A triangle reads at most 16 data bytes, which the table pads
+        if (data > dataSafeEnd) {
+            malformed("truncated triangle data");
+        }
+
+        const uint8_t codeTri = *code++;
+        if (codeTri < 0xf0) {
+            const int fe = codeTri >> 4;
+            const uint32_t a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+            const uint32_t b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+            const int fec = codeTri & 15;
+
+            if (fec < fecMax) {
+                const bool isNext = fec == 0;
+                const uint32_t c = isNext ? next : vertexFifo[(vertexOffset - 1 - fec) & 15];
+                next += isNext ? 1 : 0;
+
+                writeTriangle(i, a, b, c);
+                pushVertex(c, isNext);
+                pushEdge(c, b);
+                pushEdge(a, c);
+            } else {
+                // 13 and 14 decode to -1 and +1
+                const uint32_t c = fec != 15 ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
+                last = c;
+
+                writeTriangle(i, a, b, c);
+                pushVertex(c);
+                pushEdge(c, b);
+                pushEdge(a, c);
+            }
+        } else if (codeTri < 0xfe) {
+            // Table path; next is advanced for each vertex in order, as when encoding
+            const uint8_t codeAux = codeAuxTable[codeTri & 15];
+            const int feb = codeAux >> 4;
+            const int fec = codeAux & 15;
+
+            const uint32_t a = next++;
+            const uint32_t b = feb == 0 ? next : vertexFifo[(vertexOffset - feb) & 15];
+            next += feb == 0 ? 1 : 0;
+            const uint32_t c = fec == 0 ? next : vertexFifo[(vertexOffset - fec) & 15];
+            next += fec == 0 ? 1 : 0;
+
+            writeTriangle(i, a, b, c);
+            pushVertex(a);
+            pushVertex(b, feb == 0);
+            pushVertex(c, fec == 0);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        } else {
+            // Full code byte; 0 resets the running index
+            const uint8_t codeAux = *data++;
+            const int fea = codeTri == 0xfe ? 0 : 15;
+            const int feb = codeAux >> 4;
+            const int fec = codeAux & 15;
+            if (codeAux == 0) {
+                next = 0;
+            }
+
+            uint32_t a = fea == 0 ? next++ : 0;
+            uint32_t b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+            uint32_t c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+
+            if (fea == 15) {
+                last = a = decodeIndex(data, last);
+            }
+            if (feb == 15) {
+                last = b = decodeIndex(data, last);
+            }
+            if (fec == 15) {
+                last = c = decodeIndex(data, last);
+            }
+
+            writeTriangle(i, a, b, c);
+            pushVertex(a);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+    }
+
+    if (data != dataSafeEnd) {
+        malformed("unexpected triangle stream size");
+    }
+}
+
+/// Index sequence codec: each index is a zigzag varint delta against one of
+/// two running baselines, selected by the low bit
+void decodeIndexSequence(void* out, size_t count, size_t stride, std::span<const uint8_t> source) {
+    if (source.size() < 1 + count + 4) {
+        malformed("truncated index sequence");
+    }
+    const uint8_t* buffer = source.data();
+    if ((buffer[0] & 0xf0) != kSequenceHeader || (buffer[0] & 0x0f) > 1) {
+        malformed("unsupported index sequence version");
+    }
+
+    const uint8_t* data = buffer + 1;
+    const uint8_t* dataSafeEnd = buffer + source.size() - 4;
+    uint32_t last[2] = {0, 0};
+
+    for (size_t i = 0; i < count; ++i) {
+        // An index reads at most 5 bytes, which the 4-byte tail pads
+        if (data >= dataSafeEnd) {
+            malformed("truncated index sequence data");
+        }
+
+        uint32_t v = decodeVByte(data);
+        const uint32_t baseline = v & 1;
+        v >>= 1;
+        const uint32_t index = last[baseline] + ((v >> 1) ^ (0u - (v & 1)));
+        last[baseline] = index;
+        writeIndex(out, i, stride, index);
+    }
+
+    if (data != dataSafeEnd) {
+        malformed("unexpected index sequence size");
+    }
+}
+// }}}
+
+// Filters {{{
+template <typename T>
+void filterOctahedral(T* data, size_t count) {
+    const float max = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+    for (size_t i = 0; i < count; ++i) {
+        // z is stored as the quantized 1.0, so this reconstructs it in scale
+        float x = static_cast<float>(data[i * 4 + 0]);
+        float y = static_cast<float>(data[i * 4 + 1]);
+        float z = static_cast<float>(data[i * 4 + 2]) - std::fabs(x) - std::fabs(y);
+
+        // Unfold the lower hemisphere
+        const float t = z >= 0.0f ? 0.0f : z;
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        const float s = max / std::sqrt(x * x + y * y + z * z);
+        data[i * 4 + 0] = static_cast<T>(static_cast<int>(x * s + (x >= 0.0f ? 0.5f : -0.5f)));
+        data[i * 4 + 1] = static_cast<T>(static_cast<int>(y * s + (y >= 0.0f ? 0.5f : -0.5f)));
+        data[i * 4 + 2] = static_cast<T>(static_cast<int>(z * s + (z >= 0.0f ? 0.5f : -0.5f)));
+    }
+}
+
+void filterQuaternion(int16_t* data, size_t count) {
+    const float scale = 1.0f / std::sqrt(2.0f);
+    for (size_t i = 0; i < count; ++i) {
+        // The fourth component holds the quantized 1.0 and, in its low two
+        // bits, which component was dropped
+        const int sf = data[i * 4 + 3] | 3;
+        const float ss = scale / static_cast<float>(sf);
+
+        const float x = static_cast<float>(data[i * 4 + 0]) * ss;
+        const float y = static_cast<float>(data[i * 4 + 1]) * ss;
+        const float z = static_cast<float>(data[i * 4 + 2]) * ss;
+        const float ww = 1.0f - x * x - y * y - z * z;
+        const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+        const int qc = data[i * 4 + 3] & 3;
+        data[i * 4 + ((qc + 1) & 3)] = static_cast<int16_t>(x * 32767.0f + (x >= 0.0f ? 0.5f : -0.5f));
+        data[i * 4 + ((qc + 2) & 3)] = static_cast<int16_t>(y * 32767.0f + (y >= 0.0f ? 0.5f : -0.5f));
+        data[i * 4 + ((qc + 3) & 3)] = static_cast<int16_t>(z * 32767.0f + (z >= 0.0f ? 0.5f : -0.5f));
+        data[i * 4 + ((qc + 0) & 3)] = static_cast<int16_t>(w * 32767.0f + 0.5f);
+    }
+}
+
+void filterExponential(uint32_t* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Signed 24-bit mantissa, signed 8-bit exponent: m * 2^e
+        const int32_t m = static_cast<int32_t>(data[i] << 8) >> 8;
+        const int32_t e = static_cast<int32_t>(data[i]) >> 24;
+        const float value = std::ldexp(static_cast<float>(m), e);
+        std::memcpy(&data[i], &value, sizeof(value));
+    }
+}
+// }}}
+
+} // anonymous namespace
+// }}}
+
+// Stream decoding {{{
+void decodeMeshoptStream(
+    void* destination,
+    size_t count,
+    size_t stride,
+    std::span<const uint8_t> source,
+    MeshoptMode mode,
+    MeshoptFilter filter
+) {
+    switch (mode) {
+    case MeshoptMode::Attributes:
+        decodeVertexBuffer(static_cast<uint8_t*>(destination), count, stride, source);
+        break;
+    case MeshoptMode::Triangles:
+    case MeshoptMode::Indices:
+        if (stride != 2 && stride != 4) {
+            malformed("index stride must be 2 or 4");
+        }
+        if (mode == MeshoptMode::Triangles) {
+            decodeIndexBuffer(destination, count, stride, source);
+        } else {
+            decodeIndexSequence(destination, count, stride, source);
+        }
+        break;
+    }
+
+    switch (filter) {
+    case MeshoptFilter::None:
+        break;
+    case MeshoptFilter::Octahedral:
+        if (stride == 4) {
+            filterOctahedral(static_cast<int8_t*>(destination), count);
+        } else if (stride == 8) {
+            filterOctahedral(static_cast<int16_t*>(destination), count);
+        } else {
+            malformed("octahedral filter needs a stride of 4 or 8");
+        }
+        break;
+    case MeshoptFilter::Quaternion:
+        if (stride != 8) {
+            malformed("quaternion filter needs a stride of 8");
+        }
+        filterQuaternion(static_cast<int16_t*>(destination), count);
+        break;
+    case MeshoptFilter::Exponential:
+        if (stride % 4 != 0) {
+            malformed("exponential filter needs a stride that is a multiple of 4");
+        }
+        filterExponential(static_cast<uint32_t*>(destination), count * stride / 4);
+        break;
+    }
+}
+// }}}
@@ -1,5 +1,11 @@
 // vim:foldmethod=marker
 #include <vkDuck/model_loader.h>
+#include <vkDuck/job_system.h>
+#include <vkDuck/mesh_cache.h>
+#include <vkDuck/mapped_file.h>
+#include <vkDuck/mesh_optimizer.h>
+#include <vkDuck/meshopt_codec.h>
+#include <vkDuck/simd_kernels.h>
 
 #define TINYGLTF_IMPLEMENTATION
 #define TINYGLTF_NO_STB_IMAGE
@@ -12,114 +18,23 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <charconv>
 #include <chrono>
+#include <cmath>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <stdexcept>
 #include <unordered_map>
-#include <future>
-
-// SIMD headers for optimized index conversion
-#if defined(__ARM_NEON) || defined(__ARM_NEON__)
-#include <arm_neon.h>
-#define USE_NEON 1
-#elif defined(__SSE4_1__)
-#include <smmintrin.h>
-#define USE_SSE 1
-#endif
+#include <unordered_set>
 
 // Internal helper functions {{{
 namespace {
 
 namespace fs = std::filesystem;
 
-// SIMD-optimized index conversion for better throughput {{{
-static inline void convertIndices16to32(
-    const uint16_t* __restrict src,
-    uint32_t* __restrict dst,
-    size_t count
-) {
-#if defined(USE_NEON)
-    // ARM NEON: process 8 indices at a time
-    size_t simdCount = count / 8;
-    for (size_t i = 0; i < simdCount; ++i) {
-        uint16x8_t in = vld1q_u16(src + i * 8);
-        uint32x4_t lo = vmovl_u16(vget_low_u16(in));
-        uint32x4_t hi = vmovl_u16(vget_high_u16(in));
-        vst1q_u32(dst + i * 8, lo);
-        vst1q_u32(dst + i * 8 + 4, hi);
-    }
-    for (size_t i = simdCount * 8; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#elif defined(USE_SSE)
-    // SSE4.1: process 8 indices at a time
-    size_t simdCount = count / 8;
-    for (size_t i = 0; i < simdCount; ++i) {
-        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8));
-        __m128i lo = _mm_cvtepu16_epi32(in);
-        __m128i hi = _mm_cvtepu16_epi32(_mm_srli_si128(in, 8));
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 8), lo);
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 8 + 4), hi);
-    }
-    for (size_t i = simdCount * 8; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#else
-    // Fallback: compiler will auto-vectorize this simple loop
-    for (size_t i = 0; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#endif
-}
-
-static inline void convertIndices8to32(
-    const uint8_t* __restrict src,
-    uint32_t* __restrict dst,
-    size_t count
-) {
-#if defined(USE_NEON)
-    // ARM NEON: process 16 indices at a time
-    size_t simdCount = count / 16;
-    for (size_t i = 0; i < simdCount; ++i) {
-        uint8x16_t in = vld1q_u8(src + i * 16);
-        uint16x8_t mid_lo = vmovl_u8(vget_low_u8(in));
-        uint16x8_t mid_hi = vmovl_u8(vget_high_u8(in));
-        vst1q_u32(dst + i * 16, vmovl_u16(vget_low_u16(mid_lo)));
-        vst1q_u32(dst + i * 16 + 4, vmovl_u16(vget_high_u16(mid_lo)));
-        vst1q_u32(dst + i * 16 + 8, vmovl_u16(vget_low_u16(mid_hi)));
-        vst1q_u32(dst + i * 16 + 12, vmovl_u16(vget_high_u16(mid_hi)));
-    }
-    for (size_t i = simdCount * 16; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#elif defined(USE_SSE)
-    // SSE4.1: process 16 indices at a time
-    size_t simdCount = count / 16;
-    for (size_t i = 0; i < simdCount; ++i) {
-        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 16));
-        __m128i a = _mm_cvtepu8_epi32(in);
-        __m128i b = _mm_cvtepu8_epi32(_mm_srli_si128(in, 4));
-        __m128i c = _mm_cvtepu8_epi32(_mm_srli_si128(in, 8));
-        __m128i d = _mm_cvtepu8_epi32(_mm_srli_si128(in, 12));
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16), a);
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16 + 4), b);
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16 + 8), c);
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 16 + 12), d);
-    }
-    for (size_t i = simdCount * 16; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#else
-    // Fallback: compiler will auto-vectorize this simple loop
-    for (size_t i = 0; i < count; ++i) {
-        dst[i] = src[i];
-    }
-#endif
-}
-// }}}
-
 // Texture path resolution {{{
 /// Try multiple paths to find the texture (all project-relative)
 static fs::path findTexturePath(
@@ -171,24 +86,28 @@ static std::vector<fs::path> findTexturePathsBatch(
         return resolvedPaths;
     }
 
-    // Resolve paths in parallel for larger batches
-    std::vector<std::future<std::pair<size_t, fs::path>>> futures;
-    futures.reserve(texturesToResolve.size());
+    // Resolve paths in parallel for larger batches; the checks block on the
+    // filesystem, so they run in the I/O lane
+    jobSystem().parallelFor(texturesToResolve.size(), [&](size_t i) {
+        const auto& [index, uri] = texturesToResolve[i];
+        resolvedPaths[index] = findTexturePath(parentPath, projectRoot, uri);
+    }, JobLane::Io);
 
-    for (const auto& [index, uri] : texturesToResolve) {
-        futures.push_back(std::async(std::launch::async,
-            [&parentPath, &projectRoot, index, uri]() {
-                return std::make_pair(index, findTexturePath(parentPath, projectRoot, uri));
-            }
-        ));
-    }
+    return resolvedPaths;
+}
 
-    for (auto& future : futures) {
-        auto [index, path] = future.get();
-        resolvedPaths[index] = std::move(path);
+/// Image index of a glTF texture. `source` is preferred; a texture that only
+/// names a KTX2 image through KHR_texture_basisu uses that image, which
+/// loads if it is not Basis-supercompressed (see texture_container.h).
+static int textureImageIndex(const tinygltf::Texture& tex) {
+    if (tex.source >= 0) {
+        return tex.source;
     }
-
-    return resolvedPaths;
+    auto basisu = tex.extensions.find("KHR_texture_basisu");
+    if (basisu != tex.extensions.end() && basisu->second.Has("source")) {
+        return basisu->second.Get("source").GetNumberAsInt();
+    }
+    return -1;
 }
 // }}}
 
@@ -220,216 +139,556 @@ glm::mat4 getNodeTransform(const tinygltf::Node& node) {
     return transform;
 }
 
-struct TempGeometry {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    int materialIndex;
+// Two-phase primitive decoding {{{
+/// A single primitive instance found while walking the scene graph
+struct PrimitiveWorkItem {
+    int meshIndex;
+    int primitiveIndex;
+    glm::mat4 worldTransform;    // Baked into the decoded vertices
+    int32_t node;                // Into ModelData::nodes, -1 when instanced
 };
 
-void processNode(
-    tinygltf::Model& model,
+/// Walk the node tree depth-first, appending every node to `nodes` and
+/// recording every primitive to decode, in scene order.
+/// The order of the work items defines the order of the resulting ranges.
+/// `rootTransform` is folded into the local transform of a root (parent -1),
+/// e.g. the ancestors of a selected subtree.
+void collectPrimitives(
+    const tinygltf::Model& model,
     int nodeIndex,
-    const glm::mat4& parentTransform,
-    std::vector<TempGeometry>& geometries
+    int32_t parent,
+    std::vector<SceneNode>& nodes,
+    std::vector<PrimitiveWorkItem>& workItems,
+    const glm::mat4& rootTransform = glm::mat4(1.0f)
 ) {
     if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= model.nodes.size())
         return;
 
     const tinygltf::Node& node = model.nodes[nodeIndex];
-    glm::mat4 localTransform = getNodeTransform(node);
-    glm::mat4 worldTransform = parentTransform * localTransform;
+    const int32_t sceneNode = static_cast<int32_t>(nodes.size());
+    {
+        SceneNode& out = nodes.emplace_back();
+        out.name = node.name.empty() ? "Node " + std::to_string(nodeIndex) : node.name;
+        out.parent = parent;
+        out.localTransform = parent >= 0
+            ? getNodeTransform(node)
+            : rootTransform * getNodeTransform(node);
+        out.worldTransform = parent >= 0
+            ? nodes[parent].worldTransform * out.localTransform
+            : out.localTransform;
+    }
 
     if (node.mesh >= 0 && static_cast<size_t>(node.mesh) < model.meshes.size()) {
         const auto& mesh = model.meshes[node.mesh];
+        for (size_t p = 0; p < mesh.primitives.size(); ++p) {
+            workItems.push_back({
+                node.mesh, static_cast<int>(p), nodes[sceneNode].worldTransform, sceneNode
+            });
+        }
+    }
 
-        for (const auto& primitive : mesh.primitives) {
-            TempGeometry geometry{};
-            geometry.materialIndex = primitive.material;
+    for (int child : node.children) {
+        collectPrimitives(model, child, sceneNode, nodes, workItems);
+    }
+}
 
-            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(worldTransform)));
+/// Bytes of every model buffer: tinygltf's copies, or views into the mapped
+/// files for buffers left out of parsing (see parseGltf())
+using BufferBytes = std::vector<std::span<const uint8_t>>;
+
+/// First byte of an accessor's data. Throws unless its buffer view lies
+/// inside its buffer and all `count` strided elements lie inside the view;
+/// mapped buffers don't get checked for either by tinygltf.
+const uint8_t* accessorData(
+    const tinygltf::Model& model,
+    const BufferBytes& buffers,
+    const tinygltf::Accessor& accessor
+) {
+    if (accessor.bufferView < 0 ||
+        static_cast<size_t>(accessor.bufferView) >= model.bufferViews.size()) {
+        throw std::runtime_error("Accessor without a valid bufferView");
+    }
+    const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
+    if (view.buffer < 0 || static_cast<size_t>(view.buffer) >= buffers.size() ||
+        view.byteOffset > buffers[view.buffer].size() ||
+        view.byteLength > buffers[view.buffer].size() - view.byteOffset ||
+        accessor.byteOffset > view.byteLength) {
+        throw std::runtime_error("Accessor bufferView out of range");
+    }
 
-            if (primitive.attributes.find("POSITION") == primitive.attributes.end()) {
-                continue;
-            }
+    // The last element must end inside the view:
+    // byteOffset + (count - 1) * stride + elementSize <= view.byteLength
+    const int componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+    const int components = tinygltf::GetNumComponentsInType(accessor.type);
+    const int stride = accessor.ByteStride(view);
+    if (componentSize <= 0 || components <= 0 || stride <= 0) {
+        throw std::runtime_error("Accessor with an invalid type or stride");
+    }
+    if (accessor.count > 0) {
+        const size_t elementSize = static_cast<size_t>(componentSize) * components;
+        const size_t available = view.byteLength - accessor.byteOffset;
+        if (elementSize > available ||
+            (accessor.count - 1) > (available - elementSize) / static_cast<size_t>(stride)) {
+            throw std::runtime_error("Accessor overruns its bufferView");
+        }
+    }
+    return buffers[view.buffer].data() + view.byteOffset + accessor.byteOffset;
+}
 
-            const tinygltf::Accessor& posAccessor =
-                model.accessors[primitive.attributes.at("POSITION")];
+/// Strided float data of one vertex attribute
+struct FloatAttribute {
+    const uint8_t* data{nullptr};
+    size_t stride{0};
+};
 
-            const tinygltf::Accessor* normalAccessor = nullptr;
-            bool hasNormals = primitive.attributes.find("NORMAL") != primitive.attributes.end();
-            if (hasNormals) {
-                normalAccessor = &model.accessors[primitive.attributes.at("NORMAL")];
-            }
+/// Read an attribute as floats. FLOAT accessors are returned in place; the
+/// 8/16-bit (normalized or integer) accessors allowed by KHR_mesh_quantization
+/// are dequantized into `scratch`.
+FloatAttribute readFloatAttribute(
+    const tinygltf::Model& model,
+    const BufferBytes& buffers,
+    const tinygltf::Accessor& accessor,
+    std::vector<float>& scratch
+) {
+    const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
+    const uint8_t* data = accessorData(model, buffers, accessor);
+    const int stride = accessor.ByteStride(bufferView);
+    if (stride <= 0) {
+        throw std::runtime_error("Invalid vertex attribute accessor");
+    }
 
-            bool hasTexCoords = primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end();
-            const tinygltf::Accessor* texCoordAccessor = nullptr;
-            if (hasTexCoords) {
-                texCoordAccessor = &model.accessors[primitive.attributes.at("TEXCOORD_0")];
-            }
+    if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT) {
+        return {data, static_cast<size_t>(stride)};
+    }
 
-            bool hasTangents = primitive.attributes.find("TANGENT") != primitive.attributes.end();
-            const tinygltf::Accessor* tangentAccessor = nullptr;
-            if (hasTangents) {
-                tangentAccessor = &model.accessors[primitive.attributes.at("TANGENT")];
+    const size_t components = static_cast<size_t>(tinygltf::GetNumComponentsInType(accessor.type));
+    scratch.resize(accessor.count * components);
+
+    // Normalized values map to [-1, 1] or [0, 1] as in the glTF spec
+    const bool normalized = accessor.normalized;
+    auto dequantize = [&]<typename T>(float scale) {
+        for (size_t i = 0; i < accessor.count; ++i) {
+            const uint8_t* element = data + i * stride;
+            for (size_t c = 0; c < components; ++c) {
+                T value;
+                std::memcpy(&value, element + c * sizeof(T), sizeof(T));
+                const float f = static_cast<float>(value) * scale;
+                scratch[i * components + c] = normalized ? std::max(f, -1.0f) : f;
             }
+        }
+    };
 
-            bool hasColors = primitive.attributes.find("COLOR_0") != primitive.attributes.end();
-            const tinygltf::Accessor* colorAccessor = nullptr;
-            if (hasColors) {
-                colorAccessor = &model.accessors[primitive.attributes.at("COLOR_0")];
-            }
+    switch (accessor.componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+        dequantize.operator()<int8_t>(normalized ? 1.0f / 127.0f : 1.0f);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        dequantize.operator()<uint8_t>(normalized ? 1.0f / 255.0f : 1.0f);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+        dequantize.operator()<int16_t>(normalized ? 1.0f / 32767.0f : 1.0f);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        dequantize.operator()<uint16_t>(normalized ? 1.0f / 65535.0f : 1.0f);
+        break;
+    default:
+        throw std::runtime_error("Unsupported vertex attribute component type");
+    }
+    return {reinterpret_cast<const uint8_t*>(scratch.data()), components * sizeof(float)};
+}
 
-            const tinygltf::BufferView& posBufferView = model.bufferViews[posAccessor.bufferView];
-            const tinygltf::BufferView* normalBufferView = nullptr;
-            const tinygltf::BufferView* texCoordBufferView = nullptr;
-            const tinygltf::BufferView* colorBufferView = nullptr;
-            const tinygltf::BufferView* tangentBufferView = nullptr;
+/// Vertex and index counts of a primitive, read from the accessors only
+struct PrimitiveSize {
+    size_t vertexCount;
+    size_t indexCount;
+};
 
-            if (hasNormals) {
-                normalBufferView = &model.bufferViews[normalAccessor->bufferView];
-            }
-            if (hasTexCoords) {
-                texCoordBufferView = &model.bufferViews[texCoordAccessor->bufferView];
-            }
-            if (hasColors) {
-                colorBufferView = &model.bufferViews[colorAccessor->bufferView];
-            }
-            if (hasTangents) {
-                tangentBufferView = &model.bufferViews[tangentAccessor->bufferView];
-            }
+/// Size a primitive without touching its buffer data.
+/// Primitives without POSITION report zero vertices and are skipped.
+PrimitiveSize measurePrimitive(
+    const tinygltf::Model& model,
+    const PrimitiveWorkItem& item
+) {
+    const auto& primitive = model.meshes[item.meshIndex].primitives[item.primitiveIndex];
 
-            const tinygltf::Buffer& posBuffer = model.buffers[posBufferView.buffer];
-            const tinygltf::Buffer* normalBuffer = nullptr;
-            const tinygltf::Buffer* texCoordBuffer = nullptr;
-            const tinygltf::Buffer* colorBuffer = nullptr;
-            const tinygltf::Buffer* tangentBuffer = nullptr;
+    auto posIt = primitive.attributes.find("POSITION");
+    if (posIt == primitive.attributes.end()) {
+        return {0, 0};
+    }
 
-            if (hasNormals) {
-                normalBuffer = &model.buffers[normalBufferView->buffer];
-            }
-            if (hasTexCoords) {
-                texCoordBuffer = &model.buffers[texCoordBufferView->buffer];
-            }
-            if (hasColors) {
-                colorBuffer = &model.buffers[colorBufferView->buffer];
-            }
-            if (hasTangents) {
-                tangentBuffer = &model.buffers[tangentBufferView->buffer];
-            }
+    PrimitiveSize size{model.accessors[posIt->second].count, 0};
+    if (primitive.indices >= 0) {
+        size.indexCount = model.accessors[primitive.indices].count;
+    }
+    return size;
+}
+
+/// Decode and transform one primitive straight into its slot of the
+/// consolidated arrays and compute its bounds into `range`.
+/// `outVertices`/`outIndices` must have room for the counts reported by
+/// measurePrimitive(); indices are written as uint16_t or uint32_t following
+/// range.indexType. Only reads from `model`, so it is safe to call
+/// concurrently.
+void decodePrimitive(
+    const tinygltf::Model& model,
+    const BufferBytes& buffers,
+    const PrimitiveWorkItem& item,
+    Vertex* outVertices,
+    void* outIndices,
+    GeometryRange& range
+) {
+    const auto& primitive = model.meshes[item.meshIndex].primitives[item.primitiveIndex];
+    const glm::mat4& worldTransform = item.worldTransform;
+
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(worldTransform)));
+
+    if (primitive.attributes.find("POSITION") == primitive.attributes.end()) {
+        return;
+    }
+
+    const tinygltf::Accessor& posAccessor =
+        model.accessors[primitive.attributes.at("POSITION")];
+
+    const tinygltf::Accessor* normalAccessor = nullptr;
+    bool hasNormals = primitive.attributes.find("NORMAL") != primitive.attributes.end();
+    if (hasNormals) {
+        normalAccessor = &model.accessors[primitive.attributes.at("NORMAL")];
+    }
+
+    bool hasTexCoords = primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end();
+    const tinygltf::Accessor* texCoordAccessor = nullptr;
+    if (hasTexCoords) {
+        texCoordAccessor = &model.accessors[primitive.attributes.at("TEXCOORD_0")];
+    }
+
+    bool hasTangents = primitive.attributes.find("TANGENT") != primitive.attributes.end();
+    const tinygltf::Accessor* tangentAccessor = nullptr;
+    if (hasTangents) {
+        tangentAccessor = &model.accessors[primitive.attributes.at("TANGENT")];
+    }
+
+    bool hasColors = primitive.attributes.find("COLOR_0") != primitive.attributes.end();
+    const tinygltf::Accessor* colorAccessor = nullptr;
+    if (hasColors) {
+        colorAccessor = &model.accessors[primitive.attributes.at("COLOR_0")];
+    }
+
+    // KHR_mesh_quantization accessors are dequantized to float, so the
+    // kernels below only ever see float attributes
+    std::vector<float> posScratch, normalScratch, texCoordScratch, colorScratch, tangentScratch;
+    const FloatAttribute pos = readFloatAttribute(model, buffers, posAccessor, posScratch);
+    FloatAttribute normal, texCoord, color, tangent;
+    if (hasNormals) {
+        normal = readFloatAttribute(model, buffers, *normalAccessor, normalScratch);
+    }
+    if (hasTexCoords) {
+        texCoord = readFloatAttribute(model, buffers, *texCoordAccessor, texCoordScratch);
+    }
+    if (hasColors) {
+        // COLOR_0 can be VEC3 or VEC4; only rgb is read
+        color = readFloatAttribute(model, buffers, *colorAccessor, colorScratch);
+    }
+    if (hasTangents) {
+        tangent = readFloatAttribute(model, buffers, *tangentAccessor, tangentScratch);
+    }
+
+    const uint8_t* posData = pos.data;
+    const uint8_t* normalData = normal.data;
+    const uint8_t* texCoordData = texCoord.data;
+    const uint8_t* colorData = color.data;
+    const uint8_t* tangentData = tangent.data;
+    const size_t posStride = pos.stride;
+    const size_t normalStride = normal.stride;
+    const size_t texCoordStride = texCoord.stride;
+    const size_t colorStride = color.stride;
+    const size_t tangentStride = tangent.stride;
+
+    // glTF vertices are already deduplicated, so the accessor count is final
+    const size_t vertexCount = posAccessor.count;
+    for (const tinygltf::Accessor* attribute :
+         {normalAccessor, texCoordAccessor, colorAccessor, tangentAccessor}) {
+        if (attribute && attribute->count < vertexCount) {
+            throw std::runtime_error("Vertex attribute accessor shorter than POSITION");
+        }
+    }
+
+    const simd::KernelTable& kernels = simd::kernels();
 
-            size_t posStride = posBufferView.byteStride ? posBufferView.byteStride : sizeof(float) * 3;
-            size_t normalStride = (hasNormals && normalBufferView->byteStride)
-                ? normalBufferView->byteStride : sizeof(float) * 3;
-            size_t texCoordStride = (hasTexCoords && texCoordBufferView->byteStride)
-                ? texCoordBufferView->byteStride : sizeof(float) * 2;
-            // COLOR_0 can be VEC3 or VEC4, default to VEC4 stride
-            size_t colorStride = (hasColors && colorBufferView->byteStride)
-                ? colorBufferView->byteStride : sizeof(float) * 4;
-            size_t tangentStride = (hasTangents && tangentBufferView->byteStride)
-                ? tangentBufferView->byteStride : sizeof(float) * 4;
+    // Positions, normals and tangents go through the batched SIMD kernels,
+    // which write straight into the interleaved vertices
+    kernels.transformPositions(
+        posData, posStride, glm::value_ptr(worldTransform),
+        &outVertices[0].pos, sizeof(Vertex), vertexCount
+    );
+    if (hasNormals) {
+        kernels.transformDirections(
+            normalData, normalStride, glm::value_ptr(normalMatrix),
+            &outVertices[0].normal, sizeof(Vertex), vertexCount
+        );
+    }
+    if (hasTangents) {
+        kernels.transformDirections(
+            tangentData, tangentStride, glm::value_ptr(normalMatrix),
+            &outVertices[0].tangent, sizeof(Vertex), vertexCount
+        );
+    }
+
+    // Remaining attributes and defaults in a single pass
+    for (size_t i = 0; i < vertexCount; ++i) {
+        Vertex& vertex = outVertices[i];
+
+        if (!hasNormals) {
+            vertex.normal = {0.0f, 0.0f, 1.0f};
+        }
+
+        if (hasTexCoords) {
+            const float* tex = reinterpret_cast<const float*>(texCoordData + i * texCoordStride);
+            vertex.texCoord = {tex[0], tex[1]};
+        } else {
+            vertex.texCoord = {0.0f, 0.0f};
+        }
+
+        if (hasColors) {
+            const float* col = reinterpret_cast<const float*>(colorData + i * colorStride);
+            vertex.color = {col[0], col[1], col[2]};
+        } else {
+            vertex.color = {1.0f, 1.0f, 1.0f};  // Default white
+        }
+
+        if (hasTangents) {
+            // xyz was transformed above, keep the handedness
+            const float* tan = reinterpret_cast<const float*>(tangentData + i * tangentStride);
+            vertex.tangent.w = tan[3];
+        } else {
+            // Default tangent pointing along +X axis with positive handedness
+            vertex.tangent = {1.0f, 0.0f, 0.0f, 1.0f};
+        }
+    }
 
-            const uint8_t* posData = &posBuffer.data[posBufferView.byteOffset + posAccessor.byteOffset];
-            const uint8_t* normalData = nullptr;
-            const uint8_t* texCoordData = nullptr;
-            const uint8_t* colorData = nullptr;
-            const uint8_t* tangentData = nullptr;
+    if (vertexCount > 0) {
+        kernels.computeBounds(
+            &outVertices[0].pos, sizeof(Vertex), vertexCount,
+            &range.boundsMin.x, &range.boundsMax.x
+        );
+    }
 
-            if (hasNormals) {
-                normalData = &normalBuffer->data[normalBufferView->byteOffset + normalAccessor->byteOffset];
+    // Copy indices directly - no hash map lookups needed
+    if (primitive.indices >= 0) {
+        const tinygltf::Accessor& indexAccessor = model.accessors[primitive.indices];
+        const uint8_t* indexData = accessorData(model, buffers, indexAccessor);
+
+        const size_t indexCount = indexAccessor.count;
+
+        // Fast path: copy when the widths match, otherwise widen or narrow
+        // to the range's index type
+        if (range.indexType == VK_INDEX_TYPE_UINT16) {
+            uint16_t* dst = static_cast<uint16_t*>(outIndices);
+            switch (indexAccessor.componentType) {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+                const uint32_t* src = reinterpret_cast<const uint32_t*>(indexData);
+                kernels.narrowIndices32(src, dst, indexCount);
+                break;
             }
-            if (hasTexCoords) {
-                texCoordData = &texCoordBuffer->data[texCoordBufferView->byteOffset + texCoordAccessor->byteOffset];
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                std::memcpy(dst, indexData, indexCount * sizeof(uint16_t));
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                kernels.widenIndices8To16(indexData, dst, indexCount);
+                break;
+            default:
+                throw std::runtime_error("Unsupported index component type");
             }
-            if (hasColors) {
-                colorData = &colorBuffer->data[colorBufferView->byteOffset + colorAccessor->byteOffset];
+        } else {
+            uint32_t* dst = static_cast<uint32_t*>(outIndices);
+            switch (indexAccessor.componentType) {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+                std::memcpy(dst, indexData, indexCount * sizeof(uint32_t));
+                break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+                const uint16_t* src = reinterpret_cast<const uint16_t*>(indexData);
+                kernels.widenIndices16(src, dst, indexCount);
+                break;
             }
-            if (hasTangents) {
-                tangentData = &tangentBuffer->data[tangentBufferView->byteOffset + tangentAccessor->byteOffset];
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                kernels.widenIndices8(indexData, dst, indexCount);
+                break;
+            default:
+                throw std::runtime_error("Unsupported index component type");
             }
+        }
+    }
+}
 
-            // Pre-allocate vertices based on accessor count (glTF vertices are already deduplicated)
-            const size_t vertexCount = posAccessor.count;
-            geometry.vertices.resize(vertexCount);
+/// Move the indices of every range with at most kMaxUint16IndexedVertices
+/// vertices (including its LODs) from `indices` into `indices16`, and compact
+/// the remaining 32-bit ranges. Used after 32-bit index processing.
+void narrowRangeIndices(ModelData& data) {
+    const simd::KernelTable& kernels = simd::kernels();
+
+    // A range's block spans its own indices and those of its LODs
+    auto blockCount = [&](const GeometryRange& range) {
+        uint32_t count = range.indexCount;
+        for (uint32_t l = 0; l < range.lodCount; ++l) {
+            const GeometryLod& lod = data.lods[range.firstLod + l];
+            count = std::max(count, lod.firstIndex + lod.indexCount);
+        }
+        return count;
+    };
 
-            // Process all vertices in a single pass - much faster than per-index processing
-            for (size_t i = 0; i < vertexCount; ++i) {
-                Vertex& vertex = geometry.vertices[i];
+    size_t total16 = 0;
+    for (const GeometryRange& range : data.ranges) {
+        if (range.vertexCount <= kMaxUint16IndexedVertices) {
+            total16 += blockCount(range);
+        }
+    }
+    if (total16 == 0) {
+        return;
+    }
 
-                const float* pos = reinterpret_cast<const float*>(posData + i * posStride);
-                glm::vec4 worldPos = worldTransform * glm::vec4(pos[0], pos[1], pos[2], 1.0f);
-                vertex.pos = glm::vec3(worldPos);
+    data.indices16.resize(total16);
+    size_t next16 = 0;
+    size_t next32 = 0;
+    for (GeometryRange& range : data.ranges) {
+        const uint32_t count = blockCount(range);
+        const uint32_t* src = data.indices.data() + range.firstIndex;
+        if (range.vertexCount <= kMaxUint16IndexedVertices) {
+            kernels.narrowIndices32(src, data.indices16.data() + next16, count);
+            range.indexType = VK_INDEX_TYPE_UINT16;
+            range.firstIndex = static_cast<uint32_t>(next16);
+            next16 += count;
+        } else {
+            // Blocks only move towards the front, so memmove is safe
+            std::memmove(data.indices.data() + next32, src, count * sizeof(uint32_t));
+            range.firstIndex = static_cast<uint32_t>(next32);
+            next32 += count;
+        }
+    }
+    data.indices.resize(next32);
+    data.indices.shrink_to_fit();
+}
 
-                if (hasNormals) {
-                    const float* norm = reinterpret_cast<const float*>(normalData + i * normalStride);
-                    glm::vec3 transformedNormal = normalMatrix * glm::vec3(norm[0], norm[1], norm[2]);
-                    vertex.normal = glm::normalize(transformedNormal);
-                } else {
-                    vertex.normal = {0.0f, 0.0f, 1.0f};
-                }
+/// Optimize one decoded range in place: vertex cache order, then overdraw
+/// order, then vertex fetch order. Returns cache stats before and after.
+std::pair<VertexCacheStats, VertexCacheStats> optimizeRange(
+    Vertex* vertices,
+    uint32_t* indices,
+    const GeometryRange& range
+) {
+    const size_t vertexCount = range.vertexCount;
+    const size_t indexCount = range.indexCount;
+    VertexCacheStats before = analyzeVertexCache(indices, indexCount, vertexCount);
+    if (indexCount < 3) {
+        return {before, before};
+    }
 
-                if (hasTexCoords) {
-                    const float* tex = reinterpret_cast<const float*>(texCoordData + i * texCoordStride);
-                    vertex.texCoord = {tex[0], tex[1]};
-                } else {
-                    vertex.texCoord = {0.0f, 0.0f};
-                }
+    std::vector<uint32_t> scratch(indexCount);
+    optimizeVertexCache(scratch.data(), indices, indexCount, vertexCount);
+    optimizeOverdraw(
+        indices, scratch.data(), indexCount,
+        &vertices[0].pos, sizeof(Vertex), vertexCount
+    );
 
-                if (hasColors) {
-                    const float* col = reinterpret_cast<const float*>(colorData + i * colorStride);
-                    vertex.color = {col[0], col[1], col[2]};
-                } else {
-                    vertex.color = {1.0f, 1.0f, 1.0f};  // Default white
-                }
+    // Reorder vertices into first-use order and rewrite the indices
+    std::vector<uint32_t> remap(vertexCount);
+    generateVertexFetchRemap(remap.data(), indices, indexCount, vertexCount);
+    std::vector<Vertex> reordered(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        reordered[remap[v]] = vertices[v];
+    }
+    std::copy(reordered.begin(), reordered.end(), vertices);
+    for (size_t i = 0; i < indexCount; ++i) {
+        if (indices[i] < vertexCount) {
+            indices[i] = remap[indices[i]];
+        }
+    }
 
-                if (hasTangents) {
-                    const float* tan = reinterpret_cast<const float*>(tangentData + i * tangentStride);
-                    glm::vec3 transformedTangent = normalMatrix * glm::vec3(tan[0], tan[1], tan[2]);
-                    vertex.tangent = glm::vec4(glm::normalize(transformedTangent), tan[3]);
-                } else {
-                    // Default tangent pointing along +X axis with positive handedness
-                    vertex.tangent = {1.0f, 0.0f, 0.0f, 1.0f};
-                }
-            }
+    return {before, analyzeVertexCache(indices, indexCount, vertexCount)};
+}
 
-            // Copy indices directly - no hash map lookups needed
-            if (primitive.indices >= 0) {
-                const tinygltf::Accessor& indexAccessor = model.accessors[primitive.indices];
-                const tinygltf::BufferView& indexBufferView = model.bufferViews[indexAccessor.bufferView];
-                const tinygltf::Buffer& indexBuffer = model.buffers[indexBufferView.buffer];
-                const uint8_t* indexData = &indexBuffer.data[indexBufferView.byteOffset + indexAccessor.byteOffset];
-
-                const size_t indexCount = indexAccessor.count;
-                geometry.indices.resize(indexCount);
-
-                // Fast path: copy indices directly based on component type (with SIMD optimization)
-                switch (indexAccessor.componentType) {
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-                    std::memcpy(geometry.indices.data(), indexData, indexCount * sizeof(uint32_t));
-                    break;
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
-                    const uint16_t* src = reinterpret_cast<const uint16_t*>(indexData);
-                    convertIndices16to32(src, geometry.indices.data(), indexCount);
-                    break;
-                }
-                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
-                    convertIndices8to32(indexData, geometry.indices.data(), indexCount);
-                    break;
-                }
-                default:
-                    throw std::runtime_error("Unsupported index component type");
-                }
-            }
+/// Simplify one decoded range into its LOD chain. `outLods` receives level 0
+/// (the range itself) followed by every level that meaningfully reduced the
+/// previous one; `outIndices` receives the indices of levels 1+, to be
+/// stored right after the range's own indices.
+void generateRangeLods(
+    const Vertex* vertices,
+    const uint32_t* indices,
+    const GeometryRange& range,
+    const ModelLoadOptions& options,
+    std::vector<uint32_t>& outIndices,
+    std::vector<GeometryLod>& outLods
+) {
+    outLods.push_back({0, range.indexCount, 0.0f});
+
+    const glm::vec3 size = range.boundsMax - range.boundsMin;
+    const float extent = std::max(size.x, std::max(size.y, size.z));
+    std::vector<uint32_t> level(range.indexCount);
+    size_t previousCount = range.indexCount;
+    float targetCount = static_cast<float>(range.indexCount);
+    float targetError = options.lodTargetError;
+
+    for (uint32_t l = 1; l <= options.lodLevels; ++l) {
+        targetCount *= options.lodTriangleRatio;
+        float error = 0.0f;
+        // Levels are simplified from the full mesh so their error is
+        // measured against the original surface, not the previous level
+        size_t count = simplifyMesh(
+            level.data(), indices, range.indexCount,
+            &vertices[0].pos, sizeof(Vertex), range.vertexCount,
+            static_cast<size_t>(targetCount), targetError, &error
+        );
 
-            if (!geometry.vertices.empty()) {
-                geometries.push_back(std::move(geometry));
-            }
+        // Stop once the error budget no longer buys a real reduction
+        if (count == 0 || count > previousCount * 9 / 10) {
+            break;
+        }
+        if (options.optimizeMeshes) {
+            std::vector<uint32_t> optimized(count);
+            optimizeVertexCache(optimized.data(), level.data(), count, range.vertexCount);
+            std::copy(optimized.begin(), optimized.end(), level.begin());
         }
+
+        outLods.push_back({
+            static_cast<uint32_t>(range.indexCount + outIndices.size()),
+            static_cast<uint32_t>(count),
+            error * extent
+        });
+        outIndices.insert(outIndices.end(), level.begin(), level.begin() + count);
+        previousCount = count;
+        targetError *= 2.0f;
     }
+}
 
-    for (int child : node.children) {
-        processNode(model, child, worldTransform, geometries);
+/// Split one decoded range into meshlets; the lists are sized to what was
+/// actually emitted
+void buildRangeMeshlets(
+    const Vertex* vertices,
+    const uint32_t* indices,
+    const GeometryRange& range,
+    std::vector<Meshlet>& outMeshlets,
+    std::vector<uint32_t>& outVertices,
+    std::vector<uint8_t>& outTriangles
+) {
+    const size_t bound = meshletBound(range.indexCount);
+    outMeshlets.resize(bound);
+    outVertices.resize(bound * kMeshletMaxVertices);
+    outTriangles.resize(bound * kMeshletMaxTriangles * 3);
+
+    const size_t count = buildMeshlets(
+        outMeshlets.data(), outVertices.data(), outTriangles.data(),
+        indices, range.indexCount,
+        &vertices[0].pos, sizeof(Vertex), range.vertexCount
+    );
+    outMeshlets.resize(count);
+    if (count == 0) {
+        outVertices.clear();
+        outTriangles.clear();
+        return;
     }
+    const Meshlet& last = outMeshlets.back();
+    outVertices.resize(last.vertexOffset + last.vertexCount);
+    outTriangles.resize(last.triangleOffset + last.triangleCount * 3);
 }
+// }}}
 
 // Process camera node transforms
 void processCameraNode(
@@ -489,61 +748,980 @@ void processLightNode(
         }
     }
 
-    // Process children
-    for (int child : node.children) {
-        processLightNode(model, child, worldTransform, lights);
+    // Process children
+    for (int child : node.children) {
+        processLightNode(model, child, worldTransform, lights);
+    }
+}
+
+// Mapped parsing {{{
+constexpr std::string_view kMeshoptExtension = "EXT_meshopt_compression";
+
+/// Stands in for a buffer or image whose data tinygltf must not load (3 bytes)
+constexpr const char* kPlaceholderUri = "data:application/octet-stream;base64,AAAA";
+
+/// Where the data of a placeholder buffer comes from
+enum class BufferSource {
+    Meshopt,    // EXT_meshopt_compression fallback, exists only after decoding
+    GlbBin,     // BIN chunk of the mapped GLB
+    File,       // External file, mapped on its own
+    DataUri     // Base64 data URI, decoded by decodeDataUriBuffers()
+};
+
+/// A buffer that got a placeholder uri before parsing
+struct BufferPlaceholder {
+    int buffer;
+    size_t byteLength;
+    BufferSource source;
+    std::string uri;            // Decoded, relative to the model (File only)
+    std::string_view encoded;   // Base64 payload in the mapped JSON (DataUri only)
+};
+
+/// Buffers inlined as base64 data URIs are taken out of the JSON before it
+/// is parsed, so neither the JSON parser nor tinygltf copies or decodes
+/// them; their strings become this token followed by an index
+constexpr std::string_view kDataUriToken = "vkduck-data-uri:";
+
+/// A base64 data URI string in the mapped JSON
+struct DataUri {
+    std::string_view uri;       // Whole string, without quotes
+    std::string_view payload;   // Base64 part of `uri`
+};
+
+/// Replace every base64 data URI string value with a buffer MIME type in
+/// `json` by a token. Returns the rewritten JSON, or an empty string if
+/// there were none. Escaped payloads are left to tinygltf.
+std::string extractDataUris(std::string_view json, std::vector<DataUri>& dataUris) {
+    constexpr std::string_view kPrefixes[] = {
+        "data:application/octet-stream;base64,",
+        "data:application/gltf-buffer;base64,",
+    };
+    constexpr std::string_view kStart = "\"data:application/";
+    std::string rewritten;
+    size_t copied = 0;
+    for (size_t pos = json.find(kStart); pos != std::string_view::npos;
+         pos = json.find(kStart, pos + 1)) {
+        // Only values: the string must follow a ':'
+        size_t before = pos;
+        while (before > 0 && std::isspace(static_cast<unsigned char>(json[before - 1]))) {
+            --before;
+        }
+        if (before == 0 || json[before - 1] != ':') {
+            continue;
+        }
+        const size_t end = json.find('"', pos + 1);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        const std::string_view uri = json.substr(pos + 1, end - pos - 1);
+        std::string_view payload;
+        for (std::string_view prefix : kPrefixes) {
+            if (uri.starts_with(prefix)) {
+                payload = uri.substr(prefix.size());
+            }
+        }
+        if (payload.empty() || payload.find('\\') != std::string_view::npos) {
+            continue;
+        }
+        rewritten.append(json.substr(copied, pos + 1 - copied));
+        rewritten.append(kDataUriToken);
+        rewritten.append(std::to_string(dataUris.size()));
+        copied = end;
+        pos = end;
+        dataUris.push_back({uri, payload});
+    }
+    if (!dataUris.empty()) {
+        rewritten.append(json.substr(copied));
+    }
+    return rewritten;
+}
+
+/// Index of the data URI a token made by extractDataUris() stands for
+std::optional<size_t> dataUriIndex(std::string_view text, size_t dataUriCount) {
+    if (!text.starts_with(kDataUriToken)) {
+        return std::nullopt;
+    }
+    text.remove_prefix(kDataUriToken.size());
+    size_t index = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), index);
+    if (error != std::errc() || end != text.data() + text.size() || index >= dataUriCount) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+/// Put back the data URIs whose token is not a buffer uri
+void restoreDataUris(nlohmann::json& value, const std::vector<DataUri>& dataUris) {
+    if (value.is_string()) {
+        if (auto index = dataUriIndex(value.get_ref<const std::string&>(), dataUris.size())) {
+            value = std::string(dataUris[*index].uri);
+        }
+    } else if (value.is_structured()) {
+        for (auto& child : value) {
+            restoreDataUris(child, dataUris);
+        }
+    }
+}
+
+/// The JSON part of a mapped .gltf or .glb file
+std::string_view gltfJson(std::span<const uint8_t> bytes, bool binary) {
+    if (!binary) {
+        return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+    }
+    // 12-byte header, then the JSON chunk: length, type, data
+    if (bytes.size() < 20) {
+        return {};
+    }
+    uint32_t length = 0;
+    std::memcpy(&length, bytes.data() + 12, sizeof(length));
+    length = static_cast<uint32_t>(std::min<size_t>(length, bytes.size() - 20));
+    return {reinterpret_cast<const char*>(bytes.data()) + 20, length};
+}
+
+/// The BIN chunk data of a mapped .glb file, empty if it has none
+std::span<const uint8_t> glbBinChunk(std::span<const uint8_t> bytes) {
+    const std::string_view json = gltfJson(bytes, true);
+    const size_t chunkOffset = 20 + json.size();
+    if (json.empty() || bytes.size() < chunkOffset + 8) {
+        return {};
+    }
+    uint32_t length = 0;
+    uint32_t type = 0;
+    std::memcpy(&length, bytes.data() + chunkOffset, sizeof(length));
+    std::memcpy(&type, bytes.data() + chunkOffset + 4, sizeof(type));
+    if (type != 0x004E4942 || length > bytes.size() - chunkOffset - 8) {  // "BIN\0"
+        return {};
+    }
+    return bytes.subspan(chunkOffset + 8, length);
+}
+
+/// Parse a glTF/GLB file through a read-only mapping, which is returned in
+/// `mapping` so embedded images can be viewed in place. Buffers tinygltf
+/// should not load get a placeholder uri in a rewritten copy of the JSON and
+/// are listed in `placeholders`:
+/// - EXT_meshopt_compression fallback buffers, which have no uri and only
+///   exist after decoding (tinygltf rejects them or reads the BIN chunk)
+/// - with `mapBuffers`, the GLB BIN chunk and external .bin files, which are
+///   then mapped instead of copied (see resolveBufferBytes())
+/// - base64 data URI buffers, whose payloads stay in the mapping until
+///   decodeDataUriBuffers() decodes them
+/// Images stored in such buffers are hidden from tinygltf the same way and
+/// restored after parsing. Files that need neither load straight from the
+/// mapping.
+bool parseGltf(
+    tinygltf::TinyGLTF& loader,
+    tinygltf::Model& model,
+    std::string& err,
+    std::string& warn,
+    const std::filesystem::path& path,
+    bool binary,
+    bool mapBuffers,
+    std::shared_ptr<const MappedFile>& mapping,
+    std::vector<BufferPlaceholder>& placeholders
+) {
+    auto mapped = std::make_shared<const MappedFile>(path);
+    mapping = mapped;
+    const MappedFile& file = *mapped;
+    const std::string baseDir = path.parent_path().string();
+    auto load = [&](const uint8_t* data, size_t size) {
+        if (binary) {
+            return loader.LoadBinaryFromMemory(
+                &model, &err, &warn, data, static_cast<unsigned int>(size), baseDir
+            );
+        }
+        return loader.LoadASCIIFromString(
+            &model, &err, &warn, reinterpret_cast<const char*>(data),
+            static_cast<unsigned int>(size), baseDir
+        );
+    };
+
+    const std::string_view jsonText = gltfJson(file.bytes(), binary);
+    std::vector<DataUri> dataUris;
+    const std::string withoutDataUris = extractDataUris(jsonText, dataUris);
+    const std::string_view json = dataUris.empty() ? jsonText : withoutDataUris;
+    if (!mapBuffers && dataUris.empty() &&
+        json.find(kMeshoptExtension) == std::string_view::npos) {
+        return load(file.data(), file.size());
+    }
+
+    nlohmann::json doc = nlohmann::json::parse(json, nullptr, false);
+    if (doc.is_discarded() || !doc.contains("buffers") || !doc["buffers"].is_array()) {
+        return load(file.data(), file.size());
+    }
+    auto& buffers = doc["buffers"];
+    std::vector<bool> isPlaceholder(buffers.size(), false);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        auto& buffer = buffers[i];
+        BufferPlaceholder placeholder{
+            static_cast<int>(i), buffer.value<size_t>("byteLength", 0), BufferSource::Meshopt, {}, {}
+        };
+        auto uri = buffer.find("uri");
+        if (uri == buffer.end()) {
+            auto extensions = buffer.find("extensions");
+            bool fallback = false;
+            if (extensions != buffer.end() && extensions->is_object()) {
+                auto ext = extensions->find(kMeshoptExtension);
+                fallback = ext != extensions->end() && ext->value("fallback", false);
+            }
+            if (fallback) {
+                placeholder.source = BufferSource::Meshopt;
+            } else if (mapBuffers && binary && i == 0) {
+                placeholder.source = BufferSource::GlbBin;
+            } else {
+                continue;
+            }
+        } else if (!uri->is_string()) {
+            continue;
+        } else if (auto dataUri = dataUriIndex(uri->get_ref<const std::string&>(), dataUris.size())) {
+            placeholder.source = BufferSource::DataUri;
+            placeholder.encoded = dataUris[*dataUri].payload;
+        } else {
+            if (!mapBuffers || tinygltf::IsDataURI(uri->get<std::string>())) {
+                continue;
+            }
+            placeholder.source = BufferSource::File;
+            tinygltf::URIDecode(uri->get<std::string>(), &placeholder.uri, nullptr);
+        }
+        placeholders.push_back(std::move(placeholder));
+        isPlaceholder[i] = true;
+        buffer["uri"] = kPlaceholderUri;
+        buffer["byteLength"] = 3;
+    }
+    if (placeholders.empty()) {
+        return load(file.data(), file.size());
+    }
+    if (!dataUris.empty()) {
+        restoreDataUris(doc, dataUris);
+    }
+
+    // Images in placeholder buffers would fail tinygltf's bounds check
+    struct DetachedImage {
+        size_t image;
+        int bufferView;
+        std::string mimeType;
+    };
+    std::vector<DetachedImage> detachedImages;
+    if (doc.contains("images") && doc["images"].is_array() &&
+        doc.contains("bufferViews") && doc["bufferViews"].is_array()) {
+        const auto& views = doc["bufferViews"];
+        auto& images = doc["images"];
+        for (size_t i = 0; i < images.size(); ++i) {
+            auto& image = images[i];
+            auto view = image.find("bufferView");
+            if (view == image.end() || !view->is_number_integer()) {
+                continue;
+            }
+            const int viewIndex = view->get<int>();
+            if (viewIndex < 0 || static_cast<size_t>(viewIndex) >= views.size()) {
+                continue;  // Reported by tinygltf
+            }
+            const int bufferIndex = views[viewIndex].value("buffer", -1);
+            if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= isPlaceholder.size() ||
+                !isPlaceholder[bufferIndex]) {
+                continue;
+            }
+            detachedImages.push_back({i, viewIndex, image.value("mimeType", std::string())});
+            image.erase("bufferView");
+            image["uri"] = kPlaceholderUri;
+        }
+    }
+
+    auto loadRewritten = [&](const uint8_t* data, size_t size) {
+        if (!load(data, size)) {
+            return false;
+        }
+        for (const DetachedImage& detached : detachedImages) {
+            tinygltf::Image& image = model.images[detached.image];
+            image.bufferView = detached.bufferView;
+            image.mimeType = detached.mimeType;
+            image.uri.clear();
+            image.image.clear();
+        }
+        return true;
+    };
+
+    std::string rewritten = doc.dump();
+    if (!binary) {
+        return loadRewritten(reinterpret_cast<const uint8_t*>(rewritten.data()), rewritten.size());
+    }
+
+    // Rebuild the GLB around the new JSON chunk (space-padded to 4 bytes).
+    // The BIN chunk is copied unchanged, unless it is mapped and then left out.
+    const bool binMapped = std::any_of(placeholders.begin(), placeholders.end(),
+        [](const BufferPlaceholder& p) { return p.source == BufferSource::GlbBin; });
+    rewritten.resize((rewritten.size() + 3) & ~size_t(3), ' ');
+    const size_t tailOffset = 20 + jsonText.size();
+    const size_t tailSize = binMapped ? 0 : file.size() - tailOffset;
+    std::vector<uint8_t> glb(20 + rewritten.size() + tailSize);
+    const uint32_t totalLength = static_cast<uint32_t>(glb.size());
+    const uint32_t jsonLength = static_cast<uint32_t>(rewritten.size());
+    std::memcpy(glb.data(), file.data(), 8);
+    std::memcpy(glb.data() + 8, &totalLength, sizeof(totalLength));
+    std::memcpy(glb.data() + 12, &jsonLength, sizeof(jsonLength));
+    std::memcpy(glb.data() + 16, file.data() + 16, 4);
+    std::memcpy(glb.data() + 20, rewritten.data(), rewritten.size());
+    if (tailSize > 0) {
+        std::memcpy(glb.data() + 20 + rewritten.size(), file.data() + tailOffset, tailSize);
+    }
+    return loadRewritten(glb.data(), glb.size());
+}
+
+/// Point every buffer at its bytes: tinygltf's copy, the BIN chunk of the
+/// mapped GLB, or a mapping of its own for external files, which is kept in
+/// `mappings`. Mapped pages are only read once an accessor touches them.
+/// Meshopt placeholders are sized here and filled by
+/// decodeMeshoptBufferViews(). `inSource` flags buffers that view `source`.
+BufferBytes resolveBufferBytes(
+    tinygltf::Model& model,
+    const std::vector<BufferPlaceholder>& placeholders,
+    const MappedFile& source,
+    const std::filesystem::path& baseDir,
+    bool binary,
+    std::vector<std::shared_ptr<const MappedFile>>& mappings,
+    std::vector<bool>& inSource
+) {
+    BufferBytes bytes(model.buffers.size());
+    inSource.assign(model.buffers.size(), false);
+    for (size_t i = 0; i < model.buffers.size(); ++i) {
+        bytes[i] = model.buffers[i].data;
+    }
+
+    // tinygltf copied the BIN chunk into the first buffer; the mapping has it too
+    const std::span<const uint8_t> binChunk =
+        binary ? glbBinChunk(source.bytes()) : std::span<const uint8_t>();
+    if (!model.buffers.empty() && model.buffers[0].uri.empty() &&
+        binChunk.size() >= model.buffers[0].data.size()) {
+        bytes[0] = binChunk.first(model.buffers[0].data.size());
+        inSource[0] = true;
+    }
+
+    for (const BufferPlaceholder& placeholder : placeholders) {
+        std::vector<unsigned char>& data = model.buffers[placeholder.buffer].data;
+        switch (placeholder.source) {
+        case BufferSource::Meshopt:
+            data.assign(placeholder.byteLength, 0);
+            bytes[placeholder.buffer] = data;
+            break;
+        case BufferSource::GlbBin:
+            if (binChunk.size() < placeholder.byteLength) {
+                throw std::runtime_error("GLB BIN chunk is smaller than its buffer");
+            }
+            data.clear();
+            bytes[placeholder.buffer] = binChunk.first(placeholder.byteLength);
+            inSource[placeholder.buffer] = true;
+            break;
+        case BufferSource::DataUri:
+            break;      // Decoded into the buffer's data already
+        case BufferSource::File: {
+            auto mapped = std::make_shared<const MappedFile>(baseDir / placeholder.uri);
+            if (mapped->size() < placeholder.byteLength) {
+                throw std::runtime_error("Buffer file is smaller than its byteLength: " +
+                    placeholder.uri);
+            }
+            data.clear();
+            bytes[placeholder.buffer] = mapped->bytes().first(placeholder.byteLength);
+            mappings.push_back(std::move(mapped));
+            break;
+        }
+        }
+    }
+    return bytes;
+}
+// }}}
+
+// Base64 data URIs {{{
+/// Split base64 `text` into whole groups of 4 characters and the rest,
+/// without padding. Returns the decoded size, or nothing if `text` cannot
+/// be base64.
+std::optional<size_t> splitBase64(std::string_view& text, std::string_view& tail) {
+    for (int i = 0; i < 2 && text.ends_with('='); ++i) {
+        text.remove_suffix(1);
+    }
+    const size_t rest = text.size() % 4;
+    if (rest == 1) {
+        return std::nullopt;
+    }
+    tail = text.substr(text.size() - rest);
+    text.remove_suffix(rest);
+    return text.size() / 4 * 3 + (rest > 0 ? rest - 1 : 0);
+}
+
+/// Decode the last 2 or 3 characters of unpadded base64 into 1 or 2 bytes
+bool decodeBase64Tail(std::string_view tail, uint8_t* dst) {
+    if (tail.empty()) {
+        return true;
+    }
+    char quad[4] = {'A', 'A', 'A', 'A'};
+    std::memcpy(quad, tail.data(), tail.size());
+    uint8_t bytes[3];
+    if (!simd::kernels().decodeBase64(quad, 1, bytes)) {
+        return false;
+    }
+    std::memcpy(dst, bytes, tail.size() - 1);
+    return true;
+}
+
+/// A piece of base64 text for one job: 256 KB in, 192 KB out
+constexpr size_t kBase64ChunkQuads = 64 * 1024;
+
+struct Base64Chunk {
+    const char* text;
+    size_t quadCount;
+    uint8_t* destination;
+    int buffer;
+};
+
+/// Queue the whole groups of `text` for decoding into `destination`
+void splitBase64Chunks(
+    std::string_view text,
+    uint8_t* destination,
+    int buffer,
+    std::vector<Base64Chunk>& chunks
+) {
+    const size_t quadCount = text.size() / 4;
+    for (size_t q = 0; q < quadCount; q += kBase64ChunkQuads) {
+        chunks.push_back({
+            text.data() + q * 4, std::min(kBase64ChunkQuads, quadCount - q),
+            destination + q * 3, buffer
+        });
+    }
+}
+
+void decodeBase64Chunks(const std::vector<Base64Chunk>& chunks) {
+    jobSystem().parallelFor(chunks.size(), [&](size_t i) {
+        const Base64Chunk& chunk = chunks[i];
+        if (!simd::kernels().decodeBase64(chunk.text, chunk.quadCount, chunk.destination)) {
+            throw std::runtime_error("Invalid base64 in the data URI of buffer " +
+                std::to_string(chunk.buffer));
+        }
+    });
+}
+
+/// Decode every data URI placeholder straight into its buffer's data with
+/// the vectorized base64 kernel, in parallel chunks. Returns the number of
+/// decoded bytes.
+size_t decodeDataUriBuffers(
+    tinygltf::Model& model,
+    const std::vector<BufferPlaceholder>& placeholders
+) {
+    std::vector<Base64Chunk> chunks;
+    size_t decodedBytes = 0;
+    for (const BufferPlaceholder& placeholder : placeholders) {
+        if (placeholder.source != BufferSource::DataUri) {
+            continue;
+        }
+        const std::string bufferName = "buffer " + std::to_string(placeholder.buffer);
+        std::string_view text = placeholder.encoded;
+        std::string_view tail;
+        const std::optional<size_t> size = splitBase64(text, tail);
+        if (!size) {
+            throw std::runtime_error("Invalid base64 length in the data URI of " + bufferName);
+        }
+        if (*size < placeholder.byteLength) {
+            throw std::runtime_error("Data URI of " + bufferName + " is shorter than its byteLength");
+        }
+
+        // Replaces the placeholder's 3 bytes
+        std::vector<unsigned char>& data = model.buffers[placeholder.buffer].data;
+        data.resize(*size);
+        if (!decodeBase64Tail(tail, data.data() + text.size() / 4 * 3)) {
+            throw std::runtime_error("Invalid base64 in the data URI of " + bufferName);
+        }
+        splitBase64Chunks(text, data.data(), placeholder.buffer, chunks);
+        decodedBytes += *size;
+    }
+    decodeBase64Chunks(chunks);
+    return decodedBytes;
+}
+// }}}
+
+// EXT_meshopt_compression {{{
+/// Decode every compressed buffer view whose fallback buffer is a
+/// placeholder, in parallel. Returns the number of decoded bytes.
+size_t decodeMeshoptBufferViews(
+    tinygltf::Model& model,
+    const BufferBytes& buffers,
+    const std::vector<BufferPlaceholder>& placeholders
+) {
+    std::vector<bool> isPlaceholder(model.buffers.size(), false);
+    for (const BufferPlaceholder& placeholder : placeholders) {
+        if (placeholder.source == BufferSource::Meshopt) {
+            isPlaceholder[placeholder.buffer] = true;
+        }
+    }
+    if (std::find(isPlaceholder.begin(), isPlaceholder.end(), true) == isPlaceholder.end()) {
+        return 0;
+    }
+
+    struct DecodeJob {
+        std::span<const uint8_t> source;
+        uint8_t* destination;
+        size_t count;
+        size_t stride;
+        MeshoptMode mode;
+        MeshoptFilter filter;
+    };
+    std::vector<DecodeJob> jobs;
+    size_t decodedBytes = 0;
+
+    for (auto& bufferView : model.bufferViews) {
+        auto it = bufferView.extensions.find(std::string(kMeshoptExtension));
+        if (it == bufferView.extensions.end() || bufferView.buffer < 0 ||
+            static_cast<size_t>(bufferView.buffer) >= model.buffers.size() ||
+            !isPlaceholder[bufferView.buffer]) {
+            continue;
+        }
+
+        const tinygltf::Value& ext = it->second;
+        auto number = [&](const char* key, size_t fallback) {
+            if (!ext.Has(key)) {
+                return fallback;
+            }
+            // Whole, non-negative and exact as a double, so the cast is defined
+            const tinygltf::Value& value = ext.Get(key);
+            const double number = value.IsNumber() ? value.GetNumberAsDouble() : -1.0;
+            if (!(number >= 0.0 && number <= 9007199254740992.0) || number != std::floor(number)) {
+                throw std::runtime_error(
+                    std::string("EXT_meshopt_compression ") + key + " is not a valid size"
+                );
+            }
+            return static_cast<size_t>(number);
+        };
+        auto string = [&](const char* key, const char* fallback) {
+            return ext.Has(key) ? ext.Get(key).Get<std::string>() : std::string(fallback);
+        };
+
+        const size_t sourceBuffer = number("buffer", model.buffers.size());
+        const size_t sourceOffset = number("byteOffset", 0);
+        const size_t sourceLength = number("byteLength", 0);
+        const size_t stride = number("byteStride", 0);
+        const size_t count = number("count", 0);
+        // Compared by subtraction and division so large values cannot wrap
+        if (sourceBuffer >= model.buffers.size() ||
+            sourceOffset > buffers[sourceBuffer].size() ||
+            sourceLength > buffers[sourceBuffer].size() - sourceOffset) {
+            throw std::runtime_error("EXT_meshopt_compression source out of range");
+        }
+        const size_t targetSize = model.buffers[bufferView.buffer].data.size();
+        if (stride == 0 || count > bufferView.byteLength / stride ||
+            bufferView.byteOffset > targetSize ||
+            bufferView.byteLength > targetSize - bufferView.byteOffset) {
+            throw std::runtime_error("EXT_meshopt_compression target out of range");
+        }
+
+        const std::string mode = string("mode", "");
+        const std::string filter = string("filter", "NONE");
+        DecodeJob& job = jobs.emplace_back();
+        job.source = buffers[sourceBuffer].subspan(sourceOffset, sourceLength);
+        job.destination = model.buffers[bufferView.buffer].data.data() + bufferView.byteOffset;
+        job.count = count;
+        job.stride = stride;
+
+        if (mode == "ATTRIBUTES") {
+            job.mode = MeshoptMode::Attributes;
+        } else if (mode == "TRIANGLES") {
+            job.mode = MeshoptMode::Triangles;
+        } else if (mode == "INDICES") {
+            job.mode = MeshoptMode::Indices;
+        } else {
+            throw std::runtime_error("Unknown EXT_meshopt_compression mode: " + mode);
+        }
+
+        if (filter == "NONE") {
+            job.filter = MeshoptFilter::None;
+        } else if (filter == "OCTAHEDRAL") {
+            job.filter = MeshoptFilter::Octahedral;
+        } else if (filter == "QUATERNION") {
+            job.filter = MeshoptFilter::Quaternion;
+        } else if (filter == "EXPONENTIAL") {
+            job.filter = MeshoptFilter::Exponential;
+        } else {
+            throw std::runtime_error("Unknown EXT_meshopt_compression filter: " + filter);
+        }
+        decodedBytes += count * stride;
+    }
+
+    // Views never overlap, so each job writes its own bytes
+    jobSystem().parallelFor(jobs.size(), [&](size_t i) {
+        const DecodeJob& job = jobs[i];
+        decodeMeshoptStream(job.destination, job.count, job.stride, job.source, job.mode, job.filter);
+    });
+    return decodedBytes;
+}
+// }}}
+
+} // anonymous namespace
+// }}}
+
+// Model loading implementation {{{
+
+/// Parse and decode a glTF/GLB file. External files the result depends on
+/// (relative to the model directory) are appended to `dependencies`.
+static ModelData loadModelFromSource(
+    const std::filesystem::path& path,
+    const std::filesystem::path& projectRoot,
+    const ModelLoadOptions& options,
+    std::vector<std::filesystem::path>& dependencies
+) {
+    using Clock = std::chrono::high_resolution_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+    auto totalStart = Clock::now();
+
+    tinygltf::Model model;
+    tinygltf::TinyGLTF loader;
+    std::string err, warn;
+    std::string pathStr = path.string();
+
+    // Embedded images are only captured here (data URIs) and decoded by the
+    // caller, see loadEmbeddedImagesAsync()
+    loader.SetImageLoader(
+        [](tinygltf::Image* image, const int, std::string*, std::string*, int, int,
+           const unsigned char* bytes, int size, void*) {
+            if (image->bufferView < 0) {
+                image->image.assign(bytes, bytes + size);
+            }
+            return true;
+        },
+        nullptr
+    );
+
+    // Selective loads map the buffers, so only the selected meshes' bytes
+    // are ever read
+    const bool binary = path.extension() == ".glb";
+    const bool selective = !options.nodeSelection.empty();
+    std::shared_ptr<const MappedFile> sourceMapping;
+    std::vector<BufferPlaceholder> placeholders;
+    bool ret = parseGltf(
+        loader, model, err, warn, path, binary, selective, sourceMapping, placeholders
+    );
+
+    if (!warn.empty()) {
+        std::cerr << "Warning loading model: " << warn << std::endl;
+    }
+
+    if (!err.empty() || !ret) {
+        throw std::runtime_error("Failed to load model: " + pathStr + " - " + err);
+    }
+
+    auto parseEnd = Clock::now();
+
+    const size_t dataUriBytes = decodeDataUriBuffers(model, placeholders);
+    auto dataUriEnd = Clock::now();
+
+    std::vector<std::shared_ptr<const MappedFile>> bufferMappings;
+    std::vector<bool> bufferInSource;
+    const BufferBytes buffers = resolveBufferBytes(
+        model, placeholders, *sourceMapping, path.parent_path(), binary,
+        bufferMappings, bufferInSource
+    );
+
+    // Compressed buffer views decode before any accessor is read
+    const size_t meshoptBytes = decodeMeshoptBufferViews(model, buffers, placeholders);
+    auto meshoptEnd = Clock::now();
+
+    for (const auto& buffer : model.buffers) {
+        if (!buffer.uri.empty() && buffer.uri.rfind("data:", 0) != 0) {
+            dependencies.emplace_back(buffer.uri);
+        }
+    }
+    for (const BufferPlaceholder& placeholder : placeholders) {
+        if (placeholder.source == BufferSource::File) {
+            dependencies.emplace_back(placeholder.uri);
+        }
+    }
+
+    // Collect every primitive of the default scene, then decode them in parallel.
+    // Each work item owns its output slot, so the final order matches the
+    // depth-first scene order regardless of which thread finished first.
+    int defaultScene = model.defaultScene >= 0 ? model.defaultScene : 0;
+    ModelData result;
+    std::vector<PrimitiveWorkItem> workItems;
+    {
+        size_t estimatedGeometries = 0;
+        for (const auto& mesh : model.meshes) {
+            estimatedGeometries += mesh.primitives.size();
+        }
+        workItems.reserve(estimatedGeometries);
+    }
+    if (!selective) {
+        for (int sceneIndex : model.scenes[defaultScene].nodes) {
+            collectPrimitives(model, sceneIndex, -1, result.nodes, workItems);
+        }
+    } else {
+        // Each selected node becomes a root carrying its ancestors' transform.
+        // Nodes below another selected node are already part of its subtree.
+        std::vector<int32_t> parents(model.nodes.size(), -1);
+        for (size_t n = 0; n < model.nodes.size(); ++n) {
+            for (int child : model.nodes[n].children) {
+                if (child >= 0 && static_cast<size_t>(child) < model.nodes.size()) {
+                    parents[child] = static_cast<int32_t>(n);
+                }
+            }
+        }
+        std::vector<bool> selected(model.nodes.size(), false);
+        for (int32_t nodeIndex : options.nodeSelection) {
+            if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= model.nodes.size()) {
+                std::cerr << "Warning loading model: selected node " << nodeIndex
+                    << " does not exist in " << pathStr << std::endl;
+                continue;
+            }
+            selected[nodeIndex] = true;
+        }
+        for (size_t n = 0; n < model.nodes.size(); ++n) {
+            if (!selected[n]) {
+                continue;
+            }
+            glm::mat4 ancestors(1.0f);
+            bool covered = false;
+            for (int32_t p = parents[n]; p >= 0 && !covered; p = parents[p]) {
+                covered = selected[p];
+                ancestors = getNodeTransform(model.nodes[p]) * ancestors;
+            }
+            if (!covered) {
+                collectPrimitives(model, static_cast<int>(n), -1, result.nodes, workItems, ancestors);
+            }
+        }
+    }
+
+    const size_t primitiveCount = workItems.size();
+
+    // With instancing, every (mesh, primitive) pair is decoded once in mesh
+    // space and the world transforms of all referencing nodes become instances
+    std::vector<std::vector<glm::mat4>> instanceTransforms;
+    if (options.preserveInstancing) {
+        std::vector<PrimitiveWorkItem> uniqueItems;
+        std::unordered_map<uint64_t, size_t> uniqueIndex;
+        for (const auto& item : workItems) {
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(item.meshIndex)) << 32) |
+                static_cast<uint32_t>(item.primitiveIndex);
+            auto [it, inserted] = uniqueIndex.try_emplace(key, uniqueItems.size());
+            if (inserted) {
+                uniqueItems.push_back({item.meshIndex, item.primitiveIndex, glm::mat4(1.0f), -1});
+                instanceTransforms.emplace_back();
+            }
+            instanceTransforms[it->second].push_back(item.worldTransform);
+        }
+        workItems = std::move(uniqueItems);
+    } else if (options.preserveHierarchy) {
+        // Vertices stay in node space; the node's world transform becomes the
+        // range's model matrix instead
+        for (auto& item : workItems) {
+            item.worldTransform = glm::mat4(1.0f);
+        }
+        result.hierarchical = true;
     }
-}
 
-} // anonymous namespace
-// }}}
+    // Sizing pre-pass: the accessors already tell us every primitive's final
+    // vertex and index count, so the consolidated arrays are allocated exactly
+    // once and each primitive decodes straight into its own slot. This avoids
+    // holding per-primitive copies next to the final buffers.
+    std::vector<size_t> rangeItems;  // Work item decoded into each range
+    rangeItems.reserve(workItems.size());
+    result.ranges.reserve(workItems.size());
+    std::vector<bool> viewsRead(model.bufferViews.size(), false);
+    auto markAccessor = [&](int accessorIndex) {
+        if (accessorIndex >= 0 && static_cast<size_t>(accessorIndex) < model.accessors.size()) {
+            const int view = model.accessors[accessorIndex].bufferView;
+            if (view >= 0 && static_cast<size_t>(view) < viewsRead.size()) {
+                viewsRead[view] = true;
+            }
+        }
+    };
 
-// Model loading implementation {{{
+    // Optimization, simplification and meshlet building work on 32-bit
+    // indices; those ranges are narrowed once they are done. Otherwise small
+    // ranges decode straight into 16-bit indices.
+    const bool processIndices = options.optimizeMeshes || options.lodLevels > 0 ||
+        options.buildMeshlets;
+    {
+        size_t totalVerts = 0;
+        size_t totalIndices = 0;
+        size_t totalIndices16 = 0;
+        for (size_t i = 0; i < workItems.size(); ++i) {
+            PrimitiveSize size = measurePrimitive(model, workItems[i]);
+            // Primitives without positions produce no geometry
+            if (size.vertexCount == 0) {
+                continue;
+            }
 
-ModelData loadModel(const std::filesystem::path& path, const std::filesystem::path& projectRoot) {
-#ifndef NDEBUG
-    auto totalStart = std::chrono::high_resolution_clock::now();
-#endif
+            // Check for overflow before casting to uint32_t for Vulkan
+            constexpr size_t maxUint32 = static_cast<size_t>(UINT32_MAX);
+            if (size.vertexCount > maxUint32 - totalVerts) {
+                throw std::runtime_error("Model has too many vertices (" +
+                    std::to_string(totalVerts + size.vertexCount) +
+                    ") - exceeds uint32_t maximum");
+            }
+            if (size.indexCount > maxUint32 - (totalIndices + totalIndices16)) {
+                throw std::runtime_error("Model has too many indices (" +
+                    std::to_string(totalIndices + totalIndices16 + size.indexCount) +
+                    ") - exceeds uint32_t maximum");
+            }
 
-    tinygltf::Model model;
-    tinygltf::TinyGLTF loader;
-    std::string err, warn;
-    std::string pathStr = path.string();
+            const auto& item = workItems[i];
+            GeometryRange range{};
+            range.firstVertex = static_cast<uint32_t>(totalVerts);
+            range.vertexCount = static_cast<uint32_t>(size.vertexCount);
+            range.indexCount = static_cast<uint32_t>(size.indexCount);
+            if (!processIndices && size.vertexCount <= kMaxUint16IndexedVertices) {
+                range.indexType = VK_INDEX_TYPE_UINT16;
+                range.firstIndex = static_cast<uint32_t>(totalIndices16);
+                totalIndices16 += size.indexCount;
+            } else {
+                range.firstIndex = static_cast<uint32_t>(totalIndices);
+                totalIndices += size.indexCount;
+            }
+            const auto& primitive = model.meshes[item.meshIndex].primitives[item.primitiveIndex];
+            range.materialIndex = primitive.material;
+            range.node = item.node;
+            for (const auto& [name, accessorIndex] : primitive.attributes) {
+                markAccessor(accessorIndex);
+            }
+            markAccessor(primitive.indices);
 
-    bool ret = false;
-    if (path.extension() == ".glb") {
-        ret = loader.LoadBinaryFromFile(&model, &err, &warn, pathStr);
-    } else {
-        ret = loader.LoadASCIIFromFile(&model, &err, &warn, pathStr);
-    }
+            if (options.preserveInstancing) {
+                range.firstInstance = static_cast<uint32_t>(result.instances.size());
+                range.instanceCount = static_cast<uint32_t>(instanceTransforms[i].size());
+                for (const auto& transform : instanceTransforms[i]) {
+                    result.instances.push_back({transform});
+                }
+            }
 
-    if (!warn.empty()) {
-        std::cerr << "Warning loading model: " << warn << std::endl;
+            result.ranges.push_back(range);
+            rangeItems.push_back(i);
+            totalVerts += size.vertexCount;
+        }
+
+        result.vertices.resize(totalVerts);
+        result.indices.resize(totalIndices);
+        result.indices16.resize(totalIndices16);
     }
 
-    if (!err.empty() || !ret) {
-        throw std::runtime_error("Failed to load model: " + pathStr + " - " + err);
+    // Indices are stored as-is (NOT rebased to absolute)
+    // The ranges contain firstVertex which tells us where each geometry's vertices start
+    // This allows consumers to either:
+    // 1. Use the full consolidated buffer with vkCmdDrawIndexed(..., firstVertex=range.firstVertex)
+    // 2. Create per-geometry slices where indices remain relative
+    uint32_t decodeThreads = jobSystem().parallelFor(result.ranges.size(), [&](size_t r) {
+        GeometryRange& range = result.ranges[r];
+        void* outIndices = range.indexType == VK_INDEX_TYPE_UINT16
+            ? static_cast<void*>(result.indices16.data() + range.firstIndex)
+            : static_cast<void*>(result.indices.data() + range.firstIndex);
+        decodePrimitive(
+            model, buffers, workItems[rangeItems[r]],
+            result.vertices.data() + range.firstVertex,
+            outIndices,
+            range
+        );
+    });
+
+    auto decodeEnd = Clock::now();
+
+    if (options.optimizeMeshes) {
+        std::vector<std::pair<VertexCacheStats, VertexCacheStats>> rangeStats(result.ranges.size());
+        jobSystem().parallelFor(result.ranges.size(), [&](size_t r) {
+            const GeometryRange& range = result.ranges[r];
+            rangeStats[r] = optimizeRange(
+                result.vertices.data() + range.firstVertex,
+                result.indices.data() + range.firstIndex,
+                range
+            );
+        });
+
+        // Model-wide ratios weight every range by its size
+        size_t missesBefore = 0, missesAfter = 0, triangles = 0, vertices = 0;
+        for (const auto& [before, after] : rangeStats) {
+            missesBefore += before.misses;
+            missesAfter += after.misses;
+            triangles += before.triangles;
+            vertices += before.vertices;
+        }
+        MeshOptimizationStats& stats = result.optimization;
+        stats.applied = true;
+        if (triangles > 0) {
+            stats.acmrBefore = static_cast<float>(missesBefore) / static_cast<float>(triangles);
+            stats.acmrAfter = static_cast<float>(missesAfter) / static_cast<float>(triangles);
+        }
+        if (vertices > 0) {
+            stats.atvrBefore = static_cast<float>(missesBefore) / static_cast<float>(vertices);
+            stats.atvrAfter = static_cast<float>(missesAfter) / static_cast<float>(vertices);
+        }
     }
 
-    std::vector<TempGeometry> geometries;
+    auto optimizeEnd = Clock::now();
+
+    if (options.lodLevels > 0) {
+        std::vector<std::vector<uint32_t>> lodIndices(result.ranges.size());
+        std::vector<std::vector<GeometryLod>> rangeLods(result.ranges.size());
+        jobSystem().parallelFor(result.ranges.size(), [&](size_t r) {
+            const GeometryRange& range = result.ranges[r];
+            generateRangeLods(
+                result.vertices.data() + range.firstVertex,
+                result.indices.data() + range.firstIndex,
+                range, options, lodIndices[r], rangeLods[r]
+            );
+        });
 
-    // Pre-allocate geometry vector to avoid reallocations during loading
-    {
-        size_t estimatedGeometries = 0;
-        for (const auto& mesh : model.meshes) {
-            estimatedGeometries += mesh.primitives.size();
+        // Re-lay the index array so each range's LOD indices directly follow
+        // its own; a geometry's index data then stays one contiguous block
+        size_t totalIndices = result.indices.size();
+        for (const auto& levels : lodIndices) {
+            totalIndices += levels.size();
+        }
+        if (totalIndices > static_cast<size_t>(UINT32_MAX)) {
+            throw std::runtime_error("Model has too many indices with LODs (" +
+                std::to_string(totalIndices) + ") - exceeds uint32_t maximum");
+        }
+        std::vector<uint32_t> indices;
+        indices.reserve(totalIndices);
+        for (size_t r = 0; r < result.ranges.size(); ++r) {
+            GeometryRange& range = result.ranges[r];
+            auto first = result.indices.begin() + range.firstIndex;
+            range.firstIndex = static_cast<uint32_t>(indices.size());
+            indices.insert(indices.end(), first, first + range.indexCount);
+            indices.insert(indices.end(), lodIndices[r].begin(), lodIndices[r].end());
+
+            range.firstLod = static_cast<uint32_t>(result.lods.size());
+            range.lodCount = static_cast<uint32_t>(rangeLods[r].size());
+            result.lods.insert(result.lods.end(), rangeLods[r].begin(), rangeLods[r].end());
         }
-        geometries.reserve(estimatedGeometries);
+        result.indices = std::move(indices);
     }
 
-    // Process all scenes
-    int defaultScene = model.defaultScene >= 0 ? model.defaultScene : 0;
-    for (int sceneIndex : model.scenes[defaultScene].nodes) {
-        processNode(model, sceneIndex, glm::mat4(1.0f), geometries);
+    auto lodEnd = Clock::now();
+
+    if (options.buildMeshlets) {
+        std::vector<std::vector<Meshlet>> rangeMeshlets(result.ranges.size());
+        std::vector<std::vector<uint32_t>> rangeVertices(result.ranges.size());
+        std::vector<std::vector<uint8_t>> rangeTriangles(result.ranges.size());
+        jobSystem().parallelFor(result.ranges.size(), [&](size_t r) {
+            const GeometryRange& range = result.ranges[r];
+            buildRangeMeshlets(
+                result.vertices.data() + range.firstVertex,
+                result.indices.data() + range.firstIndex,
+                range, rangeMeshlets[r], rangeVertices[r], rangeTriangles[r]
+            );
+        });
+
+        for (size_t r = 0; r < result.ranges.size(); ++r) {
+            GeometryRange& range = result.ranges[r];
+            range.firstMeshlet = static_cast<uint32_t>(result.meshlets.size());
+            range.meshletCount = static_cast<uint32_t>(rangeMeshlets[r].size());
+            range.firstMeshletVertex = static_cast<uint32_t>(result.meshletVertices.size());
+            range.firstMeshletTriangle = static_cast<uint32_t>(result.meshletTriangles.size());
+            result.meshlets.insert(result.meshlets.end(),
+                rangeMeshlets[r].begin(), rangeMeshlets[r].end());
+            result.meshletVertices.insert(result.meshletVertices.end(),
+                rangeVertices[r].begin(), rangeVertices[r].end());
+            result.meshletTriangles.insert(result.meshletTriangles.end(),
+                rangeTriangles[r].begin(), rangeTriangles[r].end());
+        }
     }
 
-    // Consolidate all geometries into single buffers
-    ModelData result;
+    auto meshletEnd = Clock::now();
+
+    if (processIndices) {
+        narrowRangeIndices(result);
+    }
 
     // Extract cameras from GLTF {{{
     for (size_t i = 0; i < model.cameras.size(); ++i) {
@@ -650,19 +1828,97 @@ ModelData loadModel(const std::filesystem::path& path, const std::filesystem::pa
     fs::path parentPath = path.parent_path();
     fs::path projRoot = projectRoot.empty() ? fs::path() : projectRoot;
 
+    // Embedded images get a virtual path and keep their encoded bytes: GLB
+    // BIN chunk images are viewed in the source mapping, anything else
+    // (data URIs, images in other buffers) is copied once
+    std::vector<EmbeddedImage> embeddedImages(model.images.size());
+    std::vector<std::pair<size_t, std::pair<size_t, size_t>>> copiedImages;
+    auto embeddedData = std::make_shared<std::vector<uint8_t>>();
+    bool viewsSource = false;
+    auto copyImage = [&](size_t imageIndex, const uint8_t* bytes, size_t size) {
+        copiedImages.push_back({imageIndex, {embeddedData->size(), size}});
+        embeddedData->insert(embeddedData->end(), bytes, bytes + size);
+    };
+
+    // A selective load only resolves the textures of the materials it uses
+    std::vector<bool> textureUsed(model.textures.size(), !selective);
+    if (selective) {
+        for (const GeometryRange& range : result.ranges) {
+            if (range.materialIndex < 0 ||
+                static_cast<size_t>(range.materialIndex) >= model.materials.size()) {
+                continue;
+            }
+            const auto& mat = model.materials[range.materialIndex];
+            for (int texture : {mat.pbrMetallicRoughness.baseColorTexture.index,
+                                mat.pbrMetallicRoughness.metallicRoughnessTexture.index,
+                                mat.emissiveTexture.index, mat.normalTexture.index}) {
+                if (texture >= 0 && static_cast<size_t>(texture) < textureUsed.size()) {
+                    textureUsed[texture] = true;
+                }
+            }
+        }
+    }
+
     // Collect texture URIs for batch resolution
     std::vector<std::pair<size_t, std::string>> texturesToResolve;
     texturesToResolve.reserve(model.textures.size());
-    for (const auto& tex : model.textures) {
-        if (tex.source >= 0 && static_cast<size_t>(tex.source) < model.images.size()) {
-            texturesToResolve.emplace_back(tex.source, model.images[tex.source].uri);
+    std::vector<fs::path> embeddedPaths(model.images.size());
+    for (size_t t = 0; t < model.textures.size(); ++t) {
+        const auto& tex = model.textures[t];
+        if (!textureUsed[t]) {
+            continue;
+        }
+        const int source = textureImageIndex(tex);
+        if (source < 0 || static_cast<size_t>(source) >= model.images.size()) {
+            continue;
+        }
+        const size_t imageIndex = static_cast<size_t>(source);
+        const tinygltf::Image& image = model.images[imageIndex];
+        if (image.bufferView < 0 && image.image.empty()) {
+            texturesToResolve.emplace_back(imageIndex, image.uri);
+            continue;
+        }
+        if (!embeddedPaths[imageIndex].empty()) {
+            continue;  // Shared by several textures
+        }
+
+        embeddedPaths[imageIndex] = embeddedImagePath(path, imageIndex);
+        embeddedImages[imageIndex].mimeType = image.mimeType;
+        if (image.bufferView < 0) {
+            copyImage(imageIndex, image.image.data(), image.image.size());
+            continue;
+        }
+        if (static_cast<size_t>(image.bufferView) >= model.bufferViews.size()) {
+            throw std::runtime_error("Image bufferView out of range in " + pathStr);
+        }
+        const tinygltf::BufferView& view = model.bufferViews[image.bufferView];
+        if (view.buffer < 0 || static_cast<size_t>(view.buffer) >= buffers.size() ||
+            view.byteOffset + view.byteLength > buffers[view.buffer].size()) {
+            throw std::runtime_error("Image bufferView out of range in " + pathStr);
+        }
+        const std::span<const uint8_t> bytes =
+            buffers[view.buffer].subspan(view.byteOffset, view.byteLength);
+        if (bufferInSource[view.buffer]) {
+            embeddedImages[imageIndex].bytes = bytes;
+            viewsSource = true;
+        } else {
+            copyImage(imageIndex, bytes.data(), bytes.size());
         }
     }
+    for (const auto& [imageIndex, range] : copiedImages) {
+        embeddedImages[imageIndex].bytes =
+            std::span<const uint8_t>(*embeddedData).subspan(range.first, range.second);
+    }
 
     // Resolve all texture paths in parallel
     auto resolvedPaths = findTexturePathsBatch(
         parentPath, projRoot, texturesToResolve, model.images.size()
     );
+    for (size_t i = 0; i < embeddedPaths.size(); ++i) {
+        if (!embeddedPaths[i].empty()) {
+            resolvedPaths[i] = std::move(embeddedPaths[i]);
+        }
+    }
 
     // Build mapping from GLTF image index to our allTexturePaths index
     // This deduplicates textures used by multiple materials
@@ -671,15 +1927,23 @@ ModelData loadModel(const std::filesystem::path& path, const std::filesystem::pa
         if (!resolvedPaths[i].empty()) {
             imageIndexToPathIndex[static_cast<int>(i)] = static_cast<int>(result.allTexturePaths.size());
             result.allTexturePaths.push_back(resolvedPaths[i]);
+            result.embeddedImages.push_back(std::move(embeddedImages[i]));
         }
     }
 
+    if (!copiedImages.empty()) {
+        result.embeddedImageData = std::move(embeddedData);
+    }
+    if (viewsSource) {
+        result.sourceMapping = sourceMapping;
+    }
+
     // Helper to get texture index from GLTF texture info
     auto getTextureIndex = [&](int gltfTextureIndex) -> int {
         if (gltfTextureIndex < 0 || static_cast<size_t>(gltfTextureIndex) >= model.textures.size()) {
             return -1;
         }
-        int imageIndex = model.textures[gltfTextureIndex].source;
+        int imageIndex = textureImageIndex(model.textures[gltfTextureIndex]);
         auto it = imageIndexToPathIndex.find(imageIndex);
         return (it != imageIndexToPathIndex.end()) ? it->second : -1;
     };
@@ -744,94 +2008,390 @@ ModelData loadModel(const std::filesystem::path& path, const std::filesystem::pa
     }
     // }}}
 
-    // Pre-allocate result vectors to avoid reallocations
-    {
-        size_t totalVerts = 0;
-        size_t totalIndices = 0;
-        for (const auto& geom : geometries) {
-            totalVerts += geom.vertices.size();
-            totalIndices += geom.indices.size();
+    auto totalEnd = Clock::now();
+    result.timings.parseMs = Ms(parseEnd - totalStart).count();
+    result.timings.dataUriMs = Ms(dataUriEnd - parseEnd).count();
+    result.timings.dataUriBytes = dataUriBytes;
+    result.timings.meshoptMs = Ms(meshoptEnd - dataUriEnd).count();
+    result.timings.meshoptBytes = meshoptBytes;
+    for (size_t b = 0; b < buffers.size(); ++b) {
+        result.timings.bufferBytes += buffers[b].size();
+    }
+    for (size_t v = 0; v < viewsRead.size(); ++v) {
+        if (viewsRead[v]) {
+            result.timings.bufferBytesRead += model.bufferViews[v].byteLength;
         }
+    }
+    result.timings.decodeMs = Ms(decodeEnd - meshoptEnd).count();
+    result.timings.optimizeMs = Ms(optimizeEnd - decodeEnd).count();
+    result.timings.lodMs = Ms(lodEnd - optimizeEnd).count();
+    result.timings.meshletMs = Ms(meshletEnd - lodEnd).count();
+    result.timings.assembleMs = Ms(totalEnd - meshletEnd).count();
+    result.timings.totalMs = Ms(totalEnd - totalStart).count();
+    result.instanced = options.preserveInstancing;
+    result.timings.primitiveCount = static_cast<uint32_t>(primitiveCount);
+    result.timings.decodeThreads = decodeThreads;
+    result.timings.geometryBytes = result.vertices.size() * sizeof(Vertex) +
+        result.indices.size() * sizeof(uint32_t) +
+        result.indices16.size() * sizeof(uint16_t) +
+        result.meshlets.size() * sizeof(Meshlet) +
+        result.meshletVertices.size() * sizeof(uint32_t) +
+        result.meshletTriangles.size();
 
-        // Check for overflow before casting to uint32_t for Vulkan
-        constexpr size_t maxUint32 = static_cast<size_t>(UINT32_MAX);
-        if (totalVerts > maxUint32) {
-            throw std::runtime_error("Model has too many vertices (" +
-                std::to_string(totalVerts) + ") - exceeds uint32_t maximum");
-        }
-        if (totalIndices > maxUint32) {
-            throw std::runtime_error("Model has too many indices (" +
-                std::to_string(totalIndices) + ") - exceeds uint32_t maximum");
+#ifndef NDEBUG
+    std::cout << "Model loaded in " << result.timings.totalMs << "ms (parse "
+        << result.timings.parseMs << "ms, decode " << result.timings.decodeMs
+        << "ms on " << decodeThreads << " threads, assemble "
+        << result.timings.assembleMs << "ms, "
+        << result.timings.geometryBytes / (1024.0 * 1024.0) << " MB geometry)" << std::endl;
+    if (selective) {
+        std::cout << "  Selected " << options.nodeSelection.size() << " nodes: read "
+            << result.timings.bufferBytesRead / (1024.0 * 1024.0) << " of "
+            << result.timings.bufferBytes / (1024.0 * 1024.0) << " MB of buffers" << std::endl;
+    }
+    if (result.timings.dataUriBytes > 0) {
+        const double megabytes = result.timings.dataUriBytes / (1024.0 * 1024.0);
+        std::cout << "  Data URIs decoded " << megabytes << " MB in "
+            << result.timings.dataUriMs << "ms ("
+            << megabytes / std::max(result.timings.dataUriMs / 1000.0, 1e-9) << " MB/s)" << std::endl;
+    }
+    if (result.timings.meshoptBytes > 0) {
+        const double megabytes = result.timings.meshoptBytes / (1024.0 * 1024.0);
+        std::cout << "  Meshopt decoded " << megabytes << " MB in "
+            << result.timings.meshoptMs << "ms ("
+            << megabytes / std::max(result.timings.meshoptMs / 1000.0, 1e-9) << " MB/s)" << std::endl;
+    }
+    if (result.optimization.applied) {
+        std::cout << "  Optimized in " << result.timings.optimizeMs << "ms: ACMR "
+            << result.optimization.acmrBefore << " -> " << result.optimization.acmrAfter
+            << ", ATVR " << result.optimization.atvrBefore << " -> "
+            << result.optimization.atvrAfter << std::endl;
+    }
+    if (!result.lods.empty()) {
+        std::cout << "  " << result.lods.size() << " LOD levels over "
+            << result.ranges.size() << " ranges in " << result.timings.lodMs << "ms" << std::endl;
+    }
+    if (!result.meshlets.empty()) {
+        MeshletStats stats = meshletStats(result);
+        std::cout << "  " << stats.meshletCount << " meshlets in " << result.timings.meshletMs
+            << "ms (" << stats.averageVertices << " vertices, " << stats.averageTriangles
+            << " triangles on average)" << std::endl;
+    }
+#endif
+
+    return result;
+}
+
+ModelData loadModel(
+    const std::filesystem::path& path,
+    const std::filesystem::path& projectRoot,
+    const ModelLoadOptions& options
+) {
+    using Clock = std::chrono::high_resolution_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    if (options.useMeshCache) {
+        auto cacheStart = Clock::now();
+        ModelData cached;
+        if (readMeshCache(path, projectRoot, options, cached)) {
+            auto cacheEnd = Clock::now();
+            cached.timings.cacheHit = true;
+            cached.timings.cacheMs = Ms(cacheEnd - cacheStart).count();
+            cached.timings.totalMs = cached.timings.cacheMs;
+            cached.timings.primitiveCount = static_cast<uint32_t>(cached.ranges.size());
+            cached.timings.geometryBytes = cached.vertexSpan().size_bytes() +
+                cached.indexSpan().size_bytes() + cached.index16Span().size_bytes() +
+                cached.meshletSpan().size_bytes() + cached.meshletVertexSpan().size_bytes() +
+                cached.meshletTriangleSpan().size_bytes();
+#ifndef NDEBUG
+            std::cout << "Model loaded from cache in " << cached.timings.totalMs << "ms ("
+                << cached.timings.geometryBytes / (1024.0 * 1024.0) << " MB geometry mapped)"
+                << std::endl;
+#endif
+            return cached;
         }
+    }
+
+    std::vector<std::filesystem::path> dependencies;
+    ModelData result = loadModelFromSource(path, projectRoot, options, dependencies);
 
-        result.vertices.reserve(totalVerts);
-        result.indices.reserve(totalIndices);
-        result.ranges.reserve(geometries.size());
+    if (options.useMeshCache) {
+        auto cacheStart = Clock::now();
+        writeMeshCache(path, projectRoot, options, result, dependencies);
+        result.timings.cacheMs = Ms(Clock::now() - cacheStart).count();
+        result.timings.totalMs += result.timings.cacheMs;
     }
 
-    uint32_t vertexOffset = 0;
-    uint32_t indexOffset = 0;
+    return result;
+}
+
+void loadModelGeometry(
+    const ModelData& data,
+    uint32_t geometryIndex,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices
+) {
+    auto vertices = geometryVertices(data, geometryIndex);
+    IndexView indices = geometryIndices(data, geometryIndex);
+
+    // Indices are already relative to each geometry's vertex buffer
+    outVertices.assign(vertices.begin(), vertices.end());
+    outIndices.resize(indices.size());
+    if (indices.type == VK_INDEX_TYPE_UINT16) {
+        simd::kernels().widenIndices16(
+            static_cast<const uint16_t*>(indices.data), outIndices.data(), indices.size()
+        );
+    } else {
+        std::memcpy(outIndices.data(), indices.data, indices.size_bytes());
+    }
+}
 
-    for (const auto& geom : geometries) {
-        // Check individual geometry sizes before casting
-        if (geom.vertices.size() > UINT32_MAX) {
-            throw std::runtime_error("Geometry has too many vertices (" +
-                std::to_string(geom.vertices.size()) + ")");
-        }
-        if (geom.indices.size() > UINT32_MAX) {
-            throw std::runtime_error("Geometry has too many indices (" +
-                std::to_string(geom.indices.size()) + ")");
+std::span<const Vertex> geometryVertices(const ModelData& data, uint32_t geometryIndex) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
+    }
+
+    const auto& range = data.ranges[geometryIndex];
+    return data.vertexSpan().subspan(range.firstVertex, range.vertexCount);
+}
+
+/// `count` indices of `range`, from whichever array its index type selects
+static IndexView rangeIndices(const ModelData& data, const GeometryRange& range, uint32_t count) {
+    if (range.indexType == VK_INDEX_TYPE_UINT16) {
+        return {data.index16Span().subspan(range.firstIndex, count).data(), count, VK_INDEX_TYPE_UINT16};
+    }
+    return {data.indexSpan().subspan(range.firstIndex, count).data(), count, VK_INDEX_TYPE_UINT32};
+}
+
+IndexView geometryIndices(const ModelData& data, uint32_t geometryIndex) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
+    }
+
+    const auto& range = data.ranges[geometryIndex];
+    return rangeIndices(data, range, range.indexCount);
+}
+
+IndexView geometryLodIndices(const ModelData& data, uint32_t geometryIndex) {
+    auto lods = geometryLods(data, geometryIndex);
+    const auto& range = data.ranges[geometryIndex];
+    uint32_t count = range.indexCount;
+    for (const auto& lod : lods) {
+        count = std::max(count, lod.firstIndex + lod.indexCount);
+    }
+    return rangeIndices(data, range, count);
+}
+
+std::span<const GeometryLod> geometryLods(const ModelData& data, uint32_t geometryIndex) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
+    }
+
+    const auto& range = data.ranges[geometryIndex];
+    if (range.firstLod + range.lodCount > data.lods.size()) {
+        throw std::runtime_error("LOD range out of bounds for geometry " +
+            std::to_string(geometryIndex));
+    }
+    return std::span<const GeometryLod>(data.lods).subspan(range.firstLod, range.lodCount);
+}
+
+MeshletView geometryMeshlets(const ModelData& data, uint32_t geometryIndex) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
+    }
+
+    const auto& range = data.ranges[geometryIndex];
+    if (range.meshletCount == 0) {
+        return {};
+    }
+    auto meshlets = data.meshletSpan();
+    if (static_cast<size_t>(range.firstMeshlet) + range.meshletCount > meshlets.size()) {
+        throw std::runtime_error("Meshlet range out of bounds for geometry " +
+            std::to_string(geometryIndex));
+    }
+
+    MeshletView view;
+    view.meshlets = meshlets.subspan(range.firstMeshlet, range.meshletCount);
+    const Meshlet& last = view.meshlets.back();
+    const size_t vertexCount = static_cast<size_t>(last.vertexOffset) + last.vertexCount;
+    const size_t triangleBytes = static_cast<size_t>(last.triangleOffset) + last.triangleCount * 3;
+    auto vertices = data.meshletVertexSpan();
+    auto triangles = data.meshletTriangleSpan();
+    if (range.firstMeshletVertex + vertexCount > vertices.size() ||
+        range.firstMeshletTriangle + triangleBytes > triangles.size()) {
+        throw std::runtime_error("Meshlet data out of bounds for geometry " +
+            std::to_string(geometryIndex));
+    }
+    view.vertices = vertices.subspan(range.firstMeshletVertex, vertexCount);
+    view.triangles = triangles.subspan(range.firstMeshletTriangle, triangleBytes);
+    return view;
+}
+
+MeshletStats meshletStats(const ModelData& data) {
+    MeshletStats stats;
+    size_t vertices = 0, triangles = 0;
+    for (const Meshlet& meshlet : data.meshletSpan()) {
+        vertices += meshlet.vertexCount;
+        triangles += meshlet.triangleCount;
+    }
+    stats.meshletCount = data.meshletSpan().size();
+    if (stats.meshletCount > 0) {
+        stats.averageVertices = static_cast<float>(vertices) / static_cast<float>(stats.meshletCount);
+        stats.averageTriangles = static_cast<float>(triangles) / static_cast<float>(stats.meshletCount);
+        stats.vertexFill = stats.averageVertices / static_cast<float>(kMeshletMaxVertices);
+        stats.triangleFill = stats.averageTriangles / static_cast<float>(kMeshletMaxTriangles);
+    }
+    return stats;
+}
+
+std::filesystem::path embeddedImagePath(
+    const std::filesystem::path& modelPath,
+    size_t imageIndex
+) {
+    std::filesystem::path result = modelPath;
+    result += "#" + std::to_string(imageIndex);
+    return result;
+}
+
+bool isEmbeddedImagePath(const std::filesystem::path& path) {
+    const std::string name = path.filename().string();
+    const size_t hash = name.rfind('#');
+    if (hash == std::string::npos || hash + 1 == name.size()) {
+        return false;
+    }
+    const std::string model = name.substr(0, hash);
+    const bool isModel = model.ends_with(".glb") || model.ends_with(".gltf");
+    return isModel && name.find_first_not_of("0123456789", hash + 1) == std::string::npos;
+}
+
+ModelOutline inspectModel(const std::filesystem::path& path) {
+    using Clock = std::chrono::high_resolution_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+    auto start = Clock::now();
+
+    const MappedFile file(path);
+    const std::string_view jsonText = gltfJson(file.bytes(), path.extension() == ".glb");
+    const nlohmann::json doc = nlohmann::json::parse(jsonText, nullptr, false);
+    if (doc.is_discarded() || !doc.is_object()) {
+        throw std::runtime_error("Failed to parse glTF JSON: " + path.string());
+    }
+    auto array = [&](const char* key) -> const nlohmann::json& {
+        static const nlohmann::json empty = nlohmann::json::array();
+        auto it = doc.find(key);
+        return it != doc.end() && it->is_array() ? *it : empty;
+    };
+    auto index = [](const nlohmann::json& object, const char* key, size_t count) {
+        auto it = object.find(key);
+        if (it == object.end() || !it->is_number_integer()) {
+            return -1;
         }
+        const int value = it->get<int>();
+        return value >= 0 && static_cast<size_t>(value) < count ? value : -1;
+    };
 
-        GeometryRange range{};
-        range.firstVertex = vertexOffset;
-        range.vertexCount = static_cast<uint32_t>(geom.vertices.size());
-        range.firstIndex = indexOffset;
-        range.indexCount = static_cast<uint32_t>(geom.indices.size());
-        range.materialIndex = geom.materialIndex;
+    ModelOutline outline;
+    const auto& accessors = array("accessors");
+    auto accessorCount = [&](int accessor) -> uint64_t {
+        return accessor >= 0 ? accessors[accessor].value<uint64_t>("count", 0) : 0;
+    };
+
+    for (const auto& mesh : array("meshes")) {
+        ModelOutlineMesh& out = outline.meshes.emplace_back();
+        out.name = mesh.value("name", "Mesh " + std::to_string(outline.meshes.size() - 1));
+        auto primitives = mesh.find("primitives");
+        if (primitives == mesh.end() || !primitives->is_array()) {
+            continue;
+        }
+        out.primitiveCount = static_cast<uint32_t>(primitives->size());
+        for (const auto& primitive : *primitives) {
+            auto attributes = primitive.find("attributes");
+            if (attributes != primitive.end() && attributes->is_object()) {
+                out.vertexCount += accessorCount(index(*attributes, "POSITION", accessors.size()));
+            }
+            out.indexCount += accessorCount(index(primitive, "indices", accessors.size()));
+        }
+    }
 
-        // Check for offset overflow before incrementing
-        if (vertexOffset > UINT32_MAX - range.vertexCount) {
-            throw std::runtime_error("Vertex offset overflow at geometry with " +
-                std::to_string(range.vertexCount) + " vertices (current offset: " +
-                std::to_string(vertexOffset) + ")");
+    const auto& nodes = array("nodes");
+    outline.nodes.resize(nodes.size());
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        ModelOutlineNode& out = outline.nodes[n];
+        out.name = nodes[n].value("name", std::string());
+        if (out.name.empty()) {
+            out.name = "Node " + std::to_string(n);
+        }
+        out.mesh = index(nodes[n], "mesh", outline.meshes.size());
+        auto children = nodes[n].find("children");
+        if (children == nodes[n].end() || !children->is_array()) {
+            continue;
+        }
+        for (const auto& child : *children) {
+            if (child.is_number_integer() && child.get<int>() >= 0 &&
+                child.get<size_t>() < nodes.size()) {
+                out.children.push_back(child.get<int32_t>());
+            }
         }
-        if (indexOffset > UINT32_MAX - range.indexCount) {
-            throw std::runtime_error("Index offset overflow at geometry with " +
-                std::to_string(range.indexCount) + " indices (current offset: " +
-                std::to_string(indexOffset) + ")");
+    }
+    for (size_t n = 0; n < outline.nodes.size(); ++n) {
+        for (int32_t child : outline.nodes[n].children) {
+            outline.nodes[child].parent = static_cast<int32_t>(n);
         }
+    }
 
-        result.ranges.push_back(range);
+    const auto& scenes = array("scenes");
+    const int scene = std::max(index(doc, "scene", scenes.size()), 0);
+    if (static_cast<size_t>(scene) < scenes.size()) {
+        auto roots = scenes[scene].find("nodes");
+        if (roots != scenes[scene].end() && roots->is_array()) {
+            for (const auto& root : *roots) {
+                if (root.is_number_integer() && root.get<int>() >= 0 &&
+                    root.get<size_t>() < nodes.size()) {
+                    outline.roots.push_back(root.get<int32_t>());
+                }
+            }
+        }
+    }
 
-        // Add vertices
-        result.vertices.insert(result.vertices.end(), geom.vertices.begin(), geom.vertices.end());
+    for (const auto& buffer : array("buffers")) {
+        outline.bufferBytes += buffer.value<uint64_t>("byteLength", 0);
+    }
 
-        // Add indices as-is (NOT rebased to absolute)
-        // The ranges contain firstVertex which tells us where each geometry's vertices start
-        // This allows consumers to either:
-        // 1. Use the full consolidated buffer with vkCmdDrawIndexed(..., firstVertex=range.firstVertex)
-        // 2. Create per-geometry slices where indices remain relative
-        result.indices.insert(result.indices.end(), geom.indices.begin(), geom.indices.end());
+    outline.parseMs = Ms(Clock::now() - start).count();
+    return outline;
+}
 
-        vertexOffset += range.vertexCount;
-        indexOffset += range.indexCount;
+glm::mat4 geometryTransform(const ModelData& data, uint32_t geometryIndex) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
     }
 
-#ifndef NDEBUG
-    auto totalEnd = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> totalMs = totalEnd - totalStart;
-    std::cout << "Model loaded in " << totalMs.count() << "ms" << std::endl;
-#endif
+    const auto& range = data.ranges[geometryIndex];
+    if (!data.hierarchical || range.node < 0 ||
+        static_cast<size_t>(range.node) >= data.nodes.size()) {
+        return glm::mat4(1.0f);
+    }
+    return data.nodes[range.node].worldTransform;
+}
 
-    return result;
+void updateWorldTransforms(ModelData& data) {
+    // Parents precede their children, so one forward pass suffices
+    for (auto& node : data.nodes) {
+        node.worldTransform = node.parent >= 0
+            ? data.nodes[node.parent].worldTransform * node.localTransform
+            : node.localTransform;
+    }
 }
 
-void loadModelGeometry(
+void geometryBounds(
     const ModelData& data,
     uint32_t geometryIndex,
-    std::vector<Vertex>& outVertices,
-    std::vector<uint32_t>& outIndices
+    glm::vec3& outMin,
+    glm::vec3& outMax
 ) {
     if (geometryIndex >= data.ranges.size()) {
         throw std::runtime_error("Geometry index out of range: " +
@@ -839,48 +2399,154 @@ void loadModelGeometry(
     }
 
     const auto& range = data.ranges[geometryIndex];
+    const bool instanced = range.instanceCount > 0 &&
+        range.firstInstance + range.instanceCount <= data.instances.size();
+    if (!instanced && !data.hierarchical) {
+        outMin = range.boundsMin;
+        outMax = range.boundsMax;
+        return;
+    }
 
-    // Extract vertices for this geometry
-    outVertices.assign(
-        data.vertices.begin() + range.firstVertex,
-        data.vertices.begin() + range.firstVertex + range.vertexCount
-    );
+    // Union of every instance's transformed box corners
+    const glm::mat4 nodeTransform = geometryTransform(data, geometryIndex);
+    const uint32_t transformCount = instanced ? range.instanceCount : 1;
+    outMin = glm::vec3(std::numeric_limits<float>::max());
+    outMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < transformCount; ++i) {
+        const glm::mat4& transform = instanced
+            ? data.instances[range.firstInstance + i].transform
+            : nodeTransform;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 p(
+                (corner & 1) ? range.boundsMax.x : range.boundsMin.x,
+                (corner & 2) ? range.boundsMax.y : range.boundsMin.y,
+                (corner & 4) ? range.boundsMax.z : range.boundsMin.z
+            );
+            glm::vec3 world = glm::vec3(transform * glm::vec4(p, 1.0f));
+            outMin = glm::min(outMin, world);
+            outMax = glm::max(outMax, world);
+        }
+    }
+}
+
+uint32_t selectLod(
+    std::span<const GeometryLod> lods,
+    const glm::vec3& boundsMin,
+    const glm::vec3& boundsMax,
+    const glm::mat4& view,
+    const glm::mat4& proj,
+    float viewportHeight,
+    float maxPixelError
+) {
+    if (lods.size() <= 1) {
+        return 0;
+    }
+
+    const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    const float radius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    // Pixels per world unit at the nearest point of the bounding sphere.
+    // proj[1][1] is cot(fovy / 2) for perspective and 2 / height for
+    // orthographic projections (proj[3][3] == 1), where distance is irrelevant.
+    float pixelsPerUnit = std::abs(proj[1][1]) * viewportHeight * 0.5f;
+    if (proj[3][3] == 0.0f) {
+        const float distance = glm::length(glm::vec3(view * glm::vec4(center, 1.0f))) - radius;
+        if (distance <= 0.0f) {
+            return 0;  // Camera inside the bounds
+        }
+        pixelsPerUnit /= distance;
+    }
+
+    uint32_t selected = 0;
+    for (uint32_t l = 1; l < lods.size(); ++l) {
+        if (lods[l].error * pixelsPerUnit > maxPixelError) {
+            break;
+        }
+        selected = l;
+    }
+    return selected;
+}
+
+void loadModelInstances(
+    const ModelData& data,
+    uint32_t geometryIndex,
+    std::vector<InstanceData>& outInstances
+) {
+    if (geometryIndex >= data.ranges.size()) {
+        throw std::runtime_error("Geometry index out of range: " +
+            std::to_string(geometryIndex) + " >= " + std::to_string(data.ranges.size()));
+    }
+
+    const auto& range = data.ranges[geometryIndex];
+    if (range.firstInstance + range.instanceCount > data.instances.size()) {
+        throw std::runtime_error("Instance range out of bounds for geometry " +
+            std::to_string(geometryIndex));
+    }
 
-    // Extract indices for this geometry (they are already relative to each geometry's vertex buffer)
-    outIndices.assign(
-        data.indices.begin() + range.firstIndex,
-        data.indices.begin() + range.firstIndex + range.indexCount
+    outInstances.assign(
+        data.instances.begin() + range.firstInstance,
+        data.instances.begin() + range.firstInstance + range.instanceCount
     );
 }
 
-std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(const std::vector<std::filesystem::path>& paths) {
+std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(
+    const std::vector<std::filesystem::path>& paths,
+    const ModelLoadOptions& options
+) {
+    // Repeated paths share the options, so each is loaded once
+    std::unordered_set<std::filesystem::path> seen;
+    std::vector<std::pair<std::filesystem::path, ModelLoadOptions>> requests;
+    requests.reserve(paths.size());
+    for (const auto& path : paths) {
+        if (seen.insert(path).second) {
+            requests.emplace_back(path, options);
+        }
+    }
+    return loadModelsAsync(requests);
+}
+
+std::unordered_map<std::filesystem::path, ModelData> loadModelsAsync(
+    const std::vector<std::pair<std::filesystem::path, ModelLoadOptions>>& requests
+) {
 #ifndef NDEBUG
     auto totalStart = std::chrono::high_resolution_clock::now();
+    const JobLaneStats poolBefore = jobSystem().stats().cpu;
 #endif
 
-    // Launch async tasks for each model
-    std::vector<std::future<std::pair<std::filesystem::path, ModelData>>> futures;
-    futures.reserve(paths.size());
-
-    for (const auto& path : paths) {
-        futures.push_back(std::async(std::launch::async, [path]() {
-            return std::make_pair(path, loadModel(path));
-        }));
+    // Results are keyed by path, which holds one set of options
+    std::unordered_set<std::filesystem::path> seen;
+    for (const auto& [path, options] : requests) {
+        if (!seen.insert(path).second) {
+            throw std::runtime_error("Model requested more than once: " + path.string());
+        }
     }
 
-    // Collect results
-    std::unordered_map<std::filesystem::path, ModelData> results;
-    results.reserve(paths.size());
+    // Each model loads on the shared pool; the loaders inside spread their
+    // own work over the same workers instead of starting more threads
+    std::vector<ModelData> loaded(requests.size());
+    jobSystem().parallelFor(requests.size(), [&](size_t i) {
+        loaded[i] = loadModel(requests[i].first, "", requests[i].second);
+    });
 
-    for (auto& future : futures) {
-        auto [path, data] = future.get();
-        results[path] = std::move(data);
+    std::unordered_map<std::filesystem::path, ModelData> results;
+    results.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        results[requests[i].first] = std::move(loaded[i]);
     }
 
 #ifndef NDEBUG
     auto totalEnd = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> totalMs = totalEnd - totalStart;
-    std::cout << "All models loaded in " << totalMs.count() << "ms (async, " << paths.size() << " models)" << std::endl;
+    std::cout << "All models loaded in " << totalMs.count() << "ms (async, " << requests.size() << " models)" << std::endl;
+
+    JobLaneStats pool = jobSystem().stats().cpu;
+    pool.jobsCompleted -= poolBefore.jobsCompleted;
+    pool.jobsStolen -= poolBefore.jobsStolen;
+    pool.busyMs -= poolBefore.busyMs;
+    pool.wallMs -= poolBefore.wallMs;
+    std::cout << "  Job system: " << pool.threads << " CPU threads, "
+        << pool.utilization() * 100.0f << "% busy, " << pool.jobsCompleted << " jobs ("
+        << pool.jobsStolen << " stolen)" << std::endl;
 #endif
 
     return results;
@@ -0,0 +1,948 @@
+// vim:foldmethod=marker
+#include <vkDuck/simd_kernels.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VKDUCK_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC allows any intrinsic in any function, no per-function target needed
+#define VKDUCK_TARGET(isa)
+#else
+#define VKDUCK_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VKDUCK_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace simd {
+namespace {
+
+// Scalar kernels {{{
+void widenIndices16Scalar(const uint16_t* src, uint32_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void widenIndices8Scalar(const uint8_t* src, uint32_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void narrowIndices32Scalar(const uint32_t* src, uint16_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<uint16_t>(src[i]);
+    }
+}
+
+void widenIndices8To16Scalar(const uint8_t* src, uint16_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void transformPositionsScalar(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        float v[3];
+        std::memcpy(v, s, sizeof(v));
+        float r[3];
+        for (int row = 0; row < 3; ++row) {
+            r[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row];
+        }
+        std::memcpy(d, r, sizeof(r));
+    }
+}
+
+void transformDirectionsScalar(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        float v[3];
+        std::memcpy(v, s, sizeof(v));
+        float r[3];
+        for (int row = 0; row < 3; ++row) {
+            r[row] = m[row] * v[0] + m[3 + row] * v[1] + m[6 + row] * v[2];
+        }
+        float invLength = 1.0f / std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+        for (float& c : r) {
+            c *= invLength;
+        }
+        std::memcpy(d, r, sizeof(r));
+    }
+}
+
+void computeBoundsScalar(
+    const void* src, size_t stride, size_t count,
+    float outMin[3], float outMax[3]
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    float mn[3], mx[3];
+    std::memcpy(mn, s, sizeof(mn));
+    std::memcpy(mx, s, sizeof(mx));
+    for (size_t i = 1; i < count; ++i) {
+        s += stride;
+        float v[3];
+        std::memcpy(v, s, sizeof(v));
+        for (int c = 0; c < 3; ++c) {
+            mn[c] = std::min(mn[c], v[c]);
+            mx[c] = std::max(mx[c], v[c]);
+        }
+    }
+    std::memcpy(outMin, mn, sizeof(mn));
+    std::memcpy(outMax, mx, sizeof(mx));
+}
+
+/// Value of each base64 character, 0xFF for characters outside the alphabet
+constexpr std::array<uint8_t, 256> kBase64Values = []() {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (uint8_t v = 0; v < 64; ++v) {
+        values[static_cast<uint8_t>(alphabet[v])] = v;
+    }
+    return values;
+}();
+
+bool decodeBase64Scalar(const char* src, size_t quadCount, uint8_t* dst) {
+    for (size_t q = 0; q < quadCount; ++q, src += 4, dst += 3) {
+        const uint32_t a = kBase64Values[static_cast<uint8_t>(src[0])];
+        const uint32_t b = kBase64Values[static_cast<uint8_t>(src[1])];
+        const uint32_t c = kBase64Values[static_cast<uint8_t>(src[2])];
+        const uint32_t d = kBase64Values[static_cast<uint8_t>(src[3])];
+        if ((a | b | c | d) & 0x80) {
+            return false;
+        }
+        const uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+        dst[0] = static_cast<uint8_t>(bits >> 16);
+        dst[1] = static_cast<uint8_t>(bits >> 8);
+        dst[2] = static_cast<uint8_t>(bits);
+    }
+    return true;
+}
+
+void downsample2x2Scalar(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth) {
+    for (size_t x = 0; x < dstWidth; ++x, row0 += 8, row1 += 8, dst += 4) {
+        for (int c = 0; c < 4; ++c) {
+            dst[c] = static_cast<uint8_t>((row0[c] + row0[c + 4] + row1[c] + row1[c + 4] + 2) >> 2);
+        }
+    }
+}
+
+void projectPixelsScalar(const uint8_t* pixels, const int16_t axis[4], int32_t* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i, pixels += 4) {
+        dst[i] = pixels[0] * axis[0] + pixels[1] * axis[1] + pixels[2] * axis[2] + pixels[3] * axis[3];
+    }
+}
+
+constexpr KernelTable kScalarKernels{
+    Isa::Scalar,
+    widenIndices16Scalar,
+    widenIndices8Scalar,
+    narrowIndices32Scalar,
+    widenIndices8To16Scalar,
+    transformPositionsScalar,
+    transformDirectionsScalar,
+    computeBoundsScalar,
+    decodeBase64Scalar,
+    downsample2x2Scalar,
+    projectPixelsScalar,
+};
+// }}}
+
+#if defined(VKDUCK_SIMD_X86)
+// SSE4.1 kernels {{{
+/// Load x, y, z without reading past the third float; w = 0
+VKDUCK_TARGET("sse4.1") inline __m128 load3(const uint8_t* p) {
+    // Floats are only 4-byte aligned; _mm_loadl_epi64 has no alignment requirement
+    __m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    __m128 z = _mm_load_ss(reinterpret_cast<const float*>(p + 8));
+    return _mm_movelh_ps(xy, z);
+}
+
+/// Store x, y, z without touching the fourth float
+VKDUCK_TARGET("sse4.1") inline void store3(uint8_t* p, __m128 v) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+    _mm_store_ss(reinterpret_cast<float*>(p + 8), _mm_movehl_ps(v, v));
+}
+
+VKDUCK_TARGET("sse4.1") void widenIndices16Sse41(const uint16_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtepu16_epi32(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_cvtepu16_epi32(_mm_srli_si128(in, 8)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void widenIndices8Sse41(const uint8_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtepu8_epi32(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_cvtepu8_epi32(_mm_srli_si128(in, 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_cvtepu8_epi32(_mm_srli_si128(in, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), _mm_cvtepu8_epi32(_mm_srli_si128(in, 12)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void narrowIndices32Sse41(const uint32_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(a, b));
+    }
+    for (; i < count; ++i) {
+        dst[i] = static_cast<uint16_t>(src[i]);
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void widenIndices8To16Sse41(const uint8_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtepu8_epi16(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_cvtepu8_epi16(_mm_srli_si128(in, 8)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void transformPositionsSse41(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        __m128 v = load3(s);
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA)), c3)
+        );
+        store3(d, r);
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void transformDirectionsSse41(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const __m128 c0 = load3(reinterpret_cast<const uint8_t*>(m));
+    const __m128 c1 = load3(reinterpret_cast<const uint8_t*>(m + 3));
+    const __m128 c2 = load3(reinterpret_cast<const uint8_t*>(m + 6));
+    const __m128 one = _mm_set1_ps(1.0f);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        __m128 v = load3(s);
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55))),
+            _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA))
+        );
+        __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_dp_ps(r, r, 0x7F)));
+        store3(d, _mm_mul_ps(r, invLength));
+    }
+}
+
+VKDUCK_TARGET("sse4.1") void computeBoundsSse41(
+    const void* src, size_t stride, size_t count,
+    float outMin[3], float outMax[3]
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    __m128 mn = load3(s);
+    __m128 mx = mn;
+    for (size_t i = 1; i < count; ++i) {
+        s += stride;
+        __m128 v = load3(s);
+        mn = _mm_min_ps(mn, v);
+        mx = _mm_max_ps(mx, v);
+    }
+    store3(reinterpret_cast<uint8_t*>(outMin), mn);
+    store3(reinterpret_cast<uint8_t*>(outMax), mx);
+}
+
+// Base64 decoding classifies each character by its high and low nibble
+// with two table lookups, maps it to its 6-bit value by adding an offset
+// picked by the high nibble and packs four values into three bytes with two
+// multiply-adds. A character is valid when its two lookups share no bits.
+#define VKDUCK_BASE64_LUT_LO \
+    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, \
+    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define VKDUCK_BASE64_LUT_HI \
+    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, \
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+// Character to value offset by high nibble; index 1 is '/' (see below)
+#define VKDUCK_BASE64_LUT_ROLL \
+    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+/// Turn 16 base64 characters into their 6-bit values; false if any
+/// character is outside the alphabet
+VKDUCK_TARGET("sse4.1") inline bool base64ValuesSse41(__m128i& chars) {
+    const __m128i lutLo = _mm_setr_epi8(VKDUCK_BASE64_LUT_LO);
+    const __m128i lutHi = _mm_setr_epi8(VKDUCK_BASE64_LUT_HI);
+    const __m128i lutRoll = _mm_setr_epi8(VKDUCK_BASE64_LUT_ROLL);
+    const __m128i mask2F = _mm_set1_epi8(0x2F);
+
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask2F);
+    const __m128i loNibbles = _mm_and_si128(chars, mask2F);
+    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    if (!_mm_testz_si128(lo, hi)) {
+        return false;
+    }
+    // '/' shares its high nibble with '+'; moving it to index 1 gives it its own offset
+    const __m128i isSlash = _mm_cmpeq_epi8(chars, mask2F);
+    const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, hiNibbles));
+    chars = _mm_add_epi8(chars, roll);
+    return true;
+}
+
+/// Pack 4 6-bit values per 32-bit lane into 3 bytes (big-endian bit order)
+VKDUCK_TARGET("sse4.1") inline __m128i base64PackSse41(__m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i bits = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(bits, _mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+VKDUCK_TARGET("sse4.1") bool decodeBase64Sse41(const char* src, size_t quadCount, uint8_t* dst) {
+    // 16 characters make 12 bytes, but the store writes 16; keep 6 quads
+    // (18 bytes) ahead so it stays inside the output
+    for (; quadCount >= 6; quadCount -= 4, src += 16, dst += 12) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        if (!base64ValuesSse41(chars)) {
+            return false;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), base64PackSse41(chars));
+    }
+    return decodeBase64Scalar(src, quadCount, dst);
+}
+
+/// Average the two rows of 2 source pixels in each of `a` and `b` (16-bit
+/// channel sums) horizontally, giving 2 destination pixels
+VKDUCK_TARGET("sse4.1") inline __m128i downsamplePairSse41(__m128i a, __m128i b) {
+    const __m128i sums = _mm_add_epi16(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+    return _mm_srli_epi16(_mm_add_epi16(sums, _mm_set1_epi16(2)), 2);
+}
+
+VKDUCK_TARGET("sse4.1") void downsample2x2Sse41(
+    const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth
+) {
+    // 8 source pixels per row make 4 destination pixels
+    size_t x = 0;
+    for (; x + 4 <= dstWidth; x += 4, row0 += 32, row1 += 32, dst += 16) {
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 16));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 16));
+        const __m128i zero = _mm_setzero_si128();
+        // Vertical sums of source pixels 0-1, 2-3, 4-5, 6-7
+        const __m128i p01 = _mm_add_epi16(_mm_cvtepu8_epi16(a0), _mm_cvtepu8_epi16(b0));
+        const __m128i p23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        const __m128i p45 = _mm_add_epi16(_mm_cvtepu8_epi16(a1), _mm_cvtepu8_epi16(b1));
+        const __m128i p67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+        const __m128i out = _mm_packus_epi16(downsamplePairSse41(p01, p23), downsamplePairSse41(p45, p67));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out);
+    }
+    downsample2x2Scalar(row0, row1, dst, dstWidth - x);
+}
+
+VKDUCK_TARGET("sse4.1") void projectPixelsSse41(
+    const uint8_t* pixels, const int16_t axis[4], int32_t* dst, size_t count
+) {
+    // madd gives two partial sums per pixel; hadd joins them
+    const __m128i weights = _mm_setr_epi16(axis[0], axis[1], axis[2], axis[3], axis[0], axis[1], axis[2], axis[3]);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4, pixels += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        const __m128i lo = _mm_madd_epi16(_mm_cvtepu8_epi16(v), weights);
+        const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), weights);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_hadd_epi32(lo, hi));
+    }
+    projectPixelsScalar(pixels, axis, dst + i, count - i);
+}
+
+constexpr KernelTable kSse41Kernels{
+    Isa::SSE41,
+    widenIndices16Sse41,
+    widenIndices8Sse41,
+    narrowIndices32Sse41,
+    widenIndices8To16Sse41,
+    transformPositionsSse41,
+    transformDirectionsSse41,
+    computeBoundsSse41,
+    decodeBase64Sse41,
+    downsample2x2Sse41,
+    projectPixelsSse41,
+};
+// }}}
+
+// AVX2 kernels {{{
+// Vector kernels handle two vertices per 256-bit register, one per lane.
+VKDUCK_TARGET("avx2,fma") inline __m256 load3x2(const uint8_t* a, const uint8_t* b) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(load3(a)), load3(b), 1);
+}
+
+VKDUCK_TARGET("avx2,fma") void widenIndices16Avx2(const uint16_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu16_epi32(a));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), _mm256_cvtepu16_epi32(b));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void widenIndices8Avx2(const uint8_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m128i lo = _mm256_castsi256_si128(in);
+        __m128i hi = _mm256_extracti128_si256(in, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi32(lo));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_cvtepu8_epi32(hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void narrowIndices32Avx2(const uint32_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8));
+        // packus works per 128-bit lane; restore the element order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    for (; i < count; ++i) {
+        dst[i] = static_cast<uint16_t>(src[i]);
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void widenIndices8To16Avx2(const uint8_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(in)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(in, 1)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void transformPositionsAvx2(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2, s += 2 * srcStride, d += 2 * dstStride) {
+        __m256 v = load3x2(s, s + srcStride);
+        __m256 r = _mm256_fmadd_ps(c0, _mm256_permute_ps(v, 0x00),
+            _mm256_fmadd_ps(c1, _mm256_permute_ps(v, 0x55),
+                _mm256_fmadd_ps(c2, _mm256_permute_ps(v, 0xAA), c3)));
+        store3(d, _mm256_castps256_ps128(r));
+        store3(d + dstStride, _mm256_extractf128_ps(r, 1));
+    }
+    if (i < count) {
+        transformPositionsSse41(s, srcStride, m, d, dstStride, count - i);
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void transformDirectionsAvx2(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const uint8_t* mb = reinterpret_cast<const uint8_t*>(m);
+    const __m256 c0 = load3x2(mb, mb);
+    const __m256 c1 = load3x2(mb + 12, mb + 12);
+    const __m256 c2 = load3x2(mb + 24, mb + 24);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2, s += 2 * srcStride, d += 2 * dstStride) {
+        __m256 v = load3x2(s, s + srcStride);
+        __m256 r = _mm256_fmadd_ps(c0, _mm256_permute_ps(v, 0x00),
+            _mm256_fmadd_ps(c1, _mm256_permute_ps(v, 0x55),
+                _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xAA))));
+        __m256 invLength = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_dp_ps(r, r, 0x7F)));
+        r = _mm256_mul_ps(r, invLength);
+        store3(d, _mm256_castps256_ps128(r));
+        store3(d + dstStride, _mm256_extractf128_ps(r, 1));
+    }
+    if (i < count) {
+        transformDirectionsSse41(s, srcStride, m, d, dstStride, count - i);
+    }
+}
+
+VKDUCK_TARGET("avx2,fma") void computeBoundsAvx2(
+    const void* src, size_t stride, size_t count,
+    float outMin[3], float outMax[3]
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    __m128 first = load3(s);
+    __m256 mn = _mm256_insertf128_ps(_mm256_castps128_ps256(first), first, 1);
+    __m256 mx = mn;
+
+    size_t i = 1;
+    s += stride;
+    for (; i + 2 <= count; i += 2, s += 2 * stride) {
+        __m256 v = load3x2(s, s + stride);
+        mn = _mm256_min_ps(mn, v);
+        mx = _mm256_max_ps(mx, v);
+    }
+
+    __m128 mn4 = _mm_min_ps(_mm256_castps256_ps128(mn), _mm256_extractf128_ps(mn, 1));
+    __m128 mx4 = _mm_max_ps(_mm256_castps256_ps128(mx), _mm256_extractf128_ps(mx, 1));
+    if (i < count) {
+        __m128 v = load3(s);
+        mn4 = _mm_min_ps(mn4, v);
+        mx4 = _mm_max_ps(mx4, v);
+    }
+    store3(reinterpret_cast<uint8_t*>(outMin), mn4);
+    store3(reinterpret_cast<uint8_t*>(outMax), mx4);
+}
+
+VKDUCK_TARGET("avx2,fma") bool decodeBase64Avx2(const char* src, size_t quadCount, uint8_t* dst) {
+    const __m256i lutLo = _mm256_setr_epi8(VKDUCK_BASE64_LUT_LO, VKDUCK_BASE64_LUT_LO);
+    const __m256i lutHi = _mm256_setr_epi8(VKDUCK_BASE64_LUT_HI, VKDUCK_BASE64_LUT_HI);
+    const __m256i lutRoll = _mm256_setr_epi8(VKDUCK_BASE64_LUT_ROLL, VKDUCK_BASE64_LUT_ROLL);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+    const __m256i packBytes = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i packLanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+    // 32 characters make 24 bytes, but the store writes 32; keep 11 quads
+    // (33 bytes) ahead so it stays inside the output
+    for (; quadCount >= 11; quadCount -= 8, src += 32, dst += 24) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask2F);
+        const __m256i loNibbles = _mm256_and_si256(chars, mask2F);
+        const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+            return false;
+        }
+        const __m256i isSlash = _mm256_cmpeq_epi8(chars, mask2F);
+        const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(isSlash, hiNibbles));
+        chars = _mm256_add_epi8(chars, roll);
+
+        const __m256i pairs = _mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140));
+        __m256i bits = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        bits = _mm256_shuffle_epi8(bits, packBytes);
+        bits = _mm256_permutevar8x32_epi32(bits, packLanes);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), bits);
+    }
+    return decodeBase64Sse41(src, quadCount, dst);
+}
+
+VKDUCK_TARGET("avx2,fma") void downsample2x2Avx2(
+    const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth
+) {
+    // 8 source pixels per row make 4 destination pixels. Each lane holds a
+    // pair of source pixels; the sums come out as pixels 0, 2 | 1, 3.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0);
+    size_t x = 0;
+    for (; x + 4 <= dstWidth; x += 4, row0 += 32, row1 += 32, dst += 16) {
+        const __m128i* a = reinterpret_cast<const __m128i*>(row0);
+        const __m128i* b = reinterpret_cast<const __m128i*>(row1);
+        const __m256i lo = _mm256_add_epi16(
+            _mm256_cvtepu8_epi16(_mm_loadu_si128(a)), _mm256_cvtepu8_epi16(_mm_loadu_si128(b)));
+        const __m256i hi = _mm256_add_epi16(
+            _mm256_cvtepu8_epi16(_mm_loadu_si128(a + 1)), _mm256_cvtepu8_epi16(_mm_loadu_si128(b + 1)));
+        __m256i sums = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        sums = _mm256_srli_epi16(_mm256_add_epi16(sums, _mm256_set1_epi16(2)), 2);
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sums, sums), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+    }
+    downsample2x2Scalar(row0, row1, dst, dstWidth - x);
+}
+
+VKDUCK_TARGET("avx2,fma") void projectPixelsAvx2(
+    const uint8_t* pixels, const int16_t axis[4], int32_t* dst, size_t count
+) {
+    // hadd works within 128-bit lanes, giving pixels 0, 1, 4, 5 | 2, 3, 6, 7
+    const __m256i weights = _mm256_setr_epi16(
+        axis[0], axis[1], axis[2], axis[3], axis[0], axis[1], axis[2], axis[3],
+        axis[0], axis[1], axis[2], axis[3], axis[0], axis[1], axis[2], axis[3]);
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, pixels += 32) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(pixels);
+        const __m256i lo = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(p)), weights);
+        const __m256i hi = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(p + 1)), weights);
+        const __m256i sums = _mm256_permutevar8x32_epi32(_mm256_hadd_epi32(lo, hi), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), sums);
+    }
+    projectPixelsSse41(pixels, axis, dst + i, count - i);
+}
+
+constexpr KernelTable kAvx2Kernels{
+    Isa::AVX2,
+    widenIndices16Avx2,
+    widenIndices8Avx2,
+    narrowIndices32Avx2,
+    widenIndices8To16Avx2,
+    transformPositionsAvx2,
+    transformDirectionsAvx2,
+    computeBoundsAvx2,
+    decodeBase64Avx2,
+    downsample2x2Avx2,
+    projectPixelsAvx2,
+};
+// }}}
+
+// CPU feature detection {{{
+bool cpuHasSse41() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+bool cpuHasAvx2Fma() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+// }}}
+#endif // VKDUCK_SIMD_X86
+
+#if defined(VKDUCK_SIMD_NEON)
+// NEON kernels {{{
+inline float32x4_t load3(const uint8_t* p) {
+    float v[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    std::memcpy(v, p, 3 * sizeof(float));
+    return vld1q_f32(v);
+}
+
+inline void store3(uint8_t* p, float32x4_t v) {
+    float out[4];
+    vst1q_f32(out, v);
+    std::memcpy(p, out, 3 * sizeof(float));
+}
+
+void widenIndices16Neon(const uint16_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint16x8_t in = vld1q_u16(src + i);
+        vst1q_u32(dst + i, vmovl_u16(vget_low_u16(in)));
+        vst1q_u32(dst + i + 4, vmovl_u16(vget_high_u16(in)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void widenIndices8Neon(const uint8_t* src, uint32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t in = vld1q_u8(src + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(in));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(in));
+        vst1q_u32(dst + i, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(dst + i + 4, vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32(dst + i + 8, vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(dst + i + 12, vmovl_u16(vget_high_u16(hi)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void narrowIndices32Neon(const uint32_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint16x4_t lo = vmovn_u32(vld1q_u32(src + i));
+        uint16x4_t hi = vmovn_u32(vld1q_u32(src + i + 4));
+        vst1q_u16(dst + i, vcombine_u16(lo, hi));
+    }
+    for (; i < count; ++i) {
+        dst[i] = static_cast<uint16_t>(src[i]);
+    }
+}
+
+void widenIndices8To16Neon(const uint8_t* src, uint16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t in = vld1q_u8(src + i);
+        vst1q_u16(dst + i, vmovl_u8(vget_low_u8(in)));
+        vst1q_u16(dst + i + 8, vmovl_u8(vget_high_u8(in)));
+    }
+    for (; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+void transformPositionsNeon(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        float v[3];
+        std::memcpy(v, s, sizeof(v));
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, v[0]), c1, v[1]), c2, v[2]);
+        store3(d, r);
+    }
+}
+
+void transformDirectionsNeon(
+    const void* src, size_t srcStride,
+    const float* m,
+    void* dst, size_t dstStride,
+    size_t count
+) {
+    const float32x4_t c0 = load3(reinterpret_cast<const uint8_t*>(m));
+    const float32x4_t c1 = load3(reinterpret_cast<const uint8_t*>(m + 3));
+    const float32x4_t c2 = load3(reinterpret_cast<const uint8_t*>(m + 6));
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i, s += srcStride, d += dstStride) {
+        float v[3];
+        std::memcpy(v, s, sizeof(v));
+        float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, v[0]), c1, v[1]), c2, v[2]);
+        float32x4_t sq = vmulq_f32(r, r);
+        float lengthSq = vgetq_lane_f32(sq, 0) + vgetq_lane_f32(sq, 1) + vgetq_lane_f32(sq, 2);
+        store3(d, vmulq_n_f32(r, 1.0f / std::sqrt(lengthSq)));
+    }
+}
+
+void computeBoundsNeon(
+    const void* src, size_t stride, size_t count,
+    float outMin[3], float outMax[3]
+) {
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    float32x4_t mn = load3(s);
+    float32x4_t mx = mn;
+    for (size_t i = 1; i < count; ++i) {
+        s += stride;
+        float32x4_t v = load3(s);
+        mn = vminq_f32(mn, v);
+        mx = vmaxq_f32(mx, v);
+    }
+    store3(reinterpret_cast<uint8_t*>(outMin), mn);
+    store3(reinterpret_cast<uint8_t*>(outMax), mx);
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+/// Deinterleaves 64 characters into four registers, one per position in
+/// the quad, and classifies them with the same nibble tables as the x86
+/// kernels (see decodeBase64Sse41())
+bool decodeBase64Neon(const char* src, size_t quadCount, uint8_t* dst) {
+    const uint8x16_t lutLo = {
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A};
+    const uint8x16_t lutHi = {
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+    const uint8x16_t lutRoll = vreinterpretq_u8_s8(int8x16_t{
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0});
+    const uint8x16_t slash = vdupq_n_u8(0x2F);
+
+    for (; quadCount >= 16; quadCount -= 16, src += 64, dst += 48) {
+        uint8x16x4_t values = vld4q_u8(reinterpret_cast<const uint8_t*>(src));
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (uint8x16_t& chars : values.val) {
+            const uint8x16_t hiNibbles = vshrq_n_u8(chars, 4);
+            const uint8x16_t loNibbles = vandq_u8(chars, vdupq_n_u8(0x0F));
+            invalid = vorrq_u8(invalid, vandq_u8(
+                vqtbl1q_u8(lutHi, hiNibbles), vqtbl1q_u8(lutLo, loNibbles)));
+            const uint8x16_t isSlash = vceqq_u8(chars, slash);
+            chars = vaddq_u8(chars, vqtbl1q_u8(lutRoll, vaddq_u8(isSlash, hiNibbles)));
+        }
+        if (vmaxvq_u8(invalid) != 0) {
+            return false;
+        }
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(dst, bytes);
+    }
+    return decodeBase64Scalar(src, quadCount, dst);
+}
+#else
+// Table lookups across 16 bytes need AArch64
+constexpr auto decodeBase64Neon = decodeBase64Scalar;
+#endif
+
+void downsample2x2Neon(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, size_t dstWidth) {
+    // Deinterleaving 8 pixels into even and odd ones lines up the 2x2 blocks
+    size_t x = 0;
+    for (; x + 4 <= dstWidth; x += 4, row0 += 32, row1 += 32, dst += 16) {
+        const uint32x4x2_t a = vld2q_u32(reinterpret_cast<const uint32_t*>(row0));
+        const uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t*>(row1));
+        const uint8x16_t a0 = vreinterpretq_u8_u32(a.val[0]);
+        const uint8x16_t a1 = vreinterpretq_u8_u32(a.val[1]);
+        const uint8x16_t b0 = vreinterpretq_u8_u32(b.val[0]);
+        const uint8x16_t b1 = vreinterpretq_u8_u32(b.val[1]);
+        const uint16x8_t lo = vaddq_u16(
+            vaddl_u8(vget_low_u8(a0), vget_low_u8(a1)), vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+        const uint16x8_t hi = vaddq_u16(
+            vaddl_u8(vget_high_u8(a0), vget_high_u8(a1)), vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+        vst1q_u8(dst, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+    }
+    downsample2x2Scalar(row0, row1, dst, dstWidth - x);
+}
+
+void projectPixelsNeon(const uint8_t* pixels, const int16_t axis[4], int32_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, pixels += 32) {
+        const uint8x8x4_t v = vld4_u8(pixels);
+        int32x4_t lo = vdupq_n_s32(0);
+        int32x4_t hi = vdupq_n_s32(0);
+        for (int c = 0; c < 4; ++c) {
+            const int16x8_t channel = vreinterpretq_s16_u16(vmovl_u8(v.val[c]));
+            lo = vmlal_n_s16(lo, vget_low_s16(channel), axis[c]);
+            hi = vmlal_n_s16(hi, vget_high_s16(channel), axis[c]);
+        }
+        vst1q_s32(dst + i, lo);
+        vst1q_s32(dst + i + 4, hi);
+    }
+    projectPixelsScalar(pixels, axis, dst + i, count - i);
+}
+
+constexpr KernelTable kNeonKernels{
+    Isa::NEON,
+    widenIndices16Neon,
+    widenIndices8Neon,
+    narrowIndices32Neon,
+    widenIndices8To16Neon,
+    transformPositionsNeon,
+    transformDirectionsNeon,
+    computeBoundsNeon,
+    decodeBase64Neon,
+    downsample2x2Neon,
+    projectPixelsNeon,
+};
+// }}}
+#endif // VKDUCK_SIMD_NEON
+
+} // anonymous namespace
+
+// Dispatch {{{
+const char* isaName(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::SSE41: return "sse4.1";
+    case Isa::AVX2: return "avx2";
+    case Isa::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+const KernelTable* kernelsFor(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar:
+        return &kScalarKernels;
+#if defined(VKDUCK_SIMD_X86)
+    case Isa::SSE41: {
+        static const bool supported = cpuHasSse41();
+        return supported ? &kSse41Kernels : nullptr;
+    }
+    case Isa::AVX2: {
+        static const bool supported = cpuHasSse41() && cpuHasAvx2Fma();
+        return supported ? &kAvx2Kernels : nullptr;
+    }
+#endif
+#if defined(VKDUCK_SIMD_NEON)
+    case Isa::NEON:
+        return &kNeonKernels;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+const KernelTable& kernels() {
+    static const KernelTable& best = []() -> const KernelTable& {
+        for (Isa isa : {Isa::AVX2, Isa::NEON, Isa::SSE41}) {
+            if (const KernelTable* table = kernelsFor(isa)) {
+                return *table;
+            }
+        }
+        return kScalarKernels;
+    }();
+    return best;
+}
+// }}}
+
+} // namespace simd
@@ -0,0 +1,279 @@
+// vim:foldmethod=marker
+#include <vkDuck/texture_cache.h>
+#include <vkDuck/mapped_file.h>
+#include <vkDuck/texture_container.h>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+// Index {{{
+/// What the cache knows about its directory. Scanned once per
+/// configuration and updated on every hit, write and eviction.
+struct CacheIndex {
+    struct Entry {
+        uint64_t size{0};
+        fs::file_time_type lastUse{};
+    };
+
+    std::mutex mutex;
+    TextureCacheConfig config;
+    bool scanned{false};
+    std::unordered_map<std::string, Entry> entries;   // By file name
+    uint64_t bytes{0};
+    TextureCacheStats stats;
+};
+
+CacheIndex& cacheIndex() {
+    static CacheIndex index;
+    return index;
+}
+
+bool isCacheFileName(const std::string& name) {
+    return name.size() == 20 && name.ends_with(".dds") &&
+        std::all_of(name.begin(), name.begin() + 16, [](char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+        });
+}
+
+/// Create and scan the directory. Call with the index locked.
+void scanLocked(CacheIndex& index) {
+    if (index.scanned) {
+        return;
+    }
+    index.scanned = true;
+    index.entries.clear();
+    index.bytes = 0;
+
+    std::error_code ec;
+    fs::create_directories(index.config.directory, ec);
+    for (const auto& entry : fs::directory_iterator(index.config.directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (!isCacheFileName(name)) {
+            continue;
+        }
+        CacheIndex::Entry cached;
+        cached.size = entry.file_size(ec);
+        cached.lastUse = entry.last_write_time(ec);
+        index.entries[name] = cached;
+        index.bytes += cached.size;
+    }
+}
+
+/// Delete least recently used files until the cache fits its limit, never
+/// `keep`. Call with the index locked.
+void evictLocked(CacheIndex& index, const std::string& keep) {
+    if (index.bytes <= index.config.maxBytes) {
+        return;
+    }
+    std::vector<std::pair<fs::file_time_type, std::string>> byAge;
+    byAge.reserve(index.entries.size());
+    for (const auto& [name, entry] : index.entries) {
+        if (name != keep) {
+            byAge.emplace_back(entry.lastUse, name);
+        }
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    for (const auto& [lastUse, name] : byAge) {
+        if (index.bytes <= index.config.maxBytes) {
+            break;
+        }
+        // Files still mapped elsewhere cannot be removed on Windows; they
+        // stay until a later eviction
+        std::error_code ec;
+        if (!fs::remove(index.config.directory / name, ec) && ec) {
+            continue;
+        }
+        index.bytes -= index.entries[name].size;
+        index.entries.erase(name);
+        ++index.stats.evictions;
+    }
+}
+// }}}
+
+// Entries {{{
+/// Write `bytes` to `path` through a temporary file, so concurrent readers
+/// never see a partial entry
+bool writeEntry(const fs::path& path, std::span<const uint8_t> bytes) {
+    fs::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::FILE* file = std::fopen(tempPath.string().c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        if (std::fclose(file) != 0 || !written) {
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+/// Decode `source` (with its mip chain when `mips`) into DDS bytes
+std::vector<uint8_t> decodeEntry(const TextureSource& source, bool mips, bool linear) {
+    const uint32_t width = source.width();
+    const uint32_t height = source.height();
+    const uint32_t levels = mips ? mipLevelCount(width, height) : 1;
+    std::vector<uint8_t> chain(mipChainSize(width, height, levels));
+    if (!source.decodeInto(chain.data())) {
+        throw std::runtime_error("Failed to decode texture");
+    }
+    const size_t level0Size = static_cast<size_t>(width) * height * 4;
+    if (levels > 1) {
+        generateMipChain(chain.data(), width, height, levels, !linear, chain.data() + level0Size);
+    }
+
+    ContainerTexture texture{VK_FORMAT_B8G8R8A8_UNORM, width, height, {}};
+    size_t offset = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        const size_t size = static_cast<size_t>(std::max(1u, width >> level)) * std::max(1u, height >> level) * 4;
+        texture.levels.emplace_back(chain.data() + offset, size);
+        offset += size;
+    }
+    return encodeDds(texture);
+}
+// }}}
+}
+
+// Decoded texture cache {{{
+void configureTextureCache(const TextureCacheConfig& config) {
+    CacheIndex& index = cacheIndex();
+    std::lock_guard lock(index.mutex);
+    if (index.config.directory != config.directory) {
+        index.scanned = false;
+    }
+    index.config = config;
+    if (index.scanned) {
+        // Only the limit or the mips option changed
+        evictLocked(index, {});
+    }
+}
+
+TextureCacheConfig textureCacheConfig() {
+    CacheIndex& index = cacheIndex();
+    std::lock_guard lock(index.mutex);
+    return index.config;
+}
+
+TextureCacheStats textureCacheStats() {
+    CacheIndex& index = cacheIndex();
+    std::lock_guard lock(index.mutex);
+    TextureCacheStats stats = index.stats;
+    stats.entries = index.entries.size();
+    stats.bytes = index.bytes;
+    return stats;
+}
+
+void clearTextureCache() {
+    CacheIndex& index = cacheIndex();
+    std::lock_guard lock(index.mutex);
+    if (index.config.directory.empty()) {
+        return;
+    }
+    scanLocked(index);
+    for (auto it = index.entries.begin(); it != index.entries.end();) {
+        std::error_code ec;
+        if (!fs::remove(index.config.directory / it->first, ec) && ec) {
+            ++it;
+            continue;
+        }
+        index.bytes -= it->second.size;
+        it = index.entries.erase(it);
+    }
+}
+
+TextureSource openCachedTexture(TextureSource source, bool linear) {
+    CacheIndex& index = cacheIndex();
+    TextureCacheConfig config;
+    {
+        std::lock_guard lock(index.mutex);
+        config = index.config;
+        if (!config.directory.empty()) {
+            scanLocked(index);
+        }
+    }
+    if (config.directory.empty() || !source.valid() || isTextureContainer(source.bytes())) {
+        return source;
+    }
+
+    // Linear vs. sRGB only changes the filtered levels
+    const uint64_t seed = (static_cast<uint64_t>(kTextureCacheVersion) << 8) |
+        (config.mips ? 2u : 0u) | (config.mips && linear ? 1u : 0u);
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx",
+        static_cast<unsigned long long>(hashBytes(source.bytes().data(), source.bytes().size(), seed)));
+    const std::string name = std::string(key) + ".dds";
+    const fs::path path = config.directory / name;
+    const uint32_t levels = config.mips ? mipLevelCount(source.width(), source.height()) : 1;
+
+    // Checked on disk, so entries written by another process are found too
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        try {
+            TextureSource cached(path);
+            if (cached.width() == source.width() && cached.height() == source.height() &&
+                    cached.format() == VK_FORMAT_B8G8R8A8_UNORM && cached.mipLevels() == levels) {
+                const auto now = fs::file_time_type::clock::now();
+                fs::last_write_time(path, now, ec);
+                std::lock_guard lock(index.mutex);
+                if (index.config.directory == config.directory) {
+                    CacheIndex::Entry& entry = index.entries[name];
+                    if (entry.size == 0) {
+                        entry.size = cached.bytes().size();
+                        index.bytes += entry.size;
+                    }
+                    entry.lastUse = now;
+                }
+                ++index.stats.hits;
+                return cached;
+            }
+        } catch (const std::exception&) {
+            // Truncated or foreign file: replaced below
+        }
+    }
+
+    std::vector<uint8_t> entry = decodeEntry(source, config.mips, linear);
+    const uint64_t entrySize = entry.size();
+    const bool written = writeEntry(path, entry);
+    {
+        std::lock_guard lock(index.mutex);
+        ++index.stats.misses;
+        if (!written) {
+            ++index.stats.writeFailures;
+        } else if (index.config.directory == config.directory) {
+            CacheIndex::Entry& cached = index.entries[name];
+            index.bytes += entrySize - cached.size;
+            cached.size = entrySize;
+            cached.lastUse = fs::file_time_type::clock::now();
+            evictLocked(index, name);
+        }
+    }
+
+    if (written) {
+        // Mapped rather than kept, so the pixels can leave memory until upload
+        try {
+            return TextureSource(path);
+        } catch (const std::exception&) {
+            // Evicted or replaced meanwhile: serve the decoded bytes
+        }
+    }
+    return TextureSource(std::move(entry));
+}
+// }}}
@@ -0,0 +1,424 @@
+// vim:foldmethod=marker
+#include <vkDuck/texture_container.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Helpers {{{
+template <typename T>
+T readLE(std::span<const uint8_t> bytes, size_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+constexpr uint32_t fourCC(const char (&code)[5]) {
+    return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8 |
+        static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+}
+
+/// Largest width or height accepted from a container (the common Vulkan
+/// maxImageDimension2D)
+constexpr uint32_t kMaxTextureDimension = 16384;
+
+/// columns * rows * unitBytes, throwing instead of wrapping
+size_t checkedLevelSize(size_t columns, size_t rows, size_t unitBytes) {
+    if (rows != 0 && columns > std::numeric_limits<size_t>::max() / rows / unitBytes) {
+        throw std::runtime_error("Texture level size overflows");
+    }
+    return columns * rows * unitBytes;
+}
+
+bool isSupportedFormat(VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+        return true;
+    default:
+        return isBlockCompressed(format);
+    }
+}
+
+/// Check the size and the level count against it
+void validateLevels(const ContainerTexture& texture, const char* container) {
+    if (texture.width == 0 || texture.height == 0) {
+        throw std::runtime_error(std::string(container) + ": zero-sized texture");
+    }
+    if (texture.width > kMaxTextureDimension || texture.height > kMaxTextureDimension) {
+        throw std::runtime_error(std::string(container) + ": " + std::to_string(texture.width)
+            + "x" + std::to_string(texture.height) + " exceeds the maximum texture size "
+            + std::to_string(kMaxTextureDimension));
+    }
+    const uint32_t maxLevels = std::bit_width(std::max(texture.width, texture.height));
+    if (texture.levels.empty() || texture.levels.size() > maxLevels) {
+        throw std::runtime_error(std::string(container) + ": invalid mip level count "
+            + std::to_string(texture.levels.size()));
+    }
+}
+// }}}
+
+// KTX2 {{{
+constexpr uint8_t kKtx2Identifier[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+constexpr size_t kKtx2HeaderSize = 80;     // Identifier, header and index
+constexpr size_t kKtx2LevelIndexEntry = 24;
+
+bool isKtx2(std::span<const uint8_t> bytes) {
+    return bytes.size() >= sizeof(kKtx2Identifier) &&
+        std::memcmp(bytes.data(), kKtx2Identifier, sizeof(kKtx2Identifier)) == 0;
+}
+
+ContainerTexture parseKtx2(std::span<const uint8_t> bytes) {
+    if (bytes.size() < kKtx2HeaderSize) {
+        throw std::runtime_error("KTX2: truncated header");
+    }
+    ContainerTexture texture;
+    texture.format = static_cast<VkFormat>(readLE<uint32_t>(bytes, 12));
+    texture.width = readLE<uint32_t>(bytes, 20);
+    texture.height = readLE<uint32_t>(bytes, 24);
+    const uint32_t depth = readLE<uint32_t>(bytes, 28);
+    const uint32_t layers = readLE<uint32_t>(bytes, 32);
+    const uint32_t faces = readLE<uint32_t>(bytes, 36);
+    // 0 asks the loader to generate mips; only level 0 is stored then
+    const uint32_t levelCount = std::max(1u, readLE<uint32_t>(bytes, 40));
+    const uint32_t supercompression = readLE<uint32_t>(bytes, 44);
+
+    if (supercompression != 0) {
+        throw std::runtime_error("KTX2: supercompressed payloads (Basis, zstd) are not supported");
+    }
+    if (texture.format == VK_FORMAT_UNDEFINED) {
+        throw std::runtime_error("KTX2: Basis Universal (UASTC) payloads are not supported");
+    }
+    if (!isSupportedFormat(texture.format)) {
+        throw std::runtime_error("KTX2: unsupported VkFormat "
+            + std::to_string(static_cast<uint32_t>(texture.format)));
+    }
+    if (depth > 1 || layers > 1 || faces != 1) {
+        throw std::runtime_error("KTX2: only single 2D textures are supported");
+    }
+    if (bytes.size() < kKtx2HeaderSize + levelCount * kKtx2LevelIndexEntry) {
+        throw std::runtime_error("KTX2: truncated level index");
+    }
+
+    texture.levels.resize(levelCount);
+    validateLevels(texture, "KTX2");
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const size_t entry = kKtx2HeaderSize + level * kKtx2LevelIndexEntry;
+        const uint64_t offset = readLE<uint64_t>(bytes, entry);
+        const uint64_t length = readLE<uint64_t>(bytes, entry + 8);
+        const size_t expected = textureLevelSize(texture.format,
+            std::max(1u, texture.width >> level), std::max(1u, texture.height >> level));
+        if (length < expected || offset > bytes.size() || bytes.size() - offset < expected) {
+            throw std::runtime_error("KTX2: level " + std::to_string(level) + " out of range");
+        }
+        texture.levels[level] = bytes.subspan(offset, expected);
+    }
+    return texture;
+}
+// }}}
+
+// DDS {{{
+constexpr size_t kDdsHeaderSize = 4 + 124;      // Magic and DDS_HEADER
+constexpr size_t kDdsDx10HeaderSize = 20;
+constexpr uint32_t kDdsRequiredFlags = 0x1 | 0x2 | 0x4 | 0x1000;  // Caps, height, width, pixel format
+constexpr uint32_t kDdsLinearSizeFlag = 0x80000;
+constexpr uint32_t kDdsMipMapCountFlag = 0x20000;
+constexpr uint32_t kDdsTextureCaps = 0x1000;
+constexpr uint32_t kDdsMipMapCaps = 0x400000 | 0x8;             // Mipmap, complex
+constexpr uint32_t kDdsFourCCFlag = 0x4;
+constexpr uint32_t kDdsRgbFlag = 0x40;
+constexpr uint32_t kDdsCubemapCaps = 0x200;
+constexpr uint32_t kDdsVolumeCaps = 0x200000;
+constexpr uint32_t kDxgiTexture2D = 3;
+constexpr uint32_t kDxgiTextureCube = 0x4;
+
+bool isDds(std::span<const uint8_t> bytes) {
+    return bytes.size() >= 4 && readLE<uint32_t>(bytes, 0) == fourCC("DDS ");
+}
+
+VkFormat formatFromDxgi(uint32_t dxgiFormat) {
+    switch (dxgiFormat) {
+    case 28: return VK_FORMAT_R8G8B8A8_UNORM;
+    case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+    case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+    case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+    case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+    case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+    case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+    case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+    case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+    case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+    case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+    case 87: return VK_FORMAT_B8G8R8A8_UNORM;
+    case 91: return VK_FORMAT_B8G8R8A8_SRGB;
+    case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+    case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+    default: return VK_FORMAT_UNDEFINED;
+    }
+}
+
+uint32_t dxgiFromFormat(VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM: return 28;
+    case VK_FORMAT_R8G8B8A8_SRGB: return 29;
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return 71;
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: return 72;
+    case VK_FORMAT_BC2_UNORM_BLOCK: return 74;
+    case VK_FORMAT_BC2_SRGB_BLOCK: return 75;
+    case VK_FORMAT_BC3_UNORM_BLOCK: return 77;
+    case VK_FORMAT_BC3_SRGB_BLOCK: return 78;
+    case VK_FORMAT_BC4_UNORM_BLOCK: return 80;
+    case VK_FORMAT_BC4_SNORM_BLOCK: return 81;
+    case VK_FORMAT_BC5_UNORM_BLOCK: return 83;
+    case VK_FORMAT_BC5_SNORM_BLOCK: return 84;
+    case VK_FORMAT_B8G8R8A8_UNORM: return 87;
+    case VK_FORMAT_B8G8R8A8_SRGB: return 91;
+    case VK_FORMAT_BC7_UNORM_BLOCK: return 98;
+    case VK_FORMAT_BC7_SRGB_BLOCK: return 99;
+    default: return 0;
+    }
+}
+
+VkFormat formatFromFourCC(uint32_t code) {
+    if (code == fourCC("DXT1")) return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    if (code == fourCC("DXT2") || code == fourCC("DXT3")) return VK_FORMAT_BC2_UNORM_BLOCK;
+    if (code == fourCC("DXT4") || code == fourCC("DXT5")) return VK_FORMAT_BC3_UNORM_BLOCK;
+    if (code == fourCC("ATI1") || code == fourCC("BC4U")) return VK_FORMAT_BC4_UNORM_BLOCK;
+    if (code == fourCC("BC4S")) return VK_FORMAT_BC4_SNORM_BLOCK;
+    if (code == fourCC("ATI2") || code == fourCC("BC5U")) return VK_FORMAT_BC5_UNORM_BLOCK;
+    if (code == fourCC("BC5S")) return VK_FORMAT_BC5_SNORM_BLOCK;
+    return VK_FORMAT_UNDEFINED;
+}
+
+ContainerTexture parseDds(std::span<const uint8_t> bytes) {
+    if (bytes.size() < kDdsHeaderSize || readLE<uint32_t>(bytes, 4) != 124) {
+        throw std::runtime_error("DDS: truncated header");
+    }
+    ContainerTexture texture;
+    const uint32_t flags = readLE<uint32_t>(bytes, 8);
+    texture.height = readLE<uint32_t>(bytes, 12);
+    texture.width = readLE<uint32_t>(bytes, 16);
+    const uint32_t mipMapCount = readLE<uint32_t>(bytes, 28);
+    const uint32_t pixelFlags = readLE<uint32_t>(bytes, 80);
+    const uint32_t code = readLE<uint32_t>(bytes, 84);
+    const uint32_t caps2 = readLE<uint32_t>(bytes, 112);
+    if (caps2 & (kDdsCubemapCaps | kDdsVolumeCaps)) {
+        throw std::runtime_error("DDS: only single 2D textures are supported");
+    }
+
+    size_t dataOffset = kDdsHeaderSize;
+    if ((pixelFlags & kDdsFourCCFlag) && code == fourCC("DX10")) {
+        if (bytes.size() < kDdsHeaderSize + kDdsDx10HeaderSize) {
+            throw std::runtime_error("DDS: truncated DX10 header");
+        }
+        const uint32_t dxgiFormat = readLE<uint32_t>(bytes, 128);
+        const uint32_t dimension = readLE<uint32_t>(bytes, 132);
+        const uint32_t miscFlag = readLE<uint32_t>(bytes, 136);
+        const uint32_t arraySize = readLE<uint32_t>(bytes, 140);
+        if (dimension != kDxgiTexture2D || (miscFlag & kDxgiTextureCube) || arraySize > 1) {
+            throw std::runtime_error("DDS: only single 2D textures are supported");
+        }
+        texture.format = formatFromDxgi(dxgiFormat);
+        if (texture.format == VK_FORMAT_UNDEFINED) {
+            throw std::runtime_error("DDS: unsupported DXGI format " + std::to_string(dxgiFormat));
+        }
+        dataOffset += kDdsDx10HeaderSize;
+    } else if (pixelFlags & kDdsFourCCFlag) {
+        texture.format = formatFromFourCC(code);
+        if (texture.format == VK_FORMAT_UNDEFINED) {
+            throw std::runtime_error("DDS: unsupported FourCC");
+        }
+    } else if (pixelFlags & kDdsRgbFlag) {
+        const uint32_t bitCount = readLE<uint32_t>(bytes, 88);
+        const uint32_t redMask = readLE<uint32_t>(bytes, 92);
+        const uint32_t alphaMask = readLE<uint32_t>(bytes, 104);
+        if (bitCount == 32 && alphaMask == 0xFF000000u && redMask == 0x00FF0000u) {
+            texture.format = VK_FORMAT_B8G8R8A8_UNORM;
+        } else if (bitCount == 32 && alphaMask == 0xFF000000u && redMask == 0x000000FFu) {
+            texture.format = VK_FORMAT_R8G8B8A8_UNORM;
+        } else {
+            throw std::runtime_error("DDS: unsupported uncompressed layout");
+        }
+    } else {
+        throw std::runtime_error("DDS: unsupported pixel format");
+    }
+
+    texture.levels.resize((flags & kDdsMipMapCountFlag) ? std::max(1u, mipMapCount) : 1u);
+    validateLevels(texture, "DDS");
+    // Levels follow the header back to back, largest first
+    size_t offset = dataOffset;
+    for (size_t level = 0; level < texture.levels.size(); ++level) {
+        const size_t size = textureLevelSize(texture.format,
+            std::max(1u, texture.width >> level), std::max(1u, texture.height >> level));
+        if (bytes.size() - offset < size) {
+            throw std::runtime_error("DDS: level " + std::to_string(level) + " out of range");
+        }
+        texture.levels[level] = bytes.subspan(offset, size);
+        offset += size;
+    }
+    return texture;
+}
+// }}}
+}
+
+// Public API {{{
+bool isTextureContainer(std::span<const uint8_t> bytes) {
+    return isKtx2(bytes) || isDds(bytes);
+}
+
+ContainerTexture parseTextureContainer(std::span<const uint8_t> bytes) {
+    if (isKtx2(bytes)) {
+        return parseKtx2(bytes);
+    }
+    if (isDds(bytes)) {
+        return parseDds(bytes);
+    }
+    throw std::runtime_error("Not a KTX2 or DDS file");
+}
+
+bool isBlockCompressed(VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC4_SNORM_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC5_SNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        return true;
+    default:
+        return false;
+    }
+}
+
+size_t textureLevelSize(VkFormat format, uint32_t width, uint32_t height) {
+    if (!isBlockCompressed(format)) {
+        size_t texelBytes = 4;
+        if (format == VK_FORMAT_R8_UNORM) {
+            texelBytes = 1;
+        } else if (format == VK_FORMAT_R8G8_UNORM) {
+            texelBytes = 2;
+        }
+        return checkedLevelSize(width, height, texelBytes);
+    }
+    size_t blockBytes = 16;
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC4_SNORM_BLOCK:
+        blockBytes = 8;
+        break;
+    default:
+        break;
+    }
+    return checkedLevelSize(
+        (static_cast<size_t>(width) + 3) / 4, (static_cast<size_t>(height) + 3) / 4, blockBytes
+    );
+}
+
+namespace {
+using DdsHeader = std::array<uint32_t, (kDdsHeaderSize + kDdsDx10HeaderSize) / 4>;
+
+/// Validated DDS + DX10 header for `texture`
+DdsHeader ddsHeader(const ContainerTexture& texture) {
+    const uint32_t dxgiFormat = dxgiFromFormat(texture.format);
+    if (dxgiFormat == 0) {
+        throw std::runtime_error("DDS: cannot write format " + std::to_string(texture.format));
+    }
+    validateLevels(texture, "DDS");
+    for (size_t level = 0; level < texture.levels.size(); ++level) {
+        const size_t size = textureLevelSize(texture.format,
+            std::max(1u, texture.width >> level), std::max(1u, texture.height >> level));
+        if (texture.levels[level].size() != size) {
+            throw std::runtime_error("DDS: level " + std::to_string(level) + " has the wrong size");
+        }
+    }
+
+    DdsHeader header{};
+    const bool mipmapped = texture.levels.size() > 1;
+    header[0] = fourCC("DDS ");
+    header[1] = 124;
+    header[2] = kDdsRequiredFlags | kDdsLinearSizeFlag | (mipmapped ? kDdsMipMapCountFlag : 0);
+    header[3] = texture.height;
+    header[4] = texture.width;
+    header[5] = static_cast<uint32_t>(texture.levels[0].size());
+    header[7] = static_cast<uint32_t>(texture.levels.size());
+    header[19] = 32;                    // DDS_PIXELFORMAT
+    header[20] = kDdsFourCCFlag;
+    header[21] = fourCC("DX10");
+    header[27] = kDdsTextureCaps | (mipmapped ? kDdsMipMapCaps : 0);
+    header[32] = dxgiFormat;            // DDS_HEADER_DXT10
+    header[33] = kDxgiTexture2D;
+    header[35] = 1;
+    return header;
+}
+}
+
+std::vector<uint8_t> encodeDds(const ContainerTexture& texture) {
+    const DdsHeader header = ddsHeader(texture);
+    size_t size = sizeof(header);
+    for (const auto& level : texture.levels) {
+        size += level.size();
+    }
+    std::vector<uint8_t> bytes(size);
+    std::memcpy(bytes.data(), header.data(), sizeof(header));
+    size_t offset = sizeof(header);
+    for (const auto& level : texture.levels) {
+        std::memcpy(bytes.data() + offset, level.data(), level.size());
+        offset += level.size();
+    }
+    return bytes;
+}
+
+void writeDds(const std::filesystem::path& path, const ContainerTexture& texture) {
+    const DdsHeader header = ddsHeader(texture);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(header.data()), sizeof(header));
+    for (const auto& level : texture.levels) {
+        file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+    }
+    if (!file) {
+        throw std::runtime_error("DDS: could not write " + path.string());
+    }
+}
+
+VkFormat textureFormatForColorSpace(VkFormat format, bool srgb) {
+    static constexpr VkFormat kPairs[][2] = {
+        {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB},
+        {VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SRGB},
+        {VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGB_SRGB_BLOCK},
+        {VK_FORMAT_BC1_RGBA_UNORM_BLOCK, VK_FORMAT_BC1_RGBA_SRGB_BLOCK},
+        {VK_FORMAT_BC2_UNORM_BLOCK, VK_FORMAT_BC2_SRGB_BLOCK},
+        {VK_FORMAT_BC3_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK},
+        {VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK},
+    };
+    for (const auto& [unorm, srgbFormat] : kPairs) {
+        if (format == unorm || format == srgbFormat) {
+            return srgb ? srgbFormat : unorm;
+        }
+    }
+    return format;
+}
+// }}}
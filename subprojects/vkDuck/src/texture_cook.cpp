@@ -0,0 +1,315 @@
+// vim:foldmethod=marker
+#include <vkDuck/texture_cook.h>
+#include <vkDuck/bc_encoder.h>
+#include <vkDuck/mapped_file.h>
+#include <vkDuck/texture_container.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+// Helpers {{{
+bool hasTranslucentTexels(const uint8_t* bgra, size_t texels) {
+    for (size_t i = 0; i < texels; ++i) {
+        if (bgra[i * 4 + 3] != 255) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// File name prefix shared by every cook of a source in a role:
+/// "wood.png.color." or "ship.glb.image3.normal."
+std::string cookedPrefix(const fs::path& sourcePath, TextureRole role) {
+    std::string name = sourcePath.filename().string();
+    if (const size_t hash = name.rfind('#'); hash != std::string::npos) {
+        name.replace(hash, 1, ".image");
+    }
+    return name + "." + textureRoleName(role) + ".";
+}
+
+/// Remove cooks of the same source and role other than `current`
+void removeStaleCooks(const fs::path& current, const std::string& prefix) {
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(current.parent_path().empty() ? "." : current.parent_path(), ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name != current.filename().string() && name.starts_with(prefix) && name.ends_with(".dds")) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+/// Write `texture` to `path` through a temporary file, so concurrent
+/// readers never see a partial cook
+bool writeCook(const fs::path& path, const ContainerTexture& texture) {
+    fs::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    try {
+        writeDds(tempPath, texture);
+        fs::rename(tempPath, path);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: could not write cooked texture " << path.string()
+            << ": " << e.what() << std::endl;
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+}
+
+/// loadCookedTexture(), or cookTexture() when `loadResult` is false: then
+/// a cache hit is not read and the encoded blocks are dropped once written
+LoadedImage cookAndLoad(
+    const fs::path& sourcePath,
+    std::span<const uint8_t> encoded,
+    TextureRole role,
+    TextureCookStats& result,
+    bool loadResult
+) {
+    result = {};
+
+    MappedFile file;
+    if (encoded.empty()) {
+        try {
+            file = MappedFile(sourcePath);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load texture " << sourcePath << ": " << e.what() << std::endl;
+            return {};
+        }
+        encoded = file.bytes();
+    }
+    if (isTextureContainer(encoded)) {
+        return loadResult ? textureLoadFromMemory(encoded) : LoadedImage{};
+    }
+
+    const uint64_t seed = (static_cast<uint64_t>(kTextureCookVersion) << 8) | static_cast<uint64_t>(role);
+    const fs::path cookedPath = cookedTexturePath(sourcePath, role, hashBytes(encoded.data(), encoded.size(), seed));
+
+    // Warm load: the cook replaces decoding entirely
+    std::error_code ec;
+    if (fs::exists(cookedPath, ec) && !loadResult) {
+        // Only the header is read; the caller maps the file again to upload it
+        try {
+            TextureSource cooked(cookedPath);
+            if (isBlockCompressed(cooked.format())) {
+                result.cooked = true;
+                result.cacheHit = true;
+                result.format = cooked.format();
+                result.uncompressedBytes = mipChainSize(cooked.width(), cooked.height(), cooked.mipLevels());
+                result.cookedBytes = cooked.size();
+                result.cookedPath = cookedPath;
+                return {};
+            }
+        } catch (const std::exception&) {
+            // Unreadable cook: cooked again below
+        }
+    }
+    if (fs::exists(cookedPath, ec)) {
+        LoadedImage image = textureLoad(cookedPath);
+        if (image.valid && isBlockCompressed(image.format)) {
+            result.cooked = true;
+            result.cacheHit = true;
+            result.format = image.format;
+            result.uncompressedBytes = mipChainSize(image.width, image.height, image.mipLevels);
+            result.cookedBytes = image.size;
+            result.cookedPath = cookedPath;
+            return image;
+        }
+        imageFree(image.pixels);
+    }
+
+    LoadedImage source = textureLoadFromMemory(encoded);
+    if (!source.valid) {
+        return source;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t width = source.width;
+    const uint32_t height = source.height;
+    const uint32_t levels = mipLevelCount(width, height);
+    const size_t level0Size = static_cast<size_t>(width) * height * 4;
+    const auto* level0 = static_cast<const uint8_t*>(source.pixels);
+    const VkFormat format = cookedTextureFormat(role, hasTranslucentTexels(level0, size_t(width) * height));
+
+    std::vector<uint8_t> chain(mipChainSize(width, height, levels));
+    std::memcpy(chain.data(), level0, level0Size);
+    generateMipChain(level0, width, height, levels, role == TextureRole::Color, chain.data() + level0Size);
+
+    size_t cookedSize = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        cookedSize += textureLevelSize(format, std::max(1u, width >> level), std::max(1u, height >> level));
+    }
+    auto* blocks = static_cast<uint8_t*>(malloc(cookedSize));
+    if (!blocks) {
+        imageFree(source.pixels);
+        return {};
+    }
+    encodeBlockMipChain(chain.data(), width, height, levels, format, blocks);
+    const double encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint8_t> decoded(level0Size);
+    decodeBlocks(blocks, width, height, format, decoded.data());
+    result.cooked = true;
+    result.format = format;
+    result.encodeMs = encodeMs;
+    result.megapixelsPerSecond = encodeMs > 0.0 ? static_cast<double>(chain.size() / 4) / (encodeMs * 1e3) : 0.0;
+    result.psnr = blockPsnr({level0, level0Size}, decoded, format);
+    result.uncompressedBytes = chain.size();
+    result.cookedBytes = cookedSize;
+    imageFree(source.pixels);
+
+    ContainerTexture texture{format, width, height, {}};
+    size_t offset = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        const size_t size = textureLevelSize(format, std::max(1u, width >> level), std::max(1u, height >> level));
+        texture.levels.emplace_back(blocks + offset, size);
+        offset += size;
+    }
+    if (writeCook(cookedPath, texture)) {
+        result.cookedPath = cookedPath;
+        removeStaleCooks(cookedPath, cookedPrefix(sourcePath, role));
+    }
+
+    LoadedImage image;
+    image.pixels = blocks;
+    image.width = width;
+    image.height = height;
+    image.valid = true;
+    image.format = format;
+    image.mipLevels = levels;
+    image.size = cookedSize;
+    return image;
+}
+// }}}
+}
+
+// Texture cooking {{{
+const char* textureRoleName(TextureRole role) {
+    switch (role) {
+        case TextureRole::Color: return "color";
+        case TextureRole::Normal: return "normal";
+        case TextureRole::Data: return "data";
+    }
+    return "color";
+}
+
+VkFormat cookedTextureFormat(TextureRole role, bool hasAlpha) {
+    switch (role) {
+        case TextureRole::Normal:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case TextureRole::Data:
+            return VK_FORMAT_BC7_UNORM_BLOCK;
+        case TextureRole::Color:
+            break;
+    }
+    return hasAlpha ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+}
+
+fs::path cookedTexturePath(const fs::path& sourcePath, TextureRole role, uint64_t sourceHash) {
+    char key[9];
+    std::snprintf(key, sizeof(key), "%08x", static_cast<uint32_t>(sourceHash));
+    return sourcePath.parent_path() / (cookedPrefix(sourcePath, role) + key + ".dds");
+}
+
+LoadedImage loadCookedTexture(
+    const fs::path& sourcePath,
+    std::span<const uint8_t> encoded,
+    TextureRole role,
+    TextureCookStats* stats
+) {
+    TextureCookStats localStats;
+    return cookAndLoad(sourcePath, encoded, role, stats ? *stats : localStats, true);
+}
+
+fs::path cookTexture(
+    const fs::path& sourcePath,
+    std::span<const uint8_t> encoded,
+    TextureRole role,
+    TextureCookStats* stats
+) {
+    TextureCookStats localStats;
+    TextureCookStats& result = stats ? *stats : localStats;
+    imageFree(cookAndLoad(sourcePath, encoded, role, result, false).pixels);
+    return result.cookedPath;
+}
+// }}}
+
+// Reduced channels {{{
+TextureChannelLayout textureChannelLayout(TextureRole role, const uint8_t* bgra, size_t texels) {
+    TextureChannelLayout layout;
+    if (role == TextureRole::Normal) {
+        layout.channels = TextureChannels::Rg;
+        layout.swizzle = textureFormatSwizzle(role, textureChannelsFormat(layout.channels));
+        return layout;
+    }
+    if (role != TextureRole::Data || !bgra || texels == 0) {
+        return layout;
+    }
+
+    // BGRA8 byte order: 0 = B, 1 = G, 2 = R
+    bool rConstant = true;
+    bool gConstant = true;
+    bool bConstant = true;
+    bool gEqualsB = true;
+    for (size_t i = 0; i < texels; ++i) {
+        const uint8_t* texel = bgra + i * 4;
+        rConstant &= texel[2] == bgra[2];
+        gConstant &= texel[1] == bgra[1];
+        bConstant &= texel[0] == bgra[0];
+        gEqualsB &= texel[1] == texel[0];
+    }
+    // A channel that is 0 or 255 everywhere is read from the swizzle
+    auto constantSwizzle = [](bool constant, uint8_t value) -> std::optional<VkComponentSwizzle> {
+        if (constant && (value == 0 || value == 255)) {
+            return value == 0 ? VK_COMPONENT_SWIZZLE_ZERO : VK_COMPONENT_SWIZZLE_ONE;
+        }
+        return std::nullopt;
+    };
+    const VkComponentSwizzle r = constantSwizzle(rConstant, bgra[2]).value_or(VK_COMPONENT_SWIZZLE_ONE);
+    const std::optional<VkComponentSwizzle> g = constantSwizzle(gConstant, bgra[1]);
+    const std::optional<VkComponentSwizzle> b = constantSwizzle(bConstant, bgra[0]);
+
+    if (b) {
+        layout.channels = TextureChannels::G;
+        layout.swizzle = {r, VK_COMPONENT_SWIZZLE_R, *b, VK_COMPONENT_SWIZZLE_ONE};
+    } else if (g) {
+        layout.channels = TextureChannels::B;
+        layout.swizzle = {r, *g, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE};
+    } else if (gEqualsB) {
+        layout.channels = TextureChannels::G;
+        layout.swizzle = {r, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE};
+    } else {
+        layout.channels = TextureChannels::Gb;
+        layout.swizzle = {r, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_ONE};
+    }
+    return layout;
+}
+
+VkComponentMapping textureFormatSwizzle(TextureRole role, VkFormat format) {
+    if (role != TextureRole::Normal) {
+        return {};
+    }
+    switch (format) {
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R8G8_SNORM:
+        case VK_FORMAT_R16G16_UNORM:
+        case VK_FORMAT_R16G16_SNORM:
+        case VK_FORMAT_R16G16_SFLOAT:
+            return {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G,
+                    VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE};
+        default:
+            return {};
+    }
+}
+// }}}
@@ -0,0 +1,254 @@
+// vim:foldmethod=marker
+#include <vkDuck/vertex_formats.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+// Internal helper functions {{{
+namespace {
+
+int16_t toSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+uint16_t toUnorm16(float value) {
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint8_t toUnorm8(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+/// IEEE 754 binary16 with round-to-nearest-even
+uint16_t toHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        // Inf stays inf, NaN stays a quiet NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+    }
+    if (magnitude >= 0x477ff000u) {
+        return static_cast<uint16_t>(sign | 0x7c00u);  // Rounds past 65504
+    }
+    if (magnitude < 0x38800000u) {
+        // Below the smallest normal half: produce a subnormal
+        const int shift = 126 - static_cast<int>(magnitude >> 23);
+        if (shift > 24) {
+            return static_cast<uint16_t>(sign);
+        }
+        const uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (magnitude - 0x38000000u) >> 13;  // Rebias exponent 127 -> 15
+    const uint32_t remainder = magnitude & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+/// Octahedral projection of a direction onto two snorm16 values
+void octEncode(const glm::vec3& v, int16_t out[2]) {
+    const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (l1 <= 0.0f) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+    float x = v.x / l1;
+    float y = v.y / l1;
+    if (v.z < 0.0f) {
+        const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = toSnorm16(x);
+    out[1] = toSnorm16(y);
+}
+
+/// Fields shared by PackedVertex and QuantizedVertex
+template <typename T>
+void packAttributes(const Vertex& v, T& out) {
+    octEncode(v.normal, out.normal);
+    out.texCoord[0] = toHalf(v.texCoord.x);
+    out.texCoord[1] = toHalf(v.texCoord.y);
+    out.color[0] = toUnorm8(v.color.x);
+    out.color[1] = toUnorm8(v.color.y);
+    out.color[2] = toUnorm8(v.color.z);
+    out.color[3] = v.tangent.w < 0.0f ? 0 : 255;
+    octEncode(glm::vec3(v.tangent), out.tangent);
+}
+
+template <typename T>
+std::vector<VkVertexInputAttributeDescription> packedAttributes(VkFormat positionFormat) {
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions(5);
+
+    attributeDescriptions[0].binding = 0;
+    attributeDescriptions[0].location = 0;
+    attributeDescriptions[0].format = positionFormat;
+    attributeDescriptions[0].offset = offsetof(T, pos);
+
+    attributeDescriptions[1].binding = 0;
+    attributeDescriptions[1].location = 1;
+    attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
+    attributeDescriptions[1].offset = offsetof(T, normal);
+
+    attributeDescriptions[2].binding = 0;
+    attributeDescriptions[2].location = 2;
+    attributeDescriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+    attributeDescriptions[2].offset = offsetof(T, texCoord);
+
+    attributeDescriptions[3].binding = 0;
+    attributeDescriptions[3].location = 3;
+    attributeDescriptions[3].format = VK_FORMAT_R8G8B8A8_UNORM;
+    attributeDescriptions[3].offset = offsetof(T, color);
+
+    attributeDescriptions[4].binding = 0;
+    attributeDescriptions[4].location = 4;
+    attributeDescriptions[4].format = VK_FORMAT_R16G16_SNORM;
+    attributeDescriptions[4].offset = offsetof(T, tangent);
+
+    return attributeDescriptions;
+}
+
+template <typename T>
+VkVertexInputBindingDescription packedBinding() {
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = 0;
+    bindingDescription.stride = sizeof(T);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    return bindingDescription;
+}
+
+} // anonymous namespace
+// }}}
+
+// Vertex layouts {{{
+VkVertexInputBindingDescription PackedVertex::getBindingDescription() {
+    return packedBinding<PackedVertex>();
+}
+
+std::vector<VkVertexInputAttributeDescription> PackedVertex::getAttributeDescriptions() {
+    return packedAttributes<PackedVertex>(VK_FORMAT_R32G32B32_SFLOAT);
+}
+
+VkVertexInputBindingDescription QuantizedVertex::getBindingDescription() {
+    return packedBinding<QuantizedVertex>();
+}
+
+std::vector<VkVertexInputAttributeDescription> QuantizedVertex::getAttributeDescriptions() {
+    return packedAttributes<QuantizedVertex>(VK_FORMAT_R16G16B16A16_UNORM);
+}
+
+const char* vertexFormatName(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Full: return "Full";
+    case VertexFormat::Packed: return "Packed";
+    case VertexFormat::PackedQuantized: return "PackedQuantized";
+    }
+    return "Unknown";
+}
+
+uint32_t vertexStride(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Full: return sizeof(Vertex);
+    case VertexFormat::Packed: return sizeof(PackedVertex);
+    case VertexFormat::PackedQuantized: return sizeof(QuantizedVertex);
+    }
+    throw std::runtime_error("Unknown vertex format");
+}
+
+VkVertexInputBindingDescription vertexBindingDescription(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Full: return Vertex::getBindingDescription();
+    case VertexFormat::Packed: return PackedVertex::getBindingDescription();
+    case VertexFormat::PackedQuantized: return QuantizedVertex::getBindingDescription();
+    }
+    throw std::runtime_error("Unknown vertex format");
+}
+
+std::vector<VkVertexInputAttributeDescription> vertexAttributeDescriptions(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Full: return Vertex::getAttributeDescriptions();
+    case VertexFormat::Packed: return PackedVertex::getAttributeDescriptions();
+    case VertexFormat::PackedQuantized: return QuantizedVertex::getAttributeDescriptions();
+    }
+    throw std::runtime_error("Unknown vertex format");
+}
+// }}}
+
+// Packing {{{
+PositionDequantization packVertices(
+    std::span<const Vertex> vertices,
+    VertexFormat format,
+    void* destination
+) {
+    PositionDequantization dequantization;
+
+    switch (format) {
+    case VertexFormat::Full:
+        std::memcpy(destination, vertices.data(), vertices.size_bytes());
+        break;
+
+    case VertexFormat::Packed: {
+        auto* out = static_cast<PackedVertex*>(destination);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            PackedVertex packed;
+            packed.pos = vertices[i].pos;
+            packAttributes(vertices[i], packed);
+            std::memcpy(&out[i], &packed, sizeof(PackedVertex));
+        }
+        break;
+    }
+
+    case VertexFormat::PackedQuantized: {
+        glm::vec3 boundsMin(0.0f);
+        glm::vec3 boundsMax(0.0f);
+        if (!vertices.empty()) {
+            boundsMin = boundsMax = vertices[0].pos;
+            for (const Vertex& v : vertices) {
+                boundsMin = glm::min(boundsMin, v.pos);
+                boundsMax = glm::max(boundsMax, v.pos);
+            }
+        }
+        const glm::vec3 extent = boundsMax - boundsMin;
+        const glm::vec3 inverse(
+            extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+            extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+            extent.z > 0.0f ? 1.0f / extent.z : 0.0f
+        );
+
+        auto* out = static_cast<QuantizedVertex*>(destination);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const glm::vec3 unit = (vertices[i].pos - boundsMin) * inverse;
+            QuantizedVertex packed;
+            packed.pos[0] = toUnorm16(unit.x);
+            packed.pos[1] = toUnorm16(unit.y);
+            packed.pos[2] = toUnorm16(unit.z);
+            packed.pos[3] = 0;
+            packAttributes(vertices[i], packed);
+            std::memcpy(&out[i], &packed, sizeof(QuantizedVertex));
+        }
+
+        dequantization.offset = glm::vec4(boundsMin, 0.0f);
+        dequantization.scale = glm::vec4(extent, 0.0f);
+        break;
+    }
+    }
+
+    return dequantization;
+}
+// }}}
@@ -0,0 +1,565 @@
+// vim:foldmethod=marker
+// Model loader tests. Each case writes a small glTF to a temporary
+// directory, loads it and checks the result.
+//
+//   vkDuckTests [case...]
+//
+// Without arguments every case runs. Exits non-zero if any check fails.
+#include <vkDuck/meshopt_codec.h>
+#include <vkDuck/model_loader.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Test helpers {{{
+namespace {
+
+int gFailures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__,       \
+                __LINE__, #condition);                                          \
+            ++gFailures;                                                        \
+        }                                                                       \
+    } while (0)
+
+bool near(const glm::vec3& a, const glm::vec3& b) {
+    return glm::length(a - b) < 1e-5f;
+}
+
+/// True if some vertex of `vertices` sits at `position`
+bool hasVertexAt(std::span<const Vertex> vertices, const glm::vec3& position) {
+    for (const Vertex& vertex : vertices) {
+        if (near(vertex.pos, position)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void append(std::vector<unsigned char>& bytes, const T& value) {
+    const auto* begin = reinterpret_cast<const unsigned char*>(&value);
+    bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+/// Binary buffer of one triangle: three float3 positions at offset 0,
+/// then three uint16 indices at offset 36
+std::vector<unsigned char> triangleBuffer() {
+    std::vector<unsigned char> bytes;
+    for (float value : {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f}) {
+        append(bytes, value);
+    }
+    for (uint16_t index : {0, 1, 2}) {
+        append(bytes, index);
+    }
+    bytes.resize(44);
+    return bytes;
+}
+
+/// Accessors 0 (POSITION) and 1 (indices) and mesh 0 over triangleBuffer(),
+/// stored as "<name>.bin"
+std::string triangleMeshJson(const std::string& name) {
+    return "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}],"
+        "\"accessors\":["
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]},"
+        "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"bufferViews\":["
+        "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}],"
+        "\"buffers\":[{\"uri\":\"" + name + ".bin\",\"byteLength\":44}]";
+}
+
+/// Write "<name>.gltf" with the given JSON members after "asset", and
+/// "<name>.bin" with `bin`
+fs::path writeModel(const fs::path& directory, const std::string& name,
+                    const std::string& members, const std::vector<unsigned char>& bin) {
+    std::ofstream(directory / (name + ".bin"), std::ios::binary)
+        .write(reinterpret_cast<const char*>(bin.data()), std::streamsize(bin.size()));
+    const fs::path path = directory / (name + ".gltf");
+    std::ofstream(path) << "{\"asset\":{\"version\":\"2.0\"}," << members << "}";
+    return path;
+}
+
+} // namespace
+// }}}
+
+// Scene hierarchy {{{
+namespace {
+
+/// A parent node translated by (10, 0, 0) with a child translated by
+/// (0, 5, 0) that owns the triangle
+fs::path writeHierarchyModel(const fs::path& directory) {
+    return writeModel(directory, "hierarchy",
+        "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":["
+        "{\"name\":\"parent\",\"translation\":[10,0,0],\"children\":[1]},"
+        "{\"name\":\"child\",\"translation\":[0,5,0],\"mesh\":0}],"
+        + triangleMeshJson("hierarchy"),
+        triangleBuffer());
+}
+
+void testPreserveHierarchy(const fs::path& directory) {
+    const fs::path path = writeHierarchyModel(directory);
+
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    options.preserveHierarchy = true;
+    const ModelData data = loadModel(path, directory, options);
+
+    CHECK(data.hierarchical);
+    CHECK(data.ranges.size() == 1);
+    if (data.ranges.size() != 1) {
+        return;
+    }
+
+    // Vertices stay in mesh space; the owning node carries the transform
+    const auto vertices = geometryVertices(data, 0);
+    CHECK(vertices.size() == 3);
+    CHECK(hasVertexAt(vertices, {0.0f, 0.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {1.0f, 0.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {0.0f, 1.0f, 0.0f}));
+
+    const int32_t node = data.ranges[0].node;
+    CHECK(node >= 0 && node < static_cast<int32_t>(data.nodes.size()));
+    if (node < 0 || node >= static_cast<int32_t>(data.nodes.size())) {
+        return;
+    }
+    CHECK(data.nodes[node].name == "child");
+    const int32_t parent = data.nodes[node].parent;
+    CHECK(parent >= 0 && data.nodes[parent].name == "parent");
+    CHECK(near(glm::vec3(data.nodes[node].localTransform[3]), {0.0f, 5.0f, 0.0f}));
+    CHECK(near(glm::vec3(geometryTransform(data, 0) * glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)),
+        {11.0f, 5.0f, 0.0f}));
+}
+
+void testFlattenedHierarchy(const fs::path& directory) {
+    const fs::path path = writeHierarchyModel(directory);
+
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    const ModelData data = loadModel(path, directory, options);
+
+    // Without preserveHierarchy the world transform is baked in
+    CHECK(!data.hierarchical);
+    CHECK(data.ranges.size() == 1);
+    const auto vertices = geometryVertices(data, 0);
+    CHECK(vertices.size() == 3);
+    CHECK(hasVertexAt(vertices, {10.0f, 5.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {11.0f, 5.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {10.0f, 6.0f, 0.0f}));
+}
+
+} // namespace
+// }}}
+
+// Data URI buffers {{{
+namespace {
+
+void testDataUriBuffer(const fs::path& directory) {
+    // triangleBuffer() as base64; 44 bytes end in a padded quad
+    const std::vector<unsigned char> bin = triangleBuffer();
+    static constexpr char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    for (size_t i = 0; i < bin.size(); i += 3) {
+        const size_t n = std::min<size_t>(3, bin.size() - i);
+        uint32_t group = uint32_t(bin[i]) << 16;
+        if (n > 1) group |= uint32_t(bin[i + 1]) << 8;
+        if (n > 2) group |= bin[i + 2];
+        encoded += kAlphabet[(group >> 18) & 63];
+        encoded += kAlphabet[(group >> 12) & 63];
+        encoded += n > 1 ? kAlphabet[(group >> 6) & 63] : '=';
+        encoded += n > 2 ? kAlphabet[group & 63] : '=';
+    }
+
+    std::string json = triangleMeshJson("dataUri");
+    json.replace(json.find("dataUri.bin"), std::string_view("dataUri.bin").size(),
+        "data:application/octet-stream;base64," + encoded);
+    const fs::path path = writeModel(directory, "dataUri",
+        "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}]," + json, {});
+
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    const ModelData data = loadModel(path, directory, options);
+    CHECK(data.timings.dataUriBytes == bin.size());
+    CHECK(data.ranges.size() == 1);
+    if (data.ranges.size() != 1) {
+        return;
+    }
+    const auto vertices = geometryVertices(data, 0);
+    CHECK(vertices.size() == 3);
+    CHECK(hasVertexAt(vertices, {0.0f, 0.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {1.0f, 0.0f, 0.0f}));
+    CHECK(hasVertexAt(vertices, {0.0f, 1.0f, 0.0f}));
+    CHECK(data.ranges[0].indexCount == 3);
+}
+
+} // namespace
+// }}}
+
+// Accessor bounds {{{
+namespace {
+
+/// Load a single-node model whose mesh members are `meshJson`, expecting
+/// std::runtime_error
+bool loadThrows(const fs::path& directory, const std::string& name,
+                const std::string& meshJson, const std::vector<unsigned char>& bin) {
+    const fs::path path = writeModel(directory, name,
+        "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}]," + meshJson, bin);
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    try {
+        loadModel(path, directory, options);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+/// triangleMeshJson() with the POSITION accessor replaced by `position`
+/// and its buffer view by `positionView`
+std::string triangleWith(const std::string& name, const std::string& position,
+                         const std::string& positionView) {
+    return "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}],"
+        "\"accessors\":[" + position + ","
+        "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"bufferViews\":[" + positionView + ","
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}],"
+        "\"buffers\":[{\"uri\":\"" + name + ".bin\",\"byteLength\":44}]";
+}
+
+void testAccessorBounds(const fs::path& directory) {
+    const std::string view = "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36}";
+
+    // Well-formed: three float3 in a 36-byte view
+    CHECK(!loadThrows(directory, "inBounds", triangleWith("inBounds",
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]}", view), triangleBuffer()));
+
+    // Four elements in a view that holds three
+    CHECK(loadThrows(directory, "overCount", triangleWith("overCount",
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]}", view), triangleBuffer()));
+
+    // Three elements shifted by one float past the end of the view
+    CHECK(loadThrows(directory, "overOffset", triangleWith("overOffset",
+        "{\"bufferView\":0,\"byteOffset\":4,\"componentType\":5126,\"count\":3,"
+        "\"type\":\"VEC3\",\"min\":[0,0,0],\"max\":[1,1,0]}", view), triangleBuffer()));
+
+    // A 16-byte stride puts the last element at 32..44 in a 36-byte view
+    CHECK(loadThrows(directory, "overStride", triangleWith("overStride",
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]}",
+        "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36,\"byteStride\":16}"),
+        triangleBuffer()));
+
+    // A view past the end of its 44-byte buffer
+    CHECK(loadThrows(directory, "overBuffer", triangleWith("overBuffer",
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]}",
+        "{\"buffer\":0,\"byteOffset\":12,\"byteLength\":36}"), triangleBuffer()));
+
+    // NORMAL with fewer elements than POSITION
+    CHECK(loadThrows(directory, "shortNormals",
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":2},"
+        "\"indices\":1}]}],"
+        "\"accessors\":["
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+        "\"min\":[0,0,0],\"max\":[1,1,0]},"
+        "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":2,\"type\":\"VEC3\"}],"
+        "\"bufferViews\":["
+        "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}],"
+        "\"buffers\":[{\"uri\":\"shortNormals.bin\",\"byteLength\":44}]",
+        triangleBuffer()));
+}
+
+} // namespace
+// }}}
+
+// EXT_meshopt_compression {{{
+namespace {
+
+/// Vertex codec stream of four 4-byte vertices, one delta channel per byte
+/// and one of each group width: 0 bits, 2 bits with two escapes, 4 bits
+/// and 8 bits. Decodes to {7,20,30,40} {7,20,28,40} {7,22,30,40} {7,20,30,41}.
+std::vector<unsigned char> meshoptVertexStream() {
+    std::vector<unsigned char> stream = {
+        0xa0,
+        0x00,
+        0x01, 0x0f, 0x00, 0x00, 0x00, 0x04, 0x03,
+        0x02, 0x03, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x00, 0x00, 0x00, 0x02,
+    };
+    stream.resize(stream.size() + 12 + 28);
+    for (unsigned char byte : {7, 20, 30, 40}) {
+        stream.push_back(byte);
+    }
+    return stream;
+}
+
+void testMeshoptStreams(const fs::path&) {
+    // Bytes of the first case in meshoptimizer's decodeIndexV0 test
+    const std::vector<unsigned char> triangles = {
+        0xe0, 0xf0, 0x10, 0xfe, 0xff, 0xf0, 0x0c, 0xff, 0x02, 0x02, 0x02, 0x00, 0x76, 0x87,
+        0x56, 0x67, 0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+    };
+    std::vector<uint32_t> indices(12);
+    decodeMeshoptStream(indices.data(), indices.size(), 4, triangles,
+        MeshoptMode::Triangles, MeshoptFilter::None);
+    CHECK((indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9}));
+
+    // Same stream as 16-bit indices
+    std::vector<uint16_t> shortIndices(12);
+    decodeMeshoptStream(shortIndices.data(), shortIndices.size(), 2, triangles,
+        MeshoptMode::Triangles, MeshoptFilter::None);
+    CHECK((shortIndices == std::vector<uint16_t>{0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9}));
+
+    // Bytes of meshoptimizer's decodeIndexSequence test: both baselines,
+    // negative deltas and two-byte varints
+    const std::vector<unsigned char> sequence = {
+        0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00, 0x00,
+    };
+    std::vector<uint32_t> sequenceIndices(6);
+    decodeMeshoptStream(sequenceIndices.data(), sequenceIndices.size(), 4, sequence,
+        MeshoptMode::Indices, MeshoptFilter::None);
+    CHECK((sequenceIndices == std::vector<uint32_t>{0, 1, 51, 2, 49, 1000}));
+
+    std::vector<unsigned char> vertices(16);
+    decodeMeshoptStream(vertices.data(), 4, 4, meshoptVertexStream(),
+        MeshoptMode::Attributes, MeshoptFilter::None);
+    CHECK((vertices == std::vector<unsigned char>{
+        7, 20, 30, 40, 7, 20, 28, 40, 7, 22, 30, 40, 7, 20, 30, 41}));
+
+    // Two vertices 0xff000003 and 0x02fffffb, i.e. 3 * 2^-1 and -5 * 2^2
+    std::vector<unsigned char> exponential = {
+        0xa0,
+        0x03, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x10, 0x00, 0x00, 0x00,
+        0x01, 0x10, 0x00, 0x00, 0x00,
+        0x02, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    exponential.resize(exponential.size() + 28);
+    for (unsigned char byte : {0x03, 0x00, 0x00, 0xff}) {
+        exponential.push_back(byte);
+    }
+    float values[2] = {};
+    decodeMeshoptStream(values, 2, 4, exponential,
+        MeshoptMode::Attributes, MeshoptFilter::Exponential);
+    CHECK(values[0] == 1.5f);
+    CHECK(values[1] == -20.0f);
+
+    // One byte short of the tail
+    std::vector<unsigned char> truncated = meshoptVertexStream();
+    truncated.pop_back();
+    bool threw = false;
+    try {
+        decodeMeshoptStream(vertices.data(), 4, 4, truncated,
+            MeshoptMode::Attributes, MeshoptFilter::None);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+/// The triangle of triangleMeshJson() plus a 16-byte fallback buffer
+/// decoded from meshoptVertexStream(), stored after triangleBuffer(), with
+/// the extension members `ext` overriding the defaults
+std::string meshoptMeshJson(const std::string& name, const std::string& ext) {
+    const size_t binSize = 44 + meshoptVertexStream().size();
+    std::string json = triangleMeshJson(name);
+    json.replace(json.find("\"buffers\""), std::string::npos,
+        "\"buffers\":[{\"uri\":\"" + name + ".bin\",\"byteLength\":" +
+        std::to_string(binSize) + "},"
+        "{\"byteLength\":16,\"extensions\":{\"EXT_meshopt_compression\":{\"fallback\":true}}}],"
+        "\"extensionsUsed\":[\"EXT_meshopt_compression\"]");
+    const std::string views = "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}";
+    json.replace(json.find(views) + views.size(), 0,
+        ",{\"buffer\":1,\"byteLength\":16,\"extensions\":{\"EXT_meshopt_compression\":{"
+        "\"buffer\":0,\"byteOffset\":44,\"byteLength\":" +
+        std::to_string(meshoptVertexStream().size()) + ",\"mode\":\"ATTRIBUTES\"," + ext + "}}}");
+    return json;
+}
+
+void testMeshoptBounds(const fs::path& directory) {
+    std::vector<unsigned char> bin = triangleBuffer();
+    const std::vector<unsigned char> stream = meshoptVertexStream();
+    bin.insert(bin.end(), stream.begin(), stream.end());
+
+    // Well-formed: four 4-byte vertices fill the 16-byte view
+    const fs::path path = writeModel(directory, "meshopt",
+        "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}]," +
+        meshoptMeshJson("meshopt", "\"byteStride\":4,\"count\":4"), bin);
+    ModelLoadOptions options;
+    options.useMeshCache = false;
+    CHECK(loadModel(path, directory, options).timings.meshoptBytes == 16);
+
+    // count * byteStride is 2^64, which wraps to 0; decoding would write
+    // past the view. Integers are written as reals since tinygltf keeps
+    // them as int.
+    CHECK(loadThrows(directory, "meshoptWrap", meshoptMeshJson("meshoptWrap",
+        "\"byteStride\":4,\"count\":4611686018427387904.0"), bin));
+    CHECK(loadThrows(directory, "meshoptNegative", meshoptMeshJson("meshoptNegative",
+        "\"byteStride\":4,\"count\":-4"), bin));
+    CHECK(loadThrows(directory, "meshoptFraction", meshoptMeshJson("meshoptFraction",
+        "\"byteStride\":4,\"count\":3.5"), bin));
+    CHECK(loadThrows(directory, "meshoptHuge", meshoptMeshJson("meshoptHuge",
+        "\"byteStride\":4,\"count\":1e30"), bin));
+    CHECK(loadThrows(directory, "meshoptFiveVertices", meshoptMeshJson("meshoptFiveVertices",
+        "\"byteStride\":4,\"count\":5"), bin));
+}
+
+} // namespace
+// }}}
+
+// Mesh cache {{{
+namespace {
+
+/// Two nodes with a triangle each, in separate buffers "<name>_a.bin" and
+/// "<name>_b.bin"
+fs::path writeTwoBufferModel(const fs::path& directory, const std::string& name) {
+    const std::vector<unsigned char> bin = triangleBuffer();
+    std::ofstream(directory / (name + "_b.bin"), std::ios::binary)
+        .write(reinterpret_cast<const char*>(bin.data()), std::streamsize(bin.size()));
+    std::string accessors, views;
+    for (int b = 0; b < 2; ++b) {
+        const std::string sep = b ? "," : "";
+        const std::string v = std::to_string(b * 2);
+        accessors += sep +
+            "{\"bufferView\":" + v + ",\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+            "\"min\":[0,0,0],\"max\":[1,1,0]},"
+            "{\"bufferView\":" + std::to_string(b * 2 + 1) +
+            ",\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}";
+        views += sep +
+            "{\"buffer\":" + std::to_string(b) + ",\"byteOffset\":0,\"byteLength\":36},"
+            "{\"buffer\":" + std::to_string(b) + ",\"byteOffset\":36,\"byteLength\":6}";
+    }
+    return writeModel(directory, name + "_a",
+        "\"scene\":0,\"scenes\":[{\"nodes\":[0,1]}],\"nodes\":["
+        "{\"name\":\"a\",\"mesh\":0},{\"name\":\"b\",\"mesh\":1,\"translation\":[5,0,0]}],"
+        "\"meshes\":["
+        "{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]},"
+        "{\"primitives\":[{\"attributes\":{\"POSITION\":2},\"indices\":3}]}],"
+        "\"accessors\":[" + accessors + "],\"bufferViews\":[" + views + "],"
+        "\"buffers\":[{\"uri\":\"" + name + "_a.bin\",\"byteLength\":44},"
+        "{\"uri\":\"" + name + "_b.bin\",\"byteLength\":44}]",
+        bin);
+}
+
+void testSelectiveWarmLoad(const fs::path& directory) {
+    const fs::path path = writeTwoBufferModel(directory, "selective");
+    const fs::path unselected = directory / "selective_b.bin";
+
+    ModelLoadOptions options;
+    options.nodeSelection = {0};
+    const ModelData cold = loadModel(path, directory, options);
+    CHECK(!cold.timings.cacheHit);
+    CHECK(cold.ranges.size() == 1);
+    CHECK(cold.timings.bufferBytesRead == 42);
+
+    // Scramble the unselected buffer without changing its size or mtime: a
+    // warm load that read it would see different content and miss
+    const auto mtime = fs::last_write_time(unselected);
+    std::ofstream(unselected, std::ios::binary | std::ios::trunc)
+        << std::string(44, '\xff');
+    fs::last_write_time(unselected, mtime);
+
+    const ModelData warm = loadModel(path, directory, options);
+    CHECK(warm.timings.cacheHit);
+    CHECK(warm.timings.bufferBytesRead == 0);
+    CHECK(warm.ranges.size() == 1);
+    const auto vertices = geometryVertices(warm, 0);
+    CHECK(vertices.size() == 3);
+    CHECK(hasVertexAt(vertices, {1.0f, 0.0f, 0.0f}));
+
+    // Writing the cache did not hash it either: the original bytes under a
+    // new mtime would match a recorded hash, but without one they miss
+    const std::vector<unsigned char> original = triangleBuffer();
+    std::ofstream(unselected, std::ios::binary | std::ios::trunc)
+        .write(reinterpret_cast<const char*>(original.data()), std::streamsize(original.size()));
+    fs::last_write_time(unselected, mtime + std::chrono::seconds(1));
+    CHECK(!loadModel(path, directory, options).timings.cacheHit);
+}
+
+void testCacheMtimeFallback(const fs::path& directory) {
+    const fs::path path = writeTwoBufferModel(directory, "fallback");
+    const fs::path buffer = directory / "fallback_b.bin";
+
+    ModelLoadOptions options;
+    CHECK(!loadModel(path, directory, options).timings.cacheHit);
+    CHECK(loadModel(path, directory, options).timings.cacheHit);
+
+    // Same content, new mtime: the content hash keeps the cache valid
+    const auto mtime = fs::last_write_time(buffer);
+    fs::last_write_time(buffer, mtime + std::chrono::seconds(1));
+    CHECK(loadModel(path, directory, options).timings.cacheHit);
+
+    // Same size, new content and mtime: the cache is rebuilt
+    std::ofstream(buffer, std::ios::binary | std::ios::trunc) << std::string(44, '\0');
+    fs::last_write_time(buffer, mtime + std::chrono::seconds(2));
+    CHECK(!loadModel(path, directory, options).timings.cacheHit);
+}
+
+} // namespace
+// }}}
+
+int main(int argc, char** argv) {
+    struct Case {
+        const char* name;
+        void (*run)(const fs::path&);
+    };
+    const Case cases[] = {
+        {"preserveHierarchy", testPreserveHierarchy},
+        {"flattenedHierarchy", testFlattenedHierarchy},
+        {"dataUriBuffer", testDataUriBuffer},
+        {"accessorBounds", testAccessorBounds},
+        {"meshoptStreams", testMeshoptStreams},
+        {"meshoptBounds", testMeshoptBounds},
+        {"selectiveWarmLoad", testSelectiveWarmLoad},
+        {"cacheMtimeFallback", testCacheMtimeFallback},
+    };
+
+    const fs::path directory = fs::temp_directory_path() / "vkduck_tests";
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    fs::create_directories(directory);
+
+    int ran = 0;
+    for (const Case& test : cases) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            selected |= std::string_view(argv[i]) == test.name;
+        }
+        if (!selected) {
+            continue;
+        }
+        const int failuresBefore = gFailures;
+        try {
+            test.run(directory);
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "  unexpected exception: %s\n", e.what());
+            ++gFailures;
+        }
+        std::printf("%s %s\n", gFailures == failuresBefore ? "PASS" : "FAIL", test.name);
+        ++ran;
+    }
+
+    fs::remove_all(directory, ec);
+    if (ran == 0) {
+        std::fprintf(stderr, "unknown test case\n");
+        return 1;
+    }
+    return gFailures == 0 ? 0 : 1;
+}
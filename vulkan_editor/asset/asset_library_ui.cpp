@@ -133,6 +133,25 @@ void AssetLibraryUI::drawCacheStats() {
         formatBytes(memoryUsage).c_str()
     );
 
+    const TextureManagerStats textureStats = manager.getTextureManager().getStats();
+    if (textureStats.textures > 0) {
+        ImGui::SameLine();
+        ImGui::TextColored(
+            COLOR_STAT,
+            "| %zu textures, %s saved by sharing",
+            textureStats.textures,
+            formatBytes(textureStats.savedBytes).c_str()
+        );
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "%zu references to %zu textures (%s decoded, %zu at preview resolution).\n"
+                "Textures with the same content are loaded and uploaded once.",
+                textureStats.references, textureStats.textures,
+                formatBytes(textureStats.decodedBytes).c_str(), textureStats.previewTextures
+            );
+        }
+    }
+
     ImGui::SameLine();
 
     // Unload unused button (only if there are loaded models)
@@ -179,6 +198,12 @@ void AssetLibraryUI::drawAvailableModels() {
         return;
     }
 
+    auto selectWhenLoaded = [](ModelHandle handle, bool success) {
+        if (success) {
+            selectedModel_ = handle;
+        }
+    };
+
     // Display models
     for (size_t i = 0; i < filteredModels.size(); ++i) {
         const auto& path = filteredModels[i];
@@ -195,13 +220,18 @@ void AssetLibraryUI::drawAvailableModels() {
         // Use path hash as unique ID to avoid conflicts with same filenames
         ImGui::PushID(static_cast<int>(std::hash<std::string>{}(path.string())));
 
-        // Check if already loaded
+        // Check if already loaded, or loading in the background
         const CachedModel* cached = manager.getModelByPath(path);
-        ModelStatus status = cached ? cached->status : ModelStatus::NotLoaded;
+        ModelHandle handle = manager.getHandle(path);
+        ModelStatus status = manager.getStatus(handle);
 
-        // Status indicator
+        // Status indicator, with the progress of background loads
         ImGui::PushStyleColor(ImGuiCol_Text, statusToColor(status));
-        ImGui::Text("%s", statusToString(status));
+        if (status == ModelStatus::Loading) {
+            ImGui::Text("%.0f%%", manager.getLoadProgress(handle) * 100.0f);
+        } else {
+            ImGui::Text("%s", statusToString(status));
+        }
         ImGui::PopStyleColor();
 
         ImGui::SameLine();
@@ -214,11 +244,8 @@ void AssetLibraryUI::drawAvailableModels() {
             if (cached && cached->status == ModelStatus::Loaded) {
                 selectedModel_ = cached->handle;
             } else {
-                // Load and select
-                ModelHandle handle = manager.loadModel(path);
-                if (manager.isLoaded(handle)) {
-                    selectedModel_ = handle;
-                }
+                // Load in the background and select once loaded
+                manager.loadModelAsync(path, selectWhenLoaded);
             }
         }
 
@@ -240,10 +267,7 @@ void AssetLibraryUI::drawAvailableModels() {
                 }
             } else if (status == ModelStatus::NotLoaded) {
                 if (ImGui::MenuItem("Load")) {
-                    ModelHandle handle = manager.loadModel(path);
-                    if (manager.isLoaded(handle)) {
-                        selectedModel_ = handle;
-                    }
+                    manager.loadModelAsync(path, selectWhenLoaded);
                 }
             }
 
@@ -419,18 +443,19 @@ void AssetLibraryUI::drawModelDetails() {
     }
 
     // Textures section
-    if (!model->images.empty()) {
+    if (!model->textures.empty()) {
         if (ImGui::CollapsingHeader("Textures", ImGuiTreeNodeFlags_DefaultOpen)) {
             ImGui::Indent();
 
-            ImGui::Text("%zu texture(s)", model->images.size());
+            const TextureManager& textures = g_modelManager->getTextureManager();
+            ImGui::Text("%zu texture(s)", model->textures.size());
 
-            for (size_t i = 0; i < model->images.size(); ++i) {
+            for (size_t i = 0; i < model->textures.size(); ++i) {
                 ImGui::PushID(static_cast<int>(i));
-                const auto& img = model->images[i];
-                std::string filename = img.path.filename().string();
+                const EditorImage* img = textures.get(model->textures[i]);
+                std::string filename = model->texturePaths[i].filename().string();
 
-                bool loaded = img.pixels != nullptr;
+                bool loaded = img && img->loaded();
                 ImVec4 color = loaded ? COLOR_LOADED : COLOR_ERROR;
 
                 ImGui::TextColored(color, "%s", loaded ? "OK" : "FAIL");
@@ -442,8 +467,25 @@ void AssetLibraryUI::drawModelDetails() {
                     ImGui::TextColored(
                         ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
                         "(%ux%u)",
-                        img.width, img.height
+                        img->fullWidth, img->fullHeight
                     );
+                    if (img->downscale > 0) {
+                        ImGui::SameLine();
+                        ImGui::TextColored(
+                            COLOR_STAT, "preview %ux%u", img->width, img->height
+                        );
+                        if (ImGui::IsItemHovered()) {
+                            ImGui::SetTooltip(
+                                "Reduced by the project's texture preview limits.\n"
+                                "Generated code loads the full resolution."
+                            );
+                        }
+                    }
+                    const size_t references = textures.getReferenceCount(model->textures[i]);
+                    if (references > 1) {
+                        ImGui::SameLine();
+                        ImGui::TextColored(COLOR_STAT, "shared x%zu", references);
+                    }
                 }
                 ImGui::PopID();
             }
@@ -2,17 +2,34 @@
 #include "vulkan_editor/util/logger.h"
 #include <algorithm>
 #include <future>
+#include <iterator>
+#include <span>
+#include <utility>
 
 // Use vkDuck's shared implementations
 #include <vkDuck/image_loader.h>
+#include <vkDuck/job_system.h>
 #include <vkDuck/model_loader.h>
+#include <vkDuck/texture_cache.h>
+#include <vkDuck/texture_container.h>
+#include <vulkan/vk_enum_string_helper.h>
 
 namespace fs = std::filesystem;
 
-// EditorImage destructor
-EditorImage::~EditorImage() {
-    if (pixels)
-        imageFree(pixels);
+std::vector<TextureRole> classifyTextureRoles(
+    const std::vector<EditorMaterial>& materials, size_t imageCount) {
+    std::vector<TextureRole> roles(imageCount, TextureRole::Color);
+    auto assign = [&](int index, TextureRole role) {
+        if (index >= 0 && static_cast<size_t>(index) < imageCount &&
+            roles[index] != TextureRole::Normal) {
+            roles[index] = role;
+        }
+    };
+    for (const auto& material : materials) {
+        assign(material.normalTextureIndex, TextureRole::Normal);
+        assign(material.metallicRoughnessTextureIndex, TextureRole::Data);
+    }
+    return roles;
 }
 
 namespace {
@@ -32,42 +49,62 @@ std::string getDisplayName(const fs::path& path) {
     return path.stem().string();
 }
 
-// Parallel image loading result
-struct DecodedImageResult {
-    void* pixels{nullptr};
-    uint32_t width{0};
-    uint32_t height{0};
-    size_t index{0};
-    bool success{false};
-};
-
-DecodedImageResult loadSingleImage(const fs::path& path, size_t index) {
-    DecodedImageResult result;
-    result.index = index;
-    result.pixels = imageLoad(path, result.width, result.height);
-    result.success = (result.pixels != nullptr);
-    return result;
+/// Log what the shared pool did since `before` was taken
+void logJobSystemStats(const JobSystemStats& before) {
+    JobSystemStats after = jobSystem().stats();
+    auto since = [](JobLaneStats lane, const JobLaneStats& start) {
+        lane.jobsCompleted -= start.jobsCompleted;
+        lane.jobsStolen -= start.jobsStolen;
+        lane.busyMs -= start.busyMs;
+        lane.wallMs -= start.wallMs;
+        return lane;
+    };
+    JobLaneStats cpu = since(after.cpu, before.cpu);
+    JobLaneStats io = since(after.io, before.io);
+    Log::debug(
+        LOG_CATEGORY,
+        "Job system: CPU {} threads, {:.0f}% busy, {} jobs ({} stolen); I/O {} threads, {} jobs",
+        cpu.threads, cpu.utilization() * 100.0f, cpu.jobsCompleted, cpu.jobsStolen,
+        io.threads, io.jobsCompleted
+    );
 }
 
-std::vector<DecodedImageResult>
-loadImagesParallel(const std::vector<std::pair<size_t, fs::path>>& imagesToLoad) {
-    std::vector<std::future<DecodedImageResult>> futures;
-    futures.reserve(imagesToLoad.size());
-
-    for (const auto& [index, path] : imagesToLoad) {
-        futures.push_back(std::async(std::launch::async, loadSingleImage, path, index));
-    }
-
-    std::vector<DecodedImageResult> results;
-    results.reserve(futures.size());
-    for (auto& future : futures) {
-        results.push_back(future.get());
-    }
-    return results;
+void logLoadedModel(const CachedModel& model) {
+    Log::info(
+        LOG_CATEGORY,
+        "Loaded model '{}': {} vertices, {} indices, {} geometries, {} cameras, {} lights",
+        model.displayName,
+        model.modelData.getTotalVertexCount(),
+        model.modelData.getTotalIndexCount(),
+        model.modelData.getGeometryCount(),
+        model.cameras.size(),
+        model.lights.size()
+    );
 }
 
 }  // namespace
 
+/**
+ * @brief A model loading on a worker thread.
+ *
+ * The worker loads into `staged` so the cached model stays untouched;
+ * processPendingReloads() swaps the result in on the main thread. Reloads
+ * run the same way, so a loaded model is served until its new data is in.
+ */
+struct ModelManager::LoadTask {
+    ModelHandle handle;
+    CachedModel staged;
+    std::vector<ModelLoadCallback> callbacks;  ///< Guarded by mutex_
+    bool restart{false};                       ///< Requested again after cancelling, guarded by mutex_
+    std::atomic<float> progress{0.0f};
+    std::atomic<bool> cancelled{false};
+    std::mutex optionsMutex;
+    bool started{false};   ///< Worker read staged.loadOptions, guarded by optionsMutex
+    bool aborted{false};   ///< Stopped by cancelled; set by the worker
+    bool success{false};   ///< Set by the worker before it queues the task
+    std::future<void> finished;
+};
+
 // Global instance pointer - initialized in editor.cpp
 ModelManager* g_modelManager = nullptr;
 
@@ -89,12 +126,16 @@ void ModelManager::setProjectRoot(const fs::path& root) {
         return;
     }
 
+    // Workers read the project root
+    cancelAllLoads();
+
     projectRoot_ = root;
     Log::info(LOG_CATEGORY, "Project root set to: {}", root.string());
 
     // Clear cache when project changes
     cache_.clear();
     pathToHandle_.clear();
+    textureManager_.clear();
     availableModels_.clear();
 }
 
@@ -275,7 +316,9 @@ void ModelManager::cleanupStaleCacheEntries() {
     for (ModelHandle handle : toRemove) {
         auto it = cache_.find(handle);
         if (it != cache_.end()) {
+            cancelLoadLocked(handle);
             pathToHandle_.erase(it->second->path);
+            releaseTextures(*it->second);
             cache_.erase(it);
         }
     }
@@ -307,12 +350,19 @@ ModelHandle ModelManager::findOrCreateHandle(const fs::path& relativePath) {
     return handle;
 }
 
-ModelHandle ModelManager::loadModel(const fs::path& relativePath) {
+ModelHandle ModelManager::loadModel(
+    const fs::path& relativePath,
+    const ModelLoadOptions& options
+) {
     std::lock_guard lock(mutex_);
 
     ModelHandle handle = findOrCreateHandle(relativePath);
     CachedModel* model = cache_[handle].get();
 
+    if (model->status == ModelStatus::NotLoaded || model->status == ModelStatus::Error) {
+        model->loadOptions = options;
+    }
+
     if (model->status == ModelStatus::Loaded) {
         model->lastAccessed = std::chrono::system_clock::now();
         Log::debug(LOG_CATEGORY, "Model already loaded: {}", relativePath.string());
@@ -335,17 +385,7 @@ ModelHandle ModelManager::loadModel(const fs::path& relativePath) {
 
         calculateMemoryUsage(*model);
         setupFileWatcher(*model);
-
-        Log::info(
-            LOG_CATEGORY,
-            "Loaded model '{}': {} vertices, {} indices, {} geometries, {} cameras, {} lights",
-            model->displayName,
-            model->modelData.getTotalVertexCount(),
-            model->modelData.getTotalIndexCount(),
-            model->modelData.getGeometryCount(),
-            model->cameras.size(),
-            model->lights.size()
-        );
+        logLoadedModel(*model);
     } else {
         model->status = ModelStatus::Error;
         Log::error(LOG_CATEGORY, "Failed to load model: {}", relativePath.string());
@@ -356,22 +396,305 @@ ModelHandle ModelManager::loadModel(const fs::path& relativePath) {
 
 ModelHandle ModelManager::loadModelAsync(
     const fs::path& relativePath,
-    ModelLoadCallback callback
+    ModelLoadCallback callback,
+    const ModelLoadOptions& options
 ) {
-    // For simplicity, we do synchronous loading here.
-    // A full async implementation would use a worker thread pool.
-    ModelHandle handle = loadModel(relativePath);
+    std::lock_guard lock(mutex_);
+
+    ModelHandle handle = findOrCreateHandle(relativePath);
+    CachedModel* model = cache_[handle].get();
+
+    if (auto it = loadTasks_.find(handle); it != loadTasks_.end()) {
+        LoadTask& task = *it->second;
+        // A cancelled load is started again once its worker stopped
+        task.restart = task.restart || task.cancelled;
+        if (callback) {
+            task.callbacks.push_back(std::move(callback));
+        }
+        Log::debug(LOG_CATEGORY, "Model is currently loading: {}", relativePath.string());
+        return handle;
+    }
 
+    if (model->status == ModelStatus::Loaded) {
+        // Reported like a finished load
+        model->lastAccessed = std::chrono::system_clock::now();
+        if (callback) {
+            readyCallbacks_.emplace_back(handle, std::move(callback));
+        }
+        return handle;
+    }
+
+    model->loadOptions = options;
+    Log::info(LOG_CATEGORY, "Loading model in background: {}", relativePath.string());
+
+    std::vector<ModelLoadCallback> callbacks;
     if (callback) {
-        bool success = isLoaded(handle);
-        callback(handle, success);
+        callbacks.push_back(std::move(callback));
     }
+    startLoad(*model, std::move(callbacks));
 
     return handle;
 }
 
-bool ModelManager::loadModelInternal(CachedModel& model) {
+void ModelManager::startLoad(CachedModel& model, std::vector<ModelLoadCallback> callbacks) {
+    // Must be called with mutex_ held
+    if (auto it = loadTasks_.find(model.handle); it != loadTasks_.end()) {
+        // Started again with the current options once its worker stopped
+        LoadTask& task = *it->second;
+        task.restart = true;
+        task.cancelled = true;
+        task.callbacks.insert(
+            task.callbacks.end(),
+            std::make_move_iterator(callbacks.begin()),
+            std::make_move_iterator(callbacks.end())
+        );
+        return;
+    }
+
+    auto task = std::make_unique<LoadTask>();
+    task->handle = model.handle;
+    task->staged.handle = model.handle;
+    task->staged.path = model.path;
+    task->staged.displayName = model.displayName;
+    task->staged.loadOptions = model.loadOptions;
+    task->callbacks = std::move(callbacks);
+    model.pendingReload = false;
+
+    // A reload keeps the model Loaded, so its old data is used meanwhile
+    if (model.status != ModelStatus::Loaded) {
+        model.status = ModelStatus::Loading;
+    }
+
+    // The task is only destroyed after its worker queued it or was waited
+    // for. It is captured by pointer: the future's state owns the job.
+    // It runs on the Cpu lane: the load decodes and waits on the
+    // parallelFor()s inside, which Io jobs must not do
+    LoadTask* raw = task.get();
+    task->finished = jobSystem().async([this, raw] {
+        {
+            // Options set until here are applied to this load
+            std::lock_guard lock(raw->optionsMutex);
+            raw->started = true;
+        }
+        try {
+            raw->success = loadModelInternal(raw->staged, raw);
+        } catch (const std::exception& e) {
+            raw->staged.errorMessage = e.what();
+            Log::error(LOG_CATEGORY, "{}", raw->staged.errorMessage);
+        }
+        std::lock_guard lock(completedMutex_);
+        completedLoads_.push_back(raw);
+    }, JobLane::Cpu);
+
+    loadTasks_[model.handle] = std::move(task);
+}
+
+bool ModelManager::finishLoad(LoadTask& task) {
+    // Must be called with mutex_ held, once the worker is done
+    auto it = cache_.find(task.handle);
+    CachedModel* model = it != cache_.end() ? it->second.get() : nullptr;
+    if (!model || !task.success) {
+        releaseTextures(task.staged);
+    }
+
+    if (!model) {
+        Log::debug(LOG_CATEGORY, "Discarded load of removed model '{}'", task.staged.displayName);
+        return false;
+    }
+
+    if (task.aborted) {
+        if (model->status == ModelStatus::Loading) {
+            model->status = ModelStatus::NotLoaded;
+        }
+        if (task.restart) {
+            Log::info(LOG_CATEGORY, "Restarting cancelled load: {}", model->displayName);
+            startLoad(*model, std::move(task.callbacks));
+            task.callbacks.clear();
+        } else {
+            Log::info(LOG_CATEGORY, "Cancelled loading model: {}", model->displayName);
+        }
+        return false;
+    }
+
+    if (!task.success) {
+        model->status = ModelStatus::Error;
+        model->errorMessage = std::move(task.staged.errorMessage);
+        Log::error(LOG_CATEGORY, "Failed to load model: {}", model->path.string());
+        return false;
+    }
+
+    // After a failed load the model still holds the default texture
+    releaseTextures(*model);
+
+    CachedModel& staged = task.staged;
+    model->modelData = std::move(staged.modelData);
+    model->materials = std::move(staged.materials);
+    model->textures = std::move(staged.textures);
+    model->texturePaths = std::move(staged.texturePaths);
+    model->cameras = std::move(staged.cameras);
+    model->lights = std::move(staged.lights);
+    model->optimizationStats = staged.optimizationStats;
+    model->meshletStats = staged.meshletStats;
+    model->meshletBuildMs = staged.meshletBuildMs;
+    model->defaultTexture = std::exchange(staged.defaultTexture, {});
+
+    model->status = ModelStatus::Loaded;
+    model->loadedAt = std::chrono::system_clock::now();
+    model->lastAccessed = model->loadedAt;
+    model->errorMessage.clear();
+
+    calculateMemoryUsage(*model);
+    setupFileWatcher(*model);
+    logLoadedModel(*model);
+
+    // Requested again after the worker's last checkpoint: the data swapped
+    // in is stale for the new options or file, so load once more
+    if (task.restart) {
+        Log::info(LOG_CATEGORY, "Reloading model requested during its load: {}", model->displayName);
+        startLoad(*model, {});
+    }
+
+    return true;
+}
+
+float ModelManager::getLoadProgress(ModelHandle handle) const {
+    std::lock_guard lock(mutex_);
+
+    auto it = loadTasks_.find(handle);
+    return it != loadTasks_.end() ? it->second->progress.load() : 0.0f;
+}
+
+void ModelManager::cancelLoad(ModelHandle handle) {
+    std::lock_guard lock(mutex_);
+
+    auto it = cache_.find(handle);
+    if (it == cache_.end() || it->second->referenceCount > 0) {
+        return;
+    }
+    cancelLoadLocked(handle);
+}
+
+void ModelManager::cancelLoadLocked(ModelHandle handle) {
+    // Must be called with mutex_ held
+    auto it = loadTasks_.find(handle);
+    if (it == loadTasks_.end()) {
+        return;
+    }
+
+    LoadTask& task = *it->second;
+    task.restart = false;
+    if (!task.cancelled.exchange(true)) {
+        Log::info(LOG_CATEGORY, "Cancelling load of '{}'", task.staged.displayName);
+    }
+}
+
+void ModelManager::cancelAllLoads() {
+    // Must be called with mutex_ held; workers finish without taking it
+    for (auto& [handle, task] : loadTasks_) {
+        task->cancelled = true;
+    }
+    for (auto& [handle, task] : loadTasks_) {
+        task->finished.wait();
+        releaseTextures(task->staged);
+    }
+
+    if (!loadTasks_.empty()) {
+        Log::info(LOG_CATEGORY, "Cancelled {} background model loads", loadTasks_.size());
+    }
+    loadTasks_.clear();
+    readyCallbacks_.clear();
+
+    std::lock_guard lock(completedMutex_);
+    completedLoads_.clear();
+}
+
+void ModelManager::setLoadOptions(ModelHandle handle, const ModelLoadOptions& options) {
+    std::lock_guard lock(mutex_);
+
+    auto it = cache_.find(handle);
+    if (it == cache_.end()) {
+        return;
+    }
+
+    CachedModel* model = it->second.get();
+    if (model->loadOptions == options) {
+        return;
+    }
+
+    model->loadOptions = options;
+
+    if (auto found = loadTasks_.find(handle); found != loadTasks_.end()) {
+        // The running load takes the options instead of a second reload:
+        // they are swapped in before its worker starts, else it restarts
+        LoadTask& task = *found->second;
+        std::lock_guard taskLock(task.optionsMutex);
+        if (!task.started) {
+            task.staged.loadOptions = options;
+            Log::debug(LOG_CATEGORY, "Load options changed for '{}' before its load started", model->displayName);
+        } else {
+            task.restart = true;
+            task.cancelled = true;
+            Log::info(LOG_CATEGORY, "Load options changed for '{}', restarting its load", model->displayName);
+        }
+        return;
+    }
+
+    if (model->status == ModelStatus::Loaded || model->status == ModelStatus::Error) {
+        model->pendingReload = true;
+        Log::info(LOG_CATEGORY, "Load options changed for '{}', queued reload", model->displayName);
+    }
+}
+
+const ModelOutline* ModelManager::getOutline(ModelHandle handle) {
+    std::lock_guard lock(mutex_);
+
+    auto it = cache_.find(handle);
+    if (it == cache_.end()) {
+        return nullptr;
+    }
+
+    CachedModel* model = it->second.get();
+    const fs::path absolutePath = projectRoot_ / model->path;
+    std::error_code ec;
+    const auto writeTime = fs::last_write_time(absolutePath, ec);
+    if (model->outlineWriteTime != writeTime) {
+        // Failures are remembered too, until the file changes again
+        model->outlineWriteTime = writeTime;
+        model->outline.reset();
+        try {
+            model->outline = std::make_unique<ModelOutline>(inspectModel(absolutePath));
+        } catch (const std::exception& e) {
+            Log::error(LOG_CATEGORY, "Failed to inspect '{}': {}", model->displayName, e.what());
+            return nullptr;
+        }
+        Log::debug(
+            LOG_CATEGORY,
+            "Inspected '{}' in {:.2f}ms ({} nodes, {} meshes, {:.1f} MB of buffers not read)",
+            model->displayName,
+            model->outline->parseMs,
+            model->outline->nodes.size(),
+            model->outline->meshes.size(),
+            model->outline->bufferBytes / (1024.0 * 1024.0)
+        );
+    }
+    return model->outline.get();
+}
+
+bool ModelManager::advanceLoad(LoadTask* task, float progress) {
+    if (!task) {
+        return true;
+    }
+    if (task->cancelled) {
+        task->aborted = true;
+        return false;
+    }
+    task->progress = progress;
+    return true;
+}
+
+bool ModelManager::loadModelInternal(CachedModel& model, LoadTask* task) {
     auto totalStart = std::chrono::high_resolution_clock::now();
+    const JobSystemStats poolBefore = jobSystem().stats();
 
     fs::path absolutePath = projectRoot_ / model.path;
 
@@ -384,35 +707,137 @@ bool ModelManager::loadModelInternal(CachedModel& model) {
     // Clear existing data
     model.modelData.clear();
     model.materials.clear();
-    model.images.clear();
     model.cameras.clear();
     model.lights.clear();
+    model.optimizationStats = {};
 
-    // Load default texture
+    // Textures held until the new ones are acquired, so the unchanged ones
+    // are shared instead of loaded again
+    std::vector<TextureHandle> previousTextures = std::move(model.textures);
+    previousTextures.push_back(model.defaultTexture);
+    model.textures.clear();
+    model.texturePaths.clear();
+
+    // Load default texture (once per project, shared by every model)
     fs::path defaultTexPath = projectRoot_ / "data" / "images" / "default.png";
-    model.defaultTexture.path = defaultTexPath;
-    model.defaultTexture.pixels = imageLoad(defaultTexPath, model.defaultTexture.width, model.defaultTexture.height);
+    model.defaultTexture = textureManager_.acquire(defaultTexPath);
 
-    if (!model.defaultTexture.pixels) {
+    if (!model.defaultTexture.isValid()) {
         Log::warning(LOG_CATEGORY, "Failed to load default texture: {}", defaultTexPath.string());
     }
 
+    // Asynchronous loads stop between stages once cancelled
+    auto cancelled = [&](float progress) {
+        if (advanceLoad(task, progress)) {
+            return false;
+        }
+        model.errorMessage = "Cancelled";
+        textureManager_.release(previousTextures);
+        return true;
+    };
+
+    if (cancelled(0.05f)) {
+        return false;
+    }
+
     // Use vkDuck library's loadModel
-    ModelData libModelData = ::loadModel(absolutePath.string(), projectRoot_.string());
+    ModelData libModelData = ::loadModel(absolutePath.string(), projectRoot_.string(), model.loadOptions);
 
-    if (libModelData.vertices.empty()) {
+    if (libModelData.vertexSpan().empty()) {
         model.errorMessage = "Model is empty or failed to parse";
         Log::error(LOG_CATEGORY, "{}", model.errorMessage);
+        textureManager_.release(previousTextures);
         return false;
     }
 
-    // Copy consolidated geometry data
-    model.modelData.vertices = std::move(libModelData.vertices);
-    model.modelData.indices = std::move(libModelData.indices);
+    // Geometry is most of the work; textures only have headers read
+    if (cancelled(0.6f)) {
+        return false;
+    }
+
+    if (libModelData.timings.cacheHit) {
+        Log::info(
+            LOG_CATEGORY,
+            "Geometry mapped from mesh cache in {:.1f}ms ({} primitives, {:.1f} MB)",
+            libModelData.timings.totalMs,
+            libModelData.timings.primitiveCount,
+            libModelData.timings.geometryBytes / (1024.0 * 1024.0)
+        );
+    } else {
+        Log::info(
+            LOG_CATEGORY,
+            "Geometry loaded in {:.1f}ms ({} primitives, {:.1f} MB, {} decode threads, cache write {:.1f}ms)",
+            libModelData.timings.totalMs,
+            libModelData.timings.primitiveCount,
+            libModelData.timings.geometryBytes / (1024.0 * 1024.0),
+            libModelData.timings.decodeThreads,
+            libModelData.timings.cacheMs
+        );
+        if (libModelData.timings.dataUriBytes > 0) {
+            const double megabytes = libModelData.timings.dataUriBytes / (1024.0 * 1024.0);
+            Log::info(
+                LOG_CATEGORY,
+                "Data URIs decoded {:.2f} MB in {:.2f}ms ({:.0f} MB/s)",
+                megabytes,
+                libModelData.timings.dataUriMs,
+                megabytes / std::max(libModelData.timings.dataUriMs / 1000.0, 1e-9)
+            );
+        }
+        if (libModelData.timings.meshoptBytes > 0) {
+            const double megabytes = libModelData.timings.meshoptBytes / (1024.0 * 1024.0);
+            Log::info(
+                LOG_CATEGORY,
+                "Meshopt decoded {:.2f} MB in {:.2f}ms ({:.0f} MB/s)",
+                megabytes,
+                libModelData.timings.meshoptMs,
+                megabytes / std::max(libModelData.timings.meshoptMs / 1000.0, 1e-9)
+            );
+        }
+        if (!model.loadOptions.nodeSelection.empty()) {
+            Log::info(
+                LOG_CATEGORY,
+                "Selected {} nodes: read {:.2f} of {:.2f} MB of buffers",
+                model.loadOptions.nodeSelection.size(),
+                libModelData.timings.bufferBytesRead / (1024.0 * 1024.0),
+                libModelData.timings.bufferBytes / (1024.0 * 1024.0)
+            );
+        }
+    }
+
+    // Stats read the meshlet arrays, so take them before those are moved
+    model.meshletStats = ::meshletStats(libModelData);
+    model.meshletBuildMs = libModelData.timings.meshletMs;
+
+    // Copy consolidated geometry data. Cached models are served from a
+    // read-only mapping, so they are copied once into editor-owned storage.
+    if (libModelData.cacheMapping) {
+        auto vertices = libModelData.vertexSpan();
+        auto indices = libModelData.indexSpan();
+        auto indices16 = libModelData.index16Span();
+        model.modelData.vertices.assign(vertices.begin(), vertices.end());
+        model.modelData.indices.assign(indices.begin(), indices.end());
+        model.modelData.indices16.assign(indices16.begin(), indices16.end());
+        auto meshlets = libModelData.meshletSpan();
+        auto meshletVertices = libModelData.meshletVertexSpan();
+        auto meshletTriangles = libModelData.meshletTriangleSpan();
+        model.modelData.meshlets.assign(meshlets.begin(), meshlets.end());
+        model.modelData.meshletVertices.assign(meshletVertices.begin(), meshletVertices.end());
+        model.modelData.meshletTriangles.assign(meshletTriangles.begin(), meshletTriangles.end());
+    } else {
+        model.modelData.vertices = std::move(libModelData.vertices);
+        model.modelData.indices = std::move(libModelData.indices);
+        model.modelData.indices16 = std::move(libModelData.indices16);
+        model.modelData.meshlets = std::move(libModelData.meshlets);
+        model.modelData.meshletVertices = std::move(libModelData.meshletVertices);
+        model.modelData.meshletTriangles = std::move(libModelData.meshletTriangles);
+    }
+    model.modelData.lods = libModelData.lods;
+    model.modelData.nodes = libModelData.nodes;
 
     // Convert GeometryRange to EditorGeometryRange
     model.modelData.ranges.reserve(libModelData.ranges.size());
-    for (const auto& range : libModelData.ranges) {
+    for (uint32_t i = 0; i < libModelData.ranges.size(); ++i) {
+        const auto& range = libModelData.ranges[i];
         EditorGeometryRange editorRange;
         editorRange.firstVertex = range.firstVertex;
         editorRange.vertexCount = range.vertexCount;
@@ -420,8 +845,48 @@ bool ModelManager::loadModelInternal(CachedModel& model) {
         editorRange.indexCount = range.indexCount;
         editorRange.materialIndex = range.materialIndex;
         editorRange.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;  // Default
+        editorRange.firstInstance = range.firstInstance;
+        editorRange.instanceCount = range.instanceCount;
+        editorRange.firstLod = range.firstLod;
+        editorRange.lodCount = range.lodCount;
+        editorRange.indexType = range.indexType;
+        editorRange.firstMeshlet = range.firstMeshlet;
+        editorRange.meshletCount = range.meshletCount;
+        editorRange.firstMeshletVertex = range.firstMeshletVertex;
+        editorRange.firstMeshletTriangle = range.firstMeshletTriangle;
+        // Ranges of non-hierarchical models have their node baked in
+        editorRange.node = libModelData.hierarchical ? range.node : -1;
+        geometryBounds(libModelData, i, editorRange.boundsMin, editorRange.boundsMax);
         model.modelData.ranges.push_back(editorRange);
     }
+    model.modelData.instances = std::move(libModelData.instances);
+
+    model.optimizationStats = libModelData.optimization;
+    if (libModelData.optimization.applied) {
+        Log::info(
+            LOG_CATEGORY,
+            "Mesh optimization: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+            libModelData.optimization.acmrBefore, libModelData.optimization.acmrAfter,
+            libModelData.optimization.atvrBefore, libModelData.optimization.atvrAfter
+        );
+    }
+    if (!libModelData.lods.empty()) {
+        Log::info(
+            LOG_CATEGORY,
+            "Generated {} LOD levels over {} ranges in {:.1f}ms",
+            libModelData.lods.size(), libModelData.ranges.size(),
+            libModelData.timings.lodMs
+        );
+    }
+
+    if (model.meshletStats.meshletCount > 0) {
+        Log::info(
+            LOG_CATEGORY,
+            "{} meshlets in {:.1f}ms ({:.1f} vertices, {:.1f} triangles on average)",
+            model.meshletStats.meshletCount, model.meshletBuildMs,
+            model.meshletStats.averageVertices, model.meshletStats.averageTriangles
+        );
+    }
 
     // Copy cameras and lights
     model.cameras = std::move(libModelData.cameras);
@@ -435,15 +900,9 @@ bool ModelManager::loadModelInternal(CachedModel& model) {
         Log::info(LOG_CATEGORY, "Found {} light(s) in model", model.lights.size());
     }
 
-    // Set up images from all unique texture paths
-    model.images.resize(libModelData.allTexturePaths.size());
-    for (size_t i = 0; i < libModelData.allTexturePaths.size(); ++i) {
-        const auto& texPath = libModelData.allTexturePaths[i];
-        if (!texPath.empty()) {
-            model.images[i].path = texPath;
-            model.images[i].toLoad = true;
-        }
-    }
+    // One texture slot per unique texture path
+    model.texturePaths = libModelData.allTexturePaths;
+    model.textures.resize(model.texturePaths.size());
 
     // Set up materials with all PBR texture indices and factors
     model.materials.resize(libModelData.materials.size());
@@ -460,35 +919,137 @@ bool ModelManager::loadModelInternal(CachedModel& model) {
         dstMat.roughnessFactor = srcMat.roughnessFactor;
     }
 
+    if (cancelled(0.7f)) {
+        return false;
+    }
+
     // Load textures in parallel
     {
         auto t1 = std::chrono::high_resolution_clock::now();
 
-        std::vector<std::pair<size_t, fs::path>> imagesToLoad;
-        for (size_t i = 0; i < model.images.size(); ++i) {
-            if (model.images[i].toLoad) {
-                imagesToLoad.push_back({i, model.images[i].path});
+        // Textures other models (or the previous load) hold are shared.
+        // Only headers are read (or cooks and cache entries written) for
+        // new ones; pixels are decoded into the staging buffer on upload.
+        // Embedded images are read from the mapped model, which
+        // libModelData keeps alive until this function returns, and keep a
+        // copy of their encoded bytes unless the decoded texture cache
+        // serves them
+        std::vector<TextureRequest> requests;
+        std::vector<size_t> requestSlots;
+        size_t embeddedCount = 0;
+        // Roles pick the cooked format, and how cached mips are filtered
+        const bool cook = model.loadOptions.cookTextures;
+        const std::vector<TextureRole> roles =
+            classifyTextureRoles(model.materials, model.textures.size());
+        const TextureCacheStats cacheBefore = textureCacheStats();
+        for (size_t i = 0; i < model.texturePaths.size(); ++i) {
+            if (model.texturePaths[i].empty()) {
+                continue;
+            }
+            TextureRequest& request = requests.emplace_back();
+            requestSlots.push_back(i);
+            request.path = model.texturePaths[i];
+            request.cook = cook;
+            request.packChannels = model.loadOptions.packTextureChannels;
+            request.role = roles[i];
+            if (i < libModelData.embeddedImages.size()) {
+                request.embeddedBytes = libModelData.embeddedImages[i].bytes;
+                embeddedCount += request.embeddedBytes.empty() ? 0 : 1;
             }
         }
 
-        if (!imagesToLoad.empty()) {
-            Log::debug(LOG_CATEGORY, "Loading {} images in parallel...", imagesToLoad.size());
-            auto results = loadImagesParallel(imagesToLoad);
-
-            for (const auto& result : results) {
-                model.images[result.index].pixels = result.pixels;
-                model.images[result.index].width = result.width;
-                model.images[result.index].height = result.height;
-
-                if (!result.success) {
+        if (!requests.empty()) {
+            Log::debug(
+                LOG_CATEGORY, "Loading {} images in parallel ({} embedded)...",
+                requests.size(), embeddedCount
+            );
+            const auto results = textureManager_.acquire(requests);
+
+            size_t compressedCount = 0;
+            size_t previewCount = 0;
+            size_t sharedCount = 0;
+            size_t cookedCount = 0;
+            size_t cookHits = 0;
+            size_t uncompressedBytes = 0;
+            size_t cookedBytes = 0;
+            for (size_t r = 0; r < results.size(); ++r) {
+                const TextureAcquireResult& result = results[r];
+                const fs::path& path = requests[r].path;
+                model.textures[requestSlots[r]] = result.handle;
+                sharedCount += result.shared ? 1 : 0;
+                const EditorImage* image = textureManager_.get(result.handle);
+                if (!image) {
                     Log::warning(
+                        LOG_CATEGORY, "Failed to load texture: {}, will use default",
+                        path.string()
+                    );
+                    continue;
+                }
+                compressedCount += isBlockCompressed(image->format) ? 1 : 0;
+                previewCount += image->downscale > 0 ? 1 : 0;
+
+                const TextureCookStats& cookStats = result.cookStats;
+                if (cookStats.cooked) {
+                    ++cookedCount;
+                    cookHits += cookStats.cacheHit ? 1 : 0;
+                    uncompressedBytes += cookStats.uncompressedBytes;
+                    cookedBytes += cookStats.cookedBytes;
+                }
+                if (cookStats.cooked && !cookStats.cacheHit) {
+                    Log::info(
                         LOG_CATEGORY,
-                        "Failed to load texture: {}, will use default",
-                        model.images[result.index].path.string()
+                        "Cooked {} ({}x{}, {} levels) to {} in {:.1f}ms: {:.1f} Mpixel/s, PSNR {:.1f} dB",
+                        path.filename().string(), image->width, image->height,
+                        image->mipLevels, string_VkFormat(cookStats.format),
+                        cookStats.encodeMs, cookStats.megapixelsPerSecond, cookStats.psnr
                     );
                 }
             }
+            if (compressedCount > 0) {
+                Log::debug(
+                    LOG_CATEGORY, "{} of {} textures are block-compressed (KTX2/DDS)",
+                    compressedCount, results.size()
+                );
+            }
+            if (previewCount > 0) {
+                Log::info(
+                    LOG_CATEGORY, "{} of {} textures loaded at preview resolution",
+                    previewCount, results.size()
+                );
+            }
+            if (cookedCount > 0) {
+                Log::info(
+                    LOG_CATEGORY,
+                    "{} cooked textures ({} from cache): {:.1f} MB instead of {:.1f} MB as BGRA8 mip chains",
+                    cookedCount, cookHits, cookedBytes / (1024.0 * 1024.0),
+                    uncompressedBytes / (1024.0 * 1024.0)
+                );
+            }
+            const TextureCacheStats cacheAfter = textureCacheStats();
+            if (cacheAfter.hits + cacheAfter.misses > cacheBefore.hits + cacheBefore.misses) {
+                Log::info(
+                    LOG_CATEGORY, "Decoded texture cache: {} hits, {} misses, {} evicted",
+                    cacheAfter.hits - cacheBefore.hits, cacheAfter.misses - cacheBefore.misses,
+                    cacheAfter.evictions - cacheBefore.evictions
+                );
+            }
+            if (sharedCount > 0) {
+                const TextureManagerStats shared = textureManager_.getStats();
+                Log::info(
+                    LOG_CATEGORY,
+                    "{} of {} textures shared with loaded models; {} textures held, {:.1f} MB not duplicated",
+                    sharedCount, results.size(), shared.textures,
+                    shared.savedBytes / (1024.0 * 1024.0)
+                );
+            }
+        }
+
+        // Acquiring may have cooked for a while; the acquired textures are
+        // released with the rest of the staged model
+        if (cancelled(0.95f)) {
+            return false;
         }
+        textureManager_.release(previousTextures);
 
         auto t2 = std::chrono::high_resolution_clock::now();
         auto ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
@@ -498,6 +1059,11 @@ bool ModelManager::loadModelInternal(CachedModel& model) {
     auto totalEnd = std::chrono::high_resolution_clock::now();
     auto totalMs = std::chrono::duration<double, std::milli>(totalEnd - totalStart).count();
     Log::info(LOG_CATEGORY, "Total model loading time: {:.1f}ms", totalMs);
+    logJobSystemStats(poolBefore);
+
+    if (task) {
+        task->progress = 1.0f;
+    }
 
     return true;
 }
@@ -524,24 +1090,41 @@ void ModelManager::setupFileWatcher(CachedModel& model) {
     model.fileWatcher->setLoadingState(ModelFileWatcher::LoadingState::Loaded);
 }
 
+void ModelManager::releaseTextures(CachedModel& model) {
+    textureManager_.release(model.textures);
+    textureManager_.release(model.defaultTexture);
+    model.textures.clear();
+    model.defaultTexture = {};
+}
+
 void ModelManager::calculateMemoryUsage(CachedModel& model) {
     size_t usage = 0;
 
     // Vertex data
     usage += model.modelData.vertices.size() * sizeof(Vertex);
     usage += model.modelData.indices.size() * sizeof(uint32_t);
-
-    // Images (CPU side)
-    for (const auto& img : model.images) {
-        if (img.pixels) {
-            usage += img.width * img.height * 4;  // RGBA
+    usage += model.modelData.indices16.size() * sizeof(uint16_t);
+    usage += model.modelData.instances.size() * sizeof(InstanceData);
+    usage += model.modelData.lods.size() * sizeof(GeometryLod);
+    usage += model.modelData.meshlets.size() * sizeof(Meshlet);
+    usage += model.modelData.meshletVertices.size() * sizeof(uint32_t);
+    usage += model.modelData.meshletTriangles.size();
+
+    // Textures (CPU side): sources only hold their encoded file until
+    // upload. Shared textures count in proportion to their references.
+    auto addTexture = [&](TextureHandle handle) {
+        const EditorImage* img = textureManager_.get(handle);
+        if (!img) {
+            return;
         }
+        // BGRA8, or the container's own levels
+        const size_t bytes = img->pixels ? img->size : img->source->bytes().size();
+        usage += bytes / std::max<size_t>(1, textureManager_.getReferenceCount(handle));
+    };
+    for (TextureHandle texture : model.textures) {
+        addTexture(texture);
     }
-
-    // Default texture
-    if (model.defaultTexture.pixels) {
-        usage += model.defaultTexture.width * model.defaultTexture.height * 4;
-    }
+    addTexture(model.defaultTexture);
 
     model.memoryUsageBytes = usage;
 }
@@ -579,6 +1162,20 @@ const CachedModel* ModelManager::getModelByPath(const fs::path& relativePath) co
     return nullptr;
 }
 
+ModelHandle ModelManager::getHandle(const fs::path& relativePath) const {
+    std::lock_guard lock(mutex_);
+
+    auto it = pathToHandle_.find(relativePath);
+    return it != pathToHandle_.end() ? it->second : ModelHandle{};
+}
+
+fs::path ModelManager::getPath(ModelHandle handle) const {
+    std::lock_guard lock(mutex_);
+
+    auto it = cache_.find(handle);
+    return it != cache_.end() ? it->second->path : fs::path{};
+}
+
 bool ModelManager::isLoaded(ModelHandle handle) const {
     std::lock_guard lock(mutex_);
 
@@ -653,10 +1250,14 @@ bool ModelManager::unloadModel(ModelHandle handle, bool force) {
         model->fileWatcher->stopWatching();
     }
 
+    // A load still running is discarded when it finishes
+    cancelLoadLocked(handle);
+
     // Remove from path mapping
     pathToHandle_.erase(model->path);
 
     // Remove from cache
+    releaseTextures(*model);
     cache_.erase(it);
 
     return true;
@@ -679,6 +1280,7 @@ void ModelManager::unloadUnusedModels() {
         if (it != cache_.end()) {
             Log::info(LOG_CATEGORY, "Unloading unused model: {}", it->second->displayName);
             pathToHandle_.erase(it->second->path);
+            releaseTextures(*it->second);
             cache_.erase(it);
         }
     }
@@ -689,8 +1291,7 @@ void ModelManager::unloadUnusedModels() {
 }
 
 void ModelManager::reloadModel(ModelHandle handle) {
-    // Use unique_lock to allow unlocking during I/O operations
-    std::unique_lock lock(mutex_);
+    std::lock_guard lock(mutex_);
 
     auto it = cache_.find(handle);
     if (it == cache_.end()) {
@@ -699,57 +1300,18 @@ void ModelManager::reloadModel(ModelHandle handle) {
     }
 
     CachedModel* model = it->second.get();
-    Log::info(LOG_CATEGORY, "Reloading model: {}", model->displayName);
-
-    // Store state to preserve
-    bool wasAutoReload = model->autoReload;
-
-    // Stop file watcher during reload
-    if (model->fileWatcher) {
-        model->fileWatcher->stopWatching();
-    }
-
-    model->status = ModelStatus::Loading;
-
-    // Release lock during I/O-heavy loadModelInternal to avoid blocking other threads
-    // Note: projectRoot_ is read-only after setProjectRoot(), so this is safe
-    lock.unlock();
-
-    bool loadSuccess = loadModelInternal(*model);
+    Log::info(LOG_CATEGORY, "Reloading model in background: {}", model->displayName);
 
-    // Reacquire lock to update shared state
-    lock.lock();
-
-    // Verify model wasn't invalidated while we were loading
-    it = cache_.find(handle);
-    if (it == cache_.end()) {
-        Log::warning(LOG_CATEGORY, "Model was removed during reload");
-        return;
-    }
-
-    if (loadSuccess) {
-        model->status = ModelStatus::Loaded;
-        model->loadedAt = std::chrono::system_clock::now();
-        model->lastAccessed = model->loadedAt;
-        model->errorMessage.clear();
-        model->pendingReload = false;
-
-        calculateMemoryUsage(*model);
-
-        model->autoReload = wasAutoReload;
-        setupFileWatcher(*model);
-
-        Log::info(LOG_CATEGORY, "Model reloaded successfully: {}", model->displayName);
+    // A load already running is cancelled and started again
+    startLoad(*model, {});
+}
 
-        // Notify listeners - release lock first to avoid deadlock in callbacks
-        ModelReloadCallback callback = reloadCallback_;
-        lock.unlock();
-        if (callback) {
-            callback(handle);
+void ModelManager::reloadAllModels() {
+    std::lock_guard lock(mutex_);
+    for (auto& [handle, model] : cache_) {
+        if (model->status == ModelStatus::Loaded) {
+            model->pendingReload = true;
         }
-    } else {
-        model->status = ModelStatus::Error;
-        Log::error(LOG_CATEGORY, "Failed to reload model: {}", model->displayName);
     }
 }
 
@@ -760,20 +1322,60 @@ void ModelManager::processPendingReloads() {
         scanModels();
     }
 
-    // Then handle individual model reloads
-    std::vector<ModelHandle> toReload;
+    // Swap in asynchronous loads whose worker is done, and collect their
+    // callbacks to run without the lock
+    std::vector<LoadTask*> completed;
+    {
+        std::lock_guard lock(completedMutex_);
+        completed.swap(completedLoads_);
+    }
 
+    std::vector<std::function<void()>> notifications;
     {
         std::lock_guard lock(mutex_);
-        for (const auto& [handle, model] : cache_) {
-            if (model->pendingReload) {
-                toReload.push_back(handle);
+        for (LoadTask* raw : completed) {
+            // Taken out first: a restarted load gets a new task
+            auto node = loadTasks_.extract(raw->handle);
+            if (node.empty()) {
+                continue;
+            }
+            std::unique_ptr<LoadTask> task = std::move(node.mapped());
+            const ModelHandle handle = task->handle;
+            const bool success = finishLoad(*task);
+            for (ModelLoadCallback& callback : task->callbacks) {
+                notifications.push_back([callback = std::move(callback), handle, success] {
+                    callback(handle, success);
+                });
             }
+            // Nodes added the model while it was loading
+            if (success && reloadCallback_) {
+                notifications.push_back([callback = reloadCallback_, handle] {
+                    callback(handle);
+                });
+            }
+        }
+        for (auto& [handle, callback] : readyCallbacks_) {
+            auto it = cache_.find(handle);
+            const bool success = it != cache_.end() && it->second->status == ModelStatus::Loaded;
+            notifications.push_back([callback = std::move(callback), handle, success] {
+                callback(handle, success);
+            });
         }
+        readyCallbacks_.clear();
     }
 
-    for (ModelHandle handle : toReload) {
-        reloadModel(handle);
+    for (const auto& notify : notifications) {
+        notify();
+    }
+
+    // Then start queued reloads; a model already loading is reloaded once
+    // that load is done
+    std::lock_guard lock(mutex_);
+    for (auto& [handle, model] : cache_) {
+        if (model->pendingReload && !loadTasks_.contains(handle)) {
+            Log::info(LOG_CATEGORY, "Reloading model in background: {}", model->displayName);
+            startLoad(*model, {});
+        }
     }
 }
 
@@ -817,8 +1419,10 @@ void ModelManager::clearCache(bool force) {
 
     if (force) {
         Log::info(LOG_CATEGORY, "Force clearing all {} cached models", cache_.size());
+        cancelAllLoads();
         cache_.clear();
         pathToHandle_.clear();
+        textureManager_.clear();
     } else {
         // Only clear unused models
         std::vector<ModelHandle> toRemove;
@@ -831,7 +1435,9 @@ void ModelManager::clearCache(bool force) {
         for (ModelHandle handle : toRemove) {
             auto it = cache_.find(handle);
             if (it != cache_.end()) {
+                cancelLoadLocked(handle);
                 pathToHandle_.erase(it->second->path);
+                releaseTextures(*it->second);
                 cache_.erase(it);
             }
         }
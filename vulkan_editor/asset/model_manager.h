@@ -2,8 +2,11 @@
 
 #include "vulkan_editor/io/model_watcher.h"
 #include "vulkan_editor/io/directory_watcher.h"
+#include "vulkan_editor/asset/texture_manager.h"
 #include "vulkan_editor/gpu/primitives.h"
 #include <vkDuck/model_loader.h> // For Vertex, GLTFCamera, GLTFLight
+#include <vkDuck/texture_cook.h>
+#include <algorithm>
 #include <atomic>
 #include <filesystem>
 #include <functional>
@@ -18,19 +21,8 @@
 // Types needed for CachedModel (duplicated from model_node.h to avoid circular dep)
 // ============================================================================
 
-struct EditorImage {
-    std::filesystem::path path{};
-    void* pixels{nullptr};
-    bool toLoad{false};
-    uint32_t width{0};
-    uint32_t height{0};
-    primitives::StoreHandle image{};  // Forward-declared, only used as handle
-
-    ~EditorImage();
-};
-
 struct EditorMaterial {
-    // Texture indices into CachedModel::images array (-1 = not present)
+    // Texture indices into CachedModel::textures array (-1 = not present)
     int baseColorTextureIndex{-1};
     int emissiveTextureIndex{-1};
     int metallicRoughnessTextureIndex{-1};
@@ -43,6 +35,14 @@ struct EditorMaterial {
     float roughnessFactor{1.0f};
 };
 
+/**
+ * @brief How each of `imageCount` images is sampled by `materials`.
+ * Normal maps win over material data, which wins over colour, for
+ * images shared between slots. Unreferenced images are Color.
+ */
+std::vector<TextureRole> classifyTextureRoles(
+    const std::vector<EditorMaterial>& materials, size_t imageCount);
+
 /**
  * @brief GPU-ready material parameters for PBR shading.
  * Matches the expected layout in shaders (std140/std430).
@@ -62,12 +62,32 @@ struct EditorGeometryRange {
     uint32_t indexCount;
     int materialIndex;
     VkPrimitiveTopology topology;
+    uint32_t firstInstance{0};  ///< Into ConsolidatedModelData::instances
+    uint32_t instanceCount{0};  ///< 0 = not instanced (pre-transformed vertices)
+    uint32_t firstLod{0};       ///< Into ConsolidatedModelData::lods
+    uint32_t lodCount{0};       ///< 0 = no LOD chain; level 0 is the range itself
+    glm::vec3 boundsMin{0.0f};  ///< World space, covering all instances
+    glm::vec3 boundsMax{0.0f};
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32};  ///< Selects indices16 or indices
+    uint32_t firstMeshlet{0};          ///< Into ConsolidatedModelData::meshlets
+    uint32_t meshletCount{0};          ///< 0 = no meshlets built
+    uint32_t firstMeshletVertex{0};    ///< Into ConsolidatedModelData::meshletVertices
+    uint32_t firstMeshletTriangle{0};  ///< Into ConsolidatedModelData::meshletTriangles
+    int32_t node{-1};  ///< Into ConsolidatedModelData::nodes; its world transform is the
+                       ///< model matrix. -1 = identity (transform baked in, or instanced)
 };
 
 struct ConsolidatedModelData {
     std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<uint32_t> indices;      ///< Ranges with VK_INDEX_TYPE_UINT32
+    std::vector<uint16_t> indices16;    ///< Ranges with VK_INDEX_TYPE_UINT16
     std::vector<EditorGeometryRange> ranges;
+    std::vector<InstanceData> instances;
+    std::vector<GeometryLod> lods;  ///< Offsets relative to each range's firstIndex
+    std::vector<Meshlet> meshlets;  ///< Offsets relative to each range's meshlet lists
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint8_t> meshletTriangles;
+    std::vector<SceneNode> nodes;   ///< Scene hierarchy, parents before children
 
     VkBuffer vertexBuffer = VK_NULL_HANDLE;
     VmaAllocation vertexBufferAllocation = VK_NULL_HANDLE;
@@ -77,7 +97,14 @@ struct ConsolidatedModelData {
     void clear() {
         vertices.clear();
         indices.clear();
+        indices16.clear();
         ranges.clear();
+        instances.clear();
+        lods.clear();
+        meshlets.clear();
+        meshletVertices.clear();
+        meshletTriangles.clear();
+        nodes.clear();
         vertexBuffer = VK_NULL_HANDLE;
         vertexBufferAllocation = VK_NULL_HANDLE;
         indexBuffer = VK_NULL_HANDLE;
@@ -85,8 +112,29 @@ struct ConsolidatedModelData {
     }
 
     size_t getTotalVertexCount() const { return vertices.size(); }
-    size_t getTotalIndexCount() const { return indices.size(); }
+    size_t getTotalIndexCount() const { return indices.size() + indices16.size(); }
     size_t getGeometryCount() const { return ranges.size(); }
+    size_t getTotalInstanceCount() const { return instances.size(); }
+
+    /// Triangles drawn per LOD level over all ranges. Ranges with a shorter
+    /// chain contribute their coarsest level to the deeper ones.
+    std::vector<size_t> getLodTriangleCounts() const {
+        uint32_t levels = 0;
+        for (const auto& range : ranges) {
+            levels = std::max(levels, range.lodCount);
+        }
+        std::vector<size_t> triangles(levels, 0);
+        for (const auto& range : ranges) {
+            for (uint32_t l = 0; l < levels; ++l) {
+                size_t indexCount = range.indexCount;
+                if (range.lodCount > 0) {
+                    indexCount = lods[range.firstLod + std::min(l, range.lodCount - 1)].indexCount;
+                }
+                triangles[l] += indexCount / 3;
+            }
+        }
+        return triangles;
+    }
 };
 
 /**
@@ -138,12 +186,21 @@ struct CachedModel {
     std::chrono::system_clock::time_point loadedAt;
     std::chrono::system_clock::time_point lastAccessed;
 
+    // Options the model data was (or will be) loaded with
+    ModelLoadOptions loadOptions;
+
     // Model data (populated when status == Loaded)
     ConsolidatedModelData modelData;
     std::vector<EditorMaterial> materials;
-    std::vector<EditorImage> images;
+    std::vector<TextureHandle> textures;  ///< Into the TextureManager, invalid if not loaded
+    std::vector<std::filesystem::path> texturePaths;  ///< As referenced by the model
     std::vector<GLTFCamera> cameras;
     std::vector<GLTFLight> lights;
+    MeshOptimizationStats optimizationStats;  ///< Set when loaded with optimizeMeshes
+    MeshletStats meshletStats;                ///< Set when loaded with buildMeshlets
+    double meshletBuildMs{0.0};               ///< 0 when served from the mesh cache
+    std::unique_ptr<ModelOutline> outline;    ///< Filled on demand by ModelManager::getOutline()
+    std::filesystem::file_time_type outlineWriteTime;  ///< File time the outline was read at
 
     // File watching
     std::unique_ptr<ModelFileWatcher> fileWatcher;
@@ -154,8 +211,8 @@ struct CachedModel {
     size_t referenceCount{0};  ///< Number of nodes using this model
     size_t memoryUsageBytes{0};
 
-    // Default texture for fallback
-    EditorImage defaultTexture;
+    // Default texture for fallback, shared by every model
+    TextureHandle defaultTexture;
 
     CachedModel() = default;
     ~CachedModel() = default;
@@ -182,7 +239,7 @@ using ModelReloadCallback = std::function<void(ModelHandle)>;
  * @brief Centralized service for loading, caching, and managing 3D models.
  *
  * Provides:
- * - Model loading with automatic caching
+ * - Model loading with automatic caching, blocking or on worker threads
  * - File watching for hot-reload
  * - Reference counting for cache management
  * - Thread-safe access to model data
@@ -239,25 +296,76 @@ public:
      * Otherwise, loads the model synchronously.
      *
      * @param relativePath Path relative to project root
+     * @param options Load options used if the model is not cached yet
      * @return Handle to the loaded model, or invalid handle on failure
      */
-    ModelHandle loadModel(const std::filesystem::path& relativePath);
+    ModelHandle loadModel(
+        const std::filesystem::path& relativePath,
+        const ModelLoadOptions& options = {}
+    );
+
+    /**
+     * @brief Change the load options of a cached model.
+     *
+     * Options are shared by every node using the model. If they differ
+     * from the current ones, a load in progress takes them over, or is
+     * restarted if its worker already started; otherwise the model is
+     * queued for reload and picked up by processPendingReloads().
+     *
+     * @param handle Model handle
+     * @param options New load options
+     */
+    void setLoadOptions(ModelHandle handle, const ModelLoadOptions& options);
+
+    /**
+     * @brief List the nodes and meshes of a model's file.
+     *
+     * Only the glTF JSON is parsed; no buffer is read. The outline is kept
+     * until the file changes and is used to pick
+     * ModelLoadOptions::nodeSelection.
+     *
+     * @param handle Model handle
+     * @return Outline, or nullptr if the handle is unknown or parsing failed
+     */
+    const ModelOutline* getOutline(ModelHandle handle);
 
     /**
-     * @brief Load a model asynchronously.
+     * @brief Load a model on a worker thread.
      *
-     * Returns immediately. The callback is invoked on the main thread
-     * when loading completes.
+     * Returns immediately; the model's status is Loading until the load
+     * finishes. Requests for a model that is already loading join that
+     * load. The callback is invoked on the main thread, from
+     * processPendingReloads(), once the model is loaded, failed or was
+     * cancelled.
      *
      * @param relativePath Path relative to project root
      * @param callback Called when loading completes
-     * @return Handle that will be valid after loading completes
+     * @param options Load options used if the model is not cached yet
+     * @return Handle to the model, valid immediately
      */
     ModelHandle loadModelAsync(
         const std::filesystem::path& relativePath,
-        ModelLoadCallback callback = nullptr
+        ModelLoadCallback callback = nullptr,
+        const ModelLoadOptions& options = {}
     );
 
+    /**
+     * @brief Fraction of an asynchronous load done, in [0, 1].
+     *
+     * @return 0 if the model is not loading asynchronously
+     */
+    float getLoadProgress(ModelHandle handle) const;
+
+    /**
+     * @brief Cancel an asynchronous load nobody references anymore.
+     *
+     * Call when a node is deleted before its model finished loading. Does
+     * nothing if the model is still referenced. The worker stops at its
+     * next stage, the model goes back to NotLoaded and callbacks report
+     * failure.
+     */
+    void cancelLoad(ModelHandle handle);
+
     /**
      * @brief Get a cached model by handle.
      *
@@ -275,6 +383,20 @@ public:
      */
     const CachedModel* getModelByPath(const std::filesystem::path& relativePath) const;
 
+    /**
+     * @brief Get the handle of a cached model in any status.
+     *
+     * @return Handle, or invalid handle if the path is not cached
+     */
+    ModelHandle getHandle(const std::filesystem::path& relativePath) const;
+
+    /**
+     * @brief Get the path of a cached model in any status.
+     *
+     * @return Path relative to project root, empty if the handle is unknown
+     */
+    std::filesystem::path getPath(ModelHandle handle) const;
+
     /**
      * @brief Check if a model is loaded and ready.
      */
@@ -318,15 +440,26 @@ public:
     /**
      * @brief Reload a model from disk.
      *
-     * Preserves the handle but reloads all data.
+     * Preserves the handle but reloads all data on a worker thread. A
+     * loaded model stays Loaded with its old data until
+     * processPendingReloads() swaps the new data in. A load already in
+     * progress is cancelled and started again.
      */
     void reloadModel(ModelHandle handle);
 
+    /**
+     * @brief Queue a reload of every loaded model.
+     *
+     * Used when a setting changes what their textures decode to. The
+     * reloads run in processPendingReloads().
+     */
+    void reloadAllModels();
+
     /**
      * @brief Process pending reloads and rescans.
      *
      * Call this from the main loop to handle file-watcher triggered reloads
-     * and directory changes.
+     * and directory changes, and to deliver finished asynchronous loads.
      */
     void processPendingReloads();
 
@@ -337,6 +470,9 @@ public:
 
     /**
      * @brief Register a callback for model reload events.
+     *
+     * Also invoked when an asynchronous load finishes, for nodes that
+     * added the model while it was loading.
      */
     void setReloadCallback(ModelReloadCallback callback) {
         reloadCallback_ = std::move(callback);
@@ -364,9 +500,23 @@ public:
      */
     void clearCache(bool force = false);
 
+    /**
+     * @brief Textures of all cached models, shared between them.
+     */
+    TextureManager& getTextureManager() { return textureManager_; }
+    const TextureManager& getTextureManager() const { return textureManager_; }
+
 private:
-    // Internal loading implementation
-    bool loadModelInternal(CachedModel& model);
+    struct LoadTask;
+
+    // Internal loading implementation. `task` is set on worker threads,
+    // which must not touch anything guarded by mutex_.
+    bool loadModelInternal(CachedModel& model, LoadTask* task = nullptr);
+    static bool advanceLoad(LoadTask* task, float progress);
+    void startLoad(CachedModel& model, std::vector<ModelLoadCallback> callbacks);
+    bool finishLoad(LoadTask& task);
+    void cancelLoadLocked(ModelHandle handle);
+    void cancelAllLoads();
     void setupFileWatcher(CachedModel& model);
     void setupDirectoryWatcher();
     void handleDirectoryChange(
@@ -377,10 +527,14 @@ private:
     void cleanupStaleCacheEntries();
     ModelHandle findOrCreateHandle(const std::filesystem::path& relativePath);
     void calculateMemoryUsage(CachedModel& model);
+    void releaseTextures(CachedModel& model);
 
     std::filesystem::path projectRoot_;
     std::vector<std::filesystem::path> availableModels_;
 
+    // Textures of cached models, deduplicated by content
+    TextureManager textureManager_;
+
     // Model cache - indexed by handle
     std::unordered_map<ModelHandle, std::unique_ptr<CachedModel>> cache_;
 
@@ -393,6 +547,15 @@ private:
     // Callbacks
     ModelReloadCallback reloadCallback_;
 
+    // Asynchronous loads by model, until processPendingReloads() finishes them
+    std::unordered_map<ModelHandle, std::unique_ptr<LoadTask>> loadTasks_;
+    // Callbacks of loadModelAsync() calls for models that were already loaded
+    std::vector<std::pair<ModelHandle, ModelLoadCallback>> readyCallbacks_;
+    // Loads whose worker is done, guarded by completedMutex_ (workers never
+    // take mutex_)
+    std::vector<LoadTask*> completedLoads_;
+    std::mutex completedMutex_;
+
     // Directory watching for auto-refresh
     std::unique_ptr<DirectoryWatcher> directoryWatcher_;
     std::atomic<bool> pendingRescan_{false};
@@ -0,0 +1,460 @@
+#include "texture_manager.h"
+#include "vulkan_editor/util/logger.h"
+#include <algorithm>
+#include <optional>
+
+#include <vkDuck/job_system.h>
+#include <vkDuck/mapped_file.h>
+#include <vkDuck/texture_cache.h>
+
+namespace fs = std::filesystem;
+
+// EditorImage destructor
+EditorImage::~EditorImage() {
+    if (pixels)
+        imageFree(pixels);
+}
+
+namespace {
+constexpr const char* LOG_CATEGORY = "TextureManager";
+
+/// A request that was not matched by its file stamp: opened (header only)
+/// and hashed, then shared or loaded
+struct PendingTexture {
+    size_t request{0};
+    std::string stampKey;  // Empty for embedded bytes
+    uintmax_t fileSize{0};
+    fs::file_time_type writeTime{};
+    std::optional<TextureSource> source;
+    uint64_t contentHash{0};
+    size_t loadedBy{SIZE_MAX};  // Index into the loads, once resolved
+};
+
+/// A texture loaded by acquire(), registered unless another thread
+/// registered the same key meanwhile
+struct LoadedTexture {
+    size_t pending{0};
+    std::optional<TextureSource> source;  // Prepared, until the image is made
+    uint32_t downscale{0};
+    std::unique_ptr<EditorImage> image;
+    TextureCookStats cookStats;
+    TextureHandle handle;
+    bool registered{false};  // False when another thread's texture is used
+};
+
+std::string stampKeyFor(
+    const fs::path& canonicalPath, const TextureRequest& request, const TexturePreviewLimits& preview) {
+    return canonicalPath.generic_string() + "#" + textureRoleName(request.role) +
+        (request.cook ? "#cooked" : "") + (request.packChannels ? "#packed" : "") +
+        "#" + std::to_string(preview.maxDimension) + "#" + std::to_string(preview.budgetBytes);
+}
+
+bool packsChannels(const TextureRequest& request, const TextureSource& source) {
+    return request.packChannels && request.role != TextureRole::Color &&
+        source.format() == VK_FORMAT_B8G8R8A8_UNORM;
+}
+
+/// The source to upload from: cooked, served by the decoded texture cache,
+/// or kept as it is. Embedded sources view the model's bytes and are
+/// copied unless the cache or a cook replaced them.
+std::optional<TextureSource> prepareSource(
+    const TextureRequest& request, TextureSource source, TextureCookStats& cookStats) {
+    try {
+        fs::path cookedPath;
+        if (request.cook) {
+            cookedPath = cookTexture(request.path, source.bytes(), request.role, &cookStats);
+        }
+        const bool linear = request.role != TextureRole::Color;
+        if (!cookedPath.empty()) {
+            return TextureSource(cookedPath);
+        }
+        source = openCachedTexture(std::move(source), linear);
+        if (!request.embeddedBytes.empty() &&
+            source.bytes().data() == request.embeddedBytes.data()) {
+            // Not cached: copied, the model's mapping is released once
+            // loading finishes
+            return TextureSource(request.embeddedBytes);
+        }
+        return source;
+    } catch (const std::exception& e) {
+        Log::debug(LOG_CATEGORY, "Could not load texture {}: {}", request.path.string(), e.what());
+    }
+    return std::nullopt;
+}
+
+/// Halvings per loaded texture: none is larger than `limits.maxDimension`,
+/// then the largest are halved until the batch fits into `available`
+/// bytes (estimated, packed channels counted as half) or none can shrink
+void planDownscale(
+    std::vector<LoadedTexture>& loads, const std::vector<size_t>& bytes,
+    const TexturePreviewLimits& limits, size_t available) {
+    auto sizeAt = [&](size_t i, uint32_t downscale) { return bytes[i] >> (2 * downscale); };
+    size_t total = 0;
+    for (size_t i = 0; i < loads.size(); ++i) {
+        if (!loads[i].source) {
+            continue;
+        }
+        const TextureSource& source = *loads[i].source;
+        const uint32_t maxDownscale = source.maxDownscale();
+        uint32_t& downscale = loads[i].downscale;
+        while (limits.maxDimension > 0 && downscale < maxDownscale &&
+            (std::max(source.width(), source.height()) >> downscale) > limits.maxDimension) {
+            ++downscale;
+        }
+        total += sizeAt(i, downscale);
+    }
+    if (limits.budgetBytes == 0) {
+        return;
+    }
+    while (total > available) {
+        size_t largest = SIZE_MAX;
+        for (size_t i = 0; i < loads.size(); ++i) {
+            if (loads[i].source && loads[i].downscale < loads[i].source->maxDownscale() &&
+                (largest == SIZE_MAX ||
+                    sizeAt(i, loads[i].downscale) > sizeAt(largest, loads[largest].downscale))) {
+                largest = i;
+            }
+        }
+        if (largest == SIZE_MAX) {
+            break;
+        }
+        total -= sizeAt(largest, loads[largest].downscale);
+        total += sizeAt(largest, ++loads[largest].downscale);
+    }
+}
+
+/// The texture uploaded from a prepared source: reduced to its preview
+/// size, and with normal and material maps packed to the channels they are
+/// sampled for (see textureChannelLayout()). Material maps are decoded once
+/// to find channels that are constant or equal. Sources kept in their own
+/// format take the view swizzle of that format (see textureFormatSwizzle()).
+std::unique_ptr<EditorImage> makeImage(
+    const TextureRequest& request, TextureSource source, uint32_t downscale,
+    const TextureCookStats& cookStats) {
+    auto image = std::make_unique<EditorImage>();
+    image->path = request.path;
+    image->toLoad = true;
+    image->downscale = source.setDownscale(downscale, request.role == TextureRole::Color);
+    image->fullWidth = source.fullWidth();
+    image->fullHeight = source.fullHeight();
+    image->width = source.width();
+    image->height = source.height();
+    image->format = source.format();
+    image->mipLevels = source.mipLevels();
+    image->size = source.size();
+    // Stored two-channel normal maps (cooked BC5, container R8G8) are
+    // swizzled like the packed ones below
+    image->swizzle = textureFormatSwizzle(request.role, image->format);
+    if (packsChannels(request, source)) {
+        TextureChannelLayout layout;
+        if (request.role == TextureRole::Data) {
+            LoadedImage pixels = source.load();
+            if (pixels.valid) {
+                layout = textureChannelLayout(request.role, static_cast<const uint8_t*>(pixels.pixels),
+                    static_cast<size_t>(pixels.width) * pixels.height);
+            }
+            imageFree(pixels.pixels);
+        } else {
+            layout = textureChannelLayout(request.role, nullptr, 0);
+        }
+        image->channels = layout.channels;
+        image->swizzle = layout.swizzle;
+        image->format = textureChannelsFormat(layout.channels);
+        image->size = source.size(layout.channels);
+    }
+    image->source = std::make_shared<const TextureSource>(std::move(source));
+    image->cookedPath = cookStats.cookedPath;
+    return image;
+}
+
+}  // namespace
+
+std::vector<TextureAcquireResult> TextureManager::acquire(const std::vector<TextureRequest>& requests) {
+    std::vector<TextureAcquireResult> results(requests.size());
+    if (requests.empty()) {
+        return results;
+    }
+
+    const TexturePreviewLimits preview = getPreviewLimits();
+
+    // Files are recognized by path, size and time before anything is read
+    std::vector<PendingTexture> pending(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        PendingTexture& texture = pending[i];
+        texture.request = i;
+        const TextureRequest& request = requests[i];
+        if (!request.embeddedBytes.empty()) {
+            continue;
+        }
+        std::error_code ec;
+        const fs::path canonicalPath = fs::weakly_canonical(request.path, ec);
+        texture.fileSize = fs::file_size(request.path, ec);
+        texture.writeTime = fs::last_write_time(request.path, ec);
+        if (!ec) {
+            texture.stampKey = stampKeyFor(canonicalPath, request, preview);
+        }
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        std::erase_if(pending, [&](const PendingTexture& texture) {
+            auto stamp = stamps_.find(texture.stampKey);
+            if (texture.stampKey.empty() || stamp == stamps_.end() ||
+                stamp->second.size != texture.fileSize ||
+                stamp->second.writeTime != texture.writeTime) {
+                return false;
+            }
+            const TextureHandle handle = findLocked(stamp->second.key);
+            if (!handle.isValid()) {
+                return false;
+            }
+            ++entries_[handle.id]->referenceCount;
+            results[texture.request].handle = handle;
+            results[texture.request].shared = true;
+            return true;
+        });
+    }
+    if (pending.empty()) {
+        return results;
+    }
+
+    // Open (header only) and hash the rest
+    jobSystem().parallelFor(pending.size(), [&](size_t i) {
+        PendingTexture& texture = pending[i];
+        const TextureRequest& request = requests[texture.request];
+        try {
+            if (request.embeddedBytes.empty()) {
+                texture.source.emplace(request.path);
+            } else {
+                texture.source.emplace(request.embeddedBytes, false);
+            }
+            const auto bytes = texture.source->bytes();
+            texture.contentHash = hashBytes(bytes.data(), bytes.size());
+        } catch (const std::exception& e) {
+            Log::debug(LOG_CATEGORY, "Could not open texture {}: {}", request.path.string(), e.what());
+            texture.source.reset();
+        }
+    }, JobLane::Io);
+
+    // Share what is loaded already; requests repeating within the batch
+    // wait for the first one
+    std::vector<LoadedTexture> loads;
+    size_t budgetUsed = 0;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& [id, entry] : entries_) {
+            budgetUsed += entry->key.preview == preview ? entry->image->size : 0;
+        }
+        std::unordered_map<Key, size_t, KeyHash> loading;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            PendingTexture& texture = pending[i];
+            if (!texture.source) {
+                continue;
+            }
+            const TextureRequest& request = requests[texture.request];
+            const Key key{texture.contentHash, request.role, request.cook, request.packChannels, preview};
+            if (!texture.stampKey.empty()) {
+                stamps_[texture.stampKey] = {texture.fileSize, texture.writeTime, key};
+            }
+            if (const TextureHandle handle = findLocked(key); handle.isValid()) {
+                ++entries_[handle.id]->referenceCount;
+                results[texture.request].handle = handle;
+                results[texture.request].shared = true;
+                texture.source.reset();
+                continue;
+            }
+            auto [it, inserted] = loading.try_emplace(key, loads.size());
+            texture.loadedBy = it->second;
+            if (inserted) {
+                loads.push_back({i, std::nullopt, 0, nullptr, {}, {}, false});
+            } else {
+                texture.source.reset();
+            }
+        }
+    }
+
+    jobSystem().parallelFor(loads.size(), [&](size_t i) {
+        LoadedTexture& load = loads[i];
+        PendingTexture& texture = pending[load.pending];
+        load.source = prepareSource(requests[texture.request], std::move(*texture.source), load.cookStats);
+        texture.source.reset();
+    });
+
+    // Preview sizes are decided for the batch as a whole, from headers
+    std::vector<size_t> estimatedBytes(loads.size());
+    for (size_t i = 0; i < loads.size(); ++i) {
+        if (const auto& source = loads[i].source) {
+            const bool packed = packsChannels(requests[pending[loads[i].pending].request], *source);
+            estimatedBytes[i] = packed ? source->size() / 2 : source->size();
+        }
+    }
+    const size_t available = preview.budgetBytes > budgetUsed ? preview.budgetBytes - budgetUsed : 0;
+    planDownscale(loads, estimatedBytes, preview, available);
+
+    jobSystem().parallelFor(loads.size(), [&](size_t i) {
+        LoadedTexture& load = loads[i];
+        const TextureRequest& request = requests[pending[load.pending].request];
+        if (load.source) {
+            load.image = makeImage(request, std::move(*load.source), load.downscale, load.cookStats);
+            load.source.reset();
+        }
+    });
+
+    std::lock_guard lock(mutex_);
+    for (LoadedTexture& load : loads) {
+        const PendingTexture& texture = pending[load.pending];
+        const TextureRequest& request = requests[texture.request];
+        const Key key{texture.contentHash, request.role, request.cook, request.packChannels, preview};
+        load.handle = findLocked(key);
+        if (load.handle.isValid() || !load.image || !load.image->loaded()) {
+            // Registered by another model loading at the same time, or failed
+            continue;
+        }
+        auto entry = std::make_unique<Entry>();
+        entry->handle = TextureHandle{nextId_++};
+        entry->key = key;
+        entry->image = std::move(load.image);
+        load.handle = entry->handle;
+        load.registered = true;
+        byKey_[key] = entry->handle;
+        entries_[entry->handle.id] = std::move(entry);
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const PendingTexture& texture = pending[i];
+        if (texture.loadedBy == SIZE_MAX) {
+            continue;
+        }
+        const LoadedTexture& load = loads[texture.loadedBy];
+        TextureAcquireResult& result = results[texture.request];
+        const bool loader = load.pending == i;
+        if (loader) {
+            result.cookStats = load.cookStats;
+        }
+        if (load.handle.isValid()) {
+            ++entries_[load.handle.id]->referenceCount;
+            result.handle = load.handle;
+            result.shared = !loader || !load.registered;
+        }
+    }
+    return results;
+}
+
+TextureHandle TextureManager::acquire(const fs::path& path, TextureRole role) {
+    TextureRequest request;
+    request.path = path;
+    request.role = role;
+    return acquire(std::vector<TextureRequest>{request}).front().handle;
+}
+
+TextureHandle TextureManager::findLocked(const Key& key) const {
+    auto it = byKey_.find(key);
+    return it != byKey_.end() ? it->second : TextureHandle{};
+}
+
+void TextureManager::releaseLocked(TextureHandle handle) {
+    auto it = entries_.find(handle.id);
+    if (it == entries_.end()) {
+        return;
+    }
+    Entry& entry = *it->second;
+    if (entry.referenceCount > 1) {
+        --entry.referenceCount;
+        return;
+    }
+    Log::debug(LOG_CATEGORY, "Releasing texture {}", entry.image->path.string());
+    byKey_.erase(entry.key);
+    entries_.erase(it);
+}
+
+void TextureManager::release(TextureHandle handle) {
+    std::lock_guard lock(mutex_);
+    releaseLocked(handle);
+}
+
+void TextureManager::release(std::span<const TextureHandle> handles) {
+    std::lock_guard lock(mutex_);
+    for (TextureHandle handle : handles) {
+        releaseLocked(handle);
+    }
+}
+
+const EditorImage* TextureManager::get(TextureHandle handle) const {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(handle.id);
+    return it != entries_.end() ? it->second->image.get() : nullptr;
+}
+
+size_t TextureManager::getReferenceCount(TextureHandle handle) const {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(handle.id);
+    return it != entries_.end() ? it->second->referenceCount : 0;
+}
+
+primitives::StoreHandle TextureManager::findImagePrimitive(
+    const primitives::Store& store, TextureHandle handle, VkFormat format) const {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(handle.id);
+    if (it == entries_.end()) {
+        return {};
+    }
+    // The store is rebuilt from scratch; an image counts only if it still
+    // samples this texture
+    const Entry& entry = *it->second;
+    for (primitives::StoreHandle image : entry.primitives) {
+        if (image.handle < store.imageCount &&
+            store.images[image.handle].imageSource == entry.image->source &&
+            store.images[image.handle].imageInfo.format == format) {
+            return image;
+        }
+    }
+    return {};
+}
+
+void TextureManager::setImagePrimitive(
+    const primitives::Store& store, TextureHandle handle, primitives::StoreHandle image) {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(handle.id);
+    if (it == entries_.end()) {
+        return;
+    }
+    Entry& entry = *it->second;
+    std::erase_if(entry.primitives, [&](primitives::StoreHandle previous) {
+        return previous.handle >= store.imageCount ||
+            store.images[previous.handle].imageSource != entry.image->source ||
+            store.images[previous.handle].imageInfo.format ==
+                store.images[image.handle].imageInfo.format;
+    });
+    entry.primitives.push_back(image);
+}
+
+TextureManagerStats TextureManager::getStats() const {
+    std::lock_guard lock(mutex_);
+    TextureManagerStats stats;
+    stats.textures = entries_.size();
+    for (const auto& [id, entry] : entries_) {
+        const EditorImage& image = *entry->image;
+        stats.references += entry->referenceCount;
+        stats.residentBytes += image.pixels ? image.size : image.source->bytes().size();
+        stats.decodedBytes += image.size;
+        stats.savedBytes += (entry->referenceCount - 1) * image.size;
+        stats.previewTextures += image.downscale > 0 ? 1 : 0;
+    }
+    return stats;
+}
+
+void TextureManager::setPreviewLimits(const TexturePreviewLimits& limits) {
+    std::lock_guard lock(mutex_);
+    previewLimits_ = limits;
+}
+
+TexturePreviewLimits TextureManager::getPreviewLimits() const {
+    std::lock_guard lock(mutex_);
+    return previewLimits_;
+}
+
+void TextureManager::clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+    byKey_.clear();
+    stamps_.clear();
+}
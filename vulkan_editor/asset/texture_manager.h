@@ -0,0 +1,238 @@
+#pragma once
+
+#include "vulkan_editor/gpu/primitives.h"
+#include <vkDuck/image_loader.h>
+#include <vkDuck/texture_cook.h>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct EditorImage {
+    std::filesystem::path path{};
+    void* pixels{nullptr};  // Decoded pixels, or null when `source` is set
+    // Mapped file (or encoded bytes) decoded straight into the staging
+    // buffer on upload; model textures use this instead of `pixels`
+    std::shared_ptr<const TextureSource> source{};
+    bool toLoad{false};
+    uint32_t width{0};
+    uint32_t height{0};
+    // BGRA8 for decoded PNG/JPEG; KTX2/DDS keep their format and levels.
+    // R8G8/R8 when `channels` drops some of a BGRA8 source's channels
+    VkFormat format{VK_FORMAT_B8G8R8A8_UNORM};
+    uint32_t mipLevels{1};
+    size_t size{0};  // Decoded bytes, all levels
+    TextureChannels channels{TextureChannels::Bgra};  // Kept when decoding `source`
+    VkComponentMapping swizzle{};  // View swizzle restoring dropped channels
+    // Preview resolution: `width` x `height` are `downscale` halvings of
+    // the full size, which generated code loads
+    uint32_t downscale{0};
+    uint32_t fullWidth{0};
+    uint32_t fullHeight{0};
+    std::filesystem::path cookedPath{};  // Cooked .dds it was loaded from, if any
+    primitives::StoreHandle image{};  // Forward-declared, only used as handle
+
+    /// True if the image can be uploaded
+    bool loaded() const { return pixels || (source && source->valid()); }
+
+    ~EditorImage();
+};
+
+/**
+ * @brief Reference to a texture owned by the TextureManager.
+ */
+struct TextureHandle {
+    uint32_t id{UINT32_MAX};
+
+    bool isValid() const { return id != UINT32_MAX; }
+    bool operator==(const TextureHandle& other) const { return id == other.id; }
+    bool operator!=(const TextureHandle& other) const { return id != other.id; }
+};
+
+template <>
+struct std::hash<TextureHandle> {
+    size_t operator()(const TextureHandle& h) const noexcept {
+        return std::hash<uint32_t>{}(h.id);
+    }
+};
+
+/**
+ * @brief A texture to acquire: a file on disk, or encoded bytes embedded
+ * in a model under a virtual path ("ship.glb#3").
+ */
+struct TextureRequest {
+    std::filesystem::path path;
+    std::span<const uint8_t> embeddedBytes;  ///< Only read during acquire()
+    TextureRole role{TextureRole::Color};
+    bool cook{false};
+    bool packChannels{false};  ///< Drop channels the role does not read
+};
+
+/**
+ * @brief Outcome of acquiring one TextureRequest.
+ */
+struct TextureAcquireResult {
+    TextureHandle handle;       ///< Invalid if the texture could not be opened
+    bool shared{false};         ///< Served by a texture that was already loaded
+    TextureCookStats cookStats; ///< Set when this request loaded the texture
+};
+
+struct TextureManagerStats {
+    size_t textures{0};         ///< Distinct textures held
+    size_t references{0};       ///< Handles held over all textures
+    size_t residentBytes{0};    ///< CPU bytes, encoded sources or pixels
+    size_t decodedBytes{0};     ///< Uploaded bytes, all levels, once per texture
+    size_t savedBytes{0};       ///< Decoded bytes not duplicated by sharing
+    size_t previewTextures{0};  ///< Textures loaded below full resolution
+};
+
+/**
+ * @brief Editor preview resolution of model textures (project setting).
+ *
+ * Textures larger than `maxDimension` are decoded at a power-of-two
+ * fraction of their size. When the textures loaded together would exceed
+ * what is left of `budgetBytes`, the largest ones are halved further.
+ * Generated code always loads full resolution. 0 means no limit.
+ */
+struct TexturePreviewLimits {
+    uint32_t maxDimension{0};
+    uint64_t budgetBytes{0};
+
+    bool operator==(const TexturePreviewLimits&) const = default;
+};
+
+/**
+ * @class TextureManager
+ * @brief Project-wide owner of model textures, shared by content.
+ *
+ * Textures are keyed by the hash of their encoded bytes, the role they
+ * are loaded for (which picks the cooked format and how cached mips are
+ * filtered) and the preview limits in effect. A file is hashed once: later requests for the same canonical
+ * path are matched by size and modification time. Two models referencing
+ * the same image, or the same bytes under different names, share one
+ * texture and, through findImagePrimitive(), one GPU image.
+ *
+ * Textures are reference counted and destroyed with their last handle.
+ * All methods are thread-safe; loading runs without the lock held.
+ */
+class TextureManager {
+public:
+    TextureManager() = default;
+
+    // Non-copyable
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    /**
+     * @brief Acquire one reference per request, loading new textures in
+     * parallel on the job system.
+     *
+     * @return One result per request, in order
+     */
+    std::vector<TextureAcquireResult> acquire(const std::vector<TextureRequest>& requests);
+
+    /**
+     * @brief Acquire a single texture file.
+     */
+    TextureHandle acquire(const std::filesystem::path& path, TextureRole role = TextureRole::Color);
+
+    /**
+     * @brief Drop a reference. The texture is destroyed with its last one.
+     */
+    void release(TextureHandle handle);
+    void release(std::span<const TextureHandle> handles);
+
+    /**
+     * @brief Get a texture by handle.
+     *
+     * @return Pointer to the texture, or nullptr if it was destroyed. Stays
+     * valid while a reference is held.
+     */
+    const EditorImage* get(TextureHandle handle) const;
+
+    /**
+     * @brief Number of references held on a texture (0 if destroyed).
+     */
+    size_t getReferenceCount(TextureHandle handle) const;
+
+    /**
+     * @brief GPU image already created for a texture in `store`.
+     *
+     * @param format Format the image was created with (colour space)
+     * @return Handle, or an invalid handle if `store` has no such image
+     */
+    primitives::StoreHandle findImagePrimitive(
+        const primitives::Store& store, TextureHandle handle, VkFormat format) const;
+
+    /**
+     * @brief Remember the GPU image created for a texture in `store`, so
+     * other materials sampling it reuse it.
+     */
+    void setImagePrimitive(
+        const primitives::Store& store, TextureHandle handle, primitives::StoreHandle image);
+
+    TextureManagerStats getStats() const;
+
+    /**
+     * @brief Limits applied to textures acquired from now on. Textures
+     * already loaded keep their size until released.
+     */
+    void setPreviewLimits(const TexturePreviewLimits& limits);
+    TexturePreviewLimits getPreviewLimits() const;
+
+    /**
+     * @brief Destroy every texture, whatever its references.
+     */
+    void clear();
+
+private:
+    /// What a texture is loaded from, as far as sharing goes
+    struct Key {
+        uint64_t contentHash{0};
+        TextureRole role{TextureRole::Color};
+        bool cook{false};
+        bool packChannels{false};
+        TexturePreviewLimits preview;
+
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>(key.contentHash) ^
+                (static_cast<size_t>(key.role) << 2) ^
+                (static_cast<size_t>(key.packChannels) << 1) ^ static_cast<size_t>(key.cook) ^
+                (static_cast<size_t>(key.preview.maxDimension) << 8) ^
+                (static_cast<size_t>(key.preview.budgetBytes) << 16);
+        }
+    };
+
+    /// File version a content hash was computed for
+    struct FileStamp {
+        uintmax_t size{0};
+        std::filesystem::file_time_type writeTime{};
+        Key key;
+    };
+
+    struct Entry {
+        TextureHandle handle;
+        Key key;
+        std::unique_ptr<EditorImage> image;
+        size_t referenceCount{0};
+        // GPU images created for it, one per format (sRGB or UNORM)
+        std::vector<primitives::StoreHandle> primitives;
+    };
+
+    TextureHandle findLocked(const Key& key) const;
+    void releaseLocked(TextureHandle handle);
+
+    std::unordered_map<uint32_t, std::unique_ptr<Entry>> entries_;
+    std::unordered_map<Key, TextureHandle, KeyHash> byKey_;
+    std::unordered_map<std::string, FileStamp> stamps_;  // By canonical path and load settings
+    uint32_t nextId_{0};
+    TexturePreviewLimits previewLimits_;
+
+    mutable std::mutex mutex_;
+};
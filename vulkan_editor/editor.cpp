@@ -628,6 +628,34 @@ void Editor::renderPopupNotifications() {
 }
 
 void Editor::update() {
+    // Keep the decoded texture cache in step with the project setting.
+    // Cached mips change the level count of loaded textures.
+    if (graph) {
+        const TextureCacheConfig current = textureCacheConfig();
+        const TextureCacheConfig wanted = projectSelected
+            ? graph->textureCache.config(projectRoot / ".texture_cache")
+            : TextureCacheConfig{};
+        if (wanted != current) {
+            configureTextureCache(wanted);
+            const bool mipsBefore = !current.directory.empty() && current.mips;
+            const bool mipsAfter = !wanted.directory.empty() && wanted.mips;
+            if (mipsBefore != mipsAfter) {
+                g_modelManager->reloadAllModels();
+            }
+        }
+
+        // Textures reload at the new preview size
+        TextureManager& textures = g_modelManager->getTextureManager();
+        const TexturePreviewLimits preview = projectSelected
+            ? TexturePreviewLimits{graph->texturePreview.maxDimension,
+                  uint64_t{graph->texturePreview.budgetMegabytes} << 20}
+            : TexturePreviewLimits{};
+        if (preview != textures.getPreviewLimits()) {
+            textures.setPreviewLimits(preview);
+            g_modelManager->reloadAllModels();
+        }
+    }
+
     // Process any pending model reloads from file watchers
     g_modelManager->processPendingReloads();
 
@@ -708,6 +736,114 @@ void Editor::showGlobalSettingsView() {
             );
         }
 
+        ImGui::Spacing();
+
+        ImGui::TextColored(
+            ImVec4(0.4f, 0.7f, 1.0f, 1.0f), "Texture Mip Chains"
+        );
+        static const char* mipModes[] = {"None", "GPU blit", "CPU box filter"};
+        int mipMode = static_cast<int>(graph->mipGeneration);
+        if (ImGui::Combo("##MipGeneration", &mipMode, mipModes, IM_ARRAYSIZE(mipModes))) {
+            graph->mipGeneration = static_cast<MipGeneration>(mipMode);
+            // Textures are recreated with the new level count
+            rebuildLiveViewPrimitives();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "How sampled textures get their mip levels, in the editor "
+                "and in generated code.\nGPU blits each level on upload; "
+                "CPU filters the chain while staging."
+            );
+        }
+
+        ImGui::Spacing();
+
+        ImGui::TextColored(
+            ImVec4(0.4f, 0.7f, 1.0f, 1.0f), "Decoded Texture Cache"
+        );
+        auto& cache = graph->textureCache;
+        ImGui::Checkbox("Enabled##TextureCache", &cache.enabled);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "Keep decoded PNG/JPEG pixels in .texture_cache, so reopening "
+                "a project skips decoding.\nGenerated apps keep their own cache."
+            );
+        }
+        ImGui::BeginDisabled(!cache.enabled);
+        int maxMegabytes = static_cast<int>(cache.maxMegabytes);
+        if (ImGui::SliderInt("Size limit##TextureCache", &maxMegabytes, 64, 16384, "%d MB",
+                ImGuiSliderFlags_Logarithmic)) {
+            cache.maxMegabytes = static_cast<uint32_t>(maxMegabytes);
+        }
+        ImGui::Checkbox("Store mip chains##TextureCache", &cache.mips);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "Cache full mip chains; cached textures are then uploaded "
+                "with their levels instead of generating them.\n"
+                "Loaded models reload when this changes."
+            );
+        }
+        const TextureCacheStats stats = textureCacheStats();
+        ImGui::TextDisabled(
+            "%llu hits, %llu misses, %llu evicted",
+            static_cast<unsigned long long>(stats.hits),
+            static_cast<unsigned long long>(stats.misses),
+            static_cast<unsigned long long>(stats.evictions)
+        );
+        ImGui::TextDisabled(
+            "%zu files, %.1f MB", stats.entries, stats.bytes / (1024.0 * 1024.0)
+        );
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Clear##TextureCache")) {
+            clearTextureCache();
+        }
+        ImGui::EndDisabled();
+
+        ImGui::Spacing();
+
+        ImGui::TextColored(
+            ImVec4(0.4f, 0.7f, 1.0f, 1.0f), "Editor Texture Preview"
+        );
+        auto& preview = graph->texturePreview;
+        static const char* dimensions[] = {"Full", "512", "1024", "2048", "4096"};
+        static const uint32_t dimensionValues[] = {0, 512, 1024, 2048, 4096};
+        int dimension = 0;
+        for (int i = 0; i < IM_ARRAYSIZE(dimensionValues); ++i) {
+            if (dimensionValues[i] == preview.maxDimension) {
+                dimension = i;
+            }
+        }
+        if (ImGui::Combo("Max size##TexturePreview", &dimension, dimensions, IM_ARRAYSIZE(dimensions))) {
+            preview.maxDimension = dimensionValues[dimension];
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "Decode larger model textures at a power-of-two fraction of "
+                "their size in the editor.\nGenerated code always loads full "
+                "resolution. Loaded models reload when this changes."
+            );
+        }
+        int budgetMegabytes = static_cast<int>(preview.budgetMegabytes);
+        if (ImGui::SliderInt("Budget##TexturePreview", &budgetMegabytes, 0, 8192,
+                budgetMegabytes == 0 ? "Unlimited" : "%d MB", ImGuiSliderFlags_Logarithmic)) {
+            preview.budgetMegabytes = static_cast<uint32_t>(budgetMegabytes);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "Texture memory for all loaded models. The largest textures of "
+                "a model are halved further\nuntil it fits in what is left. "
+                "0 is unlimited."
+            );
+        }
+        if (g_modelManager) {
+            const TextureManagerStats stats = g_modelManager->getTextureManager().getStats();
+            ImGui::TextDisabled(
+                "%zu of %zu textures reduced, %.1f MB",
+                stats.previewTextures, stats.textures,
+                stats.decodedBytes / (1024.0 * 1024.0)
+            );
+        }
+
         ImGui::Spacing();
         ImGui::Separator();
     }
@@ -3,6 +3,7 @@
 #include <array>
 #include <filesystem>
 #include <glm/glm.hpp>
+#include <memory>
 #include <span>
 #include <string>
 #include <vector>
@@ -11,6 +12,13 @@
 
 // Use shared camera types from vkDuck library
 #include <vkDuck/camera_controller.h>
+// ModelLoadOptions for code generation of model-backed vertex data
+#include <vkDuck/model_loader.h>
+#include <vkDuck/vertex_formats.h>
+// MipGeneration for texture mip chains
+#include <vkDuck/image_loader.h>
+#include <vkDuck/texture_cache.h>
+#include <vkDuck/texture_container.h>
 
 /**
  * @namespace primitives
@@ -24,6 +32,7 @@ namespace primitives {
 enum class Type : uint8_t {
     Array,
     VertexData,
+    MeshletData,
     UniformBuffer,
     Camera,
     Light,
@@ -188,12 +197,29 @@ class VertexData : public Node, public GenerateNode {
 public:
     // CREATE
     std::span<uint8_t> vertexData{};
-    std::span<uint32_t> indexData{};
+    std::span<uint8_t> indexData{};
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32};  // Width of indexData elements
     VkDeviceSize vertexDataSize{0};
     VkDeviceSize indexDataSize{0};
 
-    // Vertex input description
+    // Per-instance stream (binding 1), only set for instanced geometry
+    std::span<uint8_t> instanceData{};
+    VkDeviceSize instanceDataSize{0};
+
+    // Level-of-detail chain, finest first, with offsets into indexData
+    // (which then holds every level). Empty for geometry without LODs.
+    std::vector<GeometryLod> lods{};
+    glm::vec3 boundsMin{0.0f};  // World space, used to pick a LOD per frame
+    glm::vec3 boundsMax{0.0f};
+
+    // Layout of vertexData. PackedQuantized positions are restored in the
+    // vertex shader from `dequantization`, pushed as constants per draw.
+    VertexFormat vertexFormat{VertexFormat::Full};
+    PositionDequantization dequantization{};
+
+    // Vertex input description (attributes cover both bindings)
     VkVertexInputBindingDescription bindingDescription{};
+    VkVertexInputBindingDescription instanceBindingDescription{};
     std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
 
     // For code generation: path to exported binary model data files
@@ -203,15 +229,71 @@ public:
     // For code generation: original model file path and geometry index
     std::filesystem::path modelFilePath{};
     uint32_t geometryIndex{0};
+    ModelLoadOptions modelLoadOptions{};
 
     // RECORD
     VkBuffer vertexBuffer{VK_NULL_HANDLE};
     VmaAllocation vertexAllocation{VK_NULL_HANDLE};
     VkBuffer indexBuffer{VK_NULL_HANDLE};
     VmaAllocation indexAllocation{VK_NULL_HANDLE};
+    VkBuffer instanceBuffer{VK_NULL_HANDLE};
+    VmaAllocation instanceAllocation{VK_NULL_HANDLE};
 
     uint32_t vertexCount{0};
     uint32_t indexCount{0};
+    uint32_t instanceCount{1};
+
+    bool isInstanced() const { return instanceDataSize > 0; }
+    bool hasLods() const { return lods.size() > 1; }
+    bool hasQuantizedPositions() const {
+        return vertexFormat == VertexFormat::PackedQuantized;
+    }
+
+    bool create(
+        const Store& store,
+        VkDevice device,
+        VmaAllocator allocator
+    ) override;
+    void stage(
+        VkDevice device,
+        VmaAllocator allocator,
+        VkQueue queue,
+        VkCommandPool cmdPool
+    ) override;
+    void destroy(
+        const Store& store,
+        VkDevice device,
+        VmaAllocator allocator
+    ) override;
+
+    void generateCreate(const Store& store, std::ostream& out) const override;
+    void generateDestroy(const Store& store, std::ostream& out) const override;
+};
+
+/// Meshlets of one geometry range as three storage buffers for cluster
+/// culling in compute, task or mesh shaders. Buffer contents follow vkDuck's
+/// Meshlet struct (48 bytes, std430), the uint32 vertex list (relative to the
+/// range's first vertex) and the byte triangle list, padded to whole uints.
+class MeshletData : public Node, public GenerateNode {
+public:
+    // CREATE
+    std::span<const Meshlet> meshlets{};
+    std::span<const uint32_t> meshletVertices{};
+    std::span<const uint8_t> meshletTriangles{};
+
+    // For code generation: original model file path and geometry index
+    std::filesystem::path modelFilePath{};
+    uint32_t geometryIndex{0};
+
+    // RECORD
+    VkBuffer meshletBuffer{VK_NULL_HANDLE};
+    VmaAllocation meshletAllocation{VK_NULL_HANDLE};
+    VkBuffer vertexBuffer{VK_NULL_HANDLE};
+    VmaAllocation vertexAllocation{VK_NULL_HANDLE};
+    VkBuffer triangleBuffer{VK_NULL_HANDLE};
+    VmaAllocation triangleAllocation{VK_NULL_HANDLE};
+
+    uint32_t meshletCount{0};
 
     bool create(
         const Store& store,
@@ -294,10 +376,23 @@ public:
     ExtentType extentType{};
     bool isSwapchainImage{false};
 
-    // If we have an externally provided image
+    // If we have an externally provided image: decoded pixels, or a source
+    // decoded straight into the staging buffer
     void* imageData{nullptr};
+    std::shared_ptr<const TextureSource> imageSource{};
     VkDeviceSize imageSize{0};
 
+    // Channels imageSource is decoded to (R8G8/R8 normal and material
+    // maps); imageInfo.format and imageSize are those of the packed texels
+    // and viewInfo.components maps them back
+    TextureChannels imageChannels{TextureChannels::Bgra};
+
+    // Editor preview of a larger texture: imageInfo and imageSource are
+    // `previewDownscale` halvings of `fullExtent`, which generated code
+    // creates and stages instead
+    uint32_t previewDownscale{0};
+    VkExtent3D fullExtent{};
+
     // For code generation: path to exported binary texture data file (legacy)
     std::filesystem::path imageDataBinPath{};
 
@@ -307,6 +402,13 @@ public:
     // For code generation: inline pixel data for small textures (e.g., 1x1 defaults)
     std::vector<uint8_t> inlineImageData{};
 
+    // How levels 1..mipLevels-1 are filled from imageData when staging
+    MipGeneration mipGeneration{MipGeneration::None};
+
+    // Levels already stored in imageData, tightly packed level 0 first
+    // (KTX2/DDS textures); imageSize covers all of them
+    uint32_t imageDataLevels{1};
+
     // RECORD
     VkImage image{VK_NULL_HANDLE};
     VmaAllocation alloc{VK_NULL_HANDLE};
@@ -630,6 +732,7 @@ public:
 private:
     VkPipeline pipeline{VK_NULL_HANDLE};
     VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+    bool pushesDequantization{false};  // Layout has the PositionDequantization range
     std::vector<VkDescriptorSet> globalDescriptorSets{};
     std::vector<std::vector<VkDescriptorSet>> perObjectDescriptorSets{};
 };
@@ -718,6 +821,7 @@ enum class StoreState { Empty, Created, Linked };
 struct Store {
     std::array<Array, 1000> arrays;
     std::array<VertexData, 1000> vertexDatas;
+    std::array<MeshletData, 1000> meshletDatas;
     std::array<UniformBuffer, 2000> uniformBuffers;
     std::array<Camera, 10> cameras;
     std::array<Light, 10> lights;
@@ -733,6 +837,10 @@ struct Store {
     // Physical device reference for querying MSAA limits
     VkPhysicalDevice physicalDevice{VK_NULL_HANDLE};
 
+    // Decoded texture cache the generated app configures, relative to its
+    // working directory (empty directory: no cache)
+    TextureCacheConfig textureCache{};
+
     /// Get maximum sample count supported by device for both color and depth
     VkSampleCountFlagBits getMaxSampleCount() const {
         if (physicalDevice == VK_NULL_HANDLE) return VK_SAMPLE_COUNT_1_BIT;
@@ -754,6 +862,7 @@ struct Store {
     StoreHandle defaultDescriptorPool();
     StoreHandle newArray();
     StoreHandle newVertexData();
+    StoreHandle newMeshletData();
     StoreHandle newUniformBuffer();
     StoreHandle newCamera();
     StoreHandle newLight();
@@ -791,6 +900,7 @@ struct Store {
 private:
     uint32_t arrayCount{0};
     uint32_t vertexDataCount{0};
+    uint32_t meshletDataCount{0};
     uint32_t uniformBufferCount{0};
     uint32_t cameraCount{0};
     uint32_t lightCount{0};
@@ -602,6 +602,8 @@ void DescriptorSet::generateCreate(const Store& store, std::ostream& out) const
                 "        .addressModeU = {},\n"
                 "        .addressModeV = {},\n"
                 "        .addressModeW = {},\n"
+                "        .minLod = {},\n"
+                "        .maxLod = {},\n"
                 "        .borderColor = {}\n"
                 "    }};\n"
                 "    vkchk(vkCreateSampler(device, &{}_samplerInfo_{}, nullptr, &{}_sampler_{}));\n\n",
@@ -612,6 +614,10 @@ void DescriptorSet::generateCreate(const Store& store, std::ostream& out) const
                 string_VkSamplerAddressMode(binding.samplerInfo.addressModeU),
                 string_VkSamplerAddressMode(binding.samplerInfo.addressModeV),
                 string_VkSamplerAddressMode(binding.samplerInfo.addressModeW),
+                std::format("{:.1f}f", binding.samplerInfo.minLod),
+                binding.samplerInfo.maxLod == VK_LOD_CLAMP_NONE
+                    ? std::string("VK_LOD_CLAMP_NONE")
+                    : std::format("{:.1f}f", binding.samplerInfo.maxLod),
                 string_VkBorderColor(binding.samplerInfo.borderColor),
                 name, binding.binding, name, binding.binding
             );
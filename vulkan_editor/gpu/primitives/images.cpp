@@ -3,6 +3,54 @@
 
 namespace primitives {
 
+static bool isSrgbFormat(VkFormat format) {
+    return format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_R8G8B8A8_SRGB;
+}
+
+static const char* textureChannelsName(TextureChannels channels) {
+    switch (channels) {
+    case TextureChannels::Bgra: return "TextureChannels::Bgra";
+    case TextureChannels::Rg: return "TextureChannels::Rg";
+    case TextureChannels::Gb: return "TextureChannels::Gb";
+    case TextureChannels::G: return "TextureChannels::G";
+    case TextureChannels::B: return "TextureChannels::B";
+    }
+    return "TextureChannels::Bgra";
+}
+
+/// Extent and levels generated code creates and stages. Editor previews
+/// of large textures are exported at full resolution.
+struct ExportedLevels {
+    VkExtent3D extent;
+    uint32_t mipLevels;
+    uint32_t dataLevels;  // Levels stored in the source
+};
+
+static ExportedLevels exportedLevels(const Image& img) {
+    if (img.previewDownscale == 0) {
+        return {img.imageInfo.extent, img.imageInfo.mipLevels, img.imageDataLevels};
+    }
+    if (img.imageDataLevels > 1) {
+        // The preview skipped the first stored levels
+        return {img.fullExtent, img.imageInfo.mipLevels + img.previewDownscale,
+                img.imageDataLevels + img.previewDownscale};
+    }
+    const uint32_t mipLevels = img.mipGeneration != MipGeneration::None
+        ? mipLevelCount(img.fullExtent.width, img.fullExtent.height)
+        : 1;
+    return {img.fullExtent, mipLevels, 1};
+}
+
+static bool isIdentitySwizzle(const VkComponentMapping& mapping) {
+    auto identity = [](VkComponentSwizzle swizzle, VkComponentSwizzle component) {
+        return swizzle == VK_COMPONENT_SWIZZLE_IDENTITY || swizzle == component;
+    };
+    return identity(mapping.r, VK_COMPONENT_SWIZZLE_R) &&
+        identity(mapping.g, VK_COMPONENT_SWIZZLE_G) &&
+        identity(mapping.b, VK_COMPONENT_SWIZZLE_B) &&
+        identity(mapping.a, VK_COMPONENT_SWIZZLE_A);
+}
+
 // ============================================================================
 // Image
 // ============================================================================
@@ -32,20 +80,30 @@ void Image::stage(
     VmaAllocationInfo allocInfoLocal{};
     VkCommandBuffer cmdBuffer{VK_NULL_HANDLE};
 
-    if (!imageData)
+    if (!imageData && !imageSource)
         return;
 
+    const uint32_t mipLevels = imageInfo.mipLevels;
+    const bool cpuMips = mipLevels > 1 && mipGeneration == MipGeneration::Cpu;
+    const bool gpuMips = mipLevels > 1 && mipGeneration == MipGeneration::Gpu;
+    const VkDeviceSize stagingSize = cpuMips
+        ? mipChainSize(imageInfo.extent.width, imageInfo.extent.height, mipLevels)
+        : imageSize;
+
     {
         VkBufferCreateInfo bufferInfo = {
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .size = imageSize,
+            .size = stagingSize,
             .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
             .sharingMode = VK_SHARING_MODE_EXCLUSIVE
         };
 
+        // Mips filtered from a level 0 decoded in place read it back
         VmaAllocationCreateInfo allocCreateInfo = {
             .flags =
-                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                (imageSource && cpuMips
+                    ? VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
+                    : VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT) |
                 VMA_ALLOCATION_CREATE_MAPPED_BIT,
             .usage = VMA_MEMORY_USAGE_AUTO
         };
@@ -56,7 +114,26 @@ void Image::stage(
         ));
 
         assert(allocInfoLocal.pMappedData != nullptr);
-        memcpy(allocInfoLocal.pMappedData, imageData, imageSize);
+        const void* level0 = imageData;
+        if (imageSource) {
+            if (!imageSource->decodeInto(allocInfoLocal.pMappedData, imageChannels)) {
+                // Still uploaded, so the image reaches a usable layout
+                Log::error("Primitives", "Image: Failed to decode {}", name);
+                memset(allocInfoLocal.pMappedData, 0, imageSize);
+            }
+            level0 = allocInfoLocal.pMappedData;
+        } else {
+            memcpy(allocInfoLocal.pMappedData, imageData, imageSize);
+        }
+        if (cpuMips) {
+            // Filtered straight into the staging buffer after level 0
+            generateMipChain(
+                static_cast<const uint8_t*>(level0),
+                imageInfo.extent.width, imageInfo.extent.height, mipLevels,
+                isSrgbFormat(imageInfo.format),
+                static_cast<uint8_t*>(allocInfoLocal.pMappedData) + imageSize
+            );
+        }
     }
 
     {
@@ -99,27 +176,43 @@ void Image::stage(
     }
 
     {
-        VkBufferImageCopy region{
-            .bufferOffset = 0,
-            .bufferRowLength = 0,
-            .bufferImageHeight = 0,
-            .imageSubresource =
-                {.aspectMask = viewInfo.subresourceRange.aspectMask,
-                 .mipLevel = viewInfo.subresourceRange.baseMipLevel,
-                 .baseArrayLayer =
-                     viewInfo.subresourceRange.baseArrayLayer,
-                 .layerCount = viewInfo.subresourceRange.layerCount},
-            .imageOffset = {0, 0, 0},
-            .imageExtent = imageInfo.extent
-        };
+        // Stored levels, plus the CPU-filtered levels packed after level 0
+        std::vector<VkBufferImageCopy> regions;
+        VkDeviceSize offset = 0;
+        VkExtent3D extent = imageInfo.extent;
+        for (uint32_t level = 0; level < (cpuMips ? mipLevels : imageDataLevels); ++level) {
+            regions.push_back({
+                .bufferOffset = offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource =
+                    {.aspectMask = viewInfo.subresourceRange.aspectMask,
+                     .mipLevel = viewInfo.subresourceRange.baseMipLevel + level,
+                     .baseArrayLayer =
+                         viewInfo.subresourceRange.baseArrayLayer,
+                     .layerCount = viewInfo.subresourceRange.layerCount},
+                .imageOffset = {0, 0, 0},
+                .imageExtent = extent
+            });
+            offset += textureLevelSize(imageInfo.format, extent.width, extent.height);
+            extent.width = std::max(1u, extent.width / 2);
+            extent.height = std::max(1u, extent.height / 2);
+        }
 
         vkCmdCopyBufferToImage(
             cmdBuffer, buffer, image,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>(regions.size()), regions.data()
         );
     }
 
-    {
+    if (gpuMips) {
+        // Blits the remaining levels and leaves all of them shader-readable
+        recordMipBlits(
+            cmdBuffer, image, imageInfo.extent.width, imageInfo.extent.height,
+            mipLevels
+        );
+    } else {
         VkImageMemoryBarrier barrier = {
             .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
             .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
@@ -192,6 +285,7 @@ void Image::generateCreate(const Store& store, std::ostream& out) const {
     }
 
     const auto& info = imageInfo;
+    const ExportedLevels levels = exportedLevels(*this);
     print(out, "// Image: {}\n", name);
     print(out, "{{\n");
 
@@ -211,8 +305,8 @@ void Image::generateCreate(const Store& store, std::ostream& out) const {
     if (extentType == ExtentType::SwapchainRelative) {
         extent = "swapChainExtent";
     } else {
-        extent = std::format("{{ {}, {}, {} }}", info.extent.width,
-                             info.extent.height, info.extent.depth);
+        extent = std::format("{{ {}, {}, {} }}", levels.extent.width,
+                             levels.extent.height, levels.extent.depth);
     }
 
     // Generate image create info
@@ -233,7 +327,7 @@ void Image::generateCreate(const Store& store, std::ostream& out) const {
         name,
         string_VkFormat(info.format),
         extent,
-        info.mipLevels, info.arrayLayers,
+        levels.mipLevels, info.arrayLayers,
         string_VkSampleCountFlagBits(info.samples),
         string_VkImageTiling(info.tiling),
         string_VkImageUsageFlags(usage)
@@ -253,14 +347,25 @@ void Image::generateCreate(const Store& store, std::ostream& out) const {
         name
     );
 
-    // Generate image view create info
+    // Generate image view create info; packed textures swizzle their
+    // channels back to where shaders sample them
     bool isDepth = (info.usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0;
+    std::string components;
+    if (!isIdentitySwizzle(viewInfo.components)) {
+        components = std::format(
+            "        .components = {{ {}, {}, {}, {} }},\n",
+            string_VkComponentSwizzle(viewInfo.components.r),
+            string_VkComponentSwizzle(viewInfo.components.g),
+            string_VkComponentSwizzle(viewInfo.components.b),
+            string_VkComponentSwizzle(viewInfo.components.a));
+    }
     print(out,
         "    VkImageViewCreateInfo {0}_viewInfo{{\n"
         "        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,\n"
         "        .image = {0},\n"
         "        .viewType = VK_IMAGE_VIEW_TYPE_2D,\n"
         "        .format = {1},\n"
+        "{5}"
         "        .subresourceRange = {{\n"
         "            .aspectMask = {2},\n"
         "            .baseMipLevel = 0,\n"
@@ -272,8 +377,9 @@ void Image::generateCreate(const Store& store, std::ostream& out) const {
         name,
         string_VkFormat(info.format),
         isDepth ? "VK_IMAGE_ASPECT_DEPTH_BIT" : "VK_IMAGE_ASPECT_COLOR_BIT",
-        info.mipLevels,
-        info.arrayLayers
+        levels.mipLevels,
+        info.arrayLayers,
+        components
     );
 
     // Generate vkCreateImageView call
@@ -315,6 +421,112 @@ void Image::generateCreateSwapchain(const Store& store, std::ostream& out) const
         imageInfo.arrayLayers);
 }
 
+/// Staging buffer, upload and mip generation of one sampled texture, after
+/// `<name>_textureSize` (level 0 bytes) has been declared. `width`,
+/// `height` and `pixels` are C++ expressions in the generated code. With
+/// `fromSource`, `pixels` names a TextureSource that is decoded straight
+/// into the staging buffer instead of being copied there.
+static void printTextureUpload(
+    std::ostream& out,
+    const Image& img,
+    std::string_view width,
+    std::string_view height,
+    std::string_view pixels,
+    bool fromSource = false
+) {
+    const ExportedLevels levels = exportedLevels(img);
+    const uint32_t mipLevels = levels.mipLevels;
+    const bool cpuMips = mipLevels > 1 && img.mipGeneration == MipGeneration::Cpu;
+    const bool gpuMips = mipLevels > 1 && img.mipGeneration == MipGeneration::Gpu;
+    const uint32_t copiedLevels = cpuMips ? mipLevels : levels.dataLevels;
+    const std::string_view format = string_VkFormat(img.imageInfo.format);
+
+    if (cpuMips) {
+        print(out,
+            "    VkDeviceSize {0}_stagingSize = mipChainSize({1}, {2}, {3});\n\n",
+            img.name, width, height, mipLevels);
+    } else {
+        print(out, "    VkDeviceSize {0}_stagingSize = {0}_textureSize;\n\n", img.name);
+    }
+
+    print(out,
+        "    // Create staging buffer\n"
+        "    VkBuffer {0}_stagingBuffer;\n"
+        "    VmaAllocation {0}_stagingAlloc;\n"
+        "    VmaAllocationInfo {0}_stagingAllocInfo;\n"
+        "    createBuffer(physicalDevice, device, allocator,\n"
+        "        {0}_stagingSize,\n"
+        "        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
+        "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
+        "        {1} | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
+        "        {0}_stagingBuffer, {0}_stagingAlloc, &{0}_stagingAllocInfo);\n",
+        img.name,
+        // Mips filtered from a decoded level 0 read the staging memory back
+        fromSource && cpuMips
+            ? "VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT"
+            : "VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT");
+    if (fromSource) {
+        const std::string channels = img.imageChannels == TextureChannels::Bgra
+            ? std::string()
+            : std::format(", {}", textureChannelsName(img.imageChannels));
+        print(out,
+            "    if (!{1}.decodeInto({0}_stagingAllocInfo.pMappedData{2})) {{\n"
+            "        throw std::runtime_error(\"Failed to decode image: {0}\");\n"
+            "    }}\n",
+            img.name, pixels, channels);
+    } else {
+        print(out,
+            "    memcpy({0}_stagingAllocInfo.pMappedData, {1}, {0}_textureSize);\n",
+            img.name, pixels);
+    }
+
+    if (cpuMips) {
+        const std::string level0 = fromSource
+            ? std::format("{}_stagingAllocInfo.pMappedData", img.name)
+            : std::string(pixels);
+        print(out,
+            "\n"
+            "    // Filter the mip chain into the staging buffer after level 0\n"
+            "    generateMipChain(reinterpret_cast<const uint8_t*>({1}), {2}, {3}, {4}, {5},\n"
+            "        static_cast<uint8_t*>({0}_stagingAllocInfo.pMappedData) + {0}_textureSize);\n",
+            img.name, level0, width, height, mipLevels,
+            isSrgbFormat(img.imageInfo.format) ? "true" : "false");
+    }
+
+    print(out,
+        "\n"
+        "    // Transition image to transfer destination layout\n"
+        "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
+        "        {1}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, {2});\n"
+        "\n"
+        "    // Copy staging buffer to image\n"
+        "    copyBufferToImage(device, graphicsQueue, commandPool, {0}_stagingBuffer, {0},\n"
+        "        {3}, {4}, {5}, {1});\n"
+        "\n",
+        img.name, format, mipLevels, width, height, copiedLevels);
+
+    if (gpuMips) {
+        print(out,
+            "    // Blit the mip chain; leaves every level in shader read-only layout\n"
+            "    generateMipmaps(device, graphicsQueue, commandPool, {0},\n"
+            "        {1}, {2}, {3});\n",
+            img.name, width, height, mipLevels);
+    } else {
+        print(out,
+            "    // Transition image to shader read-only layout\n"
+            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
+            "        {1}, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, {2});\n",
+            img.name, format, mipLevels);
+    }
+
+    print(out,
+        "\n"
+        "    // Cleanup staging buffer\n"
+        "    vmaDestroyBuffer(allocator, {0}_stagingBuffer, {0}_stagingAlloc);\n"
+        "}}\n\n",
+        img.name);
+}
+
 void Image::generateStage(const Store& store, std::ostream& out) const {
     // Skip swapchain images - they don't need staging
     if (isSwapchainImage) return;
@@ -331,44 +543,19 @@ void Image::generateStage(const Store& store, std::ostream& out) const {
         print(out,
             "// Stage texture: {0}\n"
             "{{\n"
-            "    // Use pre-loaded image data\n"
-            "    auto& {0}_img = loadedImages[\"{1}\"];\n"
-            "    if (!{0}_img.valid) {{\n"
+            "    // Use the pre-opened image, decoded into the staging buffer\n"
+            "    const auto& {0}_img = loadedImages[\"{1}\"];\n"
+            "    if (!{0}_img.valid()) {{\n"
             "        throw std::runtime_error(\"Failed to load image: {1}\");\n"
             "    }}\n"
-            "    VkDeviceSize {0}_textureSize = {0}_img.width * {0}_img.height * 4;\n"
-            "\n"
-            "    // Create staging buffer\n"
-            "    VkBuffer {0}_stagingBuffer;\n"
-            "    VmaAllocation {0}_stagingAlloc;\n"
-            "    VmaAllocationInfo {0}_stagingAllocInfo;\n"
-            "    createBuffer(physicalDevice, device, allocator,\n"
-            "        {0}_textureSize,\n"
-            "        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
-            "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
-            "        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
-            "        {0}_stagingBuffer, {0}_stagingAlloc, &{0}_stagingAllocInfo);\n"
-            "    memcpy({0}_stagingAllocInfo.pMappedData, {0}_img.pixels, {0}_textureSize);\n"
-            "\n"
-            "    // Transition image to transfer destination layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {2}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);\n"
-            "\n"
-            "    // Copy staging buffer to image\n"
-            "    copyBufferToImage(device, graphicsQueue, commandPool, {0}_stagingBuffer, {0},\n"
-            "        {0}_img.width, {0}_img.height);\n"
-            "\n"
-            "    // Transition image to shader read-only layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {2}, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);\n"
-            "\n"
-            "    // Cleanup staging buffer\n"
-            "    vmaDestroyBuffer(allocator, {0}_stagingBuffer, {0}_stagingAlloc);\n"
-            "}}\n\n",
+            "    VkDeviceSize {0}_textureSize = {0}_img.size({2});\n",
             name,
             originalImagePath,
-            string_VkFormat(imageInfo.format)
+            imageChannels == TextureChannels::Bgra ? "" : textureChannelsName(imageChannels)
         );
+        printTextureUpload(out, *this,
+            std::format("{}_img.width()", name), std::format("{}_img.height()", name),
+            std::format("{}_img", name), true);
     }
     // Fallback: load from binary file (legacy support)
     else if (!imageDataBinPath.empty()) {
@@ -377,41 +564,13 @@ void Image::generateStage(const Store& store, std::ostream& out) const {
             "{{\n"
             "    // Load texture data from binary file\n"
             "    auto {0}_textureData = readFile(\"{1}\");\n"
-            "    VkDeviceSize {0}_textureSize = {0}_textureData.size();\n"
-            "\n"
-            "    // Create staging buffer\n"
-            "    VkBuffer {0}_stagingBuffer;\n"
-            "    VmaAllocation {0}_stagingAlloc;\n"
-            "    VmaAllocationInfo {0}_stagingAllocInfo;\n"
-            "    createBuffer(physicalDevice, device, allocator,\n"
-            "        {0}_textureSize,\n"
-            "        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
-            "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
-            "        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
-            "        {0}_stagingBuffer, {0}_stagingAlloc, &{0}_stagingAllocInfo);\n"
-            "    memcpy({0}_stagingAllocInfo.pMappedData, {0}_textureData.data(), {0}_textureSize);\n"
-            "\n"
-            "    // Transition image to transfer destination layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {4}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);\n"
-            "\n"
-            "    // Copy staging buffer to image\n"
-            "    copyBufferToImage(device, graphicsQueue, commandPool, {0}_stagingBuffer, {0},\n"
-            "        {2}, {3});\n"
-            "\n"
-            "    // Transition image to shader read-only layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {4}, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);\n"
-            "\n"
-            "    // Cleanup staging buffer\n"
-            "    vmaDestroyBuffer(allocator, {0}_stagingBuffer, {0}_stagingAlloc);\n"
-            "}}\n\n",
+            "    VkDeviceSize {0}_textureSize = {0}_textureData.size();\n",
             name,
-            imageDataBinPath,
-            imageInfo.extent.width,
-            imageInfo.extent.height,
-            string_VkFormat(imageInfo.format)
+            imageDataBinPath
         );
+        printTextureUpload(out, *this,
+            std::to_string(imageInfo.extent.width), std::to_string(imageInfo.extent.height),
+            std::format("{}_textureData.data()", name));
     }
     // Inline pixel data (for small textures like 1x1 defaults)
     else if (!inlineImageData.empty()) {
@@ -423,41 +582,10 @@ void Image::generateStage(const Store& store, std::ostream& out) const {
             print(out, "{}", static_cast<int>(inlineImageData[i]));
         }
         print(out, "}}}};\n");
-        print(out, "    VkDeviceSize {}_textureSize = {}_data.size();\n\n", name, name);
-
-        print(out,
-            "    // Create staging buffer\n"
-            "    VkBuffer {0}_stagingBuffer;\n"
-            "    VmaAllocation {0}_stagingAlloc;\n"
-            "    VmaAllocationInfo {0}_stagingAllocInfo;\n"
-            "    createBuffer(physicalDevice, device, allocator,\n"
-            "        {0}_textureSize,\n"
-            "        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
-            "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
-            "        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
-            "        {0}_stagingBuffer, {0}_stagingAlloc, &{0}_stagingAllocInfo);\n"
-            "    memcpy({0}_stagingAllocInfo.pMappedData, {0}_data.data(), {0}_textureSize);\n"
-            "\n"
-            "    // Transition image to transfer destination layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {3}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);\n"
-            "\n"
-            "    // Copy staging buffer to image\n"
-            "    copyBufferToImage(device, graphicsQueue, commandPool, {0}_stagingBuffer, {0},\n"
-            "        {1}, {2});\n"
-            "\n"
-            "    // Transition image to shader read-only layout\n"
-            "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {3}, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);\n"
-            "\n"
-            "    // Cleanup staging buffer\n"
-            "    vmaDestroyBuffer(allocator, {0}_stagingBuffer, {0}_stagingAlloc);\n"
-            "}}\n\n",
-            name,
-            imageInfo.extent.width,
-            imageInfo.extent.height,
-            string_VkFormat(imageInfo.format)
-        );
+        print(out, "    VkDeviceSize {}_textureSize = {}_data.size();\n", name, name);
+        printTextureUpload(out, *this,
+            std::to_string(imageInfo.extent.width), std::to_string(imageInfo.extent.height),
+            std::format("{}_data.data()", name));
     } else {
         // Even without texture data, we need to transition to shader read-only layout
         // to avoid validation errors when the image is used in a descriptor set
@@ -465,10 +593,11 @@ void Image::generateStage(const Store& store, std::ostream& out) const {
             "// Transition image to shader read-only layout: {0}\n"
             "{{\n"
             "    transitionImageLayout(device, graphicsQueue, commandPool, {0},\n"
-            "        {1}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);\n"
+            "        {1}, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, {2});\n"
             "}}\n\n",
             name,
-            string_VkFormat(imageInfo.format)
+            string_VkFormat(imageInfo.format),
+            imageInfo.mipLevels
         );
     }
 }
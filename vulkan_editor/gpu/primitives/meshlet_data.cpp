@@ -0,0 +1,253 @@
+// MeshletData primitive implementation
+#include "common.h"
+
+namespace primitives {
+
+using std::print;
+
+namespace {
+
+struct MeshletUpload {
+    const void* data;
+    VkDeviceSize size;
+    VkBuffer* buffer;
+    VmaAllocation* allocation;
+};
+
+/// Storage buffers are read as uint arrays, so sizes round up to whole uints
+VkDeviceSize storageSize(VkDeviceSize size) {
+    return (size + 3) & ~VkDeviceSize(3);
+}
+
+} // anonymous namespace
+
+bool MeshletData::create(
+    const Store&,
+    VkDevice device,
+    VmaAllocator vma
+) {
+    // Ranges too small to split carry no buffers
+    if (meshlets.empty())
+        return true;
+
+    const MeshletUpload uploads[] = {
+        {meshlets.data(), meshlets.size_bytes(), &meshletBuffer, &meshletAllocation},
+        {meshletVertices.data(), meshletVertices.size_bytes(), &vertexBuffer, &vertexAllocation},
+        {meshletTriangles.data(), meshletTriangles.size_bytes(), &triangleBuffer, &triangleAllocation},
+    };
+
+    for (const MeshletUpload& upload : uploads) {
+        VkBufferCreateInfo bufferInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = storageSize(upload.size),
+            .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        VmaAllocationCreateInfo allocInfo{
+            .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+            .priority = 1.0f
+        };
+
+        vkchk(vmaCreateBuffer(
+            vma, &bufferInfo, &allocInfo, upload.buffer,
+            upload.allocation, nullptr
+        ));
+    }
+    return true;
+}
+
+void MeshletData::stage(
+    VkDevice device,
+    VmaAllocator allocator,
+    VkQueue queue,
+    VkCommandPool cmdPool
+) {
+    if (meshlets.empty() || meshletBuffer == VK_NULL_HANDLE)
+        return;
+
+    const MeshletUpload uploads[] = {
+        {meshlets.data(), meshlets.size_bytes(), &meshletBuffer, &meshletAllocation},
+        {meshletVertices.data(), meshletVertices.size_bytes(), &vertexBuffer, &vertexAllocation},
+        {meshletTriangles.data(), meshletTriangles.size_bytes(), &triangleBuffer, &triangleAllocation},
+    };
+    VkBuffer stagingBuffers[std::size(uploads)]{};
+    VmaAllocation stagingAllocations[std::size(uploads)]{};
+
+    VkCommandBuffer cmdBuffer{VK_NULL_HANDLE};
+    {
+        VkCommandBufferAllocateInfo cmdBufferAllocInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = cmdPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1
+        };
+
+        vkchk(vkAllocateCommandBuffers(
+            device, &cmdBufferAllocInfo, &cmdBuffer
+        ));
+
+        VkCommandBufferBeginInfo beginInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+        };
+        vkBeginCommandBuffer(cmdBuffer, &beginInfo);
+    }
+
+    // All three lists share one submit
+    for (size_t i = 0; i < std::size(uploads); ++i) {
+        const MeshletUpload& upload = uploads[i];
+        VmaAllocationInfo allocInfo{};
+
+        VkBufferCreateInfo bufferInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = storageSize(upload.size),
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        VmaAllocationCreateInfo allocCreateInfo{
+            .flags =
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            .usage = VMA_MEMORY_USAGE_AUTO
+        };
+
+        vkchk(vmaCreateBuffer(
+            allocator, &bufferInfo, &allocCreateInfo, &stagingBuffers[i],
+            &stagingAllocations[i], &allocInfo
+        ));
+
+        assert(allocInfo.pMappedData != nullptr);
+        memset(allocInfo.pMappedData, 0, bufferInfo.size);
+        memcpy(allocInfo.pMappedData, upload.data, upload.size);
+
+        VkBufferCopy copyRegion{
+            .srcOffset = 0, .dstOffset = 0, .size = bufferInfo.size
+        };
+
+        vkCmdCopyBuffer(
+            cmdBuffer, stagingBuffers[i], *upload.buffer, 1, &copyRegion
+        );
+    }
+
+    vkchk(vkEndCommandBuffer(cmdBuffer));
+
+    VkSubmitInfo submitInfo{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &cmdBuffer
+    };
+
+    vkchk(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+    vkchk(vkQueueWaitIdle(queue));
+
+    for (size_t i = 0; i < std::size(uploads); ++i) {
+        vmaDestroyBuffer(allocator, stagingBuffers[i], stagingAllocations[i]);
+    }
+
+    vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
+}
+
+void MeshletData::destroy(
+    const Store&,
+    VkDevice device,
+    VmaAllocator allocator
+) {
+    std::pair<VkBuffer*, VmaAllocation*> buffers[] = {
+        {&triangleBuffer, &triangleAllocation},
+        {&vertexBuffer, &vertexAllocation},
+        {&meshletBuffer, &meshletAllocation},
+    };
+    for (auto [buffer, allocation] : buffers) {
+        if (*buffer != VK_NULL_HANDLE) {
+            vmaDestroyBuffer(allocator, *buffer, *allocation);
+            *buffer = VK_NULL_HANDLE;
+            *allocation = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void MeshletData::generateCreate(const Store& store, std::ostream& out) const {
+    if (name.empty()) return;
+
+    print(out, "// MeshletData: {} (meshletCount={})\n", name, meshletCount);
+    print(out, "{{\n");
+
+    if (modelFilePath.empty()) {
+        print(out,
+            "    // TODO: Build meshlets and create storage buffers\n"
+            "    // Expected sizes: meshlets={} bytes, vertices={} bytes, triangles={} bytes\n",
+            meshlets.size_bytes(), meshletVertices.size_bytes(), meshletTriangles.size_bytes()
+        );
+        print(out, "}}\n\n");
+        return;
+    }
+
+    // The three lists upload the same way; sizes round up to whole uints
+    print(out,
+        "    // View the meshlets of geometry {} of the pre-loaded model (no copy)\n"
+        "    MeshletView {}_view = geometryMeshlets({}, {});\n"
+        "    {}_meshletCount = static_cast<uint32_t>({}_view.meshlets.size());\n"
+        "    auto {}_upload = [&](const void* data, VkDeviceSize size, VkBuffer& buffer, VmaAllocation& alloc) {{\n"
+        "        VkDeviceSize bufferSize = std::max<VkDeviceSize>((size + 3) & ~VkDeviceSize(3), 4);\n"
+        "        VkBuffer stagingBuffer;\n"
+        "        VmaAllocation stagingAlloc;\n"
+        "        VmaAllocationInfo stagingAllocInfo;\n"
+        "        createBuffer(physicalDevice, device, allocator,\n"
+        "            bufferSize,\n"
+        "            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
+        "            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
+        "            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
+        "            stagingBuffer, stagingAlloc, &stagingAllocInfo);\n"
+        "        memset(stagingAllocInfo.pMappedData, 0, bufferSize);\n"
+        "        if (size > 0) memcpy(stagingAllocInfo.pMappedData, data, size);\n"
+        "        createBuffer(physicalDevice, device, allocator,\n"
+        "            bufferSize,\n"
+        "            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,\n"
+        "            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,\n"
+        "            0,\n"
+        "            buffer, alloc, nullptr);\n"
+        "        copyBuffer(device, graphicsQueue, commandPool, stagingBuffer, buffer, bufferSize);\n"
+        "        vmaDestroyBuffer(allocator, stagingBuffer, stagingAlloc);\n"
+        "    }};\n"
+        "    {}_upload({}_view.meshlets.data(), {}_view.meshlets.size_bytes(),\n"
+        "        {}_meshletBuffer, {}_meshletAlloc);\n"
+        "    {}_upload({}_view.vertices.data(), {}_view.vertices.size_bytes(),\n"
+        "        {}_vertexBuffer, {}_vertexAlloc);\n"
+        "    {}_upload({}_view.triangles.data(), {}_view.triangles.size_bytes(),\n"
+        "        {}_triangleBuffer, {}_triangleAlloc);\n",
+        geometryIndex,
+        name, modelPathToVarName(modelFilePath), geometryIndex,
+        name, name,
+        name,
+        name, name, name,
+        name, name,
+        name, name, name,
+        name, name,
+        name, name, name,
+        name, name
+    );
+
+    print(out, "}}\n\n");
+}
+
+void MeshletData::generateDestroy(const Store& store, std::ostream& out) const {
+    if (name.empty()) return;
+
+    print(out, "   // Destroy MeshletData: {}\n", name);
+    for (const char* buffer : {"triangle", "vertex", "meshlet"}) {
+        print(out,
+            "   if ({0}_{1}Buffer != VK_NULL_HANDLE) {{\n"
+            "       vmaDestroyBuffer(allocator, {0}_{1}Buffer, {0}_{1}Alloc);\n"
+            "       {0}_{1}Buffer = VK_NULL_HANDLE;\n"
+            "       {0}_{1}Alloc = VK_NULL_HANDLE;\n"
+            "   }}\n",
+            name, buffer
+        );
+    }
+    print(out, "\n");
+}
+
+} // namespace primitives
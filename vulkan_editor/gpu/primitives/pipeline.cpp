@@ -62,6 +62,46 @@ std::filesystem::path Shader::getSpirvPath() const {
 // Pipeline
 // ============================================================================
 
+namespace {
+
+bool sameAttributes(
+    const std::vector<VkVertexInputAttributeDescription>& a,
+    const std::vector<VkVertexInputAttributeDescription>& b
+) {
+    return std::ranges::equal(a, b, [](const auto& x, const auto& y) {
+        return x.location == y.location && x.binding == y.binding &&
+               x.format == y.format && x.offset == y.offset;
+    });
+}
+
+/// The pipeline's vertex input state comes from the first VertexData of the
+/// array, but each element binds its own streams when drawn. Returns an
+/// error message if an element would not match that state.
+std::string checkVertexLayouts(const Store& store, const Array& vertexArray) {
+    const VertexData& first = store.vertexDatas[vertexArray.handles[0]];
+    for (size_t i = 1; i < vertexArray.handles.size(); ++i) {
+        const VertexData& vd = store.vertexDatas[vertexArray.handles[i]];
+        if (vd.isInstanced() != first.isInstanced()) {
+            return std::format(
+                "geometry {} is {}instanced but geometry 0 is {}instanced; use the "
+                "same 'Preserve mesh instancing' setting for every model drawn by "
+                "one pipeline",
+                i, vd.isInstanced() ? "" : "not ", first.isInstanced() ? "" : "not "
+            );
+        }
+        if (vd.bindingDescription.stride != first.bindingDescription.stride ||
+            !sameAttributes(vd.attributeDescriptions, first.attributeDescriptions)) {
+            return std::format(
+                "geometry {} has a different vertex layout than geometry 0; every "
+                "model drawn by one pipeline needs the same vertex format", i
+            );
+        }
+    }
+    return {};
+}
+
+}  // namespace
+
 bool Pipeline::create(
     const Store& store,
     VkDevice device,
@@ -102,7 +142,7 @@ bool Pipeline::create(
         );
     }
 
-    VkVertexInputBindingDescription bindingDescription{};
+    std::vector<VkVertexInputBindingDescription> bindingDescriptions;
     std::vector<VkVertexInputAttributeDescription>
         attributeDescriptions;
 
@@ -111,6 +151,7 @@ bool Pipeline::create(
             VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO
     };
 
+    pushesDequantization = false;
     if (vertexDataHandle.isValid()) {
         if (vertexDataHandle.type != Type::Array) {
             Log::error("Pipeline", "Vertex data is not an array");
@@ -127,15 +168,25 @@ bool Pipeline::create(
             return false;
         }
 
+        if (std::string error = checkVertexLayouts(store, vertexArray); !error.empty()) {
+            Log::error("Pipeline", "Pipeline '{}': {}", name, error);
+            return false;
+        }
+
         const VertexData& vertexData =
             store.vertexDatas[vertexArray.handles[0]];
 
-        bindingDescription = vertexData.bindingDescription;
+        bindingDescriptions.push_back(vertexData.bindingDescription);
+        if (vertexData.isInstanced()) {
+            bindingDescriptions.push_back(vertexData.instanceBindingDescription);
+        }
         attributeDescriptions = vertexData.attributeDescriptions;
+        pushesDequantization = vertexData.hasQuantizedPositions();
 
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
+        vertexInputInfo.vertexBindingDescriptionCount =
+            static_cast<uint32_t>(bindingDescriptions.size());
         vertexInputInfo.pVertexBindingDescriptions =
-            &bindingDescription;
+            bindingDescriptions.data();
         vertexInputInfo.vertexAttributeDescriptionCount =
             static_cast<uint32_t>(attributeDescriptions.size());
         vertexInputInfo.pVertexAttributeDescriptions =
@@ -267,12 +318,19 @@ bool Pipeline::create(
     }
     allSets.clear();
 
+    // Quantized vertex positions are restored from a vertex-stage push constant
+    VkPushConstantRange dequantizationRange{
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        .offset = 0,
+        .size = sizeof(PositionDequantization)
+    };
+
     VkPipelineLayoutCreateInfo layoutInfo{
         .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
         .setLayoutCount = static_cast<uint32_t>(dsLayouts.size()),
         .pSetLayouts = dsLayouts.empty() ? nullptr : dsLayouts.data(),
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr
+        .pushConstantRangeCount = pushesDequantization ? 1u : 0u,
+        .pPushConstantRanges = pushesDequantization ? &dequantizationRange : nullptr
     };
 
     vkchk(vkCreatePipelineLayout(
@@ -315,6 +373,48 @@ void Pipeline::destroy(
     perObjectDescriptorSets.clear();
 }
 
+/// Whether the pipeline's vertex data uses PackedQuantized vertices, whose
+/// positions need the PositionDequantization push constant. All geometry of
+/// one vertex data array shares a format, so the first element decides.
+static bool usesQuantizedPositions(const Store& store, StoreHandle vertexDataHandle) {
+    if (!vertexDataHandle.isValid() || vertexDataHandle.type != Type::Array) {
+        return false;
+    }
+    const Array& arr = store.arrays[vertexDataHandle.handle];
+    if (arr.type != Type::VertexData || arr.handles.empty()) {
+        return false;
+    }
+    return store.vertexDatas[arr.handles[0]].hasQuantizedPositions();
+}
+
+/// Camera UBO bound through any of the given descriptor sets, or nullptr.
+/// Geometry LODs are picked from this camera.
+static const UniformBuffer* findCameraUbo(
+    const Store& store,
+    const std::vector<StoreHandle>& descriptorSetHandles
+) {
+    for (const auto& dsHandle : descriptorSetHandles) {
+        if (!dsHandle.isValid()) continue;
+        for (const auto& binding : store.descriptorSets[dsHandle.handle].getBindings()) {
+            if (!binding.isValid()) continue;
+            const Array& arr = store.arrays[binding.handle];
+            if (arr.handles.empty()) continue;
+            if (arr.type == Type::Camera) {
+                const Camera& cam = store.cameras[arr.handles[0]];
+                if (cam.ubo.isValid()) {
+                    return &store.uniformBuffers[cam.ubo.handle];
+                }
+            } else if (arr.type == Type::UniformBuffer) {
+                const UniformBuffer& ubo = store.uniformBuffers[arr.handles[0]];
+                if (ubo.dataType == UniformDataType::Camera) {
+                    return &ubo;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
 void Pipeline::recordCommands(
     const Store& store,
     VkCommandBuffer cmdBuffer
@@ -420,25 +520,55 @@ void Pipeline::recordCommands(
             return store.vertexDatas[handle];
         });
 
-    auto drawVertices = [cmdBuffer](const auto& vdata) {
+    // LODs are picked per geometry from the camera's current matrices
+    const UniformBuffer* cameraUbo = findCameraUbo(store, descriptorSetHandles);
+    const CameraData* lodCamera =
+        cameraUbo && cameraUbo->data.size() == sizeof(CameraData)
+            ? reinterpret_cast<const CameraData*>(cameraUbo->data.data())
+            : nullptr;
+    const float viewportHeight = static_cast<float>(rp.renderArea.extent.height);
+
+    auto drawVertices = [this, cmdBuffer, lodCamera, viewportHeight](const auto& vdata) {
         if (vdata.vertexBuffer == VK_NULL_HANDLE) {
             Log::warning("Pipeline", "Skipping draw: vertex buffer is null");
             return;
         }
 
-        VkBuffer vertexBuffers[] = {vdata.vertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(cmdBuffer, 0, 1, vertexBuffers, offsets);
+        VkBuffer vertexBuffers[] = {vdata.vertexBuffer, vdata.instanceBuffer};
+        VkDeviceSize offsets[] = {0, 0};
+        uint32_t bindingCount =
+            vdata.instanceBuffer != VK_NULL_HANDLE ? 2 : 1;
+        vkCmdBindVertexBuffers(
+            cmdBuffer, 0, bindingCount, vertexBuffers, offsets
+        );
+        if (pushesDequantization) {
+            vkCmdPushConstants(
+                cmdBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                sizeof(PositionDequantization), &vdata.dequantization
+            );
+        }
 
         if (vdata.indexBuffer == VK_NULL_HANDLE) {
-            vkCmdDraw(cmdBuffer, vdata.vertexCount, 1, 0, 0);
+            vkCmdDraw(cmdBuffer, vdata.vertexCount, vdata.instanceCount, 0, 0);
             return;
         }
 
         vkCmdBindIndexBuffer(
-            cmdBuffer, vdata.indexBuffer, 0, VK_INDEX_TYPE_UINT32
+            cmdBuffer, vdata.indexBuffer, 0, vdata.indexType
+        );
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = vdata.indexCount;
+        if (vdata.hasLods() && lodCamera) {
+            const GeometryLod& lod = vdata.lods[selectLod(
+                vdata.lods, vdata.boundsMin, vdata.boundsMax,
+                lodCamera->view, lodCamera->proj, viewportHeight
+            )];
+            firstIndex = lod.firstIndex;
+            indexCount = lod.indexCount;
+        }
+        vkCmdDrawIndexed(
+            cmdBuffer, indexCount, vdata.instanceCount, firstIndex, 0, 0
         );
-        vkCmdDrawIndexed(cmdBuffer, vdata.indexCount, 1, 0, 0, 0);
     };
 
     if (perObjectDescriptorSets.empty()) {
@@ -1007,14 +1137,31 @@ void Pipeline::generateCreate(const Store& store, std::ostream& out) const {
         if (vertexDataHandle.type == Type::Array) {
             const auto& arr = store.arrays[vertexDataHandle.handle];
             if (!arr.handles.empty() && arr.type == Type::VertexData) {
+                // create() rejects these too; fail the generated build the same way
+                if (std::string error = checkVertexLayouts(store, arr); !error.empty()) {
+                    Log::error("Pipeline", "Pipeline '{}': {}", name, error);
+                    print(out, "#error \"Pipeline {}: {}\"\n", name, error);
+                }
+
                 const auto& vd = store.vertexDatas[arr.handles[0]];
                 if (!vd.name.empty()) vdName = vd.name;
 
-                print(out, "    VkVertexInputBindingDescription {}_bindingDesc{{\n", name);
-                print(out, "        .binding = {},\n", vd.bindingDescription.binding);
-                print(out, "        .stride = {},\n", vd.bindingDescription.stride);
-                print(out, "        .inputRate = {}\n", string_VkVertexInputRate(vd.bindingDescription.inputRate));
-                print(out, "    }};\n\n");
+                std::vector<VkVertexInputBindingDescription> bindings{vd.bindingDescription};
+                if (vd.isInstanced()) {
+                    bindings.push_back(vd.instanceBindingDescription);
+                }
+
+                print(out, "    std::vector<VkVertexInputBindingDescription> {}_bindingDescs = {{{{\n", name);
+                for (size_t j = 0; j < bindings.size(); ++j) {
+                    print(out, "        {{\n");
+                    print(out, "            .binding = {},\n", bindings[j].binding);
+                    print(out, "            .stride = {},\n", bindings[j].stride);
+                    print(out, "            .inputRate = {}\n", string_VkVertexInputRate(bindings[j].inputRate));
+                    print(out, "        }}");
+                    if (j < bindings.size() - 1) print(out, ",");
+                    print(out, "\n");
+                }
+                print(out, "    }}}};\n\n");
 
                 print(out, "    std::vector<VkVertexInputAttributeDescription> {}_attribDescs = {{{{\n", name);
                 for (size_t j = 0; j < vd.attributeDescriptions.size(); ++j) {
@@ -1034,8 +1181,8 @@ void Pipeline::generateCreate(const Store& store, std::ostream& out) const {
 
         print(out, "    VkPipelineVertexInputStateCreateInfo {}_vertexInputInfo{{\n", name);
         print(out, "        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,\n");
-        print(out, "        .vertexBindingDescriptionCount = 1,\n");
-        print(out, "        .pVertexBindingDescriptions = &{}_bindingDesc,\n", name);
+        print(out, "        .vertexBindingDescriptionCount = static_cast<uint32_t>({}_bindingDescs.size()),\n", name);
+        print(out, "        .pVertexBindingDescriptions = {}_bindingDescs.data(),\n", name);
         print(out, "        .vertexAttributeDescriptionCount = static_cast<uint32_t>({}_attribDescs.size()),\n", name);
         print(out, "        .pVertexAttributeDescriptions = {}_attribDescs.data()\n", name);
         print(out, "    }};\n\n");
@@ -1255,6 +1402,19 @@ void Pipeline::generateCreate(const Store& store, std::ostream& out) const {
         print(out, "    }};\n\n");
     }
 
+    // Quantized vertex positions are restored from a vertex-stage push constant
+    const bool dequantize = usesQuantizedPositions(store, vertexDataHandle);
+    if (dequantize) {
+        print(out,
+            "    VkPushConstantRange {0}_dequantizationRange{{\n"
+            "        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,\n"
+            "        .offset = 0,\n"
+            "        .size = sizeof(PositionDequantization)\n"
+            "    }};\n",
+            name
+        );
+    }
+
     // Pipeline layout
     print(out,
         "    // Pipeline layout\n"
@@ -1262,13 +1422,15 @@ void Pipeline::generateCreate(const Store& store, std::ostream& out) const {
         "        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,\n"
         "        .setLayoutCount = static_cast<uint32_t>({1}),\n"
         "        .pSetLayouts = {2},\n"
-        "        .pushConstantRangeCount = 0,\n"
-        "        .pPushConstantRanges = nullptr\n"
+        "        .pushConstantRangeCount = {3},\n"
+        "        .pPushConstantRanges = {4}\n"
         "    }};\n"
         "    vkchk(vkCreatePipelineLayout(device, &{0}_layoutInfo, nullptr, &{0}_layout));\n\n",
         name,
         descriptorSetHandles.empty() ? "0" : name + "_dsLayouts.size()",
-        descriptorSetHandles.empty() ? "nullptr" : name + "_dsLayouts.data()"
+        descriptorSetHandles.empty() ? "nullptr" : name + "_dsLayouts.data()",
+        dequantize ? "1" : "0",
+        dequantize ? "&" + name + "_dequantizationRange" : "nullptr"
     );
 
     // Graphics pipeline
@@ -1413,6 +1575,21 @@ void Pipeline::generateRecordCommands(const Store& store, std::ostream& out) con
         if (vertexDataHandle.type == Type::Array) {
             const auto& arr = store.arrays[vertexDataHandle.handle];
             if (!arr.handles.empty() && arr.type == Type::VertexData) {
+                // Geometry with LODs picks a level from the camera each frame
+                const UniformBuffer* cameraUbo = findCameraUbo(store, descriptorSetHandles);
+                const bool anyLods = std::ranges::any_of(arr.handles, [&](uint32_t handle) {
+                    const auto& vd = store.vertexDatas[handle];
+                    return !vd.modelFilePath.empty() && vd.hasLods();
+                });
+                if (anyLods && cameraUbo) {
+                    print(out,
+                        "        const CameraData* {0}_lodCamera = static_cast<const CameraData*>({1}_mapped);\n"
+                        "        const float {0}_lodViewportHeight = static_cast<float>({2}_renderArea.extent.height);\n\n",
+                        name, cameraUbo->name, rp.name
+                    );
+                }
+
+                const bool dequantize = usesQuantizedPositions(store, vertexDataHandle);
                 uint32_t geometryIndex = 0;
                 for (uint32_t handle : arr.handles) {
                     const auto& vd = store.vertexDatas[handle];
@@ -1430,21 +1607,49 @@ void Pipeline::generateRecordCommands(const Store& store, std::ostream& out) con
                         );
                     }
 
-                    print(out,
-                        "            VkBuffer vertexBuffers[] = {{{0}_vertexBuffer}};\n"
-                        "            VkDeviceSize offsets[] = {{0}};\n"
-                        "            vkCmdBindVertexBuffers(cmdBuffer, 0, 1, vertexBuffers, offsets);\n",
-                        vd.name
-                    );
-
-                    if (vd.indexCount > 0) {
+                    std::string instanceCount = "1";
+                    if (vd.isInstanced()) {
                         print(out,
-                            "            vkCmdBindIndexBuffer(cmdBuffer, {0}_indexBuffer, 0, VK_INDEX_TYPE_UINT32);\n"
-                            "            vkCmdDrawIndexed(cmdBuffer, {0}_indexCount, 1, 0, 0, 0);\n",
+                            "            VkBuffer vertexBuffers[] = {{{0}_vertexBuffer, {0}_instanceBuffer}};\n"
+                            "            VkDeviceSize offsets[] = {{0, 0}};\n"
+                            "            vkCmdBindVertexBuffers(cmdBuffer, 0, 2, vertexBuffers, offsets);\n",
                             vd.name
                         );
+                        instanceCount = vd.name + "_instanceCount";
+                    } else {
+                        print(out,
+                            "            VkBuffer vertexBuffers[] = {{{0}_vertexBuffer}};\n"
+                            "            VkDeviceSize offsets[] = {{0}};\n"
+                            "            vkCmdBindVertexBuffers(cmdBuffer, 0, 1, vertexBuffers, offsets);\n",
+                            vd.name
+                        );
+                    }
+
+                    if (dequantize) {
+                        print(out,
+                            "            vkCmdPushConstants(cmdBuffer, {0}_layout, VK_SHADER_STAGE_VERTEX_BIT, 0,\n"
+                            "                sizeof(PositionDequantization), &{1}_dequant);\n",
+                            name, vd.name
+                        );
+                    }
+
+                    if (vd.indexCount > 0 && anyLods && cameraUbo &&
+                        !vd.modelFilePath.empty() && vd.hasLods()) {
+                        print(out,
+                            "            const GeometryLod& {0}_lod = {0}_lods[selectLod({0}_lods, {0}_boundsMin, {0}_boundsMax,\n"
+                            "                {2}_lodCamera->view, {2}_lodCamera->proj, {2}_lodViewportHeight)];\n"
+                            "            vkCmdBindIndexBuffer(cmdBuffer, {0}_indexBuffer, 0, {0}_indexType);\n"
+                            "            vkCmdDrawIndexed(cmdBuffer, {0}_lod.indexCount, {1}, {0}_lod.firstIndex, 0, 0);\n",
+                            vd.name, instanceCount, name
+                        );
+                    } else if (vd.indexCount > 0) {
+                        print(out,
+                            "            vkCmdBindIndexBuffer(cmdBuffer, {0}_indexBuffer, 0, {0}_indexType);\n"
+                            "            vkCmdDrawIndexed(cmdBuffer, {0}_indexCount, {1}, 0, 0, 0);\n",
+                            vd.name, instanceCount
+                        );
                     } else {
-                        print(out, "            vkCmdDraw(cmdBuffer, {}_vertexCount, 1, 0, 0);\n", vd.name);
+                        print(out, "            vkCmdDraw(cmdBuffer, {}_vertexCount, {}, 0, 0);\n", vd.name, instanceCount);
                     }
                     print(out, "        }}\n");
                     geometryIndex++;
@@ -11,6 +11,8 @@ void Store::reset() {
         arrays[i] = Array{};
     for (uint32_t i = 0; i < vertexDataCount; ++i)
         vertexDatas[i] = VertexData{};
+    for (uint32_t i = 0; i < meshletDataCount; ++i)
+        meshletDatas[i] = MeshletData{};
     for (uint32_t i = 0; i < uniformBufferCount; ++i)
         uniformBuffers[i] = UniformBuffer{};
     for (uint32_t i = 0; i < cameraCount; ++i)
@@ -36,6 +38,7 @@ void Store::reset() {
 
     arrayCount = 0;
     vertexDataCount = 0;
+    meshletDataCount = 0;
     uniformBufferCount = 0;
     cameraCount = 0;
     lightCount = 0;
@@ -76,6 +79,9 @@ void Store::destroy(VkDevice device, VmaAllocator allocator) {
     for (uint32_t i = 0; i < vertexDataCount; ++i)
         vertexDatas[i].destroy(*this, device, allocator);
 
+    for (uint32_t i = 0; i < meshletDataCount; ++i)
+        meshletDatas[i].destroy(*this, device, allocator);
+
     // Descriptor pools last - they implicitly free descriptor sets
     for (uint32_t i = 0; i < descriptorPoolCount; ++i)
         descriptorPools[i].destroy(*this, device, allocator);
@@ -112,6 +118,17 @@ StoreHandle Store::newVertexData() {
     return handle;
 }
 
+StoreHandle Store::newMeshletData() {
+    assert(meshletDataCount < meshletDatas.max_size());
+    StoreHandle handle{meshletDataCount, Type::MeshletData};
+
+    MeshletData* md = new (meshletDatas.data() + handle.handle) MeshletData{};
+    md->name = std::format("meshletData_{}", handle.handle);
+
+    meshletDataCount += 1;
+    return handle;
+}
+
 StoreHandle Store::newUniformBuffer() {
     assert(uniformBufferCount < uniformBuffers.max_size());
     StoreHandle handle{uniformBufferCount, Type::UniformBuffer};
@@ -252,8 +269,8 @@ std::vector<Node*> Store::getNodes() {
     nodes.reserve(
         descriptorPoolCount + imageCount + attachmentCount +
         renderPassCount + uniformBufferCount + cameraCount +
-        lightCount + descriptorSetCount + vertexDataCount + shaderCount +
-        pipelineCount + presentCount
+        lightCount + descriptorSetCount + vertexDataCount + meshletDataCount +
+        shaderCount + pipelineCount + presentCount
     );
 
     for (auto& pool : descriptorPools | take(descriptorPoolCount))
@@ -274,6 +291,8 @@ std::vector<Node*> Store::getNodes() {
         nodes.push_back(&set);
     for (auto& vertexData : vertexDatas | take(vertexDataCount))
         nodes.push_back(&vertexData);
+    for (auto& meshletData : meshletDatas | take(meshletDataCount))
+        nodes.push_back(&meshletData);
     for (auto& shader : shaders | take(shaderCount))
         nodes.push_back(&shader);
     for (auto& pipeline : pipelines | take(pipelineCount))
@@ -291,8 +310,8 @@ std::vector<const GenerateNode*> Store::getGenerateNodes() const {
     nodes.reserve(
         descriptorPoolCount + imageCount + attachmentCount +
         renderPassCount + uniformBufferCount + cameraCount +
-        lightCount + descriptorSetCount + vertexDataCount + shaderCount +
-        pipelineCount
+        lightCount + descriptorSetCount + vertexDataCount + meshletDataCount +
+        shaderCount + pipelineCount
     );
 
     for (auto& pool : descriptorPools | take(descriptorPoolCount))
@@ -313,6 +332,8 @@ std::vector<const GenerateNode*> Store::getGenerateNodes() const {
         nodes.push_back(&set);
     for (auto& vertexData : vertexDatas | take(vertexDataCount))
         nodes.push_back(&vertexData);
+    for (auto& meshletData : meshletDatas | take(meshletDataCount))
+        nodes.push_back(&meshletData);
     for (auto& shader : shaders | take(shaderCount))
         nodes.push_back(&shader);
     for (auto& pipeline : pipelines | take(pipelineCount))
@@ -340,6 +361,12 @@ Node* Store::getNode(StoreHandle handle) {
             return nullptr;
         }
         return &vertexDatas[handle.handle];
+    case Type::MeshletData:
+        if (handle.handle >= meshletDataCount) {
+            Log::error("Store", "MeshletData handle {} out of bounds (count: {})", handle.handle, meshletDataCount);
+            return nullptr;
+        }
+        return &meshletDatas[handle.handle];
     case Type::UniformBuffer:
         if (handle.handle >= uniformBufferCount) {
             Log::error("Store", "UniformBuffer handle {} out of bounds (count: {})", handle.handle, uniformBufferCount);
@@ -470,6 +497,7 @@ void Store::validateUniqueNames() const {
 
     validateType(arrays, arrayCount, "Array");
     validateType(vertexDatas, vertexDataCount, "VertexData");
+    validateType(meshletDatas, meshletDataCount, "MeshletData");
     validateType(uniformBuffers, uniformBufferCount, "UniformBuffer");
     validateType(cameras, cameraCount, "Camera");
     validateType(lights, lightCount, "Light");
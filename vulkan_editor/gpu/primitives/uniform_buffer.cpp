@@ -381,19 +381,50 @@ void UniformBuffer::generateCreate(const Store& store, std::ostream& out) const
         }
     }
 
-    // Initialize model matrix UBOs with identity matrices
+    // Initialize model matrix UBOs with their node's world transform
     // Mode matrix UBO size is 128 bytes (2 x mat4: model + normalMatrix)
     if (size == 128) {
         print(out,
-            "\n    // Initialize model matrix UBO with identity matrices\n"
+            "\n    // Initialize model matrix UBO\n"
             "    struct ModelMatrices {{\n"
             "        alignas(16) glm::mat4 model{{1.0f}};\n"
             "        alignas(16) glm::mat4 normalMatrix{{1.0f}};\n"
             "    }};\n"
-            "    ModelMatrices {}_initData;\n"
-            "    memcpy({}_mapped, &{}_initData, sizeof(ModelMatrices));\n",
-            name, name, name
         );
+
+        // Ranges with baked transforms keep the identity defaults
+        glm::mat4 matrices[2]{glm::mat4(1.0f), glm::mat4(1.0f)};
+        if (data.size() == sizeof(matrices)) {
+            memcpy(matrices, data.data(), sizeof(matrices));
+        }
+        if (matrices[0] == glm::mat4(1.0f) && matrices[1] == glm::mat4(1.0f)) {
+            print(out, "    ModelMatrices {}_initData;\n", name);
+        } else {
+            auto flt = [](float v) -> std::string {
+                auto s = std::format("{:g}", v);
+                if (s.find('.') == std::string::npos && s.find('e') == std::string::npos)
+                    s += ".0";
+                return s + "f";
+            };
+            auto mat = [&](const glm::mat4& m) {
+                std::string s = "glm::mat4(";
+                for (int c = 0; c < 4; ++c) {
+                    for (int r = 0; r < 4; ++r) {
+                        s += flt(m[c][r]);
+                        s += (c == 3 && r == 3) ? ")" : ", ";
+                    }
+                }
+                return s;
+            };
+            print(out,
+                "    ModelMatrices {}_initData{{\n"
+                "        .model = {},\n"
+                "        .normalMatrix = {}\n"
+                "    }};\n",
+                name, mat(matrices[0]), mat(matrices[1])
+            );
+        }
+        print(out, "    memcpy({}_mapped, &{}_initData, sizeof(ModelMatrices));\n", name, name);
     }
 
     // Initialize MaterialParams UBOs with actual material data
@@ -56,6 +56,27 @@ bool VertexData::create(
             &indexAllocation, nullptr
         ));
     }
+
+    // Create per-instance buffer for instanced geometry
+    if (instanceData.data() && instanceDataSize > 0) {
+        VkBufferCreateInfo bufferInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = instanceDataSize,
+            .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                     VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        VmaAllocationCreateInfo allocInfo{
+            .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+            .priority = 1.0f
+        };
+
+        vkchk(vmaCreateBuffer(
+            vma, &bufferInfo, &allocInfo, &instanceBuffer,
+            &instanceAllocation, nullptr
+        ));
+    }
     return true;
 }
 
@@ -75,6 +96,8 @@ void VertexData::stage(
     VmaAllocation vertexStagingAllocation{VK_NULL_HANDLE};
     VkBuffer indexStagingBuffer{VK_NULL_HANDLE};
     VmaAllocation indexStagingAllocation{VK_NULL_HANDLE};
+    VkBuffer instanceStagingBuffer{VK_NULL_HANDLE};
+    VmaAllocation instanceStagingAllocation{VK_NULL_HANDLE};
 
     // Allocate command buffer
     {
@@ -166,6 +189,41 @@ void VertexData::stage(
         );
     }
 
+    // Create and fill instance staging buffer (if instanced)
+    if (instanceData.data() && instanceDataSize > 0) {
+        VmaAllocationInfo allocInfo{};
+
+        VkBufferCreateInfo bufferInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = instanceDataSize,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        VmaAllocationCreateInfo allocCreateInfo{
+            .flags =
+                VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                VMA_ALLOCATION_CREATE_MAPPED_BIT,
+            .usage = VMA_MEMORY_USAGE_AUTO
+        };
+
+        vkchk(vmaCreateBuffer(
+            allocator, &bufferInfo, &allocCreateInfo, &instanceStagingBuffer,
+            &instanceStagingAllocation, &allocInfo
+        ));
+
+        assert(allocInfo.pMappedData != nullptr);
+        memcpy(allocInfo.pMappedData, instanceData.data(), instanceDataSize);
+
+        VkBufferCopy copyRegion{
+            .srcOffset = 0, .dstOffset = 0, .size = instanceDataSize
+        };
+
+        vkCmdCopyBuffer(
+            cmdBuffer, instanceStagingBuffer, instanceBuffer, 1, &copyRegion
+        );
+    }
+
     // Single submit and wait for all transfers
     vkchk(vkEndCommandBuffer(cmdBuffer));
 
@@ -183,6 +241,9 @@ void VertexData::stage(
     if (indexStagingBuffer != VK_NULL_HANDLE) {
         vmaDestroyBuffer(allocator, indexStagingBuffer, indexStagingAllocation);
     }
+    if (instanceStagingBuffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(allocator, instanceStagingBuffer, instanceStagingAllocation);
+    }
 
     vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
 }
@@ -192,6 +253,12 @@ void VertexData::destroy(
     VkDevice device,
     VmaAllocator allocator
 ) {
+    if (instanceBuffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(allocator, instanceBuffer, instanceAllocation);
+        instanceBuffer = VK_NULL_HANDLE;
+        instanceAllocation = VK_NULL_HANDLE;
+    }
+
     if (indexBuffer != VK_NULL_HANDLE) {
         vmaDestroyBuffer(allocator, indexBuffer, indexAllocation);
         indexBuffer = VK_NULL_HANDLE;
@@ -213,24 +280,72 @@ void VertexData::generateCreate(const Store& store, std::ostream& out) const {
 
     // Check if we have a model file path for runtime loading
     if (!modelFilePath.empty()) {
-        // Extract geometry from pre-loaded model
-        print(out,
-            "    // Extract geometry {} from pre-loaded model\n"
-            "    std::vector<Vertex> {}_vertices;\n"
-            "    std::vector<uint32_t> {}_indices;\n"
-            "    loadModelGeometry({}, {}, {}_vertices, {}_indices);\n\n"
-            "    {}_vertexCount = static_cast<uint32_t>({}_vertices.size());\n"
-            "    {}_indexCount = static_cast<uint32_t>({}_indices.size());\n"
-            "    VkDeviceSize {}_vertexSize = {}_vertices.size() * sizeof(Vertex);\n"
-            "    VkDeviceSize {}_indexSize = {}_indices.size() * sizeof(uint32_t);\n\n",
-            geometryIndex,
-            name, name,
-            modelPathToVarName(modelFilePath), geometryIndex, name, name,
-            name, name,
-            name, name,
-            name, name,
-            name, name
-        );
+        if (hasLods()) {
+            // One index buffer holds the full-detail indices and every LOD
+            print(out,
+                "    // View geometry {} of the pre-loaded model with its LOD chain (no copy)\n"
+                "    std::span<const Vertex> {}_vertices = geometryVertices({}, {});\n"
+                "    IndexView {}_indices = geometryLodIndices({}, {});\n"
+                "    auto {}_lodView = geometryLods({}, {});\n"
+                "    {}_lods.assign({}_lodView.begin(), {}_lodView.end());\n"
+                "    geometryBounds({}, {}, {}_boundsMin, {}_boundsMax);\n\n"
+                "    {}_vertexCount = static_cast<uint32_t>({}_vertices.size());\n"
+                "    {}_indexCount = static_cast<uint32_t>(geometryIndices({}, {}).size());\n"
+                "    {}_indexType = {}_indices.type;\n"
+                "    VkDeviceSize {}_vertexSize = {}_vertices.size() * sizeof(Vertex);\n"
+                "    VkDeviceSize {}_indexSize = {}_indices.size_bytes();\n\n",
+                geometryIndex,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, name, name,
+                modelPathToVarName(modelFilePath), geometryIndex, name, name,
+                name, name,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, name,
+                name, name,
+                name, name
+            );
+        } else {
+            // Extract geometry from pre-loaded model
+            print(out,
+                "    // View geometry {} of the pre-loaded model (no copy; may be mapped from its mesh cache)\n"
+                "    std::span<const Vertex> {}_vertices = geometryVertices({}, {});\n"
+                "    IndexView {}_indices = geometryIndices({}, {});\n\n"
+                "    {}_vertexCount = static_cast<uint32_t>({}_vertices.size());\n"
+                "    {}_indexCount = static_cast<uint32_t>({}_indices.size());\n"
+                "    {}_indexType = {}_indices.type;\n"
+                "    VkDeviceSize {}_vertexSize = {}_vertices.size() * sizeof(Vertex);\n"
+                "    VkDeviceSize {}_indexSize = {}_indices.size_bytes();\n\n",
+                geometryIndex,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, modelPathToVarName(modelFilePath), geometryIndex,
+                name, name,
+                name, name,
+                name, name,
+                name, name,
+                name, name
+            );
+        }
+
+        // Compact layouts are packed once on load; Full uploads the view as is
+        if (vertexFormat != VertexFormat::Full) {
+            const std::string format = std::format("VertexFormat::{}", vertexFormatName(vertexFormat));
+            print(out,
+                "    // Pack vertices into the {} layout\n"
+                "    std::vector<uint8_t> {}_packedVertices({}_vertices.size() * vertexStride({}));\n"
+                "    {}_dequant = packVertices({}_vertices, {}, {}_packedVertices.data());\n"
+                "    const void* {}_vertexBytes = {}_packedVertices.data();\n"
+                "    {}_vertexSize = {}_packedVertices.size();\n\n",
+                vertexFormatName(vertexFormat),
+                name, name, format,
+                name, name, format, name,
+                name, name,
+                name, name
+            );
+        } else {
+            print(out, "    const void* {}_vertexBytes = {}_vertices.data();\n\n", name, name);
+        }
 
         // Create both staging buffers upfront
         print(out,
@@ -244,7 +359,7 @@ void VertexData::generateCreate(const Store& store, std::ostream& out) const {
             "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
             "        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
             "        {}_vertexStagingBuffer, {}_vertexStagingAlloc, &{}_vertexStagingAllocInfo);\n"
-            "    memcpy({}_vertexStagingAllocInfo.pMappedData, {}_vertices.data(), {}_vertexSize);\n\n"
+            "    memcpy({}_vertexStagingAllocInfo.pMappedData, {}_vertexBytes, {}_vertexSize);\n\n"
             "    VkBuffer {}_indexStagingBuffer;\n"
             "    VmaAllocation {}_indexStagingAlloc;\n"
             "    VmaAllocationInfo {}_indexStagingAllocInfo;\n"
@@ -254,7 +369,7 @@ void VertexData::generateCreate(const Store& store, std::ostream& out) const {
             "        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
             "        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
             "        {}_indexStagingBuffer, {}_indexStagingAlloc, &{}_indexStagingAllocInfo);\n"
-            "    memcpy({}_indexStagingAllocInfo.pMappedData, {}_indices.data(), {}_indexSize);\n\n",
+            "    memcpy({}_indexStagingAllocInfo.pMappedData, {}_indices.data, {}_indexSize);\n\n",
             name, name, name, name, name, name, name, name, name, name,
             name, name, name, name, name, name, name, name, name, name
         );
@@ -292,6 +407,53 @@ void VertexData::generateCreate(const Store& store, std::ostream& out) const {
             "    vmaDestroyBuffer(allocator, {}_indexStagingBuffer, {}_indexStagingAlloc);\n",
             name, name, name, name, name, name, name, name, name, name
         );
+
+        // Per-instance transforms for instanced geometry
+        if (isInstanced()) {
+            print(out,
+                "\n"
+                "    // Instance transforms for geometry {}\n"
+                "    std::vector<InstanceData> {}_instances;\n"
+                "    loadModelInstances({}, {}, {}_instances);\n"
+                "    {}_instanceCount = static_cast<uint32_t>({}_instances.size());\n"
+                "    VkDeviceSize {}_instanceSize = {}_instances.size() * sizeof(InstanceData);\n"
+                "    if ({}_instanceSize > 0) {{\n"
+                "        VkBuffer {}_instanceStagingBuffer;\n"
+                "        VmaAllocation {}_instanceStagingAlloc;\n"
+                "        VmaAllocationInfo {}_instanceStagingAllocInfo;\n"
+                "        createBuffer(physicalDevice, device, allocator,\n"
+                "            {}_instanceSize,\n"
+                "            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,\n"
+                "            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,\n"
+                "            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,\n"
+                "            {}_instanceStagingBuffer, {}_instanceStagingAlloc, &{}_instanceStagingAllocInfo);\n"
+                "        memcpy({}_instanceStagingAllocInfo.pMappedData, {}_instances.data(), {}_instanceSize);\n"
+                "        createBuffer(physicalDevice, device, allocator,\n"
+                "            {}_instanceSize,\n"
+                "            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,\n"
+                "            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,\n"
+                "            0,\n"
+                "            {}_instanceBuffer, {}_instanceAlloc, nullptr);\n"
+                "        copyBuffer(device, graphicsQueue, commandPool,\n"
+                "            {}_instanceStagingBuffer, {}_instanceBuffer, {}_instanceSize);\n"
+                "        vmaDestroyBuffer(allocator, {}_instanceStagingBuffer, {}_instanceStagingAlloc);\n"
+                "    }}\n",
+                geometryIndex,
+                name,
+                modelPathToVarName(modelFilePath), geometryIndex, name,
+                name, name,
+                name, name,
+                name,
+                name, name, name,
+                name,
+                name, name, name,
+                name, name, name,
+                name,
+                name, name,
+                name, name, name,
+                name, name
+            );
+        }
     } else if (!vertexDataBinPath.empty() && !indexDataBinPath.empty()) {
         // Load vertex/index data from binary files (legacy path)
         print(out,
@@ -379,6 +541,17 @@ void VertexData::generateCreate(const Store& store, std::ostream& out) const {
 void VertexData::generateDestroy(const Store& store, std::ostream& out) const {
     if (name.empty()) return;
 
+    if (isInstanced()) {
+        print(out,
+            "   if ({0}_instanceBuffer != VK_NULL_HANDLE) {{\n"
+            "       vmaDestroyBuffer(allocator, {0}_instanceBuffer, {0}_instanceAlloc);\n"
+            "       {0}_instanceBuffer = VK_NULL_HANDLE;\n"
+            "       {0}_instanceAlloc = VK_NULL_HANDLE;\n"
+            "   }}\n",
+            name
+        );
+    }
+
     print(out,
         "   // Destroy VertexData: {}\n"
         "   if ({}_indexBuffer != VK_NULL_HANDLE) {{\n"
@@ -141,6 +141,8 @@ const char* pinTypeName(PinType type) {
         return "Model Cameras";
     case PinType::ModelSource:
         return "Model Source";
+    case PinType::MeshletData:
+        return "Meshlet Data";
     default:
         return "Unknown";
     }
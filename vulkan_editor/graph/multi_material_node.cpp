@@ -3,7 +3,6 @@
 #include "vulkan_editor/util/logger.h"
 #include <imgui.h>
 #include <imgui_node_editor.h>
-#include <unordered_set>
 #include <vkDuck/model_loader.h>
 
 #include "external/utilities/builders.h"
@@ -235,15 +234,42 @@ primitives::StoreHandle MultiMaterialNode::createImagePrimitive(
     auto handle = store.newImage();
     auto& img = store.images[handle.handle];
     img.imageData = const_cast<void*>(static_cast<const void*>(image.pixels));
-    img.imageSize = image.width * image.height * 4;
+    img.imageSource = image.source;
+    img.imageSize = image.size;
+    img.imageChannels = image.channels;
+    img.previewDownscale = image.downscale;
+    img.fullExtent = {image.fullWidth, image.fullHeight, 1};
     img.extentType = ExtentType::Custom;
-    img.imageInfo.format =
-        linear ? VK_FORMAT_B8G8R8A8_UNORM : VK_FORMAT_B8G8R8A8_SRGB;
+    // The material slot decides the color space; containers rarely record it
+    img.imageInfo.format = textureFormatForColorSpace(image.format, !linear);
     img.imageInfo.extent = {image.width, image.height, 1};
     img.imageInfo.usage =
         VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
     img.viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    img.originalImagePath = image.path.generic_string();
+    img.viewInfo.components = image.swizzle;
+    img.mipGeneration = graph_ ? graph_->mipGeneration : MipGeneration::Gpu;
+    if (image.channels != TextureChannels::Bgra && img.mipGeneration == MipGeneration::Cpu) {
+        // The CPU filter works on 4-byte texels; R8G8/R8 blit fine
+        img.mipGeneration = MipGeneration::Gpu;
+    }
+    if (image.mipLevels > 1 || isBlockCompressed(image.format)) {
+        // KTX2/DDS levels are uploaded as stored, never regenerated
+        img.mipGeneration = MipGeneration::None;
+        img.imageDataLevels = image.mipLevels;
+        img.imageInfo.mipLevels = image.mipLevels;
+        img.viewInfo.subresourceRange.levelCount = image.mipLevels;
+    }
+    if (img.mipGeneration != MipGeneration::None) {
+        img.imageInfo.mipLevels = mipLevelCount(image.width, image.height);
+        img.viewInfo.subresourceRange.levelCount = img.imageInfo.mipLevels;
+    }
+    if (img.mipGeneration == MipGeneration::Gpu) {
+        // Each level is blitted from the previous one
+        img.imageInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    // Generated code loads the cooked .dds instead of decoding the source
+    img.originalImagePath =
+        (image.cookedPath.empty() ? image.path : image.cookedPath).generic_string();
     return handle;
 }
 
@@ -261,7 +287,7 @@ void MultiMaterialNode::createPrimitives(primitives::Store& store) {
 
     const auto& ranges = source->getConsolidatedRanges();
     const auto& mergedMaterials = source->getMergedMaterials();
-    const auto& mergedImages = source->getMergedImages();
+    const auto& mergedTextures = source->getMergedTextures();
     const size_t numRanges = ranges.size();
 
     if (numRanges == 0) {
@@ -279,23 +305,32 @@ void MultiMaterialNode::createPrimitives(primitives::Store& store) {
     defaultBlack_ = createDefaultTexture(store, defaultBlackPixels_, 0, 0, 0,
                                          255, false);
 
-    // Identify which images are used for linear data
-    std::unordered_set<int> linearTextureIndices;
-    for (const auto& mat : mergedMaterials) {
-        if (mat.normalTextureIndex >= 0)
-            linearTextureIndices.insert(mat.normalTextureIndex);
-        if (mat.metallicRoughnessTextureIndex >= 0)
-            linearTextureIndices.insert(mat.metallicRoughnessTextureIndex);
-    }
-
-    // Build image primitives for all merged images
-    std::vector<primitives::StoreHandle> imageHandles(mergedImages.size());
-    for (size_t i = 0; i < mergedImages.size(); ++i) {
-        if (mergedImages[i] && mergedImages[i]->pixels &&
-            mergedImages[i]->toLoad) {
-            bool isLinear = linearTextureIndices.count(static_cast<int>(i)) > 0;
-            imageHandles[i] =
-                createImagePrimitive(store, *mergedImages[i], isLinear);
+    // Normal maps and material data are linear; the model manager cooks
+    // textures by the same classification
+    const std::vector<TextureRole> textureRoles =
+        classifyTextureRoles(mergedMaterials, mergedTextures.size());
+
+    // Build image primitives for all merged textures. Models sharing a
+    // texture, and other material nodes, share its image
+    std::vector<primitives::StoreHandle> imageHandles(mergedTextures.size());
+    size_t sharedImages = 0;
+    if (g_modelManager) {
+        TextureManager& textures = g_modelManager->getTextureManager();
+        for (size_t i = 0; i < mergedTextures.size(); ++i) {
+            const EditorImage* image = textures.get(mergedTextures[i]);
+            if (!image || !image->loaded()) {
+                continue;
+            }
+            bool isLinear = textureRoles[i] != TextureRole::Color;
+            imageHandles[i] = textures.findImagePrimitive(
+                store, mergedTextures[i],
+                textureFormatForColorSpace(image->format, !isLinear));
+            if (imageHandles[i].isValid()) {
+                ++sharedImages;
+                continue;
+            }
+            imageHandles[i] = createImagePrimitive(store, *image, isLinear);
+            textures.setImagePrimitive(store, mergedTextures[i], imageHandles[i]);
         }
     }
 
@@ -387,8 +422,9 @@ void MultiMaterialNode::createPrimitives(primitives::Store& store) {
     }
 
     Log::info(LOG_CATEGORY,
-              "Created material arrays for {} geometry ranges from source",
-              numRanges);
+              "Created material arrays for {} geometry ranges from source "
+              "({} textures reuse a shared image)",
+              numRanges, sharedImages);
 }
 
 void MultiMaterialNode::getOutputPrimitives(
@@ -1,6 +1,7 @@
 #include "multi_model_source_node.h"
 #include "node_graph.h"
 #include "vulkan_editor/util/logger.h"
+#include <algorithm>
 #include <cstring>
 #include <imgui.h>
 #include <imgui_node_editor.h>
@@ -27,11 +28,13 @@ MultiModelSourceNode::MultiModelSourceNode(int id)
 }
 
 MultiModelSourceNode::~MultiModelSourceNode() {
-    // Release references to all cached models
+    // Release references to all cached models, and stop loading the ones
+    // nothing else uses
     if (g_modelManager) {
         for (auto& entry : models_) {
             if (entry.handle.isValid()) {
                 g_modelManager->removeReference(entry.handle);
+                g_modelManager->cancelLoad(entry.handle);
             }
         }
     }
@@ -54,8 +57,12 @@ void MultiModelSourceNode::registerPins(PinRegistry& registry) {
     usesRegistry_ = true;
 }
 
-void MultiModelSourceNode::addModel(ModelHandle handle) {
-    if (!g_modelManager || !g_modelManager->isLoaded(handle)) {
+void MultiModelSourceNode::addModel(ModelHandle handle, std::vector<int32_t> nodeSelection) {
+    // Models still loading in the background are added too; the reload
+    // callback rebuilds the node once they are loaded
+    const ModelStatus status =
+        g_modelManager ? g_modelManager->getStatus(handle) : ModelStatus::NotLoaded;
+    if (status != ModelStatus::Loaded && status != ModelStatus::Loading) {
         Log::warning(LOG_CATEGORY, "Cannot add model: handle not loaded");
         return;
     }
@@ -75,15 +82,21 @@ void MultiModelSourceNode::addModel(ModelHandle handle) {
     ModelEntry entry;
     entry.handle = handle;
     entry.enabled = true;
+    entry.nodeSelection = std::move(nodeSelection);
+
+    // Models follow the load options of the source they are added to
+    ModelLoadOptions options = loadOptions_;
+    options.nodeSelection = entry.nodeSelection;
+    g_modelManager->setLoadOptions(handle, options);
 
     // Copy path for serialization
-    const CachedModel* cached = g_modelManager->getModel(handle);
-    if (cached) {
-        std::strncpy(entry.path, cached->path.string().c_str(),
-                     sizeof(entry.path) - 1);
-        entry.path[sizeof(entry.path) - 1] = '\0';
-        Log::info(LOG_CATEGORY, "Added model '{}'", cached->displayName);
-    }
+    const std::filesystem::path path = g_modelManager->getPath(handle);
+    std::strncpy(entry.path, path.string().c_str(), sizeof(entry.path) - 1);
+    entry.path[sizeof(entry.path) - 1] = '\0';
+    Log::info(
+        LOG_CATEGORY, "Added model '{}'{}", path.stem().string(),
+        status == ModelStatus::Loading ? " (loading)" : ""
+    );
 
     models_.push_back(entry);
 
@@ -97,9 +110,10 @@ void MultiModelSourceNode::removeModel(size_t index) {
         return;
     }
 
-    // Release reference
+    // Release reference, and stop loading the model if nothing else uses it
     if (g_modelManager && models_[index].handle.isValid()) {
         g_modelManager->removeReference(models_[index].handle);
+        g_modelManager->cancelLoad(models_[index].handle);
     }
 
     models_.erase(models_.begin() + static_cast<ptrdiff_t>(index));
@@ -138,6 +152,64 @@ void MultiModelSourceNode::reorderModel(size_t fromIndex, size_t toIndex) {
     rebuildConsolidatedData();
 }
 
+void MultiModelSourceNode::setModelNodeSelection(size_t index, std::vector<int32_t> nodeSelection) {
+    if (index >= models_.size()) {
+        return;
+    }
+
+    std::sort(nodeSelection.begin(), nodeSelection.end());
+    nodeSelection.erase(std::unique(nodeSelection.begin(), nodeSelection.end()), nodeSelection.end());
+    ModelEntry& entry = models_[index];
+    if (entry.nodeSelection == nodeSelection) {
+        return;
+    }
+
+    entry.nodeSelection = std::move(nodeSelection);
+    Log::info(LOG_CATEGORY, "Node selection of '{}' set to {} nodes", entry.path,
+              entry.nodeSelection.size());
+
+    // Reloads like a load option change
+    if (g_modelManager && entry.handle.isValid()) {
+        g_modelManager->setLoadOptions(entry.handle, getModelLoadOptions(index));
+    }
+}
+
+void MultiModelSourceNode::setLoadOptions(const ModelLoadOptions& options) {
+    if (loadOptions_ == options) {
+        return;
+    }
+
+    loadOptions_ = options;
+
+    // Changed options queue a reload; the editor's reload callback then
+    // rebuilds this node once the new data is in place
+    if (g_modelManager) {
+        for (size_t i = 0; i < models_.size(); ++i) {
+            if (models_[i].handle.isValid()) {
+                g_modelManager->setLoadOptions(models_[i].handle, getModelLoadOptions(i));
+            }
+        }
+    }
+}
+
+ModelLoadOptions MultiModelSourceNode::getModelLoadOptions(size_t index) const {
+    ModelLoadOptions options = loadOptions_;
+    if (index < models_.size()) {
+        options.nodeSelection = models_[index].nodeSelection;
+    }
+    return options;
+}
+
+void MultiModelSourceNode::setVertexFormat(VertexFormat format) {
+    if (vertexFormat_ == format) {
+        return;
+    }
+
+    vertexFormat_ = format;
+    Log::info(LOG_CATEGORY, "Vertex format set to {}", vertexFormatName(format));
+    needsRebuild_ = true;
+}
+
 bool MultiModelSourceNode::hasModels() const {
     for (const auto& entry : models_) {
         if (entry.handle.isValid() && entry.enabled &&
@@ -152,10 +224,17 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
     // Clear all consolidated data
     consolidatedVertices_.clear();
     consolidatedIndices_.clear();
+    consolidatedIndices16_.clear();
     consolidatedRanges_.clear();
+    consolidatedInstances_.clear();
+    consolidatedLods_.clear();
+    consolidatedMeshlets_.clear();
+    consolidatedMeshletVertices_.clear();
+    consolidatedMeshletTriangles_.clear();
+    consolidatedNodes_.clear();
     rangeInfo_.clear();
     mergedMaterials_.clear();
-    mergedImages_.clear();
+    mergedTextures_.clear();
     mergedCameras_.clear();
     mergedLights_.clear();
     textureIndexRemap_.clear();
@@ -166,6 +245,13 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
 
     uint32_t currentVertexOffset = 0;
     uint32_t currentIndexOffset = 0;
+    uint32_t currentIndex16Offset = 0;
+    uint32_t currentInstanceOffset = 0;
+    uint32_t currentLodOffset = 0;
+    uint32_t currentMeshletOffset = 0;
+    uint32_t currentMeshletVertexOffset = 0;
+    uint32_t currentMeshletTriangleOffset = 0;
+    int32_t currentNodeOffset = 0;
     int currentMaterialOffset = 0;
     int currentImageOffset = 0;
 
@@ -194,11 +280,10 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
 
         // Build texture index remap for this model
         std::unordered_map<int, int> texRemap;
-        for (size_t i = 0; i < cached->images.size(); ++i) {
+        for (size_t i = 0; i < cached->textures.size(); ++i) {
             texRemap[static_cast<int>(i)] =
                 currentImageOffset + static_cast<int>(i);
-            mergedImages_.push_back(
-                const_cast<EditorImage*>(&cached->images[i]));
+            mergedTextures_.push_back(cached->textures[i]);
         }
         textureIndexRemap_.push_back(texRemap);
 
@@ -230,21 +315,70 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
         consolidatedIndices_.insert(consolidatedIndices_.end(),
                                     modelData.indices.begin(),
                                     modelData.indices.end());
+        consolidatedIndices16_.insert(consolidatedIndices16_.end(),
+                                      modelData.indices16.begin(),
+                                      modelData.indices16.end());
+
+        // Append instance transforms (empty for non-instanced models)
+        consolidatedInstances_.insert(consolidatedInstances_.end(),
+                                      modelData.instances.begin(),
+                                      modelData.instances.end());
+
+        // Append LOD chains (relative to their range, so copied as-is)
+        consolidatedLods_.insert(consolidatedLods_.end(),
+                                 modelData.lods.begin(),
+                                 modelData.lods.end());
+
+        // Append meshlets (relative to their range's lists, so copied as-is)
+        consolidatedMeshlets_.insert(consolidatedMeshlets_.end(),
+                                     modelData.meshlets.begin(),
+                                     modelData.meshlets.end());
+        consolidatedMeshletVertices_.insert(consolidatedMeshletVertices_.end(),
+                                            modelData.meshletVertices.begin(),
+                                            modelData.meshletVertices.end());
+        consolidatedMeshletTriangles_.insert(consolidatedMeshletTriangles_.end(),
+                                             modelData.meshletTriangles.begin(),
+                                             modelData.meshletTriangles.end());
+
+        // Append scene nodes with their parents rebased
+        for (const auto& sceneNode : modelData.nodes) {
+            SceneNode& node = consolidatedNodes_.emplace_back(sceneNode);
+            if (node.parent >= 0) {
+                node.parent += currentNodeOffset;
+            }
+        }
 
         // Create consolidated ranges with material index offset
         for (size_t ri = 0; ri < modelData.ranges.size(); ++ri) {
             const auto& srcRange = modelData.ranges[ri];
 
+            const uint32_t indexOffset = srcRange.indexType == VK_INDEX_TYPE_UINT16
+                ? currentIndex16Offset : currentIndexOffset;
+
             EditorGeometryRange newRange;
             newRange.firstVertex = srcRange.firstVertex + currentVertexOffset;
             newRange.vertexCount = srcRange.vertexCount;
-            newRange.firstIndex = srcRange.firstIndex + currentIndexOffset;
+            newRange.firstIndex = srcRange.firstIndex + indexOffset;
+            newRange.indexType = srcRange.indexType;
             newRange.indexCount = srcRange.indexCount;
             newRange.materialIndex =
                 (srcRange.materialIndex >= 0)
                     ? srcRange.materialIndex + currentMaterialOffset
                     : -1;
             newRange.topology = srcRange.topology;
+            newRange.firstInstance = srcRange.firstInstance + currentInstanceOffset;
+            newRange.instanceCount = srcRange.instanceCount;
+            newRange.firstLod = srcRange.firstLod + currentLodOffset;
+            newRange.lodCount = srcRange.lodCount;
+            newRange.firstMeshlet = srcRange.firstMeshlet + currentMeshletOffset;
+            newRange.meshletCount = srcRange.meshletCount;
+            newRange.firstMeshletVertex =
+                srcRange.firstMeshletVertex + currentMeshletVertexOffset;
+            newRange.firstMeshletTriangle =
+                srcRange.firstMeshletTriangle + currentMeshletTriangleOffset;
+            newRange.boundsMin = srcRange.boundsMin;
+            newRange.boundsMax = srcRange.boundsMax;
+            newRange.node = srcRange.node >= 0 ? srcRange.node + currentNodeOffset : -1;
 
             consolidatedRanges_.push_back(newRange);
 
@@ -253,7 +387,7 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
             info.modelIndex = mi;
             info.originalRangeIndex = ri;
             info.vertexOffset = currentVertexOffset;
-            info.indexOffset = currentIndexOffset;
+            info.indexOffset = indexOffset;
             rangeInfo_.push_back(info);
         }
 
@@ -267,19 +401,53 @@ void MultiModelSourceNode::rebuildConsolidatedData() {
         currentVertexOffset +=
             static_cast<uint32_t>(modelData.vertices.size());
         currentIndexOffset += static_cast<uint32_t>(modelData.indices.size());
+        currentIndex16Offset += static_cast<uint32_t>(modelData.indices16.size());
+        currentInstanceOffset +=
+            static_cast<uint32_t>(modelData.instances.size());
+        currentLodOffset += static_cast<uint32_t>(modelData.lods.size());
+        currentMeshletOffset += static_cast<uint32_t>(modelData.meshlets.size());
+        currentMeshletVertexOffset +=
+            static_cast<uint32_t>(modelData.meshletVertices.size());
+        currentMeshletTriangleOffset +=
+            static_cast<uint32_t>(modelData.meshletTriangles.size());
+        currentNodeOffset += static_cast<int32_t>(modelData.nodes.size());
         currentMaterialOffset += static_cast<int>(cached->materials.size());
-        currentImageOffset += static_cast<int>(cached->images.size());
+        currentImageOffset += static_cast<int>(cached->textures.size());
     }
 
     Log::info(LOG_CATEGORY,
-              "Consolidated {} models: {} vertices, {} indices, {} ranges",
+              "Consolidated {} models: {} vertices, {} indices ({} 16-bit), {} ranges, {} instances",
               models_.size(), consolidatedVertices_.size(),
-              consolidatedIndices_.size(), consolidatedRanges_.size());
+              consolidatedIndices_.size() + consolidatedIndices16_.size(),
+              consolidatedIndices16_.size(), consolidatedRanges_.size(),
+              consolidatedInstances_.size());
 
     // Flag that editor should rebuild primitives to update connections
     needsRebuild_ = true;
 }
 
+bool MultiModelSourceNode::setNodeLocalTransform(
+    size_t nodeIndex,
+    const glm::mat4& localTransform
+) {
+    if (nodeIndex >= consolidatedNodes_.size()) {
+        Log::warning(LOG_CATEGORY, "Node index {} out of range ({} nodes)",
+                     nodeIndex, consolidatedNodes_.size());
+        return false;
+    }
+
+    consolidatedNodes_[nodeIndex].localTransform = localTransform;
+
+    // Children follow their parents, so one pass from the node on suffices
+    for (size_t i = nodeIndex; i < consolidatedNodes_.size(); ++i) {
+        SceneNode& node = consolidatedNodes_[i];
+        node.worldTransform = node.parent >= 0
+            ? consolidatedNodes_[node.parent].worldTransform * node.localTransform
+            : node.localTransform;
+    }
+    return true;
+}
+
 nlohmann::json MultiModelSourceNode::toJson() const {
     nlohmann::json j;
     j["type"] = "multi_model_source";
@@ -298,10 +466,26 @@ nlohmann::json MultiModelSourceNode::toJson() const {
     // Serialize all models
     j["models"] = nlohmann::json::array();
     for (const auto& entry : models_) {
-        j["models"].push_back(
-            {{"path", entry.path}, {"enabled", entry.enabled}});
+        nlohmann::json model = {{"path", entry.path}, {"enabled", entry.enabled}};
+        if (!entry.nodeSelection.empty()) {
+            model["nodeSelection"] = entry.nodeSelection;
+        }
+        j["models"].push_back(std::move(model));
     }
 
+    j["loadOptions"] = {
+        {"preserveInstancing", loadOptions_.preserveInstancing},
+        {"optimizeMeshes", loadOptions_.optimizeMeshes},
+        {"lodLevels", loadOptions_.lodLevels},
+        {"lodTriangleRatio", loadOptions_.lodTriangleRatio},
+        {"lodTargetError", loadOptions_.lodTargetError},
+        {"buildMeshlets", loadOptions_.buildMeshlets},
+        {"preserveHierarchy", loadOptions_.preserveHierarchy},
+        {"cookTextures", loadOptions_.cookTextures},
+        {"packTextureChannels", loadOptions_.packTextureChannels}
+    };
+    j["vertexFormat"] = static_cast<uint32_t>(vertexFormat_);
+
     return j;
 }
 
@@ -321,6 +505,23 @@ void MultiModelSourceNode::fromJson(const nlohmann::json& j) {
         }
     }
 
+    if (j.contains("loadOptions") && j["loadOptions"].is_object()) {
+        const auto& opts = j["loadOptions"];
+        loadOptions_.preserveInstancing = opts.value("preserveInstancing", false);
+        loadOptions_.optimizeMeshes = opts.value("optimizeMeshes", false);
+        loadOptions_.lodLevels = opts.value("lodLevels", 0u);
+        loadOptions_.lodTriangleRatio = opts.value("lodTriangleRatio", 0.5f);
+        loadOptions_.lodTargetError = opts.value("lodTargetError", 0.01f);
+        loadOptions_.buildMeshlets = opts.value("buildMeshlets", false);
+        loadOptions_.preserveHierarchy = opts.value("preserveHierarchy", false);
+        loadOptions_.cookTextures = opts.value("cookTextures", false);
+        loadOptions_.packTextureChannels = opts.value("packTextureChannels", true);
+    }
+    vertexFormat_ = static_cast<VertexFormat>(std::min(
+        j.value("vertexFormat", 0u),
+        static_cast<uint32_t>(VertexFormat::PackedQuantized)
+    ));
+
     // Note: models are loaded by the graph serializer after fromJson()
     // We just store the paths here for reference
     if (j.contains("models") && j["models"].is_array()) {
@@ -328,6 +529,7 @@ void MultiModelSourceNode::fromJson(const nlohmann::json& j) {
             ModelEntry entry;
             entry.handle = {}; // Will be set by graph serializer
             entry.enabled = modelJson.value("enabled", true);
+            entry.nodeSelection = modelJson.value("nodeSelection", std::vector<int32_t>{});
 
             std::string path = modelJson.value("path", "");
             std::strncpy(entry.path, path.c_str(), sizeof(entry.path) - 1);
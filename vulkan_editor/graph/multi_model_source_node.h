@@ -9,6 +9,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <vkDuck/vertex_formats.h>
 
 using namespace ShaderTypes;
 
@@ -24,6 +25,7 @@ struct ModelEntry {
     ModelHandle handle;
     char path[256]{};
     bool enabled{true};
+    std::vector<int32_t> nodeSelection;  ///< glTF nodes to load, empty = whole scene (ModelLoadOptions::nodeSelection)
 };
 
 /**
@@ -34,7 +36,7 @@ struct ConsolidatedRangeInfo {
     size_t modelIndex;         // Which model in models_ array
     size_t originalRangeIndex; // Index in original model's ranges
     uint32_t vertexOffset;     // Offset into consolidated vertex buffer
-    uint32_t indexOffset;      // Offset into consolidated index buffer
+    uint32_t indexOffset;      // Offset into the consolidated index array of the range's type
 };
 
 /**
@@ -57,18 +59,34 @@ public:
     explicit MultiModelSourceNode(int id);
     ~MultiModelSourceNode() override;
 
-    // Model management
-    void addModel(ModelHandle handle);
+    // Model management. Models may still be loading in the background.
+    void addModel(ModelHandle handle, std::vector<int32_t> nodeSelection = {});
     void removeModel(size_t index);
     void setModelEnabled(size_t index, bool enabled);
     void reorderModel(size_t fromIndex, size_t toIndex);
 
+    // Load only the given glTF node subtrees of a model (empty = whole scene);
+    // queues a reload of that model
+    void setModelNodeSelection(size_t index, std::vector<int32_t> nodeSelection);
+
     size_t getModelCount() const { return models_.size(); }
     const ModelEntry& getModel(size_t index) const { return models_[index]; }
     ModelEntry& getModel(size_t index) { return models_[index]; }
     const std::vector<ModelEntry>& getModels() const { return models_; }
     bool hasModels() const;
 
+    // Load options applied to every model of this source
+    const ModelLoadOptions& getLoadOptions() const { return loadOptions_; }
+    void setLoadOptions(const ModelLoadOptions& options);
+    // The shared load options plus the model's node selection
+    ModelLoadOptions getModelLoadOptions(size_t index) const;
+    bool isInstanced() const { return loadOptions_.preserveInstancing; }
+
+    // Vertex layout the consumer nodes upload (packing happens at primitive
+    // creation, so changing it doesn't reload the models)
+    VertexFormat getVertexFormat() const { return vertexFormat_; }
+    void setVertexFormat(VertexFormat format);
+
     // Serialization
     nlohmann::json toJson() const override;
     void fromJson(const nlohmann::json& j) override;
@@ -80,17 +98,38 @@ public:
     const std::vector<uint32_t>& getConsolidatedIndices() const {
         return consolidatedIndices_;
     }
+    const std::vector<uint16_t>& getConsolidatedIndices16() const {
+        return consolidatedIndices16_;
+    }
     const std::vector<EditorGeometryRange>& getConsolidatedRanges() const {
         return consolidatedRanges_;
     }
+    const std::vector<InstanceData>& getConsolidatedInstances() const {
+        return consolidatedInstances_;
+    }
+    const std::vector<GeometryLod>& getConsolidatedLods() const {
+        return consolidatedLods_;
+    }
+    const std::vector<Meshlet>& getConsolidatedMeshlets() const {
+        return consolidatedMeshlets_;
+    }
+    const std::vector<uint32_t>& getConsolidatedMeshletVertices() const {
+        return consolidatedMeshletVertices_;
+    }
+    const std::vector<uint8_t>& getConsolidatedMeshletTriangles() const {
+        return consolidatedMeshletTriangles_;
+    }
+    const std::vector<SceneNode>& getConsolidatedNodes() const {
+        return consolidatedNodes_;
+    }
     const std::vector<ConsolidatedRangeInfo>& getRangeInfo() const {
         return rangeInfo_;
     }
     const std::vector<EditorMaterial>& getMergedMaterials() const {
         return mergedMaterials_;
     }
-    const std::vector<EditorImage*>& getMergedImages() const {
-        return mergedImages_;
+    const std::vector<TextureHandle>& getMergedTextures() const {
+        return mergedTextures_;
     }
     const std::vector<GLTFCamera>& getMergedCameras() const {
         return mergedCameras_;
@@ -132,6 +171,11 @@ public:
     // Trigger rebuild (called by UI when models change)
     void rebuildConsolidatedData();
 
+    // Move a node of the consolidated hierarchy and update the world
+    // transforms below it. Consumers refresh their model matrices from
+    // getConsolidatedNodes(); no geometry is reloaded.
+    bool setNodeLocalTransform(size_t nodeIndex, const glm::mat4& localTransform);
+
     // Flag for editor to know when rebuild is needed
     bool needsRebuild() const { return needsRebuild_; }
     void clearNeedsRebuild() { needsRebuild_ = false; }
@@ -140,16 +184,25 @@ private:
     void createDefaultPins();
 
     std::vector<ModelEntry> models_;
+    ModelLoadOptions loadOptions_;
+    VertexFormat vertexFormat_ = VertexFormat::Full;
 
     // Consolidated data (rebuilt when models change)
     std::vector<Vertex> consolidatedVertices_;
-    std::vector<uint32_t> consolidatedIndices_;
+    std::vector<uint32_t> consolidatedIndices_;    // Ranges with VK_INDEX_TYPE_UINT32
+    std::vector<uint16_t> consolidatedIndices16_;  // Ranges with VK_INDEX_TYPE_UINT16
     std::vector<EditorGeometryRange> consolidatedRanges_;
+    std::vector<InstanceData> consolidatedInstances_;
+    std::vector<GeometryLod> consolidatedLods_;
+    std::vector<Meshlet> consolidatedMeshlets_;
+    std::vector<uint32_t> consolidatedMeshletVertices_;
+    std::vector<uint8_t> consolidatedMeshletTriangles_;
+    std::vector<SceneNode> consolidatedNodes_;  // Every model's scene roots are roots here
     std::vector<ConsolidatedRangeInfo> rangeInfo_;
 
     // Merged auxiliary data
     std::vector<EditorMaterial> mergedMaterials_;
-    std::vector<EditorImage*> mergedImages_; // Pointers to CachedModel images
+    std::vector<TextureHandle> mergedTextures_; // CachedModel textures, may repeat
     std::vector<GLTFCamera> mergedCameras_;
     std::vector<GLTFLight> mergedLights_;
 
@@ -2,6 +2,7 @@
 #include "node_graph.h"
 #include "vulkan_editor/util/logger.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
 #include <imgui.h>
 #include <imgui_node_editor.h>
 
@@ -199,6 +200,7 @@ void MultiUBONode::clearPrimitives() {
     lightUbo_ = nullptr;
     lightPrimitive_ = nullptr;
     modelMatricesData_.clear();
+    modelMatrixUbos_.clear();
 }
 
 void MultiUBONode::createPrimitives(primitives::Store& store) {
@@ -234,18 +236,10 @@ void MultiUBONode::createPrimitives(primitives::Store& store) {
     uboArray.type = primitives::Type::UniformBuffer;
     uboArray.handles.resize(ranges.size());
 
-    glm::mat4 modelMatrix{1.0f};
-    glm::mat3 normalMat3 =
-        glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
-    glm::mat4 normalMatrix = glm::mat4(normalMat3);
-
     // Store matrices permanently
     modelMatricesData_.clear();
     modelMatricesData_.resize(ranges.size());
-    for (auto& matrices : modelMatricesData_) {
-        matrices.model = modelMatrix;
-        matrices.normalMatrix = normalMatrix;
-    }
+    modelMatrixUbos_.assign(ranges.size(), nullptr);
 
     // Create UBO primitives pointing to persistent storage
     for (size_t i = 0; i < ranges.size(); ++i) {
@@ -257,6 +251,7 @@ void MultiUBONode::createPrimitives(primitives::Store& store) {
             sizeof(ModelMatrices));
 
         uboArray.handles[i] = hUBO.handle;
+        modelMatrixUbos_[i] = &ubo;
 
         Log::debug(LOG_CATEGORY,
                    "Created UniformBuffer primitive for range {} with model "
@@ -264,6 +259,9 @@ void MultiUBONode::createPrimitives(primitives::Store& store) {
                    i);
     }
 
+    // Buffers are not created yet; this only fills the initial data
+    updateModelMatrices();
+
     // Create camera UBO if source has cameras
     if (!cameras.empty()) {
         primitives::StoreHandle hCameraUbo = store.newUniformBuffer();
@@ -342,6 +340,46 @@ void MultiUBONode::getOutputPrimitives(
     }
 }
 
+void MultiUBONode::updateModelMatrices() {
+    if (!graph_) return;
+
+    MultiModelSourceNode* source = findSourceNode(*graph_);
+    if (!source) return;
+
+    const auto& ranges = source->getConsolidatedRanges();
+    const auto& nodes = source->getConsolidatedNodes();
+    if (ranges.size() != modelMatricesData_.size()) {
+        Log::warning(LOG_CATEGORY,
+                     "Model matrices out of date ({} ranges, {} matrices)",
+                     ranges.size(), modelMatricesData_.size());
+        return;
+    }
+
+    size_t nodeRanges = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const int32_t node = ranges[i].node;
+        glm::mat4 model{1.0f};
+        if (node >= 0 && static_cast<size_t>(node) < nodes.size()) {
+            model = nodes[node].worldTransform;
+            ++nodeRanges;
+        }
+
+        ModelMatrices& matrices = modelMatricesData_[i];
+        matrices.model = model;
+        matrices.normalMatrix =
+            glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+
+        // Live buffers are persistently mapped, so this is the whole update
+        const primitives::UniformBuffer* ubo = modelMatrixUbos_[i];
+        if (ubo && ubo->mapped) {
+            memcpy(ubo->mapped, &matrices, sizeof(ModelMatrices));
+        }
+    }
+
+    Log::debug(LOG_CATEGORY, "Updated model matrices for {} ranges ({} from scene nodes)",
+               ranges.size(), nodeRanges);
+}
+
 void MultiUBONode::updateCameraFromSelection() {
     if (!graph_) return;
 
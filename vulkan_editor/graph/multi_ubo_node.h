@@ -11,7 +11,8 @@
  * from the consolidated model data.
  *
  * Output pins:
- * - modelMatrixPin (UniformBuffer[]) - per-geometry model/normal matrices
+ * - modelMatrixPin (UniformBuffer[]) - per-geometry model/normal matrices, from
+ *   the world transform of each range's scene node (identity when baked)
  * - cameraPin (UniformBuffer) - selected GLTF camera from merged cameras
  * - lightPin (UniformBuffer) - combined GLTF lights from all models
  *
@@ -62,6 +63,10 @@ public:
     void updateCameraFromSelection();
     void updateLightsFromMerged();
 
+    /// Refill the per-range model matrices from the source's scene nodes and
+    /// write them to the mapped UBOs (128 bytes per range, no geometry upload)
+    void updateModelMatrices();
+
     // Check if source has cameras/lights (for conditional pin display)
     bool sourceHasCameras() const;
     bool sourceHasLights() const;
@@ -95,6 +100,7 @@ private:
     primitives::CameraType cameraType_{primitives::CameraType::Fixed};
     primitives::LightsBuffer lightsBuffer_;
 
+    std::vector<primitives::UniformBuffer*> modelMatrixUbos_;
     primitives::UniformBuffer* cameraUbo_{nullptr};
     primitives::UniformBuffer* lightUbo_{nullptr};
     primitives::Light* lightPrimitive_{nullptr};
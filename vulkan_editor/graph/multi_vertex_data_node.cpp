@@ -5,6 +5,7 @@
 #include <imgui_node_editor.h>
 
 #include <vkDuck/model_loader.h>
+#include <vkDuck/vertex_formats.h>
 
 #include "external/utilities/builders.h"
 #include "external/utilities/widgets.h"
@@ -33,13 +34,17 @@ void MultiVertexDataNode::createDefaultPins() {
     vertexDataPin.id = ed::PinId(GetNextGlobalId());
     vertexDataPin.type = PinType::VertexData;
     vertexDataPin.label = "Vertex data";
+
+    meshletDataPin.id = ed::PinId(GetNextGlobalId());
+    meshletDataPin.type = PinType::MeshletData;
+    meshletDataPin.label = "Meshlets";
 }
 
 void MultiVertexDataNode::registerPins(PinRegistry& registry) {
     // Register source input pin from base class
     registerSourceInputPin(registry);
 
-    // Register output pin
+    // Register output pins
     vertexDataPinHandle = registry.registerPinWithId(
         id,
         vertexDataPin.id,
@@ -47,6 +52,13 @@ void MultiVertexDataNode::registerPins(PinRegistry& registry) {
         PinKind::Output,
         vertexDataPin.label
     );
+    meshletDataPinHandle = registry.registerPinWithId(
+        id,
+        meshletDataPin.id,
+        meshletDataPin.type,
+        PinKind::Output,
+        meshletDataPin.label
+    );
 }
 
 nlohmann::json MultiVertexDataNode::toJson() const {
@@ -59,13 +71,18 @@ nlohmann::json MultiVertexDataNode::toJson() const {
     // Serialize input pin (source connection)
     sourceInputPinToJson(j);
 
-    // Serialize output pin
+    // Serialize output pins
     j["outputPins"] = nlohmann::json::array();
     j["outputPins"].push_back({
         {"id", vertexDataPin.id.Get()},
         {"type", static_cast<int>(vertexDataPin.type)},
         {"label", vertexDataPin.label}
     });
+    j["outputPins"].push_back({
+        {"id", meshletDataPin.id.Get()},
+        {"type", static_cast<int>(meshletDataPin.type)},
+        {"label", meshletDataPin.label}
+    });
 
     return j;
 }
@@ -81,12 +98,15 @@ void MultiVertexDataNode::fromJson(const nlohmann::json& j) {
     // Restore input pin
     sourceInputPinFromJson(j);
 
-    // Restore output pin
+    // Restore output pins (projects saved before meshlets keep a fresh id)
     if (j.contains("outputPins") && j["outputPins"].is_array()) {
         auto& pins = j["outputPins"];
         if (pins.size() > 0) {
             vertexDataPin.id = ed::PinId(pins[0]["id"].get<int>());
         }
+        if (pins.size() > 1) {
+            meshletDataPin.id = ed::PinId(pins[1]["id"].get<int>());
+        }
     }
 }
 
@@ -94,7 +114,9 @@ void MultiVertexDataNode::render(
     ax::NodeEditor::Utilities::BlueprintNodeBuilder& builder,
     const NodeGraph& nodeGraph
 ) const {
-    std::vector<std::string> pinLabels = {sourceInputPin.label, vertexDataPin.label};
+    std::vector<std::string> pinLabels = {
+        sourceInputPin.label, vertexDataPin.label, meshletDataPin.label
+    };
     float nodeWidth = calculateConsumerNodeWidth(name, pinLabels);
 
     renderConsumerNodeHeader(builder, nodeWidth);
@@ -109,7 +131,7 @@ void MultiVertexDataNode::render(
         builder
     );
 
-    // Draw output pin
+    // Draw output pins
     DrawOutputPin(
         vertexDataPin.id,
         vertexDataPin.label,
@@ -118,6 +140,14 @@ void MultiVertexDataNode::render(
         nodeWidth,
         builder
     );
+    DrawOutputPin(
+        meshletDataPin.id,
+        meshletDataPin.label,
+        static_cast<int>(meshletDataPin.type),
+        nodeGraph.isPinLinked(meshletDataPin.id),
+        nodeWidth,
+        builder
+    );
 
     builder.End();
     ed::PopStyleColor();
@@ -125,6 +155,8 @@ void MultiVertexDataNode::render(
 
 void MultiVertexDataNode::clearPrimitives() {
     vertexDataArray_ = {};
+    meshletDataArray_ = {};
+    packedVertices_.clear();
 }
 
 void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
@@ -144,6 +176,13 @@ void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
     const auto& models = source->getModels();
     const auto& vertices = source->getConsolidatedVertices();
     const auto& indices = source->getConsolidatedIndices();
+    const auto& indices16 = source->getConsolidatedIndices16();
+    const auto& instances = source->getConsolidatedInstances();
+    const auto& lods = source->getConsolidatedLods();
+    const auto& meshlets = source->getConsolidatedMeshlets();
+    const auto& meshletVertices = source->getConsolidatedMeshletVertices();
+    const auto& meshletTriangles = source->getConsolidatedMeshletTriangles();
+    const VertexFormat vertexFormat = source->getVertexFormat();
 
     if (ranges.empty()) {
         Log::warning(LOG_CATEGORY, "Cannot create primitives: no models loaded in source");
@@ -156,6 +195,22 @@ void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
     vertexArray.type = primitives::Type::VertexData;
     vertexArray.handles.resize(ranges.size());
 
+    // Meshlet array, index-aligned with the vertex data array
+    primitives::Array* meshletArray = nullptr;
+    if (!meshlets.empty()) {
+        meshletDataArray_ = store.newArray();
+        meshletArray = &store.arrays[meshletDataArray_.handle];
+        meshletArray->type = primitives::Type::MeshletData;
+        meshletArray->handles.resize(ranges.size());
+    }
+
+    packedVertices_.clear();
+    if (vertexFormat != VertexFormat::Full) {
+        packedVertices_.resize(ranges.size());
+    }
+    size_t fullVertexBytes = 0;
+    size_t packedVertexBytes = 0;
+
     for (size_t i = 0; i < ranges.size(); ++i) {
         const auto& range = ranges[i];
 
@@ -163,33 +218,88 @@ void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
         primitives::VertexData& vertexData =
             store.vertexDatas[hVertexData.handle];
 
-        size_t vertexSize = range.vertexCount * sizeof(Vertex);
-        size_t indexSize = range.indexCount * sizeof(uint32_t);
+        // LOD indices directly follow the range's own, so one index buffer
+        // holds every level
+        uint32_t lodIndexCount = range.indexCount;
+        if (range.lodCount > 0 && range.firstLod + range.lodCount <= lods.size()) {
+            vertexData.lods.assign(
+                lods.begin() + range.firstLod,
+                lods.begin() + range.firstLod + range.lodCount
+            );
+            for (const auto& lod : vertexData.lods) {
+                lodIndexCount = std::max(lodIndexCount, lod.firstIndex + lod.indexCount);
+            }
+        }
+        vertexData.boundsMin = range.boundsMin;
+        vertexData.boundsMax = range.boundsMax;
 
-        // Set up vertex data span
+        size_t vertexSize = range.vertexCount * vertexStride(vertexFormat);
+        size_t indexSize = lodIndexCount * indexTypeSize(range.indexType);
+
+        // Set up vertex data span, repacking into the compact layout if selected
         auto* vertexDataPtr = reinterpret_cast<uint8_t*>(
             const_cast<Vertex*>(vertices.data() + range.firstVertex)
         );
+        if (vertexFormat != VertexFormat::Full) {
+            auto& packed = packedVertices_[i];
+            packed.resize(vertexSize);
+            vertexData.dequantization = packVertices(
+                std::span<const Vertex>(vertices.data() + range.firstVertex, range.vertexCount),
+                vertexFormat,
+                packed.data()
+            );
+            vertexDataPtr = packed.data();
+        }
         vertexData.vertexData = std::span<uint8_t>(vertexDataPtr, vertexSize);
         vertexData.vertexDataSize = vertexSize;
         vertexData.vertexCount = range.vertexCount;
-
-        // Set up index data span
-        auto* indexDataPtr =
-            const_cast<uint32_t*>(indices.data() + range.firstIndex);
-        vertexData.indexData =
-            std::span<uint32_t>(indexDataPtr, range.indexCount);
+        vertexData.vertexFormat = vertexFormat;
+        fullVertexBytes += range.vertexCount * sizeof(Vertex);
+        packedVertexBytes += vertexSize;
+
+        // Set up index data span in the range's stored width
+        const void* indexDataPtr = range.indexType == VK_INDEX_TYPE_UINT16
+            ? static_cast<const void*>(indices16.data() + range.firstIndex)
+            : static_cast<const void*>(indices.data() + range.firstIndex);
+        vertexData.indexData = std::span<uint8_t>(
+            static_cast<uint8_t*>(const_cast<void*>(indexDataPtr)), indexSize
+        );
         vertexData.indexDataSize = indexSize;
+        vertexData.indexType = range.indexType;
         vertexData.indexCount = range.indexCount;
 
-        vertexData.bindingDescription = Vertex::getBindingDescription();
-        vertexData.attributeDescriptions = Vertex::getAttributeDescriptions();
+        vertexData.bindingDescription = vertexBindingDescription(vertexFormat);
+        vertexData.attributeDescriptions = vertexAttributeDescriptions(vertexFormat);
+
+        // Instanced ranges get a second, per-instance vertex stream
+        if (range.instanceCount > 0 &&
+            range.firstInstance + range.instanceCount <= instances.size()) {
+            auto* instanceDataPtr = reinterpret_cast<uint8_t*>(
+                const_cast<InstanceData*>(instances.data() + range.firstInstance)
+            );
+            size_t instanceSize = range.instanceCount * sizeof(InstanceData);
+            vertexData.instanceData =
+                std::span<uint8_t>(instanceDataPtr, instanceSize);
+            vertexData.instanceDataSize = instanceSize;
+            vertexData.instanceCount = range.instanceCount;
+            vertexData.instanceBindingDescription =
+                InstanceData::getBindingDescription();
+
+            auto instanceAttributes = InstanceData::getAttributeDescriptions();
+            vertexData.attributeDescriptions.insert(
+                vertexData.attributeDescriptions.end(),
+                instanceAttributes.begin(),
+                instanceAttributes.end()
+            );
+        }
+        vertexData.modelLoadOptions = source->getLoadOptions();
 
         // Get model file path from range info for code generation
         if (i < rangeInfo.size()) {
             size_t modelIndex = rangeInfo[i].modelIndex;
             if (modelIndex < models.size()) {
                 vertexData.modelFilePath = models[modelIndex].path;
+                vertexData.modelLoadOptions = source->getModelLoadOptions(modelIndex);
             }
         }
         vertexData.geometryIndex = static_cast<uint32_t>(i < rangeInfo.size() ?
@@ -197,12 +307,42 @@ void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
 
         vertexArray.handles[i] = hVertexData.handle;
 
+        if (meshletArray) {
+            primitives::StoreHandle hMeshletData = store.newMeshletData();
+            primitives::MeshletData& meshletData =
+                store.meshletDatas[hMeshletData.handle];
+
+            // Meshlet offsets are relative to the range's own lists
+            if (range.meshletCount > 0 &&
+                range.firstMeshlet + range.meshletCount <= meshlets.size()) {
+                const Meshlet& last = meshlets[range.firstMeshlet + range.meshletCount - 1];
+                const size_t vertexCount = last.vertexOffset + last.vertexCount;
+                const size_t triangleBytes = last.triangleOffset + last.triangleCount * 3;
+                if (range.firstMeshletVertex + vertexCount <= meshletVertices.size() &&
+                    range.firstMeshletTriangle + triangleBytes <= meshletTriangles.size()) {
+                    meshletData.meshlets = std::span<const Meshlet>(
+                        meshlets.data() + range.firstMeshlet, range.meshletCount);
+                    meshletData.meshletVertices = std::span<const uint32_t>(
+                        meshletVertices.data() + range.firstMeshletVertex, vertexCount);
+                    meshletData.meshletTriangles = std::span<const uint8_t>(
+                        meshletTriangles.data() + range.firstMeshletTriangle, triangleBytes);
+                    meshletData.meshletCount = range.meshletCount;
+                }
+            }
+            meshletData.modelFilePath = vertexData.modelFilePath;
+            meshletData.geometryIndex = vertexData.geometryIndex;
+
+            meshletArray->handles[i] = hMeshletData.handle;
+        }
+
         Log::debug(
             LOG_CATEGORY,
-            "Created VertexData for range {}: {} verts, {} indices, model: {}",
+            "Created VertexData for range {}: {} verts, {} indices, {} instances, {} LODs, model: {}",
             i,
             range.vertexCount,
             range.indexCount,
+            vertexData.instanceCount,
+            vertexData.lods.size(),
             vertexData.modelFilePath
         );
     }
@@ -212,6 +352,23 @@ void MultiVertexDataNode::createPrimitives(primitives::Store& store) {
         "Created {} VertexData primitives from source",
         ranges.size()
     );
+    if (meshletArray) {
+        Log::info(
+            LOG_CATEGORY,
+            "Created {} MeshletData primitives ({} meshlets)",
+            ranges.size(),
+            meshlets.size()
+        );
+    }
+    if (vertexFormat != VertexFormat::Full) {
+        Log::info(
+            LOG_CATEGORY,
+            "{} vertices: {:.2f} MB instead of {:.2f} MB",
+            vertexFormatName(vertexFormat),
+            packedVertexBytes / (1024.0 * 1024.0),
+            fullVertexBytes / (1024.0 * 1024.0)
+        );
+    }
 }
 
 void MultiVertexDataNode::getOutputPrimitives(
@@ -222,4 +379,7 @@ void MultiVertexDataNode::getOutputPrimitives(
     if (vertexDataArray_.isValid()) {
         outputs.push_back({vertexDataPin.id, vertexDataArray_});
     }
+    if (meshletDataArray_.isValid()) {
+        outputs.push_back({meshletDataPin.id, meshletDataArray_});
+    }
 }
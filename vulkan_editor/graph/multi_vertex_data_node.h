@@ -9,8 +9,12 @@
  * Connects to a MultiModelSourceNode via input pin and creates VertexData primitives
  * from the consolidated geometry data.
  *
- * Single output pin: vertexDataPin (VertexData type)
- * Outputs an array of VertexData primitives, one per consolidated geometry range.
+ * Output pins:
+ * - vertexDataPin (VertexData type): an array of VertexData primitives, one
+ *   per consolidated geometry range.
+ * - meshletDataPin (MeshletData type): an array of MeshletData primitives
+ *   aligned with the vertex data array; only filled when the source is loaded
+ *   with meshlets.
  *
  * Use case: Connect to a Model Source to get combined geometry for rendering.
  */
@@ -35,6 +39,7 @@ public:
     PinLookup getPinById(ax::NodeEditor::PinId id) override {
         if (auto result = MultiModelConsumerBase::getPinById(id)) return result;
         if (vertexDataPin.id == id) return {&vertexDataPin, false};
+        if (meshletDataPin.id == id) return {&meshletDataPin, false};
         return {};
     }
 
@@ -49,12 +54,19 @@ public:
     // Store graph reference for accessing source node during createPrimitives
     void setGraph(NodeGraph* graph) { graph_ = graph; }
 
-    // Output pin
+    // Output pins
     Pin vertexDataPin;
     PinHandle vertexDataPinHandle = INVALID_PIN_HANDLE;
+    Pin meshletDataPin;
+    PinHandle meshletDataPinHandle = INVALID_PIN_HANDLE;
 
 private:
     void createDefaultPins();
     NodeGraph* graph_ = nullptr;
     primitives::StoreHandle vertexDataArray_{};
+    primitives::StoreHandle meshletDataArray_{};
+
+    // Per-range vertices repacked into the source's compact vertex format
+    // (VertexData spans point here); empty for VertexFormat::Full
+    std::vector<std::vector<uint8_t>> packedVertices_;
 };
@@ -282,6 +282,9 @@ void NodeGraph::clear() {
     LinkManager::clearLinks(links, pinToLinks);
     dependencyGraph.clear();
     pinRegistry.clear();
+    mipGeneration = MipGeneration::Gpu;
+    textureCache = {};
+    texturePreview = {};
 }
 
 // ============================================================================
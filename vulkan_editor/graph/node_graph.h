@@ -3,6 +3,9 @@
 #include "link.h"
 #include "pin_registry.h"
 #include "validation_rules.h"
+#include <vkDuck/image_loader.h>
+#include <vkDuck/texture_cache.h>
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -66,4 +69,30 @@ public:
 
     bool hasShadowPipeline = false;
     bool hasDeferredPipeline = false;
+
+    /// How sampled textures get their mip chains (project setting)
+    MipGeneration mipGeneration = MipGeneration::Gpu;
+
+    /// Decoded texture cache (project setting), used by the editor and by
+    /// generated code
+    struct TextureCacheSettings {
+        bool enabled = true;
+        uint32_t maxMegabytes = 2048;
+        bool mips = false;  ///< Cache full mip chains instead of level 0
+
+        /// The cache configuration in `directory`, or a disabled one
+        TextureCacheConfig config(const std::filesystem::path& directory) const {
+            if (!enabled) return {};
+            return {directory, uint64_t{maxMegabytes} << 20, mips};
+        }
+    };
+    TextureCacheSettings textureCache;
+
+    /// Model texture resolution in the editor (project setting); generated
+    /// code loads full resolution. 0 means no limit.
+    struct TexturePreviewSettings {
+        uint32_t maxDimension = 0;     ///< Largest preview width or height
+        uint32_t budgetMegabytes = 0;  ///< All model textures together
+    };
+    TexturePreviewSettings texturePreview;
 };
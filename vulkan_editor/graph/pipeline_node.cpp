@@ -1647,6 +1647,9 @@ void PipelineNode::createPrimitives(primitives::Store& store) {
                 // properties.limits.maxSamplerAnisotropy,
                 .compareEnable = VK_FALSE,
                 .compareOp = VK_COMPARE_OP_ALWAYS,
+                // Textures carry full mip chains
+                .minLod = 0.0f,
+                .maxLod = VK_LOD_CLAMP_NONE,
                 .borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
                 .unnormalizedCoordinates = VK_FALSE,
             };
@@ -270,6 +270,9 @@ void FileGenerator::generateProject(
     // Build dependencies for struct generation
     graph.buildDependencies();
 
+    // The generated app keeps its decoded texture cache next to its data
+    store.textureCache = graph.textureCache.config(".texture_cache");
+
     // Generate only project-specific files (shared code is now in vkDuck)
     generateCameraInstances(store, generatedDir);
     generatePrimitives(graph, store, generatedDir);
@@ -591,9 +594,11 @@ void FileGenerator::generatePrimitives(
         }
         if (hasModelFiles(store)) {
             print(out, "#include <vkDuck/model_loader.h>\n");
+            print(out, "#include <vkDuck/vertex_formats.h>\n");
         }
         if (hasImageFiles(store)) {
             print(out, "#include <vkDuck/image_loader.h>\n");
+            print(out, "#include <vkDuck/texture_cache.h>\n");
         }
         print(out, "\n");
 
@@ -1127,6 +1132,10 @@ bool FileGenerator::hasImageFiles(const primitives::Store& store) const {
         if (!img.name.empty() && !img.isSwapchainImage && !img.originalImagePath.empty()) {
             return true;
         }
+        // CPU mip chains are filtered by generateMipChain()
+        if (!img.name.empty() && img.mipGeneration == MipGeneration::Cpu && img.imageInfo.mipLevels > 1) {
+            return true;
+        }
     }
     return false;
 }
@@ -82,6 +82,22 @@ int scanJsonForMaxId(const nlohmann::json& j) {
     return maxId;
 }
 
+// Project-wide texture settings, stored as strings so the file stays readable
+const char* mipGenerationName(MipGeneration mode) {
+    switch (mode) {
+    case MipGeneration::None: return "none";
+    case MipGeneration::Cpu: return "cpu";
+    case MipGeneration::Gpu: break;
+    }
+    return "gpu";
+}
+
+MipGeneration parseMipGeneration(const std::string& name) {
+    if (name == "none") return MipGeneration::None;
+    if (name == "cpu") return MipGeneration::Cpu;
+    return MipGeneration::Gpu;
+}
+
 // Build label->ID maps from JSON pin arrays
 void buildPinIdMaps(
     const nlohmann::json& jNode,
@@ -171,6 +187,16 @@ bool PipelineState::save(
         nlohmann::json j;
         j["nodes"] = serializeNodes(graph);
         j["links"] = serializeLinks(graph);
+        j["textures"]["mipGeneration"] = mipGenerationName(graph.mipGeneration);
+        j["textures"]["cache"] = {
+            {"enabled", graph.textureCache.enabled},
+            {"maxMegabytes", graph.textureCache.maxMegabytes},
+            {"mips", graph.textureCache.mips}
+        };
+        j["textures"]["preview"] = {
+            {"maxDimension", graph.texturePreview.maxDimension},
+            {"budgetMegabytes", graph.texturePreview.budgetMegabytes}
+        };
 
         std::ofstream out(filePath);
         if (!out.is_open()) {
@@ -290,25 +316,29 @@ std::unique_ptr<Node> NodeFactory::createFromJson(
         auto sourceNode = std::make_unique<MultiModelSourceNode>(id);
         sourceNode->fromJson(jNode);
 
-        // Load all models via ModelManager
+        // Load all models via ModelManager, in the background so opening a
+        // project does not block on them
         namespace fs = std::filesystem;
-        std::vector<std::pair<std::string, bool>> entriesToLoad;
+        std::vector<ModelEntry> entriesToLoad;
         for (size_t i = 0; i < sourceNode->getModelCount(); ++i) {
             const ModelEntry& entry = sourceNode->getModel(i);
             if (entry.path[0] != '\0') {
-                entriesToLoad.emplace_back(entry.path, entry.enabled);
+                entriesToLoad.push_back(entry);
             }
         }
         // Clear placeholder entries and re-add with loaded handles
         while (sourceNode->getModelCount() > 0) {
             sourceNode->removeModel(0);
         }
-        for (const auto& [path, enabled] : entriesToLoad) {
-            ModelHandle handle = g_modelManager->loadModel(fs::path(path));
-            if (g_modelManager->isLoaded(handle)) {
-                sourceNode->addModel(handle);
+        for (const ModelEntry& entry : entriesToLoad) {
+            ModelLoadOptions options = sourceNode->getLoadOptions();
+            options.nodeSelection = entry.nodeSelection;
+            ModelHandle handle =
+                g_modelManager->loadModelAsync(fs::path(entry.path), nullptr, options);
+            if (g_modelManager->getStatus(handle) != ModelStatus::Error) {
+                sourceNode->addModel(handle, entry.nodeSelection);
                 sourceNode->setModelEnabled(
-                    sourceNode->getModelCount() - 1, enabled);
+                    sourceNode->getModelCount() - 1, entry.enabled);
             }
         }
 
@@ -498,6 +528,23 @@ bool PipelineState::load(
 
         graph.clear();
 
+        // Older files predate the setting and keep the default
+        if (j.contains("textures") && j["textures"].contains("mipGeneration")) {
+            graph.mipGeneration =
+                parseMipGeneration(j["textures"]["mipGeneration"].get<std::string>());
+        }
+        if (j.contains("textures") && j["textures"].contains("cache")) {
+            const auto& cache = j["textures"]["cache"];
+            graph.textureCache.enabled = cache.value("enabled", true);
+            graph.textureCache.maxMegabytes = cache.value("maxMegabytes", 2048u);
+            graph.textureCache.mips = cache.value("mips", false);
+        }
+        if (j.contains("textures") && j["textures"].contains("preview")) {
+            const auto& preview = j["textures"]["preview"];
+            graph.texturePreview.maxDimension = preview.value("maxDimension", 0u);
+            graph.texturePreview.budgetMegabytes = preview.value("budgetMegabytes", 0u);
+        }
+
         // CRITICAL: Scan for max ID FIRST, before creating any nodes.
         // This prevents ID conflicts when nodes call GetNextGlobalId()
         // during construction (in createDefaultPins()).
@@ -1,7 +1,9 @@
 #include "primitive_generator.h"
+#include "../asset/model_manager.h"
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_enum_string_helper.h>
 #include <print>
+#include <map>
 #include <set>
 #include <filesystem>
 
@@ -191,16 +193,21 @@ void PrimitiveGenerator::generateAll(
     const primitives::Store& store,
     std::ostream& out
 ) const {
-    // Collect all unique model paths for async loading
-    std::set<std::filesystem::path> uniqueModelPaths;
+    // Collect all unique model paths (with their load options) for async loading.
+    // Nodes sharing a model share its options; the ModelManager entry holds
+    // the ones the editor loaded it with, so the app loads the same data.
+    std::map<std::filesystem::path, ModelLoadOptions> uniqueModelPaths;
     for (const auto& vd : store.vertexDatas) {
-        if (vd.name.empty() || vd.modelFilePath.empty())
+        if (vd.name.empty() || vd.modelFilePath.empty() || uniqueModelPaths.contains(vd.modelFilePath))
             continue;
-        uniqueModelPaths.insert(vd.modelFilePath);
+        const CachedModel* model = g_modelManager ? g_modelManager->getModelByPath(vd.modelFilePath) : nullptr;
+        uniqueModelPaths.emplace(vd.modelFilePath, model ? model->loadOptions : vd.modelLoadOptions);
     }
 
-    // Collect all unique image paths for async loading
+    // Collect all unique image paths for async loading, and those sampled
+    // as linear data (their cached mips are filtered as such)
     std::set<std::filesystem::path> uniqueImagePaths;
+    std::set<std::filesystem::path> linearImagePaths;
     for (const auto& img : store.images) {
         if (img.name.empty() || img.isSwapchainImage || img.originalImagePath.empty())
             continue;
@@ -209,6 +216,9 @@ void PrimitiveGenerator::generateAll(
                                 (img.imageInfo.usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
         if (isSampledTexture) {
             uniqueImagePaths.insert(img.originalImagePath);
+            if (textureFormatForColorSpace(img.imageInfo.format, false) == img.imageInfo.format) {
+                linearImagePaths.insert(img.originalImagePath);
+            }
         }
     }
 
@@ -217,17 +227,17 @@ void PrimitiveGenerator::generateAll(
         print(out, "// Load all models asynchronously in parallel (cached for resize)\n");
         print(out, "static std::unordered_map<std::filesystem::path, ModelData> cachedModels;\n");
         print(out, "if (cachedModels.empty()) {{\n");
-        print(out, "    std::vector<std::filesystem::path> modelPaths = {{\n");
-        for (const auto& path : uniqueModelPaths) {
-            out << "        " << path << ",\n";
+        print(out, "    std::vector<std::pair<std::filesystem::path, ModelLoadOptions>> modelRequests = {{\n");
+        for (const auto& [path, options] : uniqueModelPaths) {
+            out << "        {" << path << ", " << modelLoadOptionsToCpp(options) << "},\n";
         }
         print(out, "    }};\n");
-        print(out, "    cachedModels = loadModelsAsync(modelPaths);\n");
+        print(out, "    cachedModels = loadModelsAsync(modelRequests);\n");
         print(out, "}}\n");
         print(out, "auto& loadedModels = cachedModels;\n\n");
 
         // Create references to individual models for easier access
-        for (const auto& path : uniqueModelPaths) {
+        for (const auto& [path, options] : uniqueModelPaths) {
             out << "ModelData& " << modelPathToVarName(path) << " = loadedModels[" << path << "];\n";
         }
         print(out, "\n");
@@ -235,15 +245,47 @@ void PrimitiveGenerator::generateAll(
 
     // Generate async image loading code if we have images (with caching for resize)
     if (!uniqueImagePaths.empty()) {
-        print(out, "// Load all images asynchronously in parallel (cached for resize)\n");
-        print(out, "static std::unordered_map<std::string, LoadedImage> cachedImages;\n");
+        // Only headers are read here; each texture is decoded straight into
+        // its staging buffer when staged. Images embedded in a model are
+        // read from the loaded model's memory; only files on disk go
+        // through openTexturesAsync. Both go through the decoded texture
+        // cache when the project enables it.
+        const TextureCacheConfig& textureCache = store.textureCache;
+        const bool cacheMips = !textureCache.directory.empty() && textureCache.mips;
+        bool hasEmbeddedImages = false;
+        print(out, "// Open all images asynchronously in parallel (cached for resize)\n");
+        print(out, "static std::unordered_map<std::string, TextureSource> cachedImages;\n");
         print(out, "if (cachedImages.empty()) {{\n");
+        if (!textureCache.directory.empty()) {
+            print(out,
+                "    configureTextureCache({{\"{}\", {}ull, {}}});\n",
+                textureCache.directory.generic_string(), textureCache.maxBytes,
+                textureCache.mips ? "true" : "false");
+        }
+        if (cacheMips) {
+            print(out, "    std::vector<std::string> linearImagePaths = {{\n");
+            for (const auto& path : linearImagePaths) {
+                out << "        " << path << ",\n";
+            }
+            print(out, "    }};\n");
+        }
         print(out, "    std::vector<std::string> imagePaths = {{\n");
         for (const auto& path : uniqueImagePaths) {
+            if (isEmbeddedImagePath(path)) {
+                hasEmbeddedImages = true;
+                continue;
+            }
             out << "        " << path << ",\n";
         }
         print(out, "    }};\n");
-        print(out, "    cachedImages = loadImagesAsync(imagePaths);\n");
+        print(out, "    cachedImages = openTexturesAsync(imagePaths{});\n",
+            cacheMips ? ", linearImagePaths" : "");
+        if (hasEmbeddedImages) {
+            for (const auto& [path, options] : uniqueModelPaths) {
+                print(out, "    cachedImages.merge(openEmbeddedTexturesAsync({}{}));\n",
+                    modelPathToVarName(path), cacheMips ? ", linearImagePaths" : "");
+            }
+        }
         print(out, "}}\n");
         print(out, "auto& loadedImages = cachedImages;\n\n");
     }
@@ -322,7 +364,37 @@ void PrimitiveGenerator::generateDefinitions(
             print(out, "uint32_t {}_indexCount = {};\n", vd.name, vd.indexCount);
         }
         print(out, "VkDeviceSize {}_vertexDataSize = {};\n", vd.name, vd.vertexDataSize);
-        print(out, "VkDeviceSize {}_indexDataSize = {};\n\n", vd.name, vd.indexDataSize);
+        print(out, "VkDeviceSize {}_indexDataSize = {};\n", vd.name, vd.indexDataSize);
+        print(out, "VkIndexType {}_indexType = {};\n", vd.name, string_VkIndexType(vd.indexType));
+        if (vd.isInstanced()) {
+            print(out, "VkBuffer {}_instanceBuffer = VK_NULL_HANDLE;\n", vd.name);
+            print(out, "VmaAllocation {}_instanceAlloc = VK_NULL_HANDLE;\n", vd.name);
+            print(out, "uint32_t {}_instanceCount = {};\n", vd.name, vd.instanceCount);
+        }
+        if (!vd.modelFilePath.empty() && vd.hasQuantizedPositions()) {
+            print(out, "PositionDequantization {}_dequant{{}};\n", vd.name);
+        }
+        if (!vd.modelFilePath.empty() && vd.hasLods()) {
+            print(out, "std::vector<GeometryLod> {}_lods;\n", vd.name);
+            print(out, "glm::vec3 {}_boundsMin{{0.0f}};\n", vd.name);
+            print(out, "glm::vec3 {}_boundsMax{{0.0f}};\n", vd.name);
+        }
+        print(out, "\n");
+    }
+
+    // Meshlet storage buffers
+    for (const auto& md : store.meshletDatas) {
+        if (md.name.empty())
+            continue;
+
+        print(out, "VkBuffer {}_meshletBuffer = VK_NULL_HANDLE;\n", md.name);
+        print(out, "VmaAllocation {}_meshletAlloc = VK_NULL_HANDLE;\n", md.name);
+        print(out, "VkBuffer {}_vertexBuffer = VK_NULL_HANDLE;\n", md.name);
+        print(out, "VmaAllocation {}_vertexAlloc = VK_NULL_HANDLE;\n", md.name);
+        print(out, "VkBuffer {}_triangleBuffer = VK_NULL_HANDLE;\n", md.name);
+        print(out, "VmaAllocation {}_triangleAlloc = VK_NULL_HANDLE;\n", md.name);
+        print(out, "uint32_t {}_meshletCount = {};\n\n", md.name,
+            md.modelFilePath.empty() ? md.meshletCount : 0);
     }
 
     // Uniform buffers
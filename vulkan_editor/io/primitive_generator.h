@@ -1,6 +1,7 @@
 #pragma once
 #include "../gpu/primitives.h"
 #include "../shader/shader_types.h"
+#include <format>
 #include <ostream>
 #include <string>
 #include <functional>
@@ -11,6 +12,35 @@ inline std::string modelPathToVarName(const std::filesystem::path& path) {
     return "loadedModel_" + std::to_string(std::hash<std::filesystem::path>{}(path));
 }
 
+/// Emit a ModelLoadOptions initializer for generated code
+/// (designated initializers must follow the declaration order)
+inline std::string modelLoadOptionsToCpp(const ModelLoadOptions& options) {
+    auto flag = [](bool value) { return value ? "true" : "false"; };
+    auto flt = [](float value) {
+        std::string s = std::format("{}", value);
+        if (s.find_first_of(".e") == std::string::npos)
+            s += ".0";
+        return s + "f";
+    };
+    std::string nodeSelection;
+    if (!options.nodeSelection.empty()) {
+        nodeSelection = ", .nodeSelection = {";
+        for (size_t i = 0; i < options.nodeSelection.size(); ++i) {
+            nodeSelection += (i > 0 ? ", " : "") + std::to_string(options.nodeSelection[i]);
+        }
+        nodeSelection += "}";
+    }
+    return std::string("ModelLoadOptions{") +
+        ".preserveInstancing = " + flag(options.preserveInstancing) +
+        ", .preserveHierarchy = " + flag(options.preserveHierarchy) +
+        ", .optimizeMeshes = " + flag(options.optimizeMeshes) +
+        ", .lodLevels = " + std::to_string(options.lodLevels) +
+        ", .lodTriangleRatio = " + flt(options.lodTriangleRatio) +
+        ", .lodTargetError = " + flt(options.lodTargetError) +
+        ", .buildMeshlets = " + flag(options.buildMeshlets) +
+        nodeSelection + "}";
+}
+
 /// Generates code for primitives using their assigned names.
 /// Names are set in Store::new*() methods and can be overridden
 /// in createPrimitives() by setting primitive.name directly.
@@ -29,6 +29,7 @@ enum class PinType {
     Light,
     ModelCameras,
     ModelSource,  // Multi-model source connection
+    MeshletData,  // Per-geometry meshlet storage buffers
     Unknown
 };
 
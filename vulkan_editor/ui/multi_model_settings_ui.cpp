@@ -7,10 +7,74 @@
 #include "../graph/node_graph.h"
 #include "../shader/shader_manager.h"
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <imgui.h>
+#include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
+namespace {
+/// Node selection being edited; applied to the model with "Load selection"
+struct PendingSelection {
+    const MultiModelSourceNode* node{nullptr};
+    size_t modelIndex{0};
+    std::vector<bool> selected;  // Per ModelOutline node
+};
+PendingSelection g_pendingSelection;
+
+/// Vertices declared by the meshes below `roots`, each node counted once
+uint64_t subtreeVertexCount(const ModelOutline& outline, std::vector<int32_t> roots) {
+    uint64_t total = 0;
+    std::vector<bool> visited(outline.nodes.size(), false);
+    while (!roots.empty()) {
+        const int32_t index = roots.back();
+        roots.pop_back();
+        if (visited[index]) {
+            continue;
+        }
+        visited[index] = true;
+        const ModelOutlineNode& outlineNode = outline.nodes[index];
+        if (outlineNode.mesh >= 0) {
+            total += outline.meshes[outlineNode.mesh].vertexCount;
+        }
+        roots.insert(roots.end(), outlineNode.children.begin(), outlineNode.children.end());
+    }
+    return total;
+}
+
+/// One row per node with a checkbox; children are only walked when expanded
+void drawOutlineNode(const ModelOutline& outline, int32_t index, std::vector<bool>& selected) {
+    const ModelOutlineNode& outlineNode = outline.nodes[index];
+    ImGui::PushID(index);
+
+    bool checked = selected[index];
+    if (ImGui::Checkbox("##select", &checked)) {
+        selected[index] = checked;
+    }
+    ImGui::SameLine();
+
+    std::string label = outlineNode.name;
+    if (outlineNode.mesh >= 0) {
+        const ModelOutlineMesh& mesh = outline.meshes[outlineNode.mesh];
+        label += "  [" + mesh.name + ": " + std::to_string(mesh.vertexCount) + " verts]";
+    }
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth;
+    if (outlineNode.children.empty()) {
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    }
+    const bool open = ImGui::TreeNodeEx("##node", flags, "%s", label.c_str());
+    if (open && !outlineNode.children.empty()) {
+        for (int32_t child : outlineNode.children) {
+            drawOutlineNode(outline, child, selected);
+        }
+        ImGui::TreePop();
+    }
+
+    ImGui::PopID();
+}
+} // namespace
+
 // ============================================================================
 // Source Node Settings
 // ============================================================================
@@ -29,6 +93,104 @@ void MultiModelSettingsUI::Draw(
 
     // Draw model list management
     DrawModelList(node);
+
+    // Load options shared by all models of this source
+    ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.3f, 1.0f), "Load Options");
+    ModelLoadOptions options = node->getLoadOptions();
+    bool changed = false;
+    changed |= ImGui::Checkbox("Preserve mesh instancing", &options.preserveInstancing);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Keep meshes referenced by several nodes once and draw them\n"
+            "instanced. Shaders must read the instance transform from\n"
+            "vertex input locations 5-8 (binding 1), or every instance\n"
+            "is drawn at the mesh origin. Pipelines drawing this source\n"
+            "fail to build if its models mix instanced and plain geometry.");
+    }
+    changed |= ImGui::Checkbox("Keep node transforms", &options.preserveHierarchy);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Keep vertices in mesh space instead of baking node transforms\n"
+            "into them. The Multi UBO model matrices carry each node's\n"
+            "world transform, so nodes can be moved without reloading.");
+    }
+    changed |= ImGui::Checkbox("Optimize meshes", &options.optimizeMeshes);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Reorder triangles for the vertex cache and less overdraw,\n"
+            "and vertices for linear fetch. The result is stored in the\n"
+            "mesh cache, so the cost is paid once per model.");
+    }
+    int lodLevels = static_cast<int>(options.lodLevels);
+    if (ImGui::InputInt("LOD levels", &lodLevels, 1, 1, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        options.lodLevels = static_cast<uint32_t>(std::clamp(lodLevels, 0, 8));
+        changed = true;
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Simplified versions generated per mesh. The live view and\n"
+            "generated code pick one per mesh from its size on screen.");
+    }
+    if (options.lodLevels > 0) {
+        changed |= ImGui::InputFloat("LOD triangle ratio", &options.lodTriangleRatio,
+                                     0.05f, 0.1f, "%.2f", ImGuiInputTextFlags_EnterReturnsTrue);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Triangle count of each level relative to the previous one.");
+        }
+        changed |= ImGui::InputFloat("LOD target error", &options.lodTargetError,
+                                     0.001f, 0.01f, "%.3f", ImGuiInputTextFlags_EnterReturnsTrue);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip(
+                "Allowed deviation of the first level, relative to the mesh\n"
+                "size. Doubles with every further level.");
+        }
+        options.lodTriangleRatio = std::clamp(options.lodTriangleRatio, 0.05f, 0.95f);
+        options.lodTargetError = std::clamp(options.lodTargetError, 0.0001f, 1.0f);
+    }
+    changed |= ImGui::Checkbox("Build meshlets (experimental)", &options.buildMeshlets);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Experimental: split meshes into clusters of up to 64 vertices\n"
+            "and 124 triangles with bounding spheres and normal cones, for\n"
+            "per-cluster culling. Exposed on the Multi Vertex Data node's\n"
+            "Meshlets pin as storage buffers, but no pipeline consumes them\n"
+            "yet: drawing still uses the index buffers. Costs load time and\n"
+            "GPU memory without a custom shader that reads the pin.");
+    }
+    changed |= ImGui::Checkbox("Cook textures", &options.cookTextures);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Block-compress textures with full mip chains and cache them\n"
+            "as .dds files next to their source: BC1/BC7 color, BC7\n"
+            "metallic-roughness, BC5 normal maps. BC5 stores only X and Y;\n"
+            "shaders must rebuild Z as sqrt(1 - x*x - y*y).");
+    }
+    changed |= ImGui::Checkbox("Pack texture channels", &options.packTextureChannels);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Upload uncooked normal maps as R8G8 and metallic-roughness\n"
+            "maps as R8G8 or R8, keeping only the channels materials\n"
+            "sample; a view swizzle puts them back in place. Normal Z\n"
+            "and metallic-roughness R (ORM occlusion) are not kept.");
+    }
+    if (changed) {
+        node->setLoadOptions(options);
+    }
+
+    const char* vertexFormats[] = {
+        "Full (60 bytes)", "Packed (28 bytes)", "Packed + quantized positions (24 bytes)"
+    };
+    int vertexFormat = static_cast<int>(node->getVertexFormat());
+    if (ImGui::Combo("Vertex format", &vertexFormat, vertexFormats, IM_ARRAYSIZE(vertexFormats))) {
+        node->setVertexFormat(static_cast<VertexFormat>(vertexFormat));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(
+            "Packed stores octahedral normals/tangents, half UVs and\n"
+            "8-bit colors; shaders must decode them (see\n"
+            "vkDuck/vertex_formats.h). Quantized positions are restored\n"
+            "from a vertex-stage push constant (offset, scale).");
+    }
 }
 
 void MultiModelSettingsUI::DrawModelList(MultiModelSourceNode* node) {
@@ -70,17 +232,34 @@ void MultiModelSettingsUI::DrawModelList(MultiModelSourceNode* node) {
                             : ImVec4(0.6f, 0.6f, 0.6f, 1.0f);
                 ImGui::TextColored(textColor, "%zu. %s", i + 1,
                                    cached->displayName.c_str());
+            } else if (entry.path[0] != '\0' && g_modelManager &&
+                       g_modelManager->getStatus(entry.handle) == ModelStatus::Error) {
+                ImGui::TextColored(ImVec4(0.9f, 0.4f, 0.4f, 1.0f),
+                                   "%zu. %s (failed)", i + 1, entry.path);
             } else if (entry.path[0] != '\0') {
+                const float progress =
+                    g_modelManager ? g_modelManager->getLoadProgress(entry.handle) : 0.0f;
                 ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.4f, 1.0f),
-                                   "%zu. %s (loading...)", i + 1, entry.path);
+                                   "%zu. %s (loading %.0f%%)", i + 1, entry.path,
+                                   progress * 100.0f);
             } else {
                 ImGui::TextColored(ImVec4(0.9f, 0.4f, 0.4f, 1.0f),
                                    "%zu. (invalid)", i + 1);
             }
 
-            // Remove button
-            ImGui::SameLine(ImGui::GetWindowWidth() - 80);
+            // Node selection and remove buttons
+            ImGui::SameLine(ImGui::GetWindowWidth() - 135);
+            if (ImGui::SmallButton("Nodes")) {
+                g_pendingSelection = {node, i, {}};
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Pick the scene nodes to load from this model.");
+            }
+            ImGui::SameLine();
             if (ImGui::SmallButton("Remove")) {
+                if (g_pendingSelection.node == node) {
+                    g_pendingSelection = {};
+                }
                 node->removeModel(i);
                 ImGui::PopID();
                 break; // List changed, exit loop
@@ -93,6 +272,45 @@ void MultiModelSettingsUI::DrawModelList(MultiModelSourceNode* node) {
                                    cached->modelData.getTotalVertexCount(),
                                    cached->modelData.getTotalIndexCount(),
                                    cached->modelData.getGeometryCount());
+                if (!entry.nodeSelection.empty()) {
+                    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                       "   Loaded nodes: %zu selected",
+                                       entry.nodeSelection.size());
+                }
+                if (cached->modelData.getTotalInstanceCount() > 0) {
+                    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                       "   Instances: %zu",
+                                       cached->modelData.getTotalInstanceCount());
+                }
+                const MeshOptimizationStats& opt = cached->optimizationStats;
+                if (opt.applied) {
+                    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                       "   ACMR: %.3f -> %.3f  ATVR: %.3f -> %.3f",
+                                       opt.acmrBefore, opt.acmrAfter,
+                                       opt.atvrBefore, opt.atvrAfter);
+                }
+                auto lodTriangles = cached->modelData.getLodTriangleCounts();
+                if (lodTriangles.size() > 1) {
+                    std::string levels;
+                    for (size_t l = 0; l < lodTriangles.size(); ++l) {
+                        levels += (l > 0 ? " / " : "") + std::to_string(lodTriangles[l]);
+                    }
+                    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                       "   LOD triangles: %s", levels.c_str());
+                }
+                if (cached->meshletStats.meshletCount > 0) {
+                    const MeshletStats& meshlets = cached->meshletStats;
+                    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                       "   Meshlets: %zu, fill %.0f%% vertices / %.0f%% triangles",
+                                       meshlets.meshletCount,
+                                       meshlets.vertexFill * 100.0f,
+                                       meshlets.triangleFill * 100.0f);
+                    if (cached->meshletBuildMs > 0.0) {
+                        ImGui::SameLine();
+                        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                                           "(built in %.1f ms)", cached->meshletBuildMs);
+                    }
+                }
             }
 
             ImGui::PopID();
@@ -101,16 +319,34 @@ void MultiModelSettingsUI::DrawModelList(MultiModelSourceNode* node) {
         ImGui::EndChild();
     }
 
+    DrawNodeSelection(node);
+
     // Consolidated stats
     if (modelCount > 0) {
         ImGui::Separator();
         ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.3f, 1.0f), "Consolidated Data");
         ImGui::Text("Total Vertices: %zu",
                     node->getConsolidatedVertices().size());
-        ImGui::Text("Total Indices: %zu",
-                    node->getConsolidatedIndices().size());
+        ImGui::Text("Total Indices: %zu (%zu 16-bit)",
+                    node->getConsolidatedIndices().size() +
+                        node->getConsolidatedIndices16().size(),
+                    node->getConsolidatedIndices16().size());
         ImGui::Text("Total Geometry Ranges: %zu",
                     node->getConsolidatedRanges().size());
+        if (node->isInstanced()) {
+            ImGui::Text("Total Instances: %zu",
+                        node->getConsolidatedInstances().size());
+        }
+        if (!node->getConsolidatedMeshlets().empty()) {
+            const auto& meshlets = node->getConsolidatedMeshlets();
+            size_t triangles = 0;
+            for (const auto& meshlet : meshlets) {
+                triangles += meshlet.triangleCount;
+            }
+            ImGui::Text("Total Meshlets: %zu (%.1f triangles on average)",
+                        meshlets.size(),
+                        static_cast<float>(triangles) / static_cast<float>(meshlets.size()));
+        }
 
         const auto& cameras = node->getMergedCameras();
         const auto& lights = node->getMergedLights();
@@ -123,6 +359,80 @@ void MultiModelSettingsUI::DrawModelList(MultiModelSourceNode* node) {
     ImGui::Spacing();
 }
 
+void MultiModelSettingsUI::DrawNodeSelection(MultiModelSourceNode* node) {
+    PendingSelection& pending = g_pendingSelection;
+    if (pending.node != node || pending.modelIndex >= node->getModelCount() || !g_modelManager) {
+        return;
+    }
+
+    const ModelEntry& entry = node->getModel(pending.modelIndex);
+    const ModelOutline* outline =
+        entry.handle.isValid() ? g_modelManager->getOutline(entry.handle) : nullptr;
+
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.3f, 1.0f), "Nodes of %s", entry.path);
+    ImGui::SameLine(ImGui::GetWindowWidth() - 60);
+    if (ImGui::SmallButton("Close")) {
+        pending = {};
+        return;
+    }
+    if (!outline) {
+        ImGui::TextColored(ImVec4(0.9f, 0.4f, 0.4f, 1.0f), "Could not read the model's nodes");
+        return;
+    }
+
+    // Start from what the model was loaded with
+    if (pending.selected.size() != outline->nodes.size()) {
+        pending.selected.assign(outline->nodes.size(), false);
+        for (int32_t index : entry.nodeSelection) {
+            if (index >= 0 && static_cast<size_t>(index) < pending.selected.size()) {
+                pending.selected[index] = true;
+            }
+        }
+    }
+
+    ImGui::TextWrapped(
+        "Checked nodes load with all their children, in place. Buffers are "
+        "mapped, so only the checked meshes are read. Nothing checked loads "
+        "the whole scene.");
+    ImGui::BeginChild("NodeOutline", ImVec2(0, 250), true);
+    for (int32_t root : outline->roots) {
+        drawOutlineNode(*outline, root, pending.selected);
+    }
+    ImGui::EndChild();
+
+    std::vector<int32_t> selection;
+    for (size_t i = 0; i < pending.selected.size(); ++i) {
+        if (pending.selected[i]) {
+            selection.push_back(static_cast<int32_t>(i));
+        }
+    }
+    const uint64_t sceneVertices = subtreeVertexCount(*outline, outline->roots);
+    const uint64_t selectedVertices =
+        selection.empty() ? sceneVertices : subtreeVertexCount(*outline, selection);
+    ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f),
+                       "%zu nodes checked, %llu of %llu vertices (%.1f MB of buffers in file)",
+                       selection.size(),
+                       static_cast<unsigned long long>(selectedVertices),
+                       static_cast<unsigned long long>(sceneVertices),
+                       outline->bufferBytes / (1024.0 * 1024.0));
+
+    const bool changed = selection != entry.nodeSelection;
+    ImGui::BeginDisabled(!changed);
+    if (ImGui::Button("Load selection")) {
+        node->setModelNodeSelection(pending.modelIndex, selection);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Revert")) {
+        pending.selected.clear();
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        std::fill(pending.selected.begin(), pending.selected.end(), false);
+    }
+}
+
 // ============================================================================
 // Consumer Node Settings
 // ============================================================================
@@ -316,6 +626,45 @@ void MultiModelSettingsUI::DrawMultiUBOSettings(
         ImGui::Spacing();
     }
 
+    // Scene nodes of hierarchical models: moving one only rewrites the model
+    // matrices of the ranges below it
+    const auto& nodes = source->getConsolidatedNodes();
+    const bool hasNodeRanges = std::any_of(ranges.begin(), ranges.end(),
+        [](const EditorGeometryRange& range) { return range.node >= 0; });
+    if (hasNodeRanges) {
+        ImGui::Separator();
+        if (ImGui::TreeNode("nodes", "Scene Nodes (%zu)", nodes.size())) {
+            // Parents precede their children, so depths fill in one pass
+            std::vector<int> depths(nodes.size(), 0);
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i].parent >= 0) {
+                    depths[i] = depths[nodes[i].parent] + 1;
+                }
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(nodes.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    const SceneNode& sceneNode = nodes[i];
+                    ImGui::PushID(i);
+                    ImGui::Indent(depths[i] * 10.0f + 1.0f);
+                    glm::vec3 translation(sceneNode.localTransform[3]);
+                    if (ImGui::DragFloat3(sceneNode.name.c_str(), &translation.x, 0.05f)) {
+                        glm::mat4 local = sceneNode.localTransform;
+                        local[3] = glm::vec4(translation, 1.0f);
+                        if (source->setNodeLocalTransform(static_cast<size_t>(i), local)) {
+                            node->updateModelMatrices();
+                        }
+                    }
+                    ImGui::Unindent(depths[i] * 10.0f + 1.0f);
+                    ImGui::PopID();
+                }
+            }
+            ImGui::TreePop();
+        }
+    }
+
     ImGui::Separator();
     ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.3f, 1.0f), "UBO Outputs");
     ImGui::TextWrapped(
@@ -332,7 +681,7 @@ void MultiModelSettingsUI::DrawMultiMaterialSettings(
 
     const auto& ranges = source->getConsolidatedRanges();
     const auto& materials = source->getMergedMaterials();
-    const auto& images = source->getMergedImages();
+    const auto& textures = source->getMergedTextures();
 
     ImGui::Separator();
     ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.3f, 1.0f), "Material Outputs");
@@ -346,6 +695,6 @@ void MultiModelSettingsUI::DrawMultiMaterialSettings(
         ranges.size());
 
     // Show merged counts
-    ImGui::Text("Merged Textures: %zu  |  Merged Materials: %zu", images.size(),
+    ImGui::Text("Merged Textures: %zu  |  Merged Materials: %zu", textures.size(),
                 materials.size());
 }
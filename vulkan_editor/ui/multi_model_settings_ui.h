@@ -40,6 +40,9 @@ private:
     // Model list management for source node
     static void DrawModelList(MultiModelSourceNode* node);
 
+    // Outline of one model's glTF nodes to pick the subtrees to load
+    static void DrawNodeSelection(MultiModelSourceNode* node);
+
     // Connection status for consumer nodes
     static void DrawConnectionStatus(
         const char* nodeType,